@@ -0,0 +1,259 @@
+#include "alcance.h"
+#include "grafo.h"
+#include "memoria.h"
+
+#include <stdlib.h>
+
+/*
+ * Análisis de alcance
+ * -------------------
+ * Se ejecuta una vez al cargar el mapa y deja en cada nodo:
+ *  - componente: su componente fuertemente conexa (Tarjan iterativo).
+ *  - distanciaFinal: tiempo mínimo para llegar a un escenario final con el inventario
+ *    vacío (cada movimiento cuesta el costo base de su arista más 1), o -1 si no existe
+ *    camino. Cargar ítems solo encarece los movimientos, así que es una cota inferior.
+ *  - pasosFinal: cantidad de aristas de ese camino. Con peso p, recorrerlo cuesta
+ *    distanciaFinal + pasosFinal * (p / 10): una cota superior alcanzable (ver consejo.h).
+ *
+ * Con estos datos la partida detecta en O(1) cuándo ya no se puede ganar.
+ */
+
+/*
+ * calcular_componentes
+ * --------------------
+ * Algoritmo de Tarjan sin recursión (con pila explícita), para no desbordar la pila
+ * del programa en mapas de millones de nodos. Retorna la cantidad de componentes o -1
+ * si no hay memoria.
+ */
+
+static int calcular_componentes(Graph* g) {
+    int n = g->numberOfNodes;
+    int* orden = mem_reservar(MEM_GRAFO, sizeof(int) * n);       // Orden de descubrimiento (-1 = sin visitar)
+    int* bajo = mem_reservar(MEM_GRAFO, sizeof(int) * n);
+    int* pila = mem_reservar(MEM_GRAFO, sizeof(int) * n);        // Pila de Tarjan
+    int* llamadas = mem_reservar(MEM_GRAFO, sizeof(int) * n);    // Pila de recorrido (reemplaza la recursión)
+    int* siguienteArista = mem_reservar(MEM_GRAFO, sizeof(int) * n);
+    bool* enPila = mem_reservar_ceros(MEM_GRAFO, n, sizeof(bool));
+    if (!orden || !bajo || !pila || !llamadas || !siguienteArista || !enPila) {
+        mem_liberar(orden); mem_liberar(bajo); mem_liberar(pila); mem_liberar(llamadas); mem_liberar(siguienteArista); mem_liberar(enPila);
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) orden[i] = -1;
+    int contador = 0, tope = 0, componentes = 0;
+
+    for (int raiz = 0; raiz < n; raiz++) {
+        if (orden[raiz] >= 0) continue;
+
+        int profundidad = 0;
+        llamadas[profundidad++] = raiz;
+        orden[raiz] = bajo[raiz] = contador++;
+        siguienteArista[raiz] = g->inicioAristas[raiz];
+        pila[tope++] = raiz;
+        enPila[raiz] = true;
+
+        while (profundidad > 0) {
+            int v = llamadas[profundidad - 1];
+            if (siguienteArista[v] < g->inicioAristas[v + 1]) {
+                int w = g->aristas[siguienteArista[v]++].destino;
+                if (orden[w] < 0) {
+                    orden[w] = bajo[w] = contador++;
+                    siguienteArista[w] = g->inicioAristas[w];
+                    pila[tope++] = w;
+                    enPila[w] = true;
+                    llamadas[profundidad++] = w;
+                } else if (enPila[w] && orden[w] < bajo[v]) {
+                    bajo[v] = orden[w];
+                }
+                continue;
+            }
+
+            // Todas las aristas de v revisadas: cerrar su componente si es raíz
+            if (bajo[v] == orden[v]) {
+                int w;
+                do {
+                    w = pila[--tope];
+                    enPila[w] = false;
+                    g->nodes[w].state.componente = componentes;
+                } while (w != v);
+                componentes++;
+            }
+            profundidad--;
+            if (profundidad > 0) {
+                int padre = llamadas[profundidad - 1];
+                if (bajo[v] < bajo[padre]) bajo[padre] = bajo[v];
+            }
+        }
+    }
+
+    mem_liberar(orden); mem_liberar(bajo); mem_liberar(pila); mem_liberar(llamadas); mem_liberar(siguienteArista); mem_liberar(enPila);
+    return componentes;
+}
+
+// Entrada del montículo de Dijkstra: nodo con su distancia al momento de insertarlo.
+typedef struct {
+    int distancia;
+    int nodo;
+} EntradaMonticulo;
+
+static void monticulo_insertar(EntradaMonticulo* m, int* tam, int distancia, int nodo) {
+    int i = (*tam)++;
+    while (i > 0 && m[(i - 1) / 2].distancia > distancia) {
+        m[i] = m[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    m[i].distancia = distancia;
+    m[i].nodo = nodo;
+}
+
+static EntradaMonticulo monticulo_extraer(EntradaMonticulo* m, int* tam) {
+    EntradaMonticulo minimo = m[0];
+    EntradaMonticulo ultimo = m[--(*tam)];
+    int i = 0;
+    while (2 * i + 1 < *tam) {
+        int hijo = 2 * i + 1;
+        if (hijo + 1 < *tam && m[hijo + 1].distancia < m[hijo].distancia) hijo++;
+        if (ultimo.distancia <= m[hijo].distancia) break;
+        m[i] = m[hijo];
+        i = hijo;
+    }
+    m[i] = ultimo;
+    return minimo;
+}
+
+/*
+ * calcular_distancias
+ * -------------------
+ * Dijkstra múltiple desde todos los finales sobre las aristas invertidas, con el costo
+ * de cada arista a inventario vacío (costo base + 1): la distancia obtenida para cada
+ * nodo es el tiempo mínimo para llegar a algún final. Entre los caminos de igual tiempo
+ * se cuentan las aristas del que tiene menos. Retorna false si no hay memoria.
+ */
+
+static bool calcular_distancias(Graph* g) {
+    int n = g->numberOfNodes;
+    int m = g->inicioAristas[n];
+    int* inicioInversas = mem_reservar_ceros(MEM_GRAFO, n + 1, sizeof(int));
+    int* posicion = mem_reservar(MEM_GRAFO, sizeof(int) * (n + 1));
+    int* inversas = mem_reservar(MEM_GRAFO, sizeof(int) * (m + 1));      // Índice de la arista original
+    int* origen = mem_reservar(MEM_GRAFO, sizeof(int) * (m + 1));        // Nodo del que sale cada arista
+    EntradaMonticulo* monticulo = mem_reservar(MEM_GRAFO, sizeof(EntradaMonticulo) * (m + n + 1));
+    if (!inicioInversas || !posicion || !inversas || !origen || !monticulo) {
+        mem_liberar(inicioInversas); mem_liberar(posicion); mem_liberar(inversas); mem_liberar(origen); mem_liberar(monticulo);
+        return false;
+    }
+
+    // Aristas invertidas en formato compacto: primero contar, luego ubicar
+    for (int v = 0; v < n; v++)
+        for (int k = g->inicioAristas[v]; k < g->inicioAristas[v + 1]; k++) {
+            origen[k] = v;
+            inicioInversas[g->aristas[k].destino + 1]++;
+        }
+    for (int v = 0; v < n; v++) inicioInversas[v + 1] += inicioInversas[v];
+    for (int v = 0; v <= n; v++) posicion[v] = inicioInversas[v];
+    for (int k = 0; k < m; k++) inversas[posicion[g->aristas[k].destino]++] = k;
+    mem_liberar(posicion);
+
+    int tam = 0;
+    for (int v = 0; v < n; v++) {
+        g->nodes[v].state.distanciaFinal = -1;
+        g->nodes[v].state.pasosFinal = 0;
+        if (g->nodes[v].state.esFinal) {
+            g->nodes[v].state.distanciaFinal = 0;
+            monticulo_insertar(monticulo, &tam, 0, v);
+        }
+    }
+    while (tam > 0) {
+        EntradaMonticulo actual = monticulo_extraer(monticulo, &tam);
+        int w = actual.nodo;
+        if (actual.distancia > g->nodes[w].state.distanciaFinal) continue;     // Entrada vieja
+        for (int j = inicioInversas[w]; j < inicioInversas[w + 1]; j++) {
+            int k = inversas[j];
+            int v = origen[k];
+            int distancia = actual.distancia + g->aristas[k].costo + 1;
+            int previa = g->nodes[v].state.distanciaFinal;
+            int pasos = g->nodes[w].state.pasosFinal + 1;
+            if (previa < 0 || distancia < previa) {
+                g->nodes[v].state.distanciaFinal = distancia;
+                g->nodes[v].state.pasosFinal = pasos;
+                monticulo_insertar(monticulo, &tam, distancia, v);
+            } else if (distancia == previa && pasos < g->nodes[v].state.pasosFinal) {
+                g->nodes[v].state.pasosFinal = pasos;   // v sigue en el montículo: se propaga al extraerlo
+            }
+        }
+    }
+
+    mem_liberar(inicioInversas); mem_liberar(inversas); mem_liberar(origen); mem_liberar(monticulo);
+    return true;
+}
+
+/**
+ * analizar_alcance
+ * -----------------
+ * Precalcula, para cada nodo del grafo recién cargado, su componente fuertemente
+ * conexa y su tiempo mínimo hasta un final, y deja un resumen en g->alcance.
+ *
+ * Consideraciones:
+ *  - Costo O((nodos + aristas) log nodos) en tiempo y O(nodos + aristas) en memoria auxiliar.
+ *  - Los resultados viajan con los nodos, así que también valen en las copias del grafo.
+ *  - Retorna false si no hay memoria (en ese caso ningún nodo se considera sin salida).
+ */
+
+bool analizar_alcance(Graph* g) {
+    g->alcance.componentes = 0;
+    g->alcance.sinSalida = 0;
+    g->alcance.distanciaInicio = -1;
+
+    int componentes = calcular_componentes(g);
+    if (componentes < 0 || !calcular_distancias(g)) {
+        for (int v = 0; v < g->numberOfNodes; v++) {
+            g->nodes[v].state.componente = 0;
+            g->nodes[v].state.distanciaFinal = 0;
+            g->nodes[v].state.pasosFinal = 0;
+        }
+        return false;
+    }
+
+    g->alcance.componentes = componentes;
+    for (int v = 0; v < g->numberOfNodes; v++) {
+        if (g->nodes[v].state.distanciaFinal < 0) g->alcance.sinSalida++;
+    }
+    if (g->start) g->alcance.distanciaInicio = g->start->state.distanciaFinal;
+    return true;
+}
+
+/*
+ * marcar_alcanzables
+ * ------------------
+ * Recorrido en anchura desde 'origen' siguiendo las aristas en su sentido. La cola es
+ * un arreglo de n posiciones: cada nodo entra a lo sumo una vez.
+ */
+
+bool* marcar_alcanzables(const Graph* g, int origen) {
+    int n = g->numberOfNodes;
+    bool* visitado = mem_reservar_ceros(MEM_GRAFO, n > 0 ? n : 1, sizeof(bool));
+    int* cola = mem_reservar(MEM_GRAFO, sizeof(int) * (n > 0 ? n : 1));
+    if (!visitado || !cola) {
+        mem_liberar(visitado);
+        mem_liberar(cola);
+        return NULL;
+    }
+
+    int inicio = 0, fin = 0;
+    if (origen >= 0 && origen < n) {
+        visitado[origen] = true;
+        cola[fin++] = origen;
+    }
+    while (inicio < fin) {
+        int u = cola[inicio++];
+        for (int k = g->inicioAristas[u]; k < g->inicioAristas[u + 1]; k++) {
+            int v = g->aristas[k].destino;
+            if (!visitado[v]) {
+                visitado[v] = true;
+                cola[fin++] = v;
+            }
+        }
+    }
+    mem_liberar(cola);
+    return visitado;
+}
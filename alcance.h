@@ -0,0 +1,22 @@
+#ifndef ALCANCE_H
+#define ALCANCE_H
+
+#include <stdbool.h>
+
+typedef struct Graph Graph;
+
+// Resumen del análisis de alcance de un mapa.
+typedef struct {
+    int componentes;        // Componentes fuertemente conexas
+    int sinSalida;          // Escenarios desde los que no se puede llegar a ningún final
+    int distanciaInicio;    // Tiempo mínimo desde el inicio hasta un final (-1 si no hay camino)
+} ResumenAlcance;
+
+// Calcula componentes, escenarios sin salida y tiempo mínimo hasta un final de cada nodo.
+bool analizar_alcance(Graph* g);
+
+// Marca con true los nodos a los que se puede llegar desde 'origen' (índice en g->nodes).
+// Retorna un arreglo de g->numberOfNodes posiciones que se libera con mem_liberar, o NULL.
+bool* marcar_alcanzables(const Graph* g, int origen);
+
+#endif // ALCANCE_H
@@ -0,0 +1,286 @@
+#include "bot.h"
+#include "grafo.h"
+#include "list.h"
+#include "metricas.h"
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define VICTORIA 1000000.0      // Utilidad de llegar a un final, sobre cualquier puntaje
+#define RIESGOITEM 0.05         // Probabilidad de que un rival se lleve un ítem dado en su turno
+#define REVISARRELOJ 64         // Nodos de búsqueda entre dos lecturas del reloj (potencia de 2)
+
+static _Atomic int presupuesto = PRESUPUESTOBOT;
+
+void bot_configurar_presupuesto(int microsegundos) {
+    atomic_store_explicit(&presupuesto, microsegundos < 10 ? 10 : microsegundos, memory_order_relaxed);
+}
+
+int bot_presupuesto(void) {
+    return atomic_load_explicit(&presupuesto, memory_order_relaxed);
+}
+
+typedef struct {
+    int peso;
+    int valor;
+} ItemSimulado;
+
+// Estado de la partida simulada. Cada acción se aplica y se deshace sobre él, sin reservas.
+typedef struct {
+    const Graph* g;
+    int      nodo;
+    int      tiempo;
+    int      peso;
+    int      puntaje;
+    int      turnos;                            // Movimientos simulados (turnos de los rivales)
+    ItemSimulado inventario[MAXINVENTARIOBOT];
+    int      numInventario;
+    const Item* tomados[MAXPROFUNDIDADBOT];     // Recogidos, o perdidos, en la línea simulada
+    int      numTomados;
+    double   supervivencia[MAXPROFUNDIDADBOT + 1];  // Probabilidad de que un ítem siga tras t turnos
+    uint64_t limite;                            // Reloj en que se agota el presupuesto
+    unsigned visitados;
+    bool     agotado;
+    bool     recortada;                         // Alguna línea terminó en la evaluación heurística
+} Busqueda;
+
+static bool ya_tomado(const Busqueda* b, const Item* item) {
+    for (int i = 0; i < b->numTomados; i++) {
+        if (b->tomados[i] == item) return true;
+    }
+    return false;
+}
+
+// Las mismas condiciones con que termina la partida (ver jugador_terminado).
+static bool terminal(const Busqueda* b, double* valor) {
+    const State* s = &b->g->nodes[b->nodo].state;
+    if (b->tiempo <= 0) {
+        *valor = b->puntaje;
+    } else if (s->esFinal) {
+        *valor = VICTORIA + b->puntaje;
+    } else if (s->distanciaFinal < 0 || b->tiempo <= s->distanciaFinal) {
+        *valor = b->puntaje;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/*
+ * heuristica
+ * ----------
+ * Valor de una partida que sigue en curso al llegar a la profundidad máxima. La distancia
+ * precalculada al final (ver alcance.h) supone el inventario vacío; con peso p, cada
+ * arista cuesta p / 10 más, y el camino tiene como mucho 'distancia' aristas. Si el
+ * tiempo alcanza aun en el peor caso, el final es seguro; si solo alcanza en el mejor,
+ * vale media victoria.
+ */
+
+static double heuristica(const Busqueda* b) {
+    int distancia = b->g->nodes[b->nodo].state.distanciaFinal;
+    int extra = b->peso / 10;
+    if (b->tiempo > distancia * (1 + extra)) return VICTORIA + b->puntaje;
+    if (b->tiempo > distancia + extra) return VICTORIA / 2 + b->puntaje;
+    return b->puntaje;
+}
+
+static double buscar(Busqueda* b, int profundidad, DecisionBot* raiz);
+
+/*
+ * Recoger es un nodo de azar: el ítem sigue ahí con la probabilidad de que ningún rival
+ * lo haya tomado en los turnos simulados. Si ya no está, el intento no gasta tiempo y el
+ * bot sigue desde el mismo estado sin ese ítem.
+ */
+
+static double simular_recoger(Busqueda* b, const Item* item, int profundidad) {
+    double p = b->supervivencia[b->turnos];
+    double valor = 0;
+    b->tomados[b->numTomados++] = item;
+    if (p > 0) {
+        bool guardado = b->numInventario < MAXINVENTARIOBOT;
+        if (guardado) b->inventario[b->numInventario++] = (ItemSimulado){ item->weight, item->value };
+        b->tiempo -= 1;
+        b->peso += item->weight;
+        b->puntaje += item->value;
+        valor = p * buscar(b, profundidad - 1, NULL);
+        b->tiempo += 1;
+        b->peso -= item->weight;
+        b->puntaje -= item->value;
+        if (guardado) b->numInventario--;
+    }
+    if (p < 1) valor += (1 - p) * buscar(b, profundidad - 1, NULL);
+    b->numTomados--;
+    return valor;
+}
+
+// Descartar solo sirve si baja el costo de avanzar (el peso se cuenta de a 10).
+static bool conviene_descartar(const Busqueda* b, int i) {
+    return (b->peso - b->inventario[i].peso) / 10 < b->peso / 10;
+}
+
+static double simular_descartar(Busqueda* b, int i, int profundidad) {
+    ItemSimulado quitado = b->inventario[i];
+    b->inventario[i] = b->inventario[--b->numInventario];
+    b->tiempo -= 1;
+    b->peso -= quitado.peso;
+    b->puntaje -= quitado.valor;
+    double valor = buscar(b, profundidad - 1, NULL);
+    b->tiempo += 1;
+    b->peso += quitado.peso;
+    b->puntaje += quitado.valor;
+    b->inventario[b->numInventario++] = b->inventario[i];
+    b->inventario[i] = quitado;
+    return valor;
+}
+
+static double simular_mover(Busqueda* b, const Arista* arista, int profundidad) {
+    int nodo = b->nodo;
+    int gasto = arista->costo + (b->peso + 1 + 9) / 10;     // Igual que mover_por_arista
+    b->nodo = arista->destino;
+    b->tiempo -= gasto;
+    b->turnos++;
+    double valor = buscar(b, profundidad - 1, NULL);
+    b->turnos--;
+    b->tiempo += gasto;
+    b->nodo = nodo;
+    return valor;
+}
+
+/*
+ * buscar
+ * ------
+ * Máximo sobre las acciones posibles (recoger cada ítem disponible, descartar los ítems
+ * que bajan el costo de avanzar y avanzar por cada arista) del valor esperado de la
+ * partida, hasta 'profundidad' acciones. En la raíz deja la mejor acción en 'raiz'.
+ *
+ * Consideraciones:
+ *  - Recorre las listas de ítems por sus nodos, sin mover su cursor: el grafo es
+ *    compartido y no se modifica.
+ *  - Cada REVISARRELOJ nodos mira el reloj; al pasar el límite marca la búsqueda como
+ *    agotada y todo el recorrido en curso se descarta.
+ */
+
+static double buscar(Busqueda* b, int profundidad, DecisionBot* raiz) {
+    double valor;
+    if (terminal(b, &valor)) return valor;
+    if (profundidad == 0) {
+        b->recortada = true;
+        return heuristica(b);
+    }
+    if ((++b->visitados & (REVISARRELOJ - 1)) == 0 && metricas_reloj() > b->limite) b->agotado = true;
+    if (b->agotado) return 0;
+
+    double mejor = -1;
+    const Node* n = &b->g->nodes[b->nodo];
+    List* items = n->state.availableItems;
+    for (ListNode* ln = items ? items->head : NULL; ln; ln = ln->next) {
+        Item* item = ln->data;
+        if (!item_disponible(item) || ya_tomado(b, item)) continue;
+        valor = simular_recoger(b, item, profundidad);
+        if (valor > mejor) {
+            mejor = valor;
+            if (raiz) *raiz = (DecisionBot){ .tipo = BOT_RECOGER, .item = item };
+        }
+    }
+
+    for (int i = 0; i < b->numInventario; i++) {
+        if (!conviene_descartar(b, i)) continue;
+        valor = simular_descartar(b, i, profundidad);
+        if (valor > mejor) {
+            mejor = valor;
+            if (raiz) *raiz = (DecisionBot){ .tipo = BOT_DESCARTAR, .posicion = i };
+        }
+    }
+
+    int numAristas;
+    const Arista* aristas = aristas_de(b->g, n, &numAristas);
+    for (int k = 0; k < numAristas; k++) {
+        valor = simular_mover(b, &aristas[k], profundidad);
+        if (valor > mejor) {
+            mejor = valor;
+            if (raiz) *raiz = (DecisionBot){ .tipo = BOT_MOVER, .arista = &aristas[k] };
+        }
+    }
+    return mejor < 0 ? heuristica(b) : mejor;
+}
+
+/**
+ * decidir
+ * -------
+ * Profundización iterativa: busca con profundidad 1, 2, ... mientras quede presupuesto,
+ * y se queda con la decisión de la última profundidad que terminó. Si ninguna línea llegó
+ * a la evaluación heurística, el árbol se exploró completo y la decisión es exacta.
+ *
+ * Consideraciones:
+ *  - La profundidad 1 nunca se interrumpe (sus hijos se evalúan sin mirar el reloj), así
+ *    que siempre hay una decisión aunque el presupuesto sea mínimo.
+ *  - El inventario simulado se arma con los ítems en el orden del real, de modo que la
+ *    posición de un descarte en la raíz es su posición en gs->inventory.
+ */
+
+static DecisionBot decidir(const GameState* gs, int rivales, int microsegundos) {
+    DecisionBot decision = { .tipo = BOT_NINGUNA };
+    if (jugador_terminado(gs)) return decision;
+
+    Busqueda b;
+    b.g = gs->grafo;
+    b.nodo = (int)(gs->currentNode - gs->grafo->nodes);
+    b.tiempo = gs->tiempoRestante;
+    b.peso = 0;
+    b.puntaje = 0;
+    b.turnos = 0;
+    b.numInventario = 0;
+    b.numTomados = 0;
+    for (ListNode* ln = gs->inventory->head; ln; ln = ln->next) {
+        const Item* item = ln->data;
+        b.peso += item->weight;
+        b.puntaje += item->value;
+        if (b.numInventario < MAXINVENTARIOBOT) b.inventario[b.numInventario++] = (ItemSimulado){ item->weight, item->value };
+    }
+    double porTurno = 1;
+    for (int r = 0; r < rivales; r++) porTurno *= 1 - RIESGOITEM;
+    b.supervivencia[0] = 1;
+    for (int t = 1; t <= MAXPROFUNDIDADBOT; t++) b.supervivencia[t] = b.supervivencia[t - 1] * porTurno;
+    b.limite = metricas_reloj() + (uint64_t)microsegundos * 1000u;
+    b.visitados = 0;
+    b.agotado = false;
+
+    for (int profundidad = 1; profundidad <= MAXPROFUNDIDADBOT; profundidad++) {
+        DecisionBot candidata = { .tipo = BOT_NINGUNA };
+        b.recortada = false;
+        double valor = buscar(&b, profundidad, &candidata);
+        if (b.agotado) break;
+        decision = candidata;
+        decision.valor = valor;
+        decision.profundidad = profundidad;
+        if (!b.recortada) break;
+    }
+    return decision;
+}
+
+DecisionBot bot_decidir(const GameState* gs, int rivales) {
+    return bot_decidir_con(gs, rivales, bot_presupuesto());
+}
+
+DecisionBot bot_decidir_con(const GameState* gs, int rivales, int microsegundos) {
+    MEDIR_INICIO(inicio);
+    DecisionBot decision = decidir(gs, rivales, microsegundos < 10 ? 10 : microsegundos);
+    MEDIR_FIN(inicio, MET_DECISION_BOT);
+    return decision;
+}
+
+bool bot_aplicar(GameState* gs, const DecisionBot* decision, int* gasto) {
+    switch (decision->tipo) {
+        case BOT_RECOGER:
+            return recoger_item(gs, decision->item);
+        case BOT_DESCARTAR:
+            return descartar_item(gs, decision->posicion);
+        case BOT_MOVER: {
+            int gastado = mover_por_arista(gs, decision->arista);
+            if (gasto) *gasto = gastado;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include <stdbool.h>
+#include "game.h"
+
+/*
+ * Jugador automático. Decide una acción a la vez (recoger, descartar o avanzar) con una
+ * búsqueda expectimax de profundidad creciente que simula las reglas exactas del juego:
+ * recoger y descartar gastan 1 de tiempo, avanzar gasta el costo de la arista más
+ * (peso + 10) / 10, y la partida termina sin tiempo, en un final o sin salida.
+ *
+ * En multijugador, un ítem que el bot piensa recoger más adelante puede llevárselo otro
+ * jugador: cada recogida futura es un nodo de azar cuya probabilidad baja con los turnos
+ * de los rivales que pasan antes de llegar a él.
+ *
+ * Cada decisión respeta un presupuesto de tiempo (1 ms por defecto, ver --bot-budget):
+ * al agotarlo se usa la mejor acción de la última profundidad completa. La búsqueda no
+ * reserva memoria ni modifica el grafo, así que muchos bots pueden decidir a la vez en
+ * hilos distintos.
+ */
+
+#define PRESUPUESTOBOT 1000         // Microsegundos por decisión
+#define MAXPROFUNDIDADBOT 32        // Acciones simuladas como máximo
+#define MAXINVENTARIOBOT 64         // Ítems del inventario que se consideran para descartar
+
+typedef enum {
+    BOT_NINGUNA,        // El jugador ya terminó
+    BOT_RECOGER,
+    BOT_DESCARTAR,
+    BOT_MOVER
+} TipoAccionBot;
+
+typedef struct {
+    TipoAccionBot tipo;
+    Item*         item;         // BOT_RECOGER: ítem del escenario actual
+    int           posicion;     // BOT_DESCARTAR: posición en el inventario (desde 0)
+    const Arista* arista;       // BOT_MOVER: arista del escenario actual
+    double        valor;        // Utilidad esperada según la búsqueda
+    int           profundidad;  // Última profundidad completada
+} DecisionBot;
+
+// Cambia el presupuesto de cada decisión (mínimo 10 microsegundos).
+void bot_configurar_presupuesto(int microsegundos);
+
+// Presupuesto configurado, en microsegundos.
+int bot_presupuesto(void);
+
+// Elige la siguiente acción del jugador. 'rivales' es cuántos otros jugadores siguen en
+// la partida (0 en un jugador).
+DecisionBot bot_decidir(const GameState* gs, int rivales);
+
+// Igual, con un presupuesto propio en vez del configurado (ver libgraphquest.h).
+DecisionBot bot_decidir_con(const GameState* gs, int rivales, int microsegundos);
+
+// Ejecuta la acción con las funciones del motor. Retorna false si no se pudo (por
+// ejemplo, otro jugador reclamó el ítem mientras se decidía). 'gasto' recibe el tiempo
+// gastado al avanzar (puede ser NULL).
+bool bot_aplicar(GameState* gs, const DecisionBot* decision, int* gasto);
+
+#endif // BOT_H
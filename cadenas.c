@@ -0,0 +1,378 @@
+#include "cadenas.h"
+#include "memoria.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Pool de cadenas
+ * ---------------
+ * Las cadenas se copian en bloques grandes que nunca se mueven, así que los punteros
+ * retornados son estables mientras viva el pool. Una tabla hash con direccionamiento
+ * abierto detecta las cadenas repetidas para guardarlas una sola vez.
+ *
+ * Diccionario
+ * -----------
+ * Compresión simple por palabras para descripciones: se eligen las palabras que más
+ * bytes ahorran en el conjunto de entrenamiento y cada aparición se reemplaza por un
+ * código de 2 bytes. Los bytes 0x10-0x1F inician un código (sus 4 bits bajos son la
+ * parte alta del índice) y 0x0F escapa un byte literal de ese rango, que no aparece
+ * en texto normal. Descomprimir es una sola pasada de copias.
+ */
+
+#define TAMBLOQUE (64 * 1024)
+#define MAXPALABRAS 4096
+#define MAXLARGOPALABRA 255
+#define CODIGO_MIN 0x10
+#define CODIGO_MAX 0x1F
+#define ESCAPE 0x0F
+
+typedef struct Bloque {
+    struct Bloque* siguiente;
+    size_t uso;
+    size_t tam;
+    char datos[];
+} Bloque;
+
+typedef struct {
+    unsigned long long hash;
+    const char* cadena;     // NULL si la casilla está vacía
+    size_t largo;
+} EntradaPool;
+
+struct PoolCadenas {
+    Bloque* bloques;
+    EntradaPool* tabla;
+    size_t capacidad;       // Potencia de 2
+    EstadisticasPool estadisticas;
+};
+
+struct Diccionario {
+    int numPalabras;
+    int* desplazamientos;           // Inicio de cada palabra en 'texto'
+    unsigned char* largos;
+    char* texto;
+    size_t tamTexto;
+    int* tabla;                     // Hash palabra → índice (-1 vacía), para comprimir
+    size_t capTabla;
+};
+
+static unsigned long long hash_bytes(const char* datos, size_t largo) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (size_t i = 0; i < largo; i++) {
+        h ^= (unsigned char)datos[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+PoolCadenas* pool_crear(void) {
+    PoolCadenas* pool = mem_reservar_ceros(MEM_GRAFO, 1, sizeof(PoolCadenas));
+    if (!pool) return NULL;
+    pool->capacidad = 1024;
+    pool->tabla = mem_reservar_ceros(MEM_GRAFO, pool->capacidad, sizeof(EntradaPool));
+    if (!pool->tabla) {
+        mem_liberar(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+static bool pool_crecer_tabla(PoolCadenas* pool) {
+    size_t nuevaCap = pool->capacidad * 2;
+    EntradaPool* nueva = mem_reservar_ceros(MEM_GRAFO, nuevaCap, sizeof(EntradaPool));
+    if (!nueva) return false;
+    for (size_t i = 0; i < pool->capacidad; i++) {
+        EntradaPool* e = &pool->tabla[i];
+        if (!e->cadena) continue;
+        size_t j = e->hash & (nuevaCap - 1);
+        while (nueva[j].cadena) j = (j + 1) & (nuevaCap - 1);
+        nueva[j] = *e;
+    }
+    mem_liberar(pool->tabla);
+    pool->tabla = nueva;
+    pool->capacidad = nuevaCap;
+    return true;
+}
+
+static char* pool_reservar(PoolCadenas* pool, size_t bytes) {
+    Bloque* b = pool->bloques;
+    if (!b || b->tam - b->uso < bytes) {
+        size_t tam = bytes > TAMBLOQUE ? bytes : TAMBLOQUE;
+        b = mem_reservar(MEM_GRAFO, sizeof(Bloque) + tam);
+        if (!b) return NULL;
+        b->siguiente = pool->bloques;
+        b->uso = 0;
+        b->tam = tam;
+        pool->bloques = b;
+    }
+    char* p = b->datos + b->uso;
+    b->uso += bytes;
+    return p;
+}
+
+/**
+ * pool_agregar
+ * -------------
+ * Retorna una copia de los 'largo' bytes indicados terminada en '\0'. Si el pool ya
+ * contiene exactamente los mismos bytes, retorna la copia existente en vez de crear otra.
+ * Acepta datos binarios (por ejemplo, textos comprimidos), ya que compara por largo.
+ * Retorna NULL si no hay memoria.
+ */
+
+const char* pool_agregar(PoolCadenas* pool, const char* datos, size_t largo) {
+    pool->estadisticas.cadenas++;
+    pool->estadisticas.bytesPedidos += largo + 1;
+
+    unsigned long long h = hash_bytes(datos, largo);
+    size_t mascara = pool->capacidad - 1;
+    size_t i = h & mascara;
+    for (; pool->tabla[i].cadena; i = (i + 1) & mascara) {
+        EntradaPool* e = &pool->tabla[i];
+        if (e->hash == h && e->largo == largo && memcmp(e->cadena, datos, largo) == 0) return e->cadena;
+    }
+
+    // La tabla crece antes de pasar de la mitad; si no puede crecer, no se agrega nada
+    // (llena, la búsqueda de arriba no terminaría)
+    if ((pool->estadisticas.unicas + 1) * 2 > pool->capacidad) {
+        if (!pool_crecer_tabla(pool)) return NULL;
+        mascara = pool->capacidad - 1;
+        for (i = h & mascara; pool->tabla[i].cadena; i = (i + 1) & mascara) {}
+    }
+
+    char* copia = pool_reservar(pool, largo + 1);
+    if (!copia) return NULL;
+    memcpy(copia, datos, largo);
+    copia[largo] = '\0';
+
+    pool->tabla[i].hash = h;
+    pool->tabla[i].cadena = copia;
+    pool->tabla[i].largo = largo;
+    pool->estadisticas.unicas++;
+    pool->estadisticas.bytesGuardados += largo + 1;
+    return copia;
+}
+
+EstadisticasPool pool_estadisticas(const PoolCadenas* pool) {
+    EstadisticasPool vacio = {0};
+    return pool ? pool->estadisticas : vacio;
+}
+
+void pool_liberar(PoolCadenas* pool) {
+    if (!pool) return;
+    Bloque* b = pool->bloques;
+    while (b) {
+        Bloque* siguiente = b->siguiente;
+        mem_liberar(b);
+        b = siguiente;
+    }
+    mem_liberar(pool->tabla);
+    mem_liberar(pool);
+}
+
+/* ---------------------------- Diccionario ---------------------------- */
+
+typedef struct {
+    unsigned long long hash;
+    const char* palabra;    // Apunta al texto de entrenamiento (NULL si vacía)
+    int largo;
+    int apariciones;
+} Candidata;
+
+static int comparar_candidatas(const void* a, const void* b) {
+    const Candidata* x = a;
+    const Candidata* y = b;
+    long ahorroX = (long)x->apariciones * (x->largo - 2);
+    long ahorroY = (long)y->apariciones * (y->largo - 2);
+    if (ahorroX != ahorroY) return ahorroX > ahorroY ? -1 : 1;
+    return 0;
+}
+
+// Busca la palabra en la tabla de compresión. Retorna su índice o -1.
+static int diccionario_buscar(const Diccionario* dic, const char* palabra, int largo) {
+    unsigned long long h = hash_bytes(palabra, (size_t)largo);
+    size_t mascara = dic->capTabla - 1;
+    for (size_t i = h & mascara; dic->tabla[i] >= 0; i = (i + 1) & mascara) {
+        int k = dic->tabla[i];
+        if (dic->largos[k] == largo && memcmp(dic->texto + dic->desplazamientos[k], palabra, (size_t)largo) == 0) return k;
+    }
+    return -1;
+}
+
+/**
+ * diccionario_entrenar
+ * ---------------------
+ * Cuenta las palabras (separadas por espacios, de 3 a 255 bytes) de los textos de
+ * ejemplo y conserva hasta MAXPALABRAS de las que más bytes ahorrarían al reemplazarse
+ * por un código de 2 bytes. Retorna NULL si no hay memoria.
+ */
+
+Diccionario* diccionario_entrenar(const char** textos, int cantidad) {
+    size_t capConteo = 1024;
+    size_t usadas = 0;
+    Candidata* conteo = mem_reservar_ceros(MEM_GRAFO, capConteo, sizeof(Candidata));
+    Diccionario* dic = mem_reservar_ceros(MEM_GRAFO, 1, sizeof(Diccionario));
+    if (!conteo || !dic) {
+        mem_liberar(conteo);
+        mem_liberar(dic);
+        return NULL;
+    }
+
+    for (int t = 0; t < cantidad; t++) {
+        const char* p = textos[t];
+        while (*p) {
+            while (*p == ' ') p++;
+            const char* inicio = p;
+            while (*p && *p != ' ') p++;
+            int largo = (int)(p - inicio);
+            if (largo < 3 || largo > MAXLARGOPALABRA) continue;
+
+            unsigned long long h = hash_bytes(inicio, (size_t)largo);
+            size_t i = h & (capConteo - 1);
+            while (conteo[i].palabra && !(conteo[i].hash == h && conteo[i].largo == largo &&
+                                          memcmp(conteo[i].palabra, inicio, (size_t)largo) == 0)) {
+                i = (i + 1) & (capConteo - 1);
+            }
+            if (!conteo[i].palabra) {
+                conteo[i].hash = h;
+                conteo[i].palabra = inicio;
+                conteo[i].largo = largo;
+                usadas++;
+            }
+            conteo[i].apariciones++;
+
+            if (usadas * 2 > capConteo) {
+                Candidata* nuevo = mem_reservar_ceros(MEM_GRAFO, capConteo * 2, sizeof(Candidata));
+                if (!nuevo) break;
+                for (size_t k = 0; k < capConteo; k++) {
+                    if (!conteo[k].palabra) continue;
+                    size_t j = conteo[k].hash & (capConteo * 2 - 1);
+                    while (nuevo[j].palabra) j = (j + 1) & (capConteo * 2 - 1);
+                    nuevo[j] = conteo[k];
+                }
+                mem_liberar(conteo);
+                conteo = nuevo;
+                capConteo *= 2;
+            }
+        }
+    }
+
+    // Compactar y ordenar las candidatas por ahorro
+    size_t n = 0;
+    for (size_t k = 0; k < capConteo; k++) {
+        if (conteo[k].palabra && conteo[k].apariciones >= 2) conteo[n++] = conteo[k];
+    }
+    qsort(conteo, n, sizeof(Candidata), comparar_candidatas);
+    if (n > MAXPALABRAS) n = MAXPALABRAS;
+
+    dic->numPalabras = (int)n;
+    for (size_t k = 0; k < n; k++) dic->tamTexto += (size_t)conteo[k].largo;
+    dic->desplazamientos = mem_reservar(MEM_GRAFO, sizeof(int) * (n + 1));
+    dic->largos = mem_reservar(MEM_GRAFO, n + 1);
+    dic->texto = mem_reservar(MEM_GRAFO, dic->tamTexto + 1);
+    dic->capTabla = 16;
+    while (dic->capTabla < n * 2) dic->capTabla *= 2;
+    dic->tabla = mem_reservar(MEM_GRAFO, sizeof(int) * dic->capTabla);
+    if (!dic->desplazamientos || !dic->largos || !dic->texto || !dic->tabla) {
+        mem_liberar(conteo);
+        diccionario_liberar(dic);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < dic->capTabla; i++) dic->tabla[i] = -1;
+    size_t uso = 0;
+    for (size_t k = 0; k < n; k++) {
+        memcpy(dic->texto + uso, conteo[k].palabra, (size_t)conteo[k].largo);
+        dic->desplazamientos[k] = (int)uso;
+        dic->largos[k] = (unsigned char)conteo[k].largo;
+        uso += (size_t)conteo[k].largo;
+
+        size_t i = conteo[k].hash & (dic->capTabla - 1);
+        while (dic->tabla[i] >= 0) i = (i + 1) & (dic->capTabla - 1);
+        dic->tabla[i] = (int)k;
+    }
+
+    mem_liberar(conteo);
+    return dic;
+}
+
+/**
+ * diccionario_comprimir
+ * ----------------------
+ * Reemplaza cada palabra del diccionario por su código de 2 bytes y copia el resto
+ * literalmente (escapando los bytes que coinciden con el rango de los códigos).
+ * Retorna el largo comprimido; en el peor caso es 2 * largo.
+ */
+
+size_t diccionario_comprimir(const Diccionario* dic, const char* texto, size_t largo, char* destino) {
+    size_t escrito = 0;
+    size_t i = 0;
+    while (i < largo) {
+        if (texto[i] == ' ') {
+            destino[escrito++] = ' ';
+            i++;
+            continue;
+        }
+
+        size_t fin = i;
+        while (fin < largo && texto[fin] != ' ') fin++;
+        int largoPalabra = (int)(fin - i);
+        int k = (largoPalabra >= 3 && largoPalabra <= MAXLARGOPALABRA && dic->numPalabras > 0)
+                    ? diccionario_buscar(dic, texto + i, largoPalabra) : -1;
+        if (k >= 0) {
+            destino[escrito++] = (char)(CODIGO_MIN | (k >> 8));
+            destino[escrito++] = (char)(k & 0xFF);
+        } else {
+            for (; i < fin; i++) {
+                unsigned char c = (unsigned char)texto[i];
+                if (c >= ESCAPE && c <= CODIGO_MAX) destino[escrito++] = (char)ESCAPE;
+                destino[escrito++] = (char)c;
+            }
+        }
+        i = fin;
+    }
+    return escrito;
+}
+
+/**
+ * diccionario_descomprimir
+ * -------------------------
+ * Reconstruye el texto original en una sola pasada. Nunca escribe más de 'capacidad'
+ * bytes (incluido el '\0' final).
+ */
+
+size_t diccionario_descomprimir(const Diccionario* dic, const char* datos, size_t largo, char* destino, size_t capacidad) {
+    size_t escrito = 0;
+    size_t limite = capacidad - 1;
+    for (size_t i = 0; i < largo && escrito < limite; i++) {
+        unsigned char c = (unsigned char)datos[i];
+        if (c >= CODIGO_MIN && c <= CODIGO_MAX && i + 1 < largo) {
+            int k = ((c & 0x0F) << 8) | (unsigned char)datos[++i];
+            if (k >= dic->numPalabras) continue;
+            size_t n = dic->largos[k];
+            if (n > limite - escrito) n = limite - escrito;
+            memcpy(destino + escrito, dic->texto + dic->desplazamientos[k], n);
+            escrito += n;
+        } else if (c == ESCAPE && i + 1 < largo) {
+            destino[escrito++] = datos[++i];
+        } else {
+            destino[escrito++] = (char)c;
+        }
+    }
+    destino[escrito] = '\0';
+    return escrito;
+}
+
+size_t diccionario_tam(const Diccionario* dic) {
+    if (!dic) return 0;
+    return sizeof(Diccionario) + dic->tamTexto + (size_t)dic->numPalabras * (sizeof(int) + 1) + dic->capTabla * sizeof(int);
+}
+
+void diccionario_liberar(Diccionario* dic) {
+    if (!dic) return;
+    mem_liberar(dic->desplazamientos);
+    mem_liberar(dic->largos);
+    mem_liberar(dic->texto);
+    mem_liberar(dic->tabla);
+    mem_liberar(dic);
+}
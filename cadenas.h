@@ -0,0 +1,44 @@
+#ifndef CADENAS_H
+#define CADENAS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct PoolCadenas PoolCadenas;
+typedef struct Diccionario Diccionario;
+
+typedef struct {
+    size_t cadenas;         // Cadenas agregadas (contando repetidas)
+    size_t unicas;          // Cadenas distintas realmente almacenadas
+    size_t bytesPedidos;    // Bytes que ocuparían todas las cadenas copiadas por separado
+    size_t bytesGuardados;  // Bytes que ocupan las cadenas únicas en el pool
+} EstadisticasPool;
+
+// Crea un pool de cadenas vacío.
+PoolCadenas* pool_crear(void);
+
+// Agrega 'largo' bytes (se termina en '\0') y retorna la copia única; las repetidas se guardan una vez.
+const char* pool_agregar(PoolCadenas* pool, const char* datos, size_t largo);
+
+// Retorna las estadísticas de uso del pool.
+EstadisticasPool pool_estadisticas(const PoolCadenas* pool);
+
+// Libera el pool y todas sus cadenas.
+void pool_liberar(PoolCadenas* pool);
+
+// Entrena un diccionario de palabras frecuentes a partir de los textos de ejemplo.
+Diccionario* diccionario_entrenar(const char** textos, int cantidad);
+
+// Comprime el texto con el diccionario. 'destino' debe tener espacio para 2 * largo bytes.
+size_t diccionario_comprimir(const Diccionario* dic, const char* texto, size_t largo, char* destino);
+
+// Descomprime en 'destino' (termina en '\0', sin pasar de 'capacidad'). Retorna el largo resultante.
+size_t diccionario_descomprimir(const Diccionario* dic, const char* datos, size_t largo, char* destino, size_t capacidad);
+
+// Bytes que ocupa el diccionario en memoria.
+size_t diccionario_tam(const Diccionario* dic);
+
+// Libera el diccionario.
+void diccionario_liberar(Diccionario* dic);
+
+#endif // CADENAS_H
@@ -0,0 +1,230 @@
+#include "catalogo.h"
+#include "grafo.h"
+#include "list.h"
+#include "indice.h"
+#include "plano.h"
+#include "consejo.h"
+#include "memoria.h"
+#include "recarga.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define MEGABYTE (1024.0 * 1024.0)
+
+// Mapa del catálogo. El grafo del mapa actual vive en 'graph' y su 'grafo' queda vacío.
+typedef struct {
+    char*     ruta;             // Como se pidió (es la que se muestra)
+    char*     clave;            // Ruta absoluta: reconoce el mismo archivo pedido de otra forma
+    long long tamano;           // Tamaño y fecha de modificación del archivo al leerlo
+    long long modificado;
+    Graph     grafo;
+    size_t    bytes;            // Memoria que ocupa el grafo (ver memoria_grafo)
+    unsigned long long ultimoUso;
+    bool      actual;
+} MapaCatalogo;
+
+static MapaCatalogo mapas[MAXMAPASCATALOGO];
+static int numMapas = 0;
+static unsigned long long reloj = 0;
+static size_t presupuesto = PRESUPUESTOCATALOGO;
+
+/*
+ * memoria_grafo
+ * -------------
+ * Bytes que ocupa un grafo cargado: nodos, aristas, textos en memoria, índices, plano,
+ * listas e ítems, y la copia del archivo si los textos diferidos se copiaron (--watch).
+ */
+
+static size_t memoria_grafo(const Graph* g) {
+    size_t bytes = sizeof(Node) * (size_t)g->capacidad + sizeof(int) * ((size_t)g->numberOfNodes + 1) +
+                   sizeof(Arista) * (size_t)g->numAristas + g->estadisticas.bytesTextoGuardados +
+                   indice_memoria(g->indice) + plano_memoria(g->plano, g->numberOfNodes) +
+                   orden_items_memoria(g->ordenItems, g->numberOfNodes) + fuente_memoria(g->textos);
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        const State* s = &g->nodes[i].state;
+        bytes += list_bytes(s->availableItems) + list_bytes(s->playerInventory) +
+                 sizeof(Item) * (size_t)list_size(s->availableItems);
+    }
+    return bytes;
+}
+
+static char* ruta_absoluta(const char* ruta) {
+#ifndef _WIN32
+    char* absoluta = realpath(ruta, NULL);
+    if (absoluta) {
+        char* copia = mem_duplicar(MEM_GRAFO, absoluta);
+        free(absoluta);
+        return copia;
+    }
+#endif
+    return mem_duplicar(MEM_GRAFO, ruta);
+}
+
+static int buscar_mapa(const char* clave) {
+    for (int i = 0; i < numMapas; i++) {
+        if (strcmp(mapas[i].clave, clave) == 0) return i;
+    }
+    return -1;
+}
+
+// Saca el mapa i del catálogo. Si es el actual, su grafo sigue en 'graph' sin catalogar.
+// Los grafos se retiran en vez de liberarse: puede haber partidas que todavía los usen.
+static void quitar_mapa(int i) {
+    MapaCatalogo* m = &mapas[i];
+    if (!m->actual) recarga_retirar(&m->grafo);
+    mem_liberar(m->ruta);
+    mem_liberar(m->clave);
+    memmove(&mapas[i], &mapas[i + 1], sizeof(MapaCatalogo) * (size_t)(numMapas - i - 1));
+    numMapas--;
+}
+
+// Mapa usado hace más tiempo, sin contar el actual (-1 si no hay).
+static int menos_usado(void) {
+    int victima = -1;
+    for (int i = 0; i < numMapas; i++) {
+        if (mapas[i].actual) continue;
+        if (victima < 0 || mapas[i].ultimoUso < mapas[victima].ultimoUso) victima = i;
+    }
+    return victima;
+}
+
+// Descarta los mapas usados hace más tiempo hasta volver a entrar en el presupuesto.
+static void ajustar_presupuesto(void) {
+    size_t total = 0;
+    for (int i = 0; i < numMapas; i++) total += mapas[i].bytes;
+    int victima;
+    while (total > presupuesto && (victima = menos_usado()) >= 0) {
+        total -= mapas[victima].bytes;
+        quitar_mapa(victima);
+    }
+}
+
+void catalogo_guardar_actual(void) {
+    for (int i = 0; i < numMapas; i++) {
+        if (!mapas[i].actual) continue;
+        mapas[i].grafo = graph;
+        mapas[i].actual = false;
+        graph = (Graph){ 0 };
+        return;
+    }
+    recarga_retirar(&graph);
+    graph = (Graph){ 0 };
+}
+
+void catalogo_actualizar_actual(long long tamano, long long modificado) {
+    for (int i = 0; i < numMapas; i++) {
+        if (!mapas[i].actual) continue;
+        mapas[i].tamano = tamano;
+        mapas[i].modificado = modificado;
+        mapas[i].bytes = memoria_grafo(&graph);
+        ajustar_presupuesto();
+        return;
+    }
+}
+
+/**
+ * catalogo_cargar
+ * ---------------
+ * Busca el mapa por su ruta absoluta. Si está en el catálogo y el archivo no cambió
+ * (mismo tamaño y fecha de modificación), lo intercambia con el actual sin leer nada;
+ * si cambió, descarta la versión guardada. Si no está, lo lee con cargar_escenarios
+ * (que guarda el mapa anterior en el catálogo) y lo agrega.
+ *
+ * Consideraciones:
+ *  - Después de cada cambio se descartan los mapas menos usados que excedan el
+ *    presupuesto; el mapa actual nunca se descarta.
+ *  - Los mapas que salen del catálogo se retiran (ver recarga.h): las partidas en curso
+ *    que los copiaron pueden seguir hasta terminar.
+ */
+
+ResultadoCatalogo catalogo_cargar(const char* ruta) {
+    struct stat datos;
+    if (stat(ruta, &datos) != 0) {
+        return cargar_escenarios(ruta) ? CATALOGO_LEIDO : CATALOGO_ERROR;   // Informa el error
+    }
+    // Copia propia: 'ruta' puede ser la de un mapa del catálogo que se descarte más abajo
+    char* copiaRuta = mem_duplicar(MEM_GRAFO, ruta);
+    char* clave = ruta_absoluta(ruta);
+    if (!copiaRuta || !clave) {
+        mem_liberar(copiaRuta);
+        mem_liberar(clave);
+        return CATALOGO_ERROR;
+    }
+
+    int i = buscar_mapa(clave);
+    if (i >= 0 && (mapas[i].tamano != (long long)datos.st_size || mapas[i].modificado != (long long)datos.st_mtime)) {
+        quitar_mapa(i);
+        i = -1;
+    }
+
+    if (i >= 0) {
+        mem_liberar(copiaRuta);
+        mem_liberar(clave);
+        MapaCatalogo* m = &mapas[i];
+        if (!m->actual) {
+            catalogo_guardar_actual();
+            graph = m->grafo;
+            m->grafo = (Graph){ 0 };
+            m->actual = true;
+        }
+        m->ultimoUso = ++reloj;
+        recarga_vigilar(m->ruta);
+        if (!opcionesCarga.silencioso) {
+            printf("Se tomó \"%s\" del catálogo (%d escenarios) sin volver a leer el archivo.\n", m->ruta, graph.numberOfNodes);
+        }
+        ajustar_presupuesto();
+        return CATALOGO_EN_CACHE;
+    }
+
+    if (!cargar_escenarios(copiaRuta)) {
+        mem_liberar(copiaRuta);
+        mem_liberar(clave);
+        return CATALOGO_ERROR;
+    }
+
+    // El mapa anterior ya pasó al catálogo: si está lleno se hace lugar para el nuevo
+    if (numMapas == MAXMAPASCATALOGO) quitar_mapa(menos_usado());
+    mapas[numMapas++] = (MapaCatalogo){
+        .ruta = copiaRuta, .clave = clave,
+        .tamano = (long long)datos.st_size, .modificado = (long long)datos.st_mtime,
+        .bytes = memoria_grafo(&graph), .ultimoUso = ++reloj, .actual = true
+    };
+    recarga_vigilar(copiaRuta);
+    ajustar_presupuesto();
+    return CATALOGO_LEIDO;
+}
+
+void catalogo_configurar_presupuesto(size_t bytes) {
+    presupuesto = bytes;
+    ajustar_presupuesto();
+}
+
+int catalogo_cantidad(void) {
+    return numMapas;
+}
+
+const char* catalogo_ruta(int i) {
+    return i >= 0 && i < numMapas ? mapas[i].ruta : NULL;
+}
+
+void catalogo_mostrar(void) {
+    if (numMapas == 0) return;
+    size_t total = 0;
+    puts("Mapas en el catálogo:");
+    for (int i = 0; i < numMapas; i++) {
+        const MapaCatalogo* m = &mapas[i];
+        int escenarios = m->actual ? graph.numberOfNodes : m->grafo.numberOfNodes;
+        printf("(%d)   %s: %d escenarios, %.1f MB%s\n", i + 1, m->ruta, escenarios, m->bytes / MEGABYTE,
+               m->actual ? " (actual)" : "");
+        total += m->bytes;
+    }
+    printf("En memoria: %.1f MB de %.1f MB.\n", total / MEGABYTE, presupuesto / MEGABYTE);
+}
+
+void catalogo_liberar(void) {
+    while (numMapas > 0) quitar_mapa(numMapas - 1);
+    recarga_retirar(&graph);
+}
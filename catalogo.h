@@ -0,0 +1,49 @@
+#ifndef CATALOGO_H
+#define CATALOGO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Catálogo de mapas: los mapas ya leídos quedan en una caché LRU con un presupuesto de
+ * memoria, así que volver a elegir uno no lo lee de nuevo. Cada mapa se identifica por
+ * su ruta, tamaño y fecha de modificación: si el archivo cambió, se vuelve a leer.
+ *
+ * El mapa elegido es siempre el grafo global 'graph'; los demás esperan en el catálogo.
+ * Cambiar de mapa solo mueve estructuras (no copia nodos ni ítems).
+ */
+
+#define MAXMAPASCATALOGO 64
+#define PRESUPUESTOCATALOGO (256u * 1024 * 1024)    // Bytes, contando el mapa actual
+
+typedef enum {
+    CATALOGO_ERROR,         // No se pudo abrir o se rechazó el mapa
+    CATALOGO_LEIDO,         // Se leyó del archivo
+    CATALOGO_EN_CACHE       // Se tomó del catálogo sin leer el archivo
+} ResultadoCatalogo;
+
+// Deja el mapa de 'ruta' como mapa actual, desde la caché si está y no cambió.
+ResultadoCatalogo catalogo_cargar(const char* ruta);
+
+// Llamado por cargar_escenarios antes de reemplazar 'graph': lo guarda en el catálogo
+// si viene de él o lo retira (ver recarga_retirar) si no.
+void catalogo_guardar_actual(void);
+
+// Llamado al recargar en caliente el mapa actual (ver recarga.h): actualiza su tamaño,
+// fecha de modificación y memoria.
+void catalogo_actualizar_actual(long long tamano, long long modificado);
+
+// Cambia el presupuesto de memoria (0 desactiva la caché: solo se conserva el mapa actual).
+void catalogo_configurar_presupuesto(size_t bytes);
+
+// Cantidad de mapas del catálogo y ruta del mapa i (en el orden en que se leyeron).
+int catalogo_cantidad(void);
+const char* catalogo_ruta(int i);
+
+// Muestra los mapas del catálogo con su tamaño en memoria, marcando el actual.
+void catalogo_mostrar(void);
+
+// Retira todos los mapas, incluido el actual. Se llama al salir, antes de recarga_detener.
+void catalogo_liberar(void);
+
+#endif // CATALOGO_H
@@ -0,0 +1,316 @@
+#include "consejo.h"
+#include "grafo.h"
+#include "list.h"
+#include "memoria.h"
+#include "metricas.h"
+#include "escritor.h"
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+
+#define INALCANZABLE INT_MIN
+#define CELDASCONSEJO ((MAXACCIONESCONSEJO + 1) * (MAXPESOCONSEJO + 1))
+#define MAXOPCIONESCONSEJO (MAXCANDIDATOSCONSEJO + MAXINVENTARIOCONSEJO)
+
+/* ------------------------------------------------------------------ */
+/*  Índice de ítems por escenario                                      */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    int valor;
+    int peso;
+    int posicion;
+} ItemOrdenable;
+
+static int comparar_valor(const void* a, const void* b) {
+    const ItemOrdenable* x = a;
+    const ItemOrdenable* y = b;
+    if (x->valor != y->valor) return x->valor > y->valor ? -1 : 1;
+    if (x->peso != y->peso) return x->peso < y->peso ? -1 : 1;
+    return x->posicion - y->posicion;
+}
+
+// Valor por kilo sin dividir: x va antes si x.valor / x.peso > y.valor / y.peso.
+static int comparar_razon(const void* a, const void* b) {
+    const ItemOrdenable* x = a;
+    const ItemOrdenable* y = b;
+    long long izquierda = (long long)x->valor * (y->peso > 0 ? y->peso : 1);
+    long long derecha = (long long)y->valor * (x->peso > 0 ? x->peso : 1);
+    if ((x->peso > 0) != (y->peso > 0)) return x->peso == 0 ? -1 : 1;     // Sin peso: razón infinita
+    if (izquierda != derecha) return izquierda > derecha ? -1 : 1;
+    return comparar_valor(a, b);
+}
+
+OrdenItems* orden_items_construir(const Graph* g) {
+    int n = g->numberOfNodes;
+    OrdenItems* orden = mem_reservar(MEM_GRAFO, sizeof(OrdenItems));
+    int* inicio = mem_reservar(MEM_GRAFO, sizeof(int) * ((size_t)n + 1));
+    if (!orden || !inicio) {
+        mem_liberar(orden);
+        mem_liberar(inicio);
+        return NULL;
+    }
+    inicio[0] = 0;
+    int maximo = 0;
+    for (int i = 0; i < n; i++) {
+        int cantidad = list_size(g->nodes[i].state.availableItems);
+        inicio[i + 1] = inicio[i] + cantidad;
+        if (cantidad > maximo) maximo = cantidad;
+    }
+
+    orden->inicio = inicio;
+    orden->porValor = mem_reservar(MEM_GRAFO, sizeof(int) * ((size_t)inicio[n] + 1));
+    orden->porRazon = mem_reservar(MEM_GRAFO, sizeof(int) * ((size_t)inicio[n] + 1));
+    ItemOrdenable* items = mem_reservar(MEM_CARGADOR, sizeof(ItemOrdenable) * ((size_t)maximo + 1));
+    if (!orden->porValor || !orden->porRazon || !items) {
+        mem_liberar(items);
+        orden_items_liberar(orden);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const List* lista = g->nodes[i].state.availableItems;
+        int cantidad = 0;
+        for (const ListNode* ln = lista ? lista->head : NULL; ln; ln = ln->next) {
+            const Item* it = ln->data;
+            items[cantidad] = (ItemOrdenable){ it->value, it->weight, cantidad };
+            cantidad++;
+        }
+        qsort(items, (size_t)cantidad, sizeof(ItemOrdenable), comparar_valor);
+        for (int k = 0; k < cantidad; k++) orden->porValor[inicio[i] + k] = items[k].posicion;
+        qsort(items, (size_t)cantidad, sizeof(ItemOrdenable), comparar_razon);
+        for (int k = 0; k < cantidad; k++) orden->porRazon[inicio[i] + k] = items[k].posicion;
+    }
+    mem_liberar(items);
+    return orden;
+}
+
+void orden_items_liberar(OrdenItems* orden) {
+    if (!orden) return;
+    mem_liberar(orden->inicio);
+    mem_liberar(orden->porValor);
+    mem_liberar(orden->porRazon);
+    mem_liberar(orden);
+}
+
+size_t orden_items_memoria(const OrdenItems* orden, int numNodos) {
+    if (!orden) return 0;
+    return sizeof(OrdenItems) + sizeof(int) * ((size_t)numNodos + 1 + 2 * ((size_t)orden->inicio[numNodos] + 1));
+}
+
+static void escribir_enteros(Escritor* e, const char* nombre, const int* valores, int cantidad) {
+    escritor_printf(e, "static const int %s[%d] = {", nombre, cantidad > 0 ? cantidad : 1);
+    for (int i = 0; i < cantidad; i++) {
+        escritor_cadena(e, i % 16 == 0 ? "\n    " : " ");
+        escritor_printf(e, "%d,", valores[i]);
+    }
+    escritor_cadena(e, cantidad > 0 ? "\n};\n\n" : " 0 };\n\n");
+}
+
+void orden_items_generar_c(const OrdenItems* orden, int numNodos, Escritor* e) {
+    escribir_enteros(e, "ordenInicio", orden->inicio, numNodos + 1);
+    escribir_enteros(e, "ordenPorValor", orden->porValor, orden->inicio[numNodos]);
+    escribir_enteros(e, "ordenPorRazon", orden->porRazon, orden->inicio[numNodos]);
+    escritor_cadena(e, "static const OrdenItems ordenItems = {\n"
+                       "    (int*)ordenInicio, (int*)ordenPorValor, (int*)ordenPorRazon\n};\n\n");
+}
+
+/* ------------------------------------------------------------------ */
+/*  Consejero                                                          */
+/* ------------------------------------------------------------------ */
+
+// Un ítem que entra en la mochila. Los del inventario se conservan o se descartan
+// (1 de tiempo); los del escenario se dejan o se recogen (1 de tiempo).
+typedef struct {
+    Item* item;
+    int   posicion;         // En el inventario (solo para los del inventario)
+    int   peso;
+    int   valor;
+    bool  enInventario;
+} OpcionConsejo;
+
+static bool ya_elegido(const OpcionConsejo* opciones, int desde, int hasta, const Item* item) {
+    for (int i = desde; i < hasta; i++) {
+        if (opciones[i].item == item) return true;
+    }
+    return false;
+}
+
+/*
+ * Candidatos del escenario: los ítems disponibles en el orden del índice, alternando
+ * el de más valor por kilo y el de más valor, hasta MAXCANDIDATOSCONSEJO. Así un
+ * escenario con cientos de ítems no agranda la mochila y no se pierden ni los livianos
+ * valiosos ni los pesados muy valiosos. Sin índice, en el orden de la lista.
+ */
+
+static int elegir_candidatos(const GameState* gs, OpcionConsejo* opciones, int desde) {
+    const Graph* g = gs->grafo;
+    const List* lista = gs->currentNode->state.availableItems;
+    Item* enPosicion[MAXITEMSNODOCONSEJO];
+    int cantidad = 0;
+    for (const ListNode* ln = lista ? lista->head : NULL; ln && cantidad < MAXITEMSNODOCONSEJO; ln = ln->next) {
+        enPosicion[cantidad++] = ln->data;
+    }
+
+    int numOpciones = desde;
+    int nodo = (int)(gs->currentNode - g->nodes);
+    const OrdenItems* orden = g->ordenItems;
+    const int* listas[2] = { orden ? orden->porRazon + orden->inicio[nodo] : NULL,
+                             orden ? orden->porValor + orden->inicio[nodo] : NULL };
+    int siguiente[2] = { 0, 0 };
+    for (int turno = 0; numOpciones - desde < MAXCANDIDATOSCONSEJO; turno ^= 1) {
+        int* k = &siguiente[turno];
+        if (*k >= cantidad && siguiente[turno ^ 1] >= cantidad) break;
+        if (*k >= cantidad) continue;
+        int posicion = listas[turno] ? listas[turno][*k] : *k;
+        (*k)++;
+        if (posicion >= cantidad) continue;    // Más allá de MAXITEMSNODOCONSEJO
+        Item* item = enPosicion[posicion];
+        if (!item_disponible(item) || ya_elegido(opciones, desde, numOpciones, item)) continue;
+        opciones[numOpciones++] = (OpcionConsejo){ item, -1, item->weight, item->value, false };
+    }
+    return numOpciones;
+}
+
+/*
+ * aconsejar_items
+ * ---------------
+ * Con T el tiempo restante, D y S la distancia y las aristas del camino precalculado al
+ * final, c las acciones (recogidas y descartes) y p el peso final, se llega si
+ * T - c - D - S * (p / 10) >= 1 (con 0 de tiempo la partida se pierde). Entonces c y S *
+ * (p / 10) no pueden pasar de B = T - D - 1, que acota la tabla: mejor[c][p] es el mayor
+ * puntaje que se logra con c acciones y peso p. Cada ítem agrega una capa; un bit por
+ * celda anota qué opción se eligió para reconstruir el consejo desde la mejor celda.
+ *
+ * Consideraciones:
+ *  - Entre los de igual puntaje se prefiere el que deja más tiempo, y luego menos peso.
+ *  - Los ítems del inventario más allá de MAXINVENTARIOCONSEJO se conservan siempre.
+ *  - Es una cota: con peso, otro camino podría ser más corto que el precalculado.
+ */
+
+bool aconsejar_items(const GameState* gs, Consejo* consejo) {
+    consejo->llega = false;
+    consejo->numRecoger = consejo->numDescartar = 0;
+    if (jugador_terminado(gs)) return false;
+    MEDIR_INICIO(inicio);
+
+    const State* st = &gs->currentNode->state;
+    int pasos = st->pasosFinal > 0 ? st->pasosFinal : 1;
+    int presupuesto = gs->tiempoRestante - st->distanciaFinal - 1;
+    if (presupuesto > MAXACCIONESCONSEJO) presupuesto = MAXACCIONESCONSEJO;
+    int pesoMaximo = 10 * (presupuesto / pasos) + 9;
+
+    // Opciones: el inventario (el resto queda fijo) y los candidatos del escenario
+    OpcionConsejo opciones[MAXOPCIONESCONSEJO];
+    int numOpciones = 0, pesoFijo = 0, valorFijo = 0, posicion = 0;
+    for (const ListNode* ln = gs->inventory->head; ln; ln = ln->next, posicion++) {
+        Item* it = ln->data;
+        if (numOpciones < MAXINVENTARIOCONSEJO) {
+            opciones[numOpciones++] = (OpcionConsejo){ it, posicion, it->weight, it->value, true };
+        } else {
+            pesoFijo += it->weight;
+            valorFijo += it->value;
+        }
+    }
+    numOpciones = elegir_candidatos(gs, opciones, numOpciones);
+
+    consejo->peso = pesoFijo;
+    consejo->puntaje = valorFijo;
+    for (int i = 0; i < numOpciones; i++) {
+        if (opciones[i].enInventario) {
+            consejo->peso += opciones[i].peso;
+            consejo->puntaje += opciones[i].valor;
+        }
+    }
+    consejo->tiempoFinal = gs->tiempoRestante - st->distanciaFinal - pasos * (consejo->peso / 10);
+
+    int mejor[2][CELDASCONSEJO];
+    uint64_t eleccion[MAXOPCIONESCONSEJO][(CELDASCONSEJO + 63) / 64];
+    int ancho = pesoMaximo + 1;
+    int celdas = (presupuesto + 1) * ancho;
+    int* actual = mejor[0];
+    int* nuevo = mejor[1];
+    if (st->distanciaFinal < 0 || presupuesto < 0 || pesoFijo > pesoMaximo) {
+        MEDIR_FIN(inicio, MET_CONSEJO_ITEMS);
+        return true;        // Ni descartando lo que se puede se llega
+    }
+    for (int i = 0; i < celdas; i++) actual[i] = INALCANZABLE;
+    actual[pesoFijo] = valorFijo;
+
+    for (int i = 0; i < numOpciones; i++) {
+        const OpcionConsejo* o = &opciones[i];
+        // Opción A: conservar (inventario) o dejar (escenario); B: descartar o recoger
+        int pesoA = o->enInventario ? o->peso : 0, valorA = o->enInventario ? o->valor : 0;
+        int pesoB = o->enInventario ? 0 : o->peso, valorB = o->enInventario ? 0 : o->valor;
+        for (int c = 0; c <= presupuesto; c++) {
+            for (int p = 0; p < ancho; p++) {
+                int celda = c * ancho + p;
+                int a = p >= pesoA && actual[celda - pesoA] != INALCANZABLE ? actual[celda - pesoA] + valorA : INALCANZABLE;
+                int b = c > 0 && p >= pesoB && actual[celda - ancho - pesoB] != INALCANZABLE
+                        ? actual[celda - ancho - pesoB] + valorB : INALCANZABLE;
+                bool tomarB = b > a;
+                nuevo[celda] = tomarB ? b : a;
+                uint64_t bit = 1ULL << (celda & 63);
+                if (tomarB) eleccion[i][celda >> 6] |= bit;
+                else eleccion[i][celda >> 6] &= ~bit;
+            }
+        }
+        int* cambio = actual;
+        actual = nuevo;
+        nuevo = cambio;
+    }
+
+    // Mejor celda desde la que se llega al final
+    int celdaMejor = -1, gastoMejor = 0;
+    for (int c = 0; c <= presupuesto; c++) {
+        for (int p = 0; p < ancho; p++) {
+            int celda = c * ancho + p;
+            int gasto = c + pasos * (p / 10);
+            if (actual[celda] == INALCANZABLE || gasto > presupuesto) continue;
+            if (celdaMejor < 0 || actual[celda] > actual[celdaMejor] ||
+                (actual[celda] == actual[celdaMejor] && (gasto < gastoMejor ||
+                 (gasto == gastoMejor && p < celdaMejor % ancho)))) {
+                celdaMejor = celda;
+                gastoMejor = gasto;
+            }
+        }
+    }
+    if (celdaMejor < 0) {
+        MEDIR_FIN(inicio, MET_CONSEJO_ITEMS);
+        return true;
+    }
+
+    consejo->llega = true;
+    consejo->puntaje = actual[celdaMejor];
+    consejo->peso = celdaMejor % ancho;
+    consejo->tiempoFinal = gs->tiempoRestante - st->distanciaFinal - gastoMejor;
+    int celda = celdaMejor;
+    for (int i = numOpciones - 1; i >= 0; i--) {
+        const OpcionConsejo* o = &opciones[i];
+        bool tomarB = (eleccion[i][celda >> 6] >> (celda & 63)) & 1;
+        if (tomarB) {
+            celda -= ancho + (o->enInventario ? 0 : o->peso);
+            if (o->enInventario) consejo->descartar[consejo->numDescartar++] = o->posicion;
+            else consejo->recoger[consejo->numRecoger++] = o->item;
+        } else if (o->enInventario) {
+            celda -= o->peso;
+        }
+    }
+
+    // El inventario se recorrió en orden, así que los descartes ya quedan de mayor a menor
+    for (int i = 1; i < consejo->numRecoger; i++) {
+        Item* it = consejo->recoger[i];
+        int j = i;
+        for (; j > 0 && consejo->recoger[j - 1]->value < it->value; j--) consejo->recoger[j] = consejo->recoger[j - 1];
+        consejo->recoger[j] = it;
+    }
+    MEDIR_FIN(inicio, MET_CONSEJO_ITEMS);
+    return true;
+}
+
+DecisionBot siguiente_consejo(const Consejo* consejo) {
+    if (consejo->numDescartar > 0) return (DecisionBot){ .tipo = BOT_DESCARTAR, .posicion = consejo->descartar[0] };
+    if (consejo->numRecoger > 0) return (DecisionBot){ .tipo = BOT_RECOGER, .item = consejo->recoger[0] };
+    return (DecisionBot){ .tipo = BOT_NINGUNA };
+}
@@ -0,0 +1,71 @@
+#ifndef CONSEJO_H
+#define CONSEJO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "game.h"
+#include "bot.h"
+
+typedef struct Escritor Escritor;
+
+/*
+ * Consejero de recogida: decide qué ítems del escenario actual conviene llevar y cuáles
+ * del inventario soltar para terminar con el mayor puntaje sin dejar de llegar a un final.
+ *
+ * Cuenta lo que cuesta cada acción: recoger y descartar gastan 1 de tiempo, y con peso p
+ * el camino precalculado al final (distanciaFinal, pasosFinal; ver alcance.c) cuesta
+ * distanciaFinal + pasosFinal * (p / 10). Es una mochila pequeña que se resuelve exacta
+ * con programación dinámica sobre (acciones, peso final), sin reservar memoria, en
+ * microsegundos: la pantalla de recoger la muestra como sugerencia y los jugadores
+ * automáticos pueden pedirla en cada turno.
+ *
+ * Al cargar el mapa se construye un índice con los ítems de cada escenario ordenados por
+ * valor y por valor por kilo (OrdenItems), compartido por las copias del grafo. Si un
+ * escenario tiene muchos ítems, solo se consideran los mejores según ese índice.
+ */
+
+#define MAXCANDIDATOSCONSEJO 32                         // Ítems del escenario que se consideran
+#define MAXINVENTARIOCONSEJO 64                         // Ítems del inventario que se pueden descartar
+#define MAXITEMSNODOCONSEJO 256                         // Ítems de un escenario que se miran como máximo
+#define MAXACCIONESCONSEJO TIEMPOINICIAL                // Recogidas más descartes
+#define MAXPESOCONSEJO (10 * MAXACCIONESCONSEJO + 9)    // Peso que se puede llevar hasta el final
+
+// Pública para que los mapas incrustados (ver incrustado.h) traigan el índice ya construido.
+typedef struct OrdenItems {
+    int* inicio;        // numberOfNodes + 1 posiciones en porValor y porRazon
+    int* porValor;      // Posición de cada ítem en availableItems, de más a menos valor
+    int* porRazon;      // Ídem, de más a menos valor por kilo (los que no pesan, primero)
+} OrdenItems;
+
+// Ordena los ítems de cada escenario del grafo (ya reordenado). Retorna NULL sin memoria.
+OrdenItems* orden_items_construir(const Graph* g);
+
+void orden_items_liberar(OrdenItems* orden);
+
+// Bytes que ocupa el índice en memoria.
+size_t orden_items_memoria(const OrdenItems* orden, int numNodos);
+
+// Escribe el índice como tablas de C 'static const' (ver incrustado.h).
+void orden_items_generar_c(const OrdenItems* orden, int numNodos, Escritor* e);
+
+typedef struct {
+    bool  llega;                                // Siguiéndolo se llega al final por el camino precalculado
+    Item* recoger[MAXCANDIDATOSCONSEJO];        // Ítems del escenario, de más a menos valor
+    int   numRecoger;
+    int   descartar[MAXINVENTARIOCONSEJO];      // Posiciones del inventario (desde 0), de mayor a menor
+    int   numDescartar;
+    int   puntaje;                              // Puntaje del inventario después de seguirlo
+    int   peso;
+    int   tiempoFinal;                          // Tiempo que quedaría al llegar al final
+} Consejo;
+
+// Calcula el consejo para el jugador en su escenario actual. Retorna false si la partida
+// ya terminó. Si ni descartando todo se llega al final, 'llega' queda en false y no se
+// aconseja nada. Descartar en el orden dado no cambia las posiciones que faltan.
+bool aconsejar_items(const GameState* gs, Consejo* consejo);
+
+// Primera acción del consejo, lista para bot_aplicar: los descartes y después las
+// recogidas. BOT_NINGUNA si ya no conviene hacer nada con los ítems (hay que avanzar).
+DecisionBot siguiente_consejo(const Consejo* consejo);
+
+#endif // CONSEJO_H
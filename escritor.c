@@ -0,0 +1,95 @@
+#include "escritor.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+void escritor_iniciar(Escritor* e, FILE* destino) {
+    e->destino = destino;
+    e->uso = 0;
+}
+
+void escritor_vaciar(Escritor* e) {
+    if (e->uso > 0) fwrite(e->datos, 1, e->uso, e->destino);
+    e->uso = 0;
+    fflush(e->destino);
+}
+
+void escritor_texto_largo(Escritor* e, const char* texto, size_t largo) {
+    escritor_vaciar(e);
+    if (largo > TAMESCRITOR) {
+        fwrite(texto, 1, largo, e->destino);
+        return;
+    }
+    memcpy(e->datos, texto, largo);
+    e->uso = largo;
+}
+
+void escritor_entero(Escritor* e, long long valor) {
+    char digitos[24];
+    int pos = sizeof(digitos);
+    unsigned long long absoluto = valor < 0 ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+    do {
+        digitos[--pos] = (char)('0' + absoluto % 10);
+        absoluto /= 10;
+    } while (absoluto > 0);
+    if (valor < 0) digitos[--pos] = '-';
+    escritor_texto(e, digitos + pos, sizeof(digitos) - pos);
+}
+
+/*
+ * escritor_printf
+ * ---------------
+ * Formatea directamente en el espacio libre del búfer. Si no cabe, vacía el búfer y
+ * vuelve a intentar; un texto más largo que el búfer completo se escribe sin pasar por él.
+ */
+
+void escritor_printf(Escritor* e, const char* formato, ...) {
+    va_list argumentos;
+    va_start(argumentos, formato);
+    va_list copia;
+    va_copy(copia, argumentos);
+
+    int largo = vsnprintf(e->datos + e->uso, TAMESCRITOR - e->uso, formato, argumentos);
+    if (largo >= 0 && (size_t)largo >= TAMESCRITOR - e->uso) {
+        escritor_vaciar(e);
+        if ((size_t)largo < TAMESCRITOR) {
+            vsnprintf(e->datos, TAMESCRITOR, formato, copia);
+        } else {
+            vfprintf(e->destino, formato, copia);
+            largo = 0;
+        }
+    }
+    if (largo > 0) e->uso += (size_t)largo;
+
+    va_end(copia);
+    va_end(argumentos);
+}
+
+/*
+ * escritor_literal_c
+ * ------------------
+ * Los escapes octales se escriben siempre con tres dígitos, así que un dígito que los
+ * siga no se confunde con el escape. '?' también se escapa para no formar trigrafos.
+ * Cada LARGOLITERAL bytes de texto se cierra el literal y se abre otro en la línea
+ * siguiente (el compilador los concatena).
+ */
+
+#define LARGOLITERAL 96
+
+void escritor_literal_c(Escritor* e, const char* texto, size_t largo) {
+    escritor_texto(e, "\"", 1);
+    for (size_t i = 0; i < largo; i++) {
+        unsigned char c = (unsigned char)texto[i];
+        if (i > 0 && i % LARGOLITERAL == 0) escritor_texto(e, "\"\n    \"", 7);
+        if (c == '"' || c == '\\' || c == '?') {
+            char escape[2] = { '\\', (char)c };
+            escritor_texto(e, escape, 2);
+        } else if (c < 0x20 || c >= 0x7f) {
+            char octal[4] = { '\\', (char)('0' + (c >> 6)), (char)('0' + ((c >> 3) & 7)), (char)('0' + (c & 7)) };
+            escritor_texto(e, octal, 4);
+        } else {
+            escritor_texto(e, (const char*)&c, 1);
+        }
+    }
+    escritor_texto(e, "\"", 1);
+}
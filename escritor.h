@@ -0,0 +1,60 @@
+#ifndef ESCRITOR_H
+#define ESCRITOR_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * Escritor con búfer propio: junta la salida de muchos printf pequeños y la escribe con
+ * un solo fwrite cada TAMESCRITOR bytes (o al vaciarlo). Se usa para listados largos,
+ * donde escribir escenario por escenario con printf domina el tiempo.
+ */
+
+#define TAMESCRITOR (256 * 1024)
+
+typedef struct Escritor {
+    FILE*  destino;
+    size_t uso;                     // Bytes pendientes en 'datos'
+    char   datos[TAMESCRITOR];
+} Escritor;
+
+void escritor_iniciar(Escritor* e, FILE* destino);
+
+// Agrega texto con formato de printf.
+void escritor_printf(Escritor* e, const char* formato, ...)
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+// Caso lento de escritor_texto: vacía el búfer y, si el texto no cabe, lo escribe directo.
+void escritor_texto_largo(Escritor* e, const char* texto, size_t largo);
+
+// Agrega 'largo' bytes tal cual. Está en el encabezado para que el caso común (cabe en
+// el búfer) quede en línea: las exportaciones lo llaman decenas de millones de veces.
+static inline void escritor_texto(Escritor* e, const char* texto, size_t largo) {
+    if (largo <= TAMESCRITOR - e->uso) {
+        memcpy(e->datos + e->uso, texto, largo);
+        e->uso += largo;
+    } else {
+        escritor_texto_largo(e, texto, largo);
+    }
+}
+
+// Agrega un texto terminado en '\0'.
+static inline void escritor_cadena(Escritor* e, const char* texto) {
+    escritor_texto(e, texto, strlen(texto));
+}
+
+// Agrega un entero en decimal, sin pasar por printf (para exportaciones masivas).
+void escritor_entero(Escritor* e, long long valor);
+
+// Agrega el texto como literal de cadena de C, con los caracteres especiales y los bytes
+// fuera de ASCII escapados en octal. Los textos largos se parten en varios literales.
+void escritor_literal_c(Escritor* e, const char* texto, size_t largo);
+
+// Escribe lo pendiente en el destino.
+void escritor_vaciar(Escritor* e);
+
+#endif // ESCRITOR_H
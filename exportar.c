@@ -0,0 +1,222 @@
+#include "exportar.h"
+#include "escritor.h"
+#include "grafo.h"
+#include "list.h"
+#include "memoria.h"
+
+#include <string.h>
+
+bool formato_exportacion(const char* nombre, FormatoExportacion* formato) {
+    if (strcmp(nombre, "dot") == 0) {
+        *formato = EXPORTAR_DOT;
+    } else if (strcmp(nombre, "json") == 0 || strcmp(nombre, "jsonl") == 0) {
+        *formato = EXPORTAR_JSONL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/*
+ * escribir_cadena
+ * ---------------
+ * Escribe el texto entre comillas, escapado para JSON y DOT (ambos aceptan \" y \\).
+ * Copia de a tramos sin caracteres especiales, que son casi todo el texto.
+ */
+
+static void escribir_cadena(Escritor* e, const char* texto) {
+    escritor_texto(e, "\"", 1);
+    const char* tramo = texto;
+    for (const char* p = texto; ; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c != '\0' && c != '"' && c != '\\' && c >= 0x20) continue;
+
+        escritor_texto(e, tramo, (size_t)(p - tramo));
+        if (c == '\0') break;
+        if (c == '"' || c == '\\') {
+            char escape[2] = {'\\', (char)c};
+            escritor_texto(e, escape, 2);
+        } else if (c == '\n') {
+            escritor_texto(e, "\\n", 2);
+        } else {
+            escritor_printf(e, "\\u%04x", c);
+        }
+        tramo = p + 1;
+    }
+    escritor_texto(e, "\"", 1);
+}
+
+static int disponibles_en(const Node* node) {
+    int cantidad = 0;
+    for (ListNode* ln = node->state.availableItems->head; ln; ln = ln->next) {
+        if (item_disponible(ln->data)) cantidad++;
+    }
+    return cantidad;
+}
+
+/*
+ * exportar_dot
+ * ------------
+ * Los nodos se nombran "n<ID>" con el ID del archivo. Los jugadores se agregan al final
+ * como atributos extra de su nodo (DOT los combina con los ya declarados), así no hay
+ * que buscar jugadores al escribir cada escenario.
+ */
+
+static void exportar_dot(Escritor* e, const Graph* g, const GameState* jugadores, int numJugadores) {
+    escritor_cadena(e, "digraph graphquest {\n  node [shape=ellipse];\n");
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        const Node* node = &g->nodes[i];
+        escritor_cadena(e, "  n");
+        escritor_entero(e, node->state.id);
+        escritor_cadena(e, " [label=");
+        escribir_cadena(e, nombre_escenario(node));
+        int disponibles = disponibles_en(node);
+        if (disponibles > 0) {
+            escritor_cadena(e, ", xlabel=\"");
+            escritor_entero(e, disponibles);
+            escritor_cadena(e, disponibles == 1 ? " ítem\"" : " ítems\"");
+        }
+        if (node->state.esFinal) escritor_cadena(e, ", shape=doublecircle");
+        if (node == g->start) escritor_cadena(e, ", style=bold");
+        escritor_cadena(e, "];\n");
+    }
+
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        for (int k = g->inicioAristas[i]; k < g->inicioAristas[i + 1]; k++) {
+            const Arista* a = &g->aristas[k];
+            escritor_cadena(e, "  n");
+            escritor_entero(e, g->nodes[i].state.id);
+            escritor_cadena(e, " -> n");
+            escritor_entero(e, g->nodes[a->destino].state.id);
+            escritor_cadena(e, " [label=");
+            escribir_cadena(e, a->etiqueta);
+            if (a->costo > 0) {
+                escritor_cadena(e, ", weight=");
+                escritor_entero(e, a->costo);
+            }
+            escritor_cadena(e, "];\n");
+        }
+    }
+
+    for (int j = 0; j < numJugadores; j++) {
+        escritor_cadena(e, "  n");
+        escritor_entero(e, jugadores[j].currentNode->state.id);
+        escritor_cadena(e, " [color=red, penwidth=3, tooltip=\"Jugador ");
+        escritor_entero(e, j + 1);
+        escritor_cadena(e, "\"];\n");
+    }
+    escritor_cadena(e, "}\n");
+}
+
+static void escribir_item_json(Escritor* e, const char* tipo, const char* campo, int valorCampo, const Item* it) {
+    escritor_cadena(e, "{\"tipo\":\"");
+    escritor_cadena(e, tipo);
+    escritor_cadena(e, "\",\"");
+    escritor_cadena(e, campo);
+    escritor_cadena(e, "\":");
+    escritor_entero(e, valorCampo);
+    escritor_cadena(e, ",\"nombre\":");
+    escribir_cadena(e, it->name);
+    escritor_cadena(e, ",\"valor\":");
+    escritor_entero(e, it->value);
+    escritor_cadena(e, ",\"peso\":");
+    escritor_entero(e, it->weight);
+}
+
+/*
+ * exportar_jsonl
+ * --------------
+ * Primero una línea "mapa" con los totales, luego cada escenario seguido de sus ítems y
+ * sus aristas, y al final los jugadores con su inventario. Los ítems llevan "dueno":
+ * -1 si siguen disponibles o el número de jugador (desde 0) que los tomó.
+ */
+
+static void exportar_jsonl(Escritor* e, const Graph* g, const GameState* jugadores, int numJugadores) {
+    escritor_cadena(e, "{\"tipo\":\"mapa\",\"escenarios\":");
+    escritor_entero(e, g->numberOfNodes);
+    escritor_cadena(e, ",\"aristas\":");
+    escritor_entero(e, g->numAristas);
+    escritor_cadena(e, ",\"inicio\":");
+    escritor_entero(e, g->start ? g->start->state.id : -1);
+    escritor_cadena(e, ",\"componentes\":");
+    escritor_entero(e, g->alcance.componentes);
+    escritor_cadena(e, ",\"jugadores\":");
+    escritor_entero(e, numJugadores);
+    escritor_cadena(e, "}\n");
+
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        const Node* node = &g->nodes[i];
+        int id = node->state.id;
+        escritor_cadena(e, "{\"tipo\":\"escenario\",\"id\":");
+        escritor_entero(e, id);
+        escritor_cadena(e, ",\"nombre\":");
+        escribir_cadena(e, nombre_escenario(node));
+        escritor_cadena(e, ",\"descripcion\":");
+        escribir_cadena(e, descripcion_escenario(node));
+        escritor_cadena(e, node->state.esFinal ? ",\"final\":true" : ",\"final\":false");
+        escritor_cadena(e, ",\"componente\":");
+        escritor_entero(e, node->state.componente);
+        escritor_cadena(e, ",\"distanciaFinal\":");
+        escritor_entero(e, node->state.distanciaFinal);
+        escritor_cadena(e, "}\n");
+
+        for (ListNode* ln = node->state.availableItems->head; ln; ln = ln->next) {
+            Item* it = ln->data;
+            escribir_item_json(e, "item", "escenario", id, it);
+            escritor_cadena(e, ",\"dueno\":");
+            escritor_entero(e, atomic_load_explicit(&it->dueno, memory_order_relaxed));
+            escritor_cadena(e, "}\n");
+        }
+
+        for (int k = g->inicioAristas[i]; k < g->inicioAristas[i + 1]; k++) {
+            const Arista* a = &g->aristas[k];
+            escritor_cadena(e, "{\"tipo\":\"arista\",\"origen\":");
+            escritor_entero(e, id);
+            escritor_cadena(e, ",\"destino\":");
+            escritor_entero(e, g->nodes[a->destino].state.id);
+            escritor_cadena(e, ",\"etiqueta\":");
+            escribir_cadena(e, a->etiqueta);
+            escritor_cadena(e, ",\"costo\":");
+            escritor_entero(e, a->costo);
+            escritor_cadena(e, "}\n");
+        }
+    }
+
+    for (int j = 0; j < numJugadores; j++) {
+        const GameState* gs = &jugadores[j];
+        escritor_cadena(e, "{\"tipo\":\"jugador\",\"jugador\":");
+        escritor_entero(e, gs->jugador);
+        escritor_cadena(e, ",\"escenario\":");
+        escritor_entero(e, gs->currentNode->state.id);
+        escritor_cadena(e, ",\"tiempo\":");
+        escritor_entero(e, gs->tiempoRestante);
+        escritor_cadena(e, "}\n");
+        for (Item* it = list_first(gs->inventory); it; it = list_next(gs->inventory)) {
+            escribir_item_json(e, "inventario", "jugador", gs->jugador, it);
+            escritor_cadena(e, "}\n");
+        }
+    }
+}
+
+/**
+ * exportar_grafo
+ * --------------
+ * Escribe el grafo en el formato pedido. Retorna false si no hay grafo cargado, si no
+ * hay memoria para el búfer o si falló la escritura.
+ */
+
+bool exportar_grafo(const Graph* g, const GameState* jugadores, int numJugadores,
+                    FormatoExportacion formato, FILE* destino) {
+    if (!g || g->numberOfNodes == 0) return false;
+
+    Escritor* e = mem_reservar(MEM_INTERFAZ, sizeof(Escritor));
+    if (!e) return false;
+    escritor_iniciar(e, destino);
+
+    if (formato == EXPORTAR_DOT) exportar_dot(e, g, jugadores, numJugadores);
+    else                         exportar_jsonl(e, g, jugadores, numJugadores);
+
+    escritor_vaciar(e);
+    mem_liberar(e);
+    return !ferror(destino);
+}
@@ -0,0 +1,32 @@
+#ifndef EXPORTAR_H
+#define EXPORTAR_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "game.h"
+
+/*
+ * Exportación del grafo para herramientas externas:
+ *  - DOT (Graphviz): un nodo por escenario (los finales con doble círculo, el inicial en
+ *    negrita, con su cantidad de ítems disponibles) y una arista por conexión.
+ *  - Líneas JSON: un objeto por línea con "tipo" mapa, escenario, arista, item, jugador
+ *    o inventario, fácil de procesar en flujo.
+ *
+ * Toda la salida pasa por un Escritor (escritor.h) y no se reserva memoria por nodo, así
+ * que sirve para mapas de millones de escenarios.
+ */
+
+typedef enum {
+    EXPORTAR_DOT,
+    EXPORTAR_JSONL
+} FormatoExportacion;
+
+// Interpreta "dot" o "json". Retorna false si el nombre no corresponde a ningún formato.
+bool formato_exportacion(const char* nombre, FormatoExportacion* formato);
+
+// Exporta el grafo. Si se pasan jugadores (el mundo de una partida en curso), incluye su
+// posición e inventario, y los ítems que ya tienen dueño aparecen como tomados.
+bool exportar_grafo(const Graph* g, const GameState* jugadores, int numJugadores,
+                    FormatoExportacion formato, FILE* destino);
+
+#endif // EXPORTAR_H
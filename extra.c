@@ -1,75 +1,241 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <limits.h>
 #include "extra.h"
 #include "list.h"
 #include "grafo.h"
 #include "game.h"
+#include "indice.h"
+#include "cadenas.h"
+#include "metricas.h"
+#include "memoria.h"
+#include "plano.h"
+#include "consejo.h"
 
-#ifdef _MSC_VER
-#define strdup _strdup
-#endif
-
-#ifndef HAVE_STRDUP
-char* strdup(const char* s) {
-    size_t len = strlen(s) + 1;
-    char* copy = malloc(len);
-    if (copy) memcpy(copy, s, len);
-    return copy;
-}
-#endif
-
-#define MAX_LINE_LENGTH 1024
+#define MAX_LINE_LENGTH 4096
 #define MAX_FIELDS 100
 
-char **leer_linea_csv(FILE *archivo, char separador) {
-    static char linea[MAX_LINE_LENGTH];
-    static char *campos[MAX_FIELDS];
+/*
+ * leer_linea_csv
+ * --------------
+ * Lee una línea del archivo y la separa en campos (respetando campos entre comillas).
+ * Los campos apuntan a un búfer del hilo que se sobrescribe en la siguiente llamada
+ * (cada hilo puede leer su propio archivo, ver recarga.h).
+ *
+ * Si 'info' no es NULL, deja en él la cantidad de campos leídos y si la línea estaba
+ * mal formada: demasiado larga (se recorta y se descarta el resto de la línea física)
+ * o con comillas sin cerrar, además de la posición de la línea en el archivo.
+ */
 
+static char **leer_linea(FILE *archivo, char separador, InfoLineaCsv *info) {
+    static _Thread_local char linea[MAX_LINE_LENGTH];
+    static _Thread_local char *campos[MAX_FIELDS];
+
+    long desplazamiento = info ? ftell(archivo) : 0;
     if (fgets(linea, MAX_LINE_LENGTH, archivo) == NULL) {
         return NULL;
     }
 
+    size_t largo = strlen(linea);
+    bool truncada = false;
+    if (largo > 0 && linea[largo - 1] != '\n' && !feof(archivo)) {
+        truncada = true;
+        int c;
+        while ((c = fgetc(archivo)) != EOF && c != '\n');
+    }
+    while (largo > 0 && (linea[largo - 1] == '\n' || linea[largo - 1] == '\r')) {
+        linea[--largo] = '\0';
+    }
+
     int i = 0;
+    bool comillaSinCerrar = false;
     char *ptr = linea;
     while (*ptr && i < MAX_FIELDS) {
         if (*ptr == '"') {
             ptr++;
             campos[i++] = ptr;
-            while (*ptr && (*ptr != '"' || ((*(ptr + 1) != separador) && (*(ptr + 1) != '\n')))) ptr++;
+            while (*ptr && (*ptr != '"' || ((*(ptr + 1) != separador) && (*(ptr + 1) != '\0')))) ptr++;
+            if (*ptr == '\0') {
+                comillaSinCerrar = true;
+                break;
+            }
             *ptr = '\0';
             ptr++;
             if (*ptr == separador) ptr++;
         } else {
             campos[i++] = ptr;
-            while (*ptr && *ptr != separador && *ptr != '\n') ptr++;
+            while (*ptr && *ptr != separador) ptr++;
             if (*ptr) *ptr++ = '\0';
         }
     }
 
+    if (info) {
+        info->numCampos = i;
+        info->truncada = truncada;
+        info->comillaSinCerrar = comillaSinCerrar;
+        info->desplazamiento = desplazamiento;
+        info->linea = linea;
+    }
     return campos;
 }
 
-List *split_string(const char *str, const char *delim) {
+char **leer_linea_csv(FILE *archivo, char separador, InfoLineaCsv *info) {
+    MEDIR_INICIO(inicio);
+    char **campos = leer_linea(archivo, separador, info);
+    MEDIR_FIN(inicio, MET_LEER_LINEA_CSV);
+    return campos;
+}
+
+/*
+ * texto_a_entero
+ * --------------
+ * Convierte el texto completo a entero (se permiten espacios alrededor).
+ * Retorna false si el texto no es un número o no cabe en un int.
+ */
+
+bool texto_a_entero(const char *texto, int *valor) {
+    char *fin;
+    long numero = strtol(texto, &fin, 10);
+    if (fin == texto) return false;
+    while (isspace((unsigned char)*fin)) fin++;
+    if (*fin != '\0' || numero < INT_MIN || numero > INT_MAX) return false;
+    *valor = (int)numero;
+    return true;
+}
+
+/*
+ * texto_a_entero_n
+ * ----------------
+ * Igual que texto_a_entero, pero sobre los primeros 'largo' caracteres de 'texto', que
+ * no necesita terminar en '\0'. Así se pueden validar números dentro de un campo sin
+ * copiarlos.
+ */
+
+bool texto_a_entero_n(const char *texto, size_t largo, int *valor) {
+    const char *p = texto;
+    const char *fin = texto + largo;
+    while (p < fin && isspace((unsigned char)*p)) p++;
+    bool negativo = false;
+    if (p < fin && (*p == '-' || *p == '+')) negativo = (*p++ == '-');
+
+    const char *digitos = p;
+    long long numero = 0;
+    while (p < fin && isdigit((unsigned char)*p)) {
+        numero = numero * 10 + (*p++ - '0');
+        if (numero > (long long)INT_MAX + 1) return false;
+    }
+    if (p == digitos) return false;
+    while (p < fin && isspace((unsigned char)*p)) p++;
+    if (p != fin) return false;
+
+    if (negativo) numero = -numero;
+    if (numero < INT_MIN || numero > INT_MAX) return false;
+    *valor = (int)numero;
+    return true;
+}
+
+/*
+ * leer_item_csv
+ * -------------
+ * Lee el siguiente ítem no vacío del campo de ítems ("nombre,valor,peso;...") a partir
+ * de *cursor y deja el cursor después de él. No reserva memoria ni modifica el campo:
+ * el nombre y los números quedan como vistas dentro del texto original, y los números
+ * se validan (enteros no negativos) en vez de convertirse con atoi.
+ *
+ * Retorna false cuando ya no quedan ítems. Un ítem mal formado se retorna igual, con
+ * su estado, para que quien llama decida si informarlo u omitirlo.
+ */
+
+bool leer_item_csv(const char **cursor, ItemCsv *item) {
+    const char *p = *cursor;
+    while (*p == ';') p++;
+    if (*p == '\0') {
+        *cursor = p;
+        return false;
+    }
+
+    const char *fin = p;
+    while (*fin && *fin != ';') fin++;
+    *cursor = fin;
+
+    item->inicio = p;
+    item->largo = (size_t)(fin - p);
+
+    // Hasta tres partes separadas por comas; una cuarta coma hace el ítem mal formado
+    const char *partes[3];
+    size_t largos[3];
+    int numPartes = 0;
+    const char *inicioParte = p;
+    for (const char *q = p; ; q++) {
+        if (q == fin || *q == ',') {
+            if (numPartes == 3) {
+                numPartes++;
+                break;
+            }
+            partes[numPartes] = inicioParte;
+            largos[numPartes] = (size_t)(q - inicioParte);
+            numPartes++;
+            if (q == fin) break;
+            inicioParte = q + 1;
+        }
+    }
+
+    item->nombre = partes[0];
+    item->largoNombre = largos[0];
+    item->textoValor = item->textoPeso = NULL;
+    item->largoValor = item->largoPeso = 0;
+    if (numPartes != 3) {
+        item->estado = ITEM_CSV_MALFORMADO;
+        return true;
+    }
+    item->textoValor = partes[1];
+    item->largoValor = largos[1];
+    item->textoPeso = partes[2];
+    item->largoPeso = largos[2];
+
+    if (item->largoNombre == 0) {
+        item->estado = ITEM_CSV_SIN_NOMBRE;
+    } else if (!texto_a_entero_n(partes[1], largos[1], &item->valor) || item->valor < 0) {
+        item->estado = ITEM_CSV_VALOR_INVALIDO;
+    } else if (!texto_a_entero_n(partes[2], largos[2], &item->peso) || item->peso < 0) {
+        item->estado = ITEM_CSV_PESO_INVALIDO;
+    } else {
+        item->estado = ITEM_CSV_VALIDO;
+    }
+    return true;
+}
+
+static List *separar(const char *str, const char *delim) {
     List *lista = list_create();
     if (!lista || !str || !delim) return NULL;
 
-    char *copia = strdup(str);
+    char *copia = mem_duplicar(MEM_CARGADOR, str);
     if (!copia) return NULL;
 
     char *token = strtok(copia, delim);
     while (token != NULL) {
-        char *dato = strdup(token);
+        char *dato = mem_duplicar(MEM_CARGADOR, token);
         list_pushBack(lista, dato);
         token = strtok(NULL, delim);
     }
 
-    free(copia);
+    mem_liberar(copia);
+    return lista;
+}
+
+List *split_string(const char *str, const char *delim) {
+    MEDIR_INICIO(inicio);
+    List *lista = separar(str, delim);
+    MEDIR_FIN(inicio, MET_SPLIT_STRING);
     return lista;
 }
 
 void limpiarPantalla(void) {
+    MEDIR_INICIO(inicio);
     system(CLEAR_CMD);
+    MEDIR_FIN(inicio, MET_LIMPIAR_PANTALLA);
 }
 
 void presioneTeclaParaContinuar() {
@@ -80,16 +246,15 @@ void presioneTeclaParaContinuar() {
 
 void liberarEscenarios(Graph* g) {
     if (g == NULL || g->nodes == NULL) return;
+    if (g->esEstatico) {
+        *g = (Graph){ 0 };      // Sus datos están en el ejecutable: no hay nada que liberar
+        return;
+    }
 
     for (int i = 0; i < g->numberOfNodes; i++) {
         Node* nodo = &g->nodes[i];
         if (nodo == NULL) continue;
 
-        if (nodo->adjacents != NULL) {
-            free(nodo->adjacents);
-            nodo->adjacents = NULL;
-        }
-
         if (nodo->state.availableItems != NULL) {
             liberarListaItems(nodo->state.availableItems);
             nodo->state.availableItems = NULL;
@@ -101,7 +266,25 @@ void liberarEscenarios(Graph* g) {
         }
     }
 
-    free(g->nodes);
+    if (!g->esCopia) {
+        indice_liberar(g->indice);
+        plano_liberar(g->plano);
+        orden_items_liberar(g->ordenItems);
+        fuente_cerrar(g->textos);
+        pool_liberar(g->cadenas);
+        mem_liberar(g->inicioAristas);
+        mem_liberar(g->aristas);
+    }
+    g->inicioAristas = NULL;
+    g->aristas = NULL;
+    g->numAristas = 0;
+    g->indice = NULL;
+    g->plano = NULL;
+    g->ordenItems = NULL;
+    g->textos = NULL;
+    g->cadenas = NULL;
+
+    mem_liberar(g->nodes);
     g->nodes = NULL;
     g->numberOfNodes = 0;
     g->capacidad = 0;
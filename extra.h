@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdbool.h>
 
 typedef struct List List;
 typedef struct Graph Graph;
@@ -14,7 +15,42 @@ typedef struct Graph Graph;
 #define CLEAR_CMD "clear"
 #endif
 
-char **leer_linea_csv(FILE *archivo, char separador);
+typedef struct {
+    int  numCampos;         // Cantidad de campos encontrados en la línea
+    bool truncada;          // La línea superaba el largo máximo y se recortó
+    bool comillaSinCerrar;  // Un campo entre comillas no tenía comilla de cierre
+    long desplazamiento;    // Posición del inicio de la línea dentro del archivo
+    const char *linea;      // Inicio del búfer de la línea (para ubicar cada campo en el archivo)
+} InfoLineaCsv;
+
+// Resultado de leer un ítem del campo de ítems del CSV.
+typedef enum {
+    ITEM_CSV_VALIDO,        // nombre,valor,peso con números enteros no negativos
+    ITEM_CSV_MALFORMADO,    // No tiene exactamente tres partes separadas por comas
+    ITEM_CSV_SIN_NOMBRE,
+    ITEM_CSV_VALOR_INVALIDO,
+    ITEM_CSV_PESO_INVALIDO
+} EstadoItemCsv;
+
+// Ítem leído sin copiar nada: los textos apuntan dentro del campo original.
+typedef struct {
+    const char*   inicio;       // Comienzo del ítem dentro del campo
+    size_t        largo;        // Largo del ítem completo (hasta el ';' o el fin del campo)
+    const char*   nombre;
+    size_t        largoNombre;
+    const char*   textoValor;   // Solo válidos si el ítem tiene sus tres partes
+    size_t        largoValor;
+    const char*   textoPeso;
+    size_t        largoPeso;
+    int           valor;
+    int           peso;
+    EstadoItemCsv estado;
+} ItemCsv;
+
+char **leer_linea_csv(FILE *archivo, char separador, InfoLineaCsv *info);
+bool leer_item_csv(const char **cursor, ItemCsv *item);
+bool texto_a_entero(const char *texto, int *valor);
+bool texto_a_entero_n(const char *texto, size_t largo, int *valor);
 List *split_string(const char *str, const char *delim);
 void limpiarPantalla(void);
 void presioneTeclaParaContinuar(void);
@@ -2,10 +2,20 @@
 #include "extra.h"
 #include "grafo.h"
 #include "list.h"
+#include "indice.h"
+#include "metricas.h"
+#include "memoria.h"
+#include "plano.h"
+#include "bot.h"
+#include "historial.h"
+#include "puntajes.h"
+#include "consejo.h"
 
 #include <ctype.h>
 #define MAXOPTION 256
 
+bool modoDepuracion = false;
+
 /*
  * Función: showPrincipalOptions
  * -----------------------------
@@ -20,6 +30,7 @@
  */
 
 void showPrincipalOptions(){
+    MEDIR_INICIO(inicio);
     limpiarPantalla();
     puts("---------- GraphQuest ----------\n");
     puts("-------- Menú Principal --------");
@@ -27,6 +38,7 @@ void showPrincipalOptions(){
     puts("(2)   Mostrar Escenarios Cargados.");
     puts("(3)   Iniciar Partida.");
     puts("(4)   Salir");
+    MEDIR_FIN(inicio, MET_RENDER_MENU);
 }
 
 /*
@@ -39,16 +51,34 @@ void showPrincipalOptions(){
  *    dentro del juego.
  * 
  * Esta función no recibe parámetros ni retorna valores. Está diseñada para guiar al jugador
- * mostrando el conjunto de comandos que puede ejecutar.
+ * mostrando el conjunto de comandos que puede ejecutar. La opción de saltar a un escenario
+ * solo aparece cuando el programa se inicia con --debug.
  */
 
 void showGameOptions(){
+    MEDIR_INICIO(inicio);
     puts("------ Opciones Disponibles ------");
     puts("(1)   Recoger Ítem(s)");
     puts("(2)   Descartar Ítem(s)");
     puts("(3)   Avanzar en una dirección");
     puts("(4)   Reiniciar partida");
     puts("(5)   Salir del juego");
+    puts("(6)   Buscar ítem por nombre");
+    puts("(7)   Piloto automático");
+    puts("(8)   Deshacer / rehacer");
+    if (modoDepuracion) puts("(9)   Saltar a escenario (depuración)");
+    MEDIR_FIN(inicio, MET_RENDER_MENU);
+}
+
+/*
+ * Función: cantidadOpcionesJuego
+ * ------------------------------
+ * Retorna cuántas opciones muestra showGameOptions (la opción de salto solo existe
+ * en modo depuración).
+ */
+
+int cantidadOpcionesJuego(){
+    return modoDepuracion ? 9 : 8;
 }
 
 /*
@@ -99,6 +129,43 @@ char readOption(char reading[MAXOPTION], int maxOpciones) {
     }
 }
 
+/*
+ * Función: jugar_turno_automatico
+ * -------------------------------
+ * La computadora juega por el jugador (ver bot.h) hasta que avanza, lo que termina su
+ * turno, o hasta que el jugador termina. Informa cada acción que realiza.
+ *
+ * Parámetros:
+ *  - gs: Estado del jugador.
+ *  - rivales: Cantidad de otros jugadores que siguen en juego (0 en un jugador).
+ */
+
+static void jugar_turno_automatico(GameState* gs, int rivales) {
+    while (!jugador_terminado(gs)) {
+        DecisionBot decision = bot_decidir(gs, rivales);
+        if (decision.tipo == BOT_DESCARTAR) {
+            // El nombre se toma antes de descartar: descartar libera el ítem
+            ListNode* ln = gs->inventory->head;
+            for (int i = 0; ln && i < decision.posicion; i++) ln = ln->next;
+            if (ln) printf("La computadora descartó: %s\n", ((Item*)ln->data)->name);
+        }
+
+        int gasto = 0;
+        bool hecha = bot_aplicar(gs, &decision, &gasto);
+        if (decision.tipo == BOT_RECOGER) {
+            if (hecha) printf("La computadora recogió: %s (valor %d, peso %d)\n", decision.item->name,
+                              decision.item->value, decision.item->weight);
+            else       printf("Otro jugador tomó %s antes.\n", decision.item->name);
+        } else if (decision.tipo == BOT_MOVER) {
+            printf("La computadora avanzó por \"%s\" hasta %s (gastó %d de tiempo, quedan %d).\n",
+                   decision.arista->etiqueta, nombre_escenario(gs->currentNode), gasto, gs->tiempoRestante);
+            return;
+        } else if (decision.tipo == BOT_NINGUNA) {
+            return;
+        }
+    }
+}
+
 /*
  * Función: iniciar_partida
  * ------------------------
@@ -116,6 +183,8 @@ char readOption(char reading[MAXOPTION], int maxOpciones) {
  *      - Muestra el estado actual del jugador y opciones disponibles.
  *      - Lee y valida la opción del usuario.
  *      - Según la opción, permite recoger ítems, descartar ítems, moverse, reiniciar o salir.
+ *      - Con el piloto automático, la computadora juega el resto de la partida (ver bot.h).
+ *      - Deshacer / rehacer revierte o repite la última acción (ver historial.h).
  *      - Si la acción termina la partida (por ejemplo, movimiento a nodo final), se sale del bucle.
  *  - Soporta reinicio recursivo al llamar a sí misma cuando el jugador elige reiniciar.
  *  - Al finalizar, muestra un mensaje según se haya terminado por tiempo o por alcanzar el nodo final,
@@ -125,27 +194,32 @@ char readOption(char reading[MAXOPTION], int maxOpciones) {
  *
  * Detalles adicionales:
  *  - Usa funciones auxiliares como mostrar_estado_actual, showGameOptions, readOption,
- *    recoger_items, descartar_items, moverse y liberarJuego.
+ *    recoger_items, descartar_items, moverse, buscar_item_por_nombre y liberarJuego.
  */
 
 void iniciar_partida(Graph* grafo) {
     GameState gs;
+    gs.grafo = grafo;
     gs.currentNode = grafo->start;
-    gs.inventory = list_create();
-    gs.tiempoRestante = 10; // Tiempo inicial
-
-    while (gs.tiempoRestante > 0 && !gs.currentNode->state.esFinal) {
+    gs.inventory = lista_items_crear();
+    gs.tiempoRestante = TIEMPOINICIAL;
+    gs.jugador = 0;
+    gs.automatico = false;
+    gs.turnos = 0;
+    historial_iniciar(&gs.historial);
+
+    while (gs.tiempoRestante > 0 && !gs.currentNode->state.esFinal && !partida_sin_salida(&gs)) {
         mostrar_estado_actual(&gs, 1);
         showGameOptions();
 
         char buf[MAXOPTION];
-        char opcion = readOption(buf, 5);
+        char opcion = readOption(buf, cantidadOpcionesJuego());
 
         bool partidaTerminada = false;
         
         switch (opcion) {
             case '1':
-                recoger_items(&gs, false, NULL);
+                recoger_items(&gs);
                 break;
             case '2': descartar_items(&gs, 1); break;
             case '3': partidaTerminada = moverse(&gs); break;
@@ -153,17 +227,28 @@ void iniciar_partida(Graph* grafo) {
                 // Reiniciar sin liberar el grafo, para mantener ítems recogidos
                 puts("\n--- Reiniciando la partida... ---");
                 presioneTeclaParaContinuar();
+                liberar_jugador(&gs);
                 iniciar_partida(grafo);
                 return;
             case '5': 
                 // Salir
+                liberar_jugador(&gs);
                 liberarJuego(grafo);
                 return;
+            case '6': buscar_item_por_nombre(grafo); break;
+            case '7':
+                // La computadora juega el resto de la partida
+                puts("\n--- Piloto automático ---");
+                while (!jugador_terminado(&gs)) jugar_turno_automatico(&gs, 0);
+                break;
+            case '8': deshacer_o_rehacer(&gs); break;
+            case '9': saltar_a_escenario(&gs, grafo); break;
         }
 
         if (partidaTerminada) {
             printf("\nPresione cualquier tecla para volver al menú principal...");
             getchar(); // Esperar entrada del usuario
+            liberar_jugador(&gs);
             liberarJuego(grafo);
             return;
         }
@@ -176,92 +261,209 @@ void iniciar_partida(Graph* grafo) {
     } else if (gs.currentNode->state.esFinal) {
         puts("\n¡Llegaste al final!");
         mostrar_puntaje_final(&gs);
+    } else {
+        puts("\n¡Ya no puedes llegar a ningún final! La partida termina.");
+        mostrar_puntaje_final(&gs);
     }
 
     printf("\nPresione cualquier tecla para volver al menú principal...");
     getchar();
+    liberar_jugador(&gs);
     liberarJuego(grafo);
 }
 
+/*
+ * Función: crear_partida_compartida
+ * ---------------------------------
+ * Prepara una partida multijugador de N jugadores sobre un único mundo compartido.
+ *
+ * Parámetros:
+ *  - grafo: Puntero al grafo original con el laberinto cargado.
+ *  - numJugadores: Cantidad de jugadores (entre 1 y MAXJUGADORES).
+ *
+ * Funcionalidad:
+ *  - Crea una sola copia del grafo, común a todos los jugadores.
+ *  - Inicializa a cada jugador en el nodo inicial, con inventario vacío y tiempo inicial.
+ *
+ * Retorno:
+ *  - Puntero a la partida creada, o NULL si no se pudo reservar memoria.
+ *
+ * Detalles adicionales:
+ *  - Los ítems se reparten reclamándolos atómicamente (ver reclamar_item), por lo que
+ *    no hace falta sincronizar inventarios ni mantener un grafo por jugador.
+ */
+
+GameStateMultiplayer* crear_partida_compartida(Graph* grafo, int numJugadores) {
+    if (!grafo || numJugadores < 1 || numJugadores > MAXJUGADORES) return NULL;
+
+    GameStateMultiplayer* partida = mem_reservar(MEM_PARTIDAS, sizeof(GameStateMultiplayer));
+    if (!partida) return NULL;
+
+    partida->grafo = copiar_grafo(grafo);
+    partida->jugadores = mem_reservar_ceros(MEM_PARTIDAS, numJugadores, sizeof(GameState));
+    if (!partida->grafo || !partida->jugadores) {
+        if (partida->grafo) {
+            liberarJuego(partida->grafo);
+            mem_liberar(partida->grafo);
+        }
+        mem_liberar(partida->jugadores);
+        mem_liberar(partida);
+        return NULL;
+    }
+
+    partida->numJugadores = numJugadores;
+    partida->turnoActual = 0;
+    for (int i = 0; i < numJugadores; i++) {
+        GameState* gs = &partida->jugadores[i];
+        gs->grafo = partida->grafo;
+        gs->currentNode = partida->grafo->start;
+        gs->inventory = lista_items_crear();
+        gs->tiempoRestante = TIEMPOINICIAL;
+        gs->jugador = i;
+        gs->turnos = 0;
+        historial_iniciar(&gs->historial);
+    }
+    return partida;
+}
+
+/*
+ * Función: liberar_jugador
+ * ------------------------
+ * Libera el historial del jugador (con los ítems descartados que guardaba) y su inventario.
+ */
+
+void liberar_jugador(GameState* gs) {
+    historial_liberar(gs);
+    list_destroy(gs->inventory);
+    gs->inventory = NULL;
+}
+
+/*
+ * Función: liberar_partida_compartida
+ * -----------------------------------
+ * Libera los inventarios de todos los jugadores, el grafo compartido y la partida.
+ */
+
+void liberar_partida_compartida(GameStateMultiplayer* partida) {
+    if (!partida) return;
+    for (int i = 0; i < partida->numJugadores; i++) {
+        liberar_jugador(&partida->jugadores[i]);
+    }
+    liberarJuego(partida->grafo);
+    mem_liberar(partida->grafo);
+    mem_liberar(partida->jugadores);
+    mem_liberar(partida);
+}
+
+// Un jugador termina al quedarse sin tiempo, al llegar a un nodo final o al quedar sin salida.
+bool jugador_terminado(const GameState* gs) {
+    return gs->tiempoRestante <= 0 || gs->currentNode->state.esFinal || partida_sin_salida(gs);
+}
+
+// Jugadores que siguen en juego, sin contar a 'gs'.
+static int rivales_en_juego(const GameStateMultiplayer* partida, const GameState* gs) {
+    int rivales = 0;
+    for (int i = 0; i < partida->numJugadores; i++) {
+        if (&partida->jugadores[i] != gs && !jugador_terminado(&partida->jugadores[i])) rivales++;
+    }
+    return rivales;
+}
+
+// Pasa el turno al siguiente jugador que siga en juego. Retorna false si ya no queda ninguno.
+static bool avanzar_turno(GameStateMultiplayer* partida) {
+    for (int paso = 1; paso <= partida->numJugadores; paso++) {
+        int siguiente = (partida->turnoActual + paso) % partida->numJugadores;
+        if (!jugador_terminado(&partida->jugadores[siguiente])) {
+            partida->turnoActual = siguiente;
+            return true;
+        }
+    }
+    return false;
+}
+
 /*
  * Función: iniciar_partida_multijugador
  * -------------------------------------
- * Inicia y controla una partida en modo multijugador para dos jugadores.
+ * Inicia y controla una partida por turnos para N jugadores en un mundo compartido.
  *
  * Parámetros:
  *  - grafo: Puntero a la estructura Graph que contiene el laberinto original.
+ *  - numJugadores: Cantidad de jugadores que participan.
+ *  - automaticos: Jugadores que controla la computadora (NULL si todos son personas).
  *
  * Funcionalidad:
- *  - Crea copias independientes del grafo para cada jugador para evitar interferencias.
- *  - Inicializa los estados de ambos jugadores con nodo inicial, inventario vacío y tiempo inicial.
- *  - Ejecuta turnos alternados donde cada jugador puede realizar múltiples acciones 
+ *  - Crea la partida compartida (un solo grafo para todos los jugadores).
+ *  - Ejecuta turnos en ronda donde cada jugador puede realizar múltiples acciones 
  *    (recoger ítems, descartar ítems, moverse, reiniciar o salir) hasta terminar el turno.
- *  - Sincroniza los ítems disponibles entre ambos grafos según las acciones de los jugadores.
- *  - Verifica condiciones de término: tiempo agotado o llegada al nodo final para ambos jugadores.
+ *  - Los jugadores que ya terminaron (sin tiempo o en un nodo final) se saltan.
+ *  - En el turno de un jugador automático, la computadora juega hasta avanzar (ver
+ *    bot.h). Con el piloto automático, un jugador pasa a ser automático desde ese turno.
+ *  - Deshacer / rehacer no termina el turno; deshacer una recogida devuelve el ítem al
+ *    mundo compartido.
+ *  - Si no queda ninguna persona, los turnos se juegan seguidos, sin pausas.
+ *  - La partida termina cuando todos los jugadores terminaron o alguien elige salir.
  *  - Al finalizar la partida, muestra puntajes individuales y libera los recursos asignados.
  *
  * Detalles adicionales:
  *  - Soporta reinicio recursivo de la partida.
- *  - Utiliza funciones auxiliares para mostrar estado, leer opciones, sincronizar ítems, etc.
+ *  - Un ítem recogido por un jugador queda reclamado en el grafo compartido, de modo que
+ *    los demás dejan de verlo sin ninguna pasada de sincronización.
  */
 
-void iniciar_partida_multijugador(Graph* grafo) {
-    // Crear una copia del grafo para cada jugador
-    Graph* grafoJugador1 = copiar_grafo(grafo);
-    Graph* grafoJugador2 = copiar_grafo(grafo);
-    
-    if (!grafoJugador1 || !grafoJugador2) {
-        puts("Error al crear copias del grafo para multijugador");
-        if (grafoJugador1) liberarJuego(grafoJugador1);
-        if (grafoJugador2) liberarJuego(grafoJugador2);
+void iniciar_partida_multijugador(Graph* grafo, int numJugadores, const bool* automaticos) {
+    GameStateMultiplayer* partida = crear_partida_compartida(grafo, numJugadores);
+    if (!partida) {
+        puts("Error al crear la partida multijugador");
         return;
     }
+    for (int i = 0; automaticos && i < numJugadores; i++) partida->jugadores[i].automatico = automaticos[i];
 
-    GameState gs1, gs2;
-    gs1.currentNode = grafoJugador1->start;
-    gs1.inventory = list_create();
-    gs1.tiempoRestante = 10;
-    
-    gs2.currentNode = grafoJugador2->start;
-    gs2.inventory = list_create();
-    gs2.tiempoRestante = 10;
-
-    int jugadorActual = 0; // 0 para jugador 1, 1 para jugador 2
-    bool partidaTerminada = false;
+    // Si el mapa no permite ganar desde el inicio, nadie llega a jugar un turno
+    bool partidaTerminada = jugador_terminado(&partida->jugadores[0]) && !avanzar_turno(partida);
 
     while (!partidaTerminada) {
-        GameState* gsActual = (jugadorActual == 0) ? &gs1 : &gs2;
+        GameState* gsActual = &partida->jugadores[partida->turnoActual];
+        int numeroJugador = partida->turnoActual + 1;
         bool turnoTerminado = false;
 
+        if (gsActual->automatico) {
+            bool hayPersonas = false;
+            for (int i = 0; i < partida->numJugadores; i++) {
+                if (!partida->jugadores[i].automatico) hayPersonas = true;
+            }
+            if (hayPersonas) limpiarPantalla();
+            printf("====== TURNO DEL JUGADOR %d (computadora) ======\n", numeroJugador);
+            if (hayPersonas) mostrar_estado_actual(gsActual, 0);
+            jugar_turno_automatico(gsActual, rivales_en_juego(partida, gsActual));
+            if (hayPersonas) presioneTeclaParaContinuar();
+            if (!avanzar_turno(partida)) partidaTerminada = true;
+            continue;
+        }
+
         // Mostrar pantalla de turno
         limpiarPantalla();
-        printf("====== TURNO DEL JUGADOR %d ======\n", jugadorActual + 1);
+        printf("====== TURNO DEL JUGADOR %d ======\n", numeroJugador);
         mostrar_estado_actual(gsActual, 0); // 0 para multijugador
         
         while (!turnoTerminado && !partidaTerminada) {
             showGameOptions();
             char buf[MAXOPTION];
-            char opcion = readOption(buf, 5);
+            char opcion = readOption(buf, cantidadOpcionesJuego());
 
             switch (opcion) {
                 case '1': 
-                    recoger_items(gsActual, true, (jugadorActual == 0) ? gs2.currentNode : gs1.currentNode);
-                    sincronizar_items(grafoJugador1, grafoJugador2, &gs1, &gs2);
+                    recoger_items(gsActual);
                     break;
                 case '2': {
                     // Descartar ítem
                     limpiarPantalla();
-                    printf("====== TURNO DEL JUGADOR %d ======\n", jugadorActual + 1);
+                    printf("====== TURNO DEL JUGADOR %d ======\n", numeroJugador);
                     descartar_items(gsActual, 0); // 0 para multijugador
-                    // presioneTeclaParaContinuar();
                     break;
                 }
                 case '3': {
                     // Moverse
-                    bool movimientoTerminoPartida = moverse(gsActual);
-                    if (movimientoTerminoPartida) {
-                        partidaTerminada = true;
-                    }
+                    moverse(gsActual);
                     turnoTerminado = true;
                     break;
                 }
@@ -269,9 +471,8 @@ void iniciar_partida_multijugador(Graph* grafo) {
                 case '4': 
                     puts("\n--- Reiniciando la partida multijugador... ---");
                     presioneTeclaParaContinuar();
-                    liberarJuego(grafoJugador1);
-                    liberarJuego(grafoJugador2);
-                    iniciar_partida_multijugador(grafo);
+                    liberar_partida_compartida(partida);
+                    iniciar_partida_multijugador(grafo, numJugadores, automaticos);
                     return;
 
                 case '5': 
@@ -279,26 +480,50 @@ void iniciar_partida_multijugador(Graph* grafo) {
                     partidaTerminada = true;
                     turnoTerminado = true;
                     break;
+
+                case '6':
+                    buscar_item_por_nombre(partida->grafo);
+                    break;
+
+                case '7':
+                    // Desde ahora la computadora juega por este jugador
+                    gsActual->automatico = true;
+                    puts("\n--- Piloto automático ---");
+                    jugar_turno_automatico(gsActual, rivales_en_juego(partida, gsActual));
+                    presioneTeclaParaContinuar();
+                    turnoTerminado = true;
+                    break;
+
+                case '8':
+                    // No termina el turno: el jugador sigue con el estado que quedó
+                    deshacer_o_rehacer(gsActual);
+                    break;
+
+                case '9':
+                    saltar_a_escenario(gsActual, partida->grafo);
+                    break;
             }
 
             // Verificar si terminó el turno
-            if (gsActual->tiempoRestante <= 0 || gsActual->currentNode->state.esFinal) {
+            if (jugador_terminado(gsActual)) {
+                if (opcion != '3' && partida_sin_salida(gsActual)) {
+                    printf("\nEl jugador %d ya no puede llegar a ningún final.\n", numeroJugador);
+                    presioneTeclaParaContinuar();
+                }
                 turnoTerminado = true;
-                partidaTerminada = (gs1.tiempoRestante <= 0 || gs1.currentNode->state.esFinal) &&
-                                  (gs2.tiempoRestante <= 0 || gs2.currentNode->state.esFinal);
             }
 
             // Mostrar estado actualizado
             if (!turnoTerminado && !partidaTerminada) {
                 limpiarPantalla();
-                printf("====== TURNO DEL JUGADOR %d ======\n", jugadorActual + 1);
+                printf("====== TURNO DEL JUGADOR %d ======\n", numeroJugador);
                 mostrar_estado_actual(gsActual, 0);
             }
         }
 
-        // Cambiar jugador
-        if (!partidaTerminada) {
-            jugadorActual = 1 - jugadorActual;
+        // Cambiar jugador (si nadie sigue en juego, la partida termina)
+        if (!partidaTerminada && !avanzar_turno(partida)) {
+            partidaTerminada = true;
         }
     }
 
@@ -306,18 +531,37 @@ void iniciar_partida_multijugador(Graph* grafo) {
     limpiarPantalla();
     puts("====== RESULTADOS FINALES ======\n");
     
-    puts("JUGADOR 1:");
-    mostrar_puntaje_final(&gs1);
-    printf("\n");
-    
-    puts("JUGADOR 2:");
-    mostrar_puntaje_final(&gs2);
+    for (int i = 0; i < partida->numJugadores; i++) {
+        printf("JUGADOR %d:\n", i + 1);
+        mostrar_puntaje_final(&partida->jugadores[i]);
+        printf("\n");
+    }
 
     // Liberar recursos
-    liberarJuego(grafoJugador1);
-    liberarJuego(grafoJugador2);
-    free(grafoJugador1);
-    free(grafoJugador2);
+    liberar_partida_compartida(partida);
+}
+
+// Indica si el consejo recomienda recoger el ítem.
+static bool en_consejo(const Consejo* consejo, const Item* item) {
+    for (int i = 0; i < consejo->numRecoger; i++) {
+        if (consejo->recoger[i] == item) return true;
+    }
+    return false;
+}
+
+// Resume el consejo en una línea, debajo de la lista de ítems o del inventario.
+static void mostrar_sugerencia(const Consejo* consejo) {
+    if (!consejo->llega) {
+        puts("\nSugerencia: ni soltando ítems se llega a un final por el camino más corto.");
+    } else if (consejo->numRecoger == 0 && consejo->numDescartar == 0) {
+        printf("\nSugerencia: no recojas nada y avanza (puntaje %d, llegarías con tiempo %d).\n",
+               consejo->puntaje, consejo->tiempoFinal);
+    } else {
+        printf("\nSugerencia: recoge los marcados con '*'");
+        if (consejo->numDescartar > 0) printf(", después de descartar %d del inventario", consejo->numDescartar);
+        printf(" (puntaje %d, peso %d, llegarías con tiempo %d).\n", consejo->puntaje, consejo->peso,
+               consejo->tiempoFinal);
+    }
 }
 
 /*
@@ -327,51 +571,64 @@ void iniciar_partida_multijugador(Graph* grafo) {
  *
  * Parámetros:
  *  - gs: Puntero a la estructura GameState con el estado actual del jugador.
- *  - esMultijugador: Indica si la partida está en modo multijugador (true o false).
- *  - otroJugadorNode: Puntero al nodo actual del otro jugador (solo usado en multijugador para sincronizar ítems).
  *
  * Funcionalidad:
- *  - Muestra los ítems disponibles en el nodo actual.
+ *  - Muestra los ítems del nodo actual que nadie ha reclamado todavía, marcando con '*'
+ *    los que conviene llevar según aconsejar_items (ver consejo.h).
  *  - Solicita al usuario que seleccione un ítem por su índice.
  *  - Valida la entrada del usuario y el índice seleccionado.
- *  - Verifica que el ítem seleccionado aún esté disponible (considerando posibles cambios en multijugador).
- *  - Copia el ítem al inventario del jugador y lo elimina del nodo actual.
- *  - En modo multijugador, elimina el ítem también del nodo del otro jugador para mantener sincronización.
- *  - Deduce 1 unidad de tiempo restante como penalización por recoger un ítem.
+ *  - Reclama el ítem con recoger_item; si otro jugador lo tomó mientras se elegía,
+ *    el reclamo falla y se informa al usuario.
  *  - Muestra mensajes de error o confirmación según corresponda.
  *
  * Manejo de errores:
  *  - Detecta entrada inválida o índice fuera de rango.
- *  - Notifica si el ítem ya fue tomado por el otro jugador.
+ *  - Notifica si el ítem ya fue tomado por otro jugador.
  */
 
-void recoger_items(GameState* gs, bool esMultijugador, Node* otroJugadorNode) {
+void recoger_items(GameState* gs) {
     limpiarPantalla();
     puts("======- Recoger Ítem -======");
     Node* n = gs->currentNode;
-    
-    if (list_size(n->state.availableItems) == 0) {
+
+    // Los mismos números que item_disponible_en, sin tope: el arreglo cubre toda la lista
+    // y se recorre sin su cursor, que otros jugadores pueden estar usando
+    List* lista = n->state.availableItems;
+    Item** items = mem_reservar(MEM_INTERFAZ, sizeof(Item*) * (list_size(lista) > 0 ? list_size(lista) : 1));
+    if (!items) {
+        puts("No hay memoria suficiente para mostrar los ítems.");
+        presioneTeclaParaContinuar();
+        return;
+    }
+    int itemCount = 0;
+    for (ListNode* ln = lista->head; ln != NULL; ln = ln->next) {
+        if (item_disponible(ln->data)) items[itemCount++] = ln->data;
+    }
+
+    if (itemCount == 0) {
         puts("No hay ítems para recoger.");
+        mem_liberar(items);
         presioneTeclaParaContinuar();
         return;
     }
 
+    Consejo consejo;
+    bool hayConsejo = aconsejar_items(gs, &consejo);
+
     // Mostrar ítems disponibles
     printf("\nÍtems disponibles:\n");
-    int itemCount = 0;
-    Item* items[MAXNODES];
-    
-    for (Item* it = list_first(n->state.availableItems); it != NULL; it = list_next(n->state.availableItems)) {
-        printf("(%d) %s (valor: %d, peso: %d)\n", itemCount, it->name, it->value, it->weight);
-        items[itemCount] = it;
-        itemCount++;
+    for (int i = 0; i < itemCount; i++) {
+        printf("(%d) %s (valor: %d, peso: %d)%s\n", i, items[i]->name, items[i]->value, items[i]->weight,
+               hayConsejo && en_consejo(&consejo, items[i]) ? " *" : "");
     }
+    if (hayConsejo) mostrar_sugerencia(&consejo);
 
     printf("\nIngresa el índice del ítem a recoger (0-%d): ", itemCount-1);
     char input[MAXOPTION];
     
     if (!fgets(input, MAXOPTION, stdin)) {
         puts("Error al leer la entrada.");
+        mem_liberar(items);
         presioneTeclaParaContinuar();
         return;
     }
@@ -381,58 +638,271 @@ void recoger_items(GameState* gs, bool esMultijugador, Node* otroJugadorNode) {
     
     if (endptr == input || *endptr != '\n') {
         puts("Entrada inválida. Debe ser un número.");
+        mem_liberar(items);
         presioneTeclaParaContinuar();
         return;
     }
 
     if (choice < 0 || choice >= itemCount) {
         printf("Índice inválido. Debe estar entre 0 y %d.\n", itemCount-1);
+        mem_liberar(items);
         presioneTeclaParaContinuar();
         return;
     }
 
     Item* it = items[choice];
-    
-    // Verificar si el ítem todavía existe (para multijugador)
-    bool itemExistente = false;
-    for (Item* current = list_first(n->state.availableItems); current != NULL; current = list_next(n->state.availableItems)) {
-        if (strcmp(current->name, it->name) == 0) {
-            itemExistente = true;
-            break;
-        }
+    mem_liberar(items);
+    if (!recoger_item(gs, it)) {
+        puts(item_disponible(it) ? "No hay memoria suficiente para recoger el ítem." : "Este ítem ya fue tomado por otro jugador.");
+        presioneTeclaParaContinuar();
+        return;
+    }
+
+    printf("\nRecogiste: %s\n", it->name);
+    presioneTeclaParaContinuar();
+}
+
+/*
+ * Función: recoger_item
+ * ---------------------
+ * Acción del motor para recoger un ítem concreto, sin interacción con el usuario.
+ *
+ * Parámetros:
+ *  - gs: Estado del jugador que recoge.
+ *  - item: Ítem del escenario actual que se quiere recoger.
+ *
+ * Funcionalidad:
+ *  - Reclama el ítem de forma atómica para gs->jugador.
+ *  - Si el reclamo tiene éxito, agrega una copia al inventario y descuenta 1 de tiempo.
+ *  - Anota la acción para poder deshacerla (ver historial.h).
+ *
+ * Retorno:
+ *  - true si el jugador obtuvo el ítem, false si otro jugador lo reclamó antes o si no
+ *    hubo memoria para agregarlo al inventario (en ese caso el ítem sigue disponible).
+ *
+ * Detalles adicionales:
+ *  - Es segura para jugadores que actúan en hilos distintos sobre el mismo grafo,
+ *    siempre que cada hilo maneje su propio GameState.
+ */
+
+bool recoger_item(GameState* gs, Item* item) {
+    if (!reclamar_item(item, gs->jugador)) return false;
+
+    // Sin memoria para guardarlo, el ítem vuelve al mundo y la acción no cuesta nada
+    Item* copia = item_crear();
+    if (!copia) {
+        soltar_item(item, gs->jugador);
+        return false;
+    }
+    // Campo por campo: 'dueno' lo pueden estar comparando otros jugadores en este momento
+    copia->name = item->name;
+    copia->weight = item->weight;
+    copia->value = item->value;
+    atomic_init(&copia->dueno, gs->jugador);
+    ListNode* anterior = gs->inventory->tail;
+    list_pushBack(gs->inventory, copia);
+    if (gs->inventory->tail == anterior) {
+        item_liberar(copia);
+        soltar_item(item, gs->jugador);
+        return false;
+    }
+    historial_recoger(gs, item, gs->inventory->tail, anterior);
+    gs->tiempoRestante -= 1;
+    gs->turnos++;
+    return true;
+}
+
+/*
+ * Función: item_en_posicion
+ * -------------------------
+ * Retorna el ítem que ocupa la posición indicada en la lista, o NULL si no existe.
+ */
+
+static Item* item_en_posicion(List* items, int posicion) {
+    ListNode* ln = items->head;
+    for (int i = 0; ln != NULL && i < posicion; i++) ln = ln->next;
+    return ln ? ln->data : NULL;
+}
+
+/*
+ * Función: item_disponible_en
+ * ---------------------------
+ * Retorna el ítem que nadie ha reclamado en la posición indicada (desde 0, en el orden
+ * en que recoger_items los ofrece), o NULL si no hay tantos.
+ */
+
+Item* item_disponible_en(Node* n, int posicion) {
+    if (posicion < 0) return NULL;
+    for (ListNode* ln = n->state.availableItems->head; ln; ln = ln->next) {
+        if (item_disponible(ln->data) && posicion-- == 0) return ln->data;
+    }
+    return NULL;
+}
+
+/*
+ * Función: descartar_item
+ * -----------------------
+ * Acción del motor para descartar el ítem del inventario en la posición indicada
+ * (desde 0), sin interacción con el usuario. Descuenta 1 de tiempo y anota la acción
+ * (ver historial.h). Retorna false si no hay un ítem en esa posición.
+ */
+
+bool descartar_item(GameState* gs, int posicion) {
+    if (posicion < 0 || posicion >= list_size(gs->inventory)) return false;
+    ListNode* anterior = NULL;
+    for (int i = 0; i < posicion; i++) anterior = anterior ? anterior->next : gs->inventory->head;
+    // El nodo queda en el historial: el ítem se libera cuando ya no se puede deshacer
+    historial_descartar(gs, list_removeAfter(gs->inventory, anterior), anterior);
+    gs->tiempoRestante -= 1;
+    gs->turnos++;
+    return true;
+}
+
+/*
+ * Función: leer_nombre
+ * --------------------
+ * Muestra el mensaje y lee un nombre desde la entrada, sin el salto de línea final.
+ * Retorna false si no se pudo leer o si el nombre quedó vacío.
+ */
+
+static bool leer_nombre(const char* mensaje, char* nombre, int largo) {
+    printf("%s", mensaje);
+    if (!fgets(nombre, largo, stdin)) return false;
+    nombre[strcspn(nombre, "\n")] = '\0';
+    return nombre[0] != '\0';
+}
+
+/*
+ * Función: buscar_item_por_nombre
+ * -------------------------------
+ * Informa en qué escenarios aparece un ítem y si cada ejemplar sigue disponible.
+ *
+ * Parámetros:
+ *  - grafo: Grafo de la partida en curso (con sus índices de nombres).
+ *
+ * Funcionalidad:
+ *  - Solicita el nombre del ítem (sin distinguir mayúsculas).
+ *  - Obtiene sus ubicaciones desde el índice en O(1), sin recorrer el grafo.
+ *  - Para cada ubicación muestra el escenario y si el ítem ya fue recogido.
+ */
+
+void buscar_item_por_nombre(Graph* grafo) {
+    limpiarPantalla();
+    puts("======- Buscar Ítem -======");
+    char nombre[MAXITEMNAME];
+    if (!leer_nombre("Nombre del ítem: ", nombre, MAXITEMNAME)) {
+        puts("Entrada inválida.");
+        presioneTeclaParaContinuar();
+        return;
+    }
+
+    int cantidad;
+    const UbicacionItem* ubicaciones = indice_buscar_item(grafo->indice, nombre, &cantidad);
+    if (cantidad == 0) {
+        printf("No hay ningún ítem llamado \"%s\" en el mapa.\n", nombre);
+    }
+    for (int i = 0; i < cantidad; i++) {
+        Node* n = &grafo->nodes[ubicaciones[i].nodo];
+        Item* it = item_en_posicion(n->state.availableItems, ubicaciones[i].posicion);
+        printf(" - %s (nodo %d): %s\n", nombre_escenario(n), n->state.id,
+               (it && item_disponible(it)) ? "disponible" : "ya fue recogido");
     }
+    presioneTeclaParaContinuar();
+}
+
+/*
+ * Función: saltar_a_escenario
+ * ---------------------------
+ * Comando de depuración que lleva al jugador directamente al escenario indicado por nombre,
+ * sin gastar tiempo. Solo se ofrece cuando el programa se inicia con --debug.
+ *
+ * Parámetros:
+ *  - gs: Estado del jugador que se moverá.
+ *  - grafo: Grafo de la partida en curso (con sus índices de nombres).
+ */
 
-    if (!itemExistente) {
-        puts("Este ítem ya fue tomado por el otro jugador.");
+void saltar_a_escenario(GameState* gs, Graph* grafo) {
+    limpiarPantalla();
+    puts("======- Saltar a Escenario -======");
+    char nombre[MAXNAME];
+    if (!leer_nombre("Nombre del escenario: ", nombre, MAXNAME)) {
+        puts("Entrada inválida.");
         presioneTeclaParaContinuar();
         return;
     }
 
-    Item* copia = malloc(sizeof(Item));
-    *copia = *it;
+    int nodo = indice_buscar_escenario(grafo->indice, nombre);
+    if (nodo < 0) {
+        printf("No existe el escenario \"%s\".\n", nombre);
+    } else {
+        gs->currentNode = &grafo->nodes[nodo];
+        historial_liberar(gs);      // Las acciones anteriores suponían el escenario de antes
+        printf("Saltaste a: %s\n", nombre_escenario(gs->currentNode));
+    }
+    presioneTeclaParaContinuar();
+}
+
+static void describir_accion(const AccionRegistrada* a) {
+    switch (a->tipo) {
+        case ACCION_RECOGER:   printf("recoger %s", a->item->name); break;
+        case ACCION_DESCARTAR: printf("descartar %s", ((Item*)a->nodo->data)->name); break;
+        case ACCION_MOVER:     printf("avanzar por \"%s\"", a->arista->etiqueta); break;
+    }
+}
 
-    list_pushBack(gs->inventory, copia);
+/*
+ * Función: deshacer_o_rehacer
+ * ---------------------------
+ * Muestra la última acción hecha y la última deshecha del jugador, y permite deshacer la
+ * primera o rehacer la segunda (ver historial.h). El tiempo que gastó la acción se
+ * devuelve al deshacerla y se vuelve a descontar al rehacerla.
+ *
+ * Consideraciones:
+ *  - En multijugador, deshacer una recogida deja el ítem disponible para los demás; si
+ *    alguno lo toma, ya no se puede rehacer.
+ */
 
-    // Eliminar el ítem de la lista actual
-    for (Item* current = list_first(n->state.availableItems); current != NULL; current = list_next(n->state.availableItems)) {
-        if (strcmp(current->name, it->name) == 0) {
-            list_popCurrent(n->state.availableItems);
-            break;
-        }
+void deshacer_o_rehacer(GameState* gs) {
+    const AccionRegistrada* porDeshacer = historial_por_deshacer(gs);
+    const AccionRegistrada* porRehacer = historial_por_rehacer(gs);
+    puts("\n--- Deshacer / rehacer ---");
+    if (!porDeshacer && !porRehacer) {
+        puts("No hay acciones para deshacer ni rehacer.");
+        presioneTeclaParaContinuar();
+        return;
     }
 
-    // Si es multijugador, sincronizar con el otro jugador
-    if (esMultijugador && otroJugadorNode != NULL) {
-        for (Item* current = list_first(otroJugadorNode->state.availableItems); current != NULL; current = list_next(otroJugadorNode->state.availableItems)) {
-            if (strcmp(current->name, it->name) == 0) {
-                list_popCurrent(otroJugadorNode->state.availableItems);
-                break;
-            }
+    printf("(1)   Deshacer: ");
+    if (porDeshacer) describir_accion(porDeshacer);
+    else             printf("(nada)");
+    printf("\n(2)   Rehacer: ");
+    if (porRehacer) describir_accion(porRehacer);
+    else            printf("(nada)");
+    printf("\nIngrese una opción (0 para cancelar): ");
+
+    char buf[MAXOPTION];
+    if (!fgets(buf, MAXOPTION, stdin)) {
+        puts("Error de lectura.");
+        return;
+    }
+    int opcion = atoi(buf);
+    if (opcion == 1 && porDeshacer) {
+        printf("Deshiciste: ");
+        describir_accion(porDeshacer);
+        deshacer_accion(gs);
+        printf(". Tiempo restante: %d\n", gs->tiempoRestante);
+    } else if (opcion == 2 && porRehacer) {
+        const AccionRegistrada accion = *porRehacer;
+        if (rehacer_accion(gs)) {
+            printf("Rehiciste: ");
+            describir_accion(&accion);
+            printf(". Tiempo restante: %d\n", gs->tiempoRestante);
+        } else {
+            printf("Otro jugador tomó %s: ya no se puede rehacer.\n", accion.item->name);
         }
+    } else if (opcion != 0) {
+        puts("Selección inválida.");
     }
-
-    printf("\nRecogiste: %s\n", copia->name);
-    gs->tiempoRestante -= 1;
     presioneTeclaParaContinuar();
 }
 
@@ -447,7 +917,8 @@ void recoger_items(GameState* gs, bool esMultijugador, Node* otroJugadorNode) {
  *
  * Funcionalidad:
  *  - Si indicador es 1, limpia pantalla y muestra encabezado de la sección.
- *  - Muestra la lista de ítems actuales en el inventario con un índice numérico.
+ *  - Muestra la lista de ítems actuales en el inventario con un índice numérico, marcando
+ *    con '*' los que conviene soltar según aconsejar_items (ver consejo.h).
  *  - Solicita al usuario el número correspondiente al ítem a descartar.
  *  - Si el usuario ingresa 0, cancela la acción sin cambios.
  *  - Valida la selección y, si es válida, elimina el ítem del inventario y descuenta 1 unidad del tiempo restante.
@@ -469,10 +940,16 @@ void descartar_items(GameState* gs, int indicador) {
         return;
     }
     else{
+        Consejo consejo;
+        bool hayConsejo = aconsejar_items(gs, &consejo);
         printf("Ítems en tu inventario:\n");
         int index = 1;
-        for (Item* it = list_first(gs->inventory); it; it = list_next(gs->inventory))
-            printf("(%d) %s (valor %d, peso %d)\n", index++, it->name, it->value, it->weight);
+        for (Item* it = list_first(gs->inventory); it; it = list_next(gs->inventory), index++) {
+            bool soltar = false;
+            for (int k = 0; hayConsejo && k < consejo.numDescartar; k++) soltar |= consejo.descartar[k] == index - 1;
+            printf("(%d) %s (valor %d, peso %d)%s\n", index, it->name, it->value, it->weight, soltar ? " *" : "");
+        }
+        if (hayConsejo && consejo.numDescartar > 0) puts("Sugerencia: descarta los marcados con '*' para llegar al final con más puntaje.");
 
         printf("Ingrese el número del ítem a descartar (0 para cancelar): ");
         char buf[MAXOPTION];
@@ -484,20 +961,45 @@ void descartar_items(GameState* gs, int indicador) {
         int seleccion = atoi(buf);
         if (seleccion == 0) return;
 
-        int actual = 1;
-        for (Item* it = list_first(gs->inventory); it; it = list_next(gs->inventory), actual++) {
-            if (actual == seleccion) {
-                printf("Descartaste: %s\n", it->name);
-                list_popCurrent(gs->inventory); // Elimina el ítem actual
-                gs->tiempoRestante -= 1;
-                return;
-            }
+        Item* it = seleccion > 0 ? item_en_posicion(gs->inventory, seleccion - 1) : NULL;
+        if (it) {
+            printf("Descartaste: %s\n", it->name);
+            descartar_item(gs, seleccion - 1);
+            return;
         }
 
         puts("Selección inválida.");
     }
 }
 
+/*
+ * Función: anotar_puntaje
+ * -----------------------
+ * Pide el nombre del jugador, anota la partida en la tabla de posiciones (ver puntajes.h)
+ * y muestra los mejores puntajes del mapa, marcando el recién anotado. No hace nada si
+ * no hay tabla o si el jugador lo controla la computadora.
+ */
+
+static void anotar_puntaje(GameState* gs) {
+    if (!puntajes_activos() || gs->automatico) return;
+
+    char nombre[MAXOPTION];     // Se recorta al anotarlo
+    if (!leer_nombre("\nNombre para la tabla de posiciones (ENTER para no anotarlo): ", nombre, MAXOPTION)) {
+        puts("No se anotó el puntaje.");
+        return;
+    }
+    int posicion = puntajes_anotar(gs->grafo->huella, nombre, calcular_puntaje(gs), gs->tiempoRestante, gs->turnos);
+
+    int cantidad;
+    const RegistroPuntaje* mejores = puntajes_mejores(gs->grafo->huella, &cantidad);
+    printf("\n--- Mejores puntajes de este mapa ---\n");
+    for (int i = 0; i < cantidad; i++) {
+        printf("%s%2d. %-*s %6d puntos  tiempo %3d  turnos %3d\n", i + 1 == posicion ? "->" : "  ", i + 1,
+               MAXNOMBREPUNTAJE - 1, mejores[i].nombre, mejores[i].puntaje, mejores[i].tiempoRestante, mejores[i].turnos);
+    }
+    if (posicion == 0) printf("Tu puntaje no entró entre los %d mejores.\n", TOPPUNTAJES);
+}
+
 /*
  * Función: mostrar_puntaje_final
  * ------------------------------
@@ -507,18 +1009,31 @@ void descartar_items(GameState* gs, int indicador) {
  *  - gs: Puntero a la estructura GameState del jugador.
  *
  * Funcionalidad:
- *  - Recorre el inventario sumando el valor de cada ítem.
- *  - Imprime los ítems y el puntaje total acumulado.
+ *  - Imprime los ítems del inventario y el puntaje total (ver calcular_puntaje).
+ *  - Anota la partida en la tabla de posiciones, si hay una abierta (ver anotar_puntaje).
  */
 
 void mostrar_puntaje_final(GameState* gs) {
-    int puntaje_total = 0;
     printf("\n--- Inventario final ---\n");
     for (Item* item = list_first(gs->inventory); item != NULL; item = list_next(gs->inventory)) {
         printf(" - %s (valor: %d)\n", item->name, item->value);
+    }
+    printf("Puntaje total: %d\n", calcular_puntaje(gs));
+    anotar_puntaje(gs);
+}
+
+/*
+ * Función: calcular_puntaje
+ * -------------------------
+ * Retorna la suma de los valores de los ítems del inventario del jugador.
+ */
+
+int calcular_puntaje(GameState* gs) {
+    int puntaje_total = 0;
+    for (Item* item = list_first(gs->inventory); item != NULL; item = list_next(gs->inventory)) {
         puntaje_total += item->value;
     }
-    printf("Puntaje total: %d\n", puntaje_total);
+    return puntaje_total;
 }
 
 /*
@@ -535,22 +1050,26 @@ void mostrar_puntaje_final(GameState* gs) {
  *  - Muestra la descripción y nombre del escenario actual (nodo en el grafo).
  *  - Muestra el tiempo restante disponible para el jugador.
  *  - Lista los ítems que el jugador tiene en su inventario, o informa si está vacío.
- *  - Lista los ítems disponibles para recoger en el nodo actual, o informa si no hay ninguno.
+ *  - Lista los ítems del nodo actual que nadie ha reclamado, o informa si no hay ninguno.
  *
  * Propósito:
  *  - Permitir al jugador evaluar su situación actual y recursos antes de decidir su siguiente acción.
  */
 
 
-void mostrar_estado_actual(GameState* gs, int indicador) {
+static void mostrar_estado(GameState* gs, int indicador) {
     Node* n = gs->currentNode;
     if (indicador == 1){
         limpiarPantalla();
         puts("=======- Partida en Curso -=======");
     }
-    printf("Escenario: %s\n", n->state.name);
-    printf("\nDescripción %s\n", n->state.description);
+    printf("Escenario: %s\n", nombre_escenario(n));
+    printf("\nDescripción %s\n", descripcion_escenario(n));
     printf("Tiempo restante: %d\n", gs->tiempoRestante);
+    if (gs->grafo->plano) {
+        puts("");
+        mostrar_minimapa(gs->grafo, n, RADIOMINIMAPA);
+    }
 
     if (list_size(gs->inventory) == 0) puts("\nTu inventario está vacío.");
     else    {
@@ -561,10 +1080,16 @@ void mostrar_estado_actual(GameState* gs, int indicador) {
         // printf("\n");
     }
 
-    if (list_size(n->state.availableItems) == 0) puts("\nNo hay ítems disponibles aquí.\n");
+    int disponibles = 0;
+    for (ListNode* ln = n->state.availableItems->head; ln; ln = ln->next)
+        if (item_disponible(ln->data)) disponibles++;
+
+    if (disponibles == 0) puts("\nNo hay ítems disponibles aquí.\n");
     else    {
         printf("\nÍtems disponibles aquí:\n");
-        for (Item* it = list_first(n->state.availableItems); it; it = list_next(n->state.availableItems)){
+        for (ListNode* ln = n->state.availableItems->head; ln; ln = ln->next){
+            Item* it = ln->data;
+            if (!item_disponible(it)) continue;
             printf(" - %s (valor %d, peso %d)\n", it->name, it->value, it->weight);
         }
         printf("\n");
@@ -572,6 +1097,12 @@ void mostrar_estado_actual(GameState* gs, int indicador) {
     }
 }
 
+void mostrar_estado_actual(GameState* gs, int indicador) {
+    MEDIR_INICIO(inicio);
+    mostrar_estado(gs, indicador);
+    MEDIR_FIN(inicio, MET_RENDER_ESTADO);
+}
+
 /*
  * Función: moverse
  * ----------------
@@ -582,7 +1113,8 @@ void mostrar_estado_actual(GameState* gs, int indicador) {
  *        el inventario y el tiempo restante.
  *
  * Funcionalidad:
- *  - Muestra las direcciones disponibles (Norte, Este, Sur, Oeste) hacia nodos adyacentes.
+ *  - Muestra las aristas que salen del nodo actual: las direcciones cardinales (1-4) y
+ *    las aristas extendidas del mapa (5 en adelante), con su costo extra si lo tienen.
  *  - Solicita al jugador elegir una dirección válida para moverse.
  *  - Calcula el costo de tiempo para moverse, que depende del peso total de los ítems en el inventario.
  *  - Actualiza la posición actual del jugador y decrementa el tiempo restante según el gasto calculado.
@@ -597,38 +1129,83 @@ void mostrar_estado_actual(GameState* gs, int indicador) {
  *
  * Detalles adicionales:
  *  - Utiliza funciones auxiliares como limpiarPantalla, mostrar_puntaje_final, list_first y list_next.
- *  - El gasto de tiempo se calcula como (pesoTotalInventario + 10) / 10, asegurando un gasto mínimo.
+ *  - El gasto de tiempo es el costo base de la arista más (pesoTotalInventario + 10) / 10,
+ *    asegurando un gasto mínimo de 1.
  */
 
-bool moverse(GameState* gs) {
-    Node* n = gs->currentNode;
+// Número con que se ofrece una arista: las cardinales conservan 1-4 y las extendidas siguen desde 5.
+int opcion_de_arista(const Arista* aristas, int k) {
+    if (aristas[k].direccion >= 0) return aristas[k].direccion + 1;
+    int extendidas = 0;
+    for (int j = 0; j < k; j++) {
+        if (aristas[j].direccion < 0) extendidas++;
+    }
+    return MAXDIR + 1 + extendidas;
+}
+
+/*
+ * Función: arista_por_opcion
+ * --------------------------
+ * Retorna la arista del nodo actual que moverse ofrece con ese número, o NULL si no hay.
+ */
+
+const Arista* arista_por_opcion(const GameState* gs, int opcion) {
+    int numAristas;
+    const Arista* aristas = aristas_de(gs->grafo, gs->currentNode, &numAristas);
+    for (int k = 0; k < numAristas; k++) {
+        if (opcion_de_arista(aristas, k) == opcion) return &aristas[k];
+    }
+    return NULL;
+}
+
+/*
+ * Función: mover_por_arista
+ * -------------------------
+ * Acción del motor para recorrer una arista del nodo actual, sin interacción con el
+ * usuario: lleva al jugador al destino y descuenta el gasto de tiempo, que es el costo
+ * base de la arista más (pesoTotalInventario + 10) / 10. Anota la acción (ver
+ * historial.h) y retorna el gasto.
+ */
+
+int mover_por_arista(GameState* gs, const Arista* arista) {
+    int pesoTotal = 0;
+    for (Item* it = list_first(gs->inventory); it; it = list_next(gs->inventory))
+        pesoTotal += it->weight;
+
+    int gasto = arista->costo + (pesoTotal + 1 + 9) / 10;
+    historial_mover(gs, gs->currentNode, arista, gasto);
+    gs->currentNode = &gs->grafo->nodes[arista->destino];
+    gs->tiempoRestante -= gasto;
+    gs->turnos++;
+    return gasto;
+}
+
+static bool mover(GameState* gs) {
+    int numAristas;
+    const Arista* aristas = aristas_de(gs->grafo, gs->currentNode, &numAristas);
     limpiarPantalla();
     puts("======- Moverse en una dirección -======");
-    const char* dirNames[] = {"Arriba", "Abajo", "Izquierda", "Derecha"};
 
     printf("\nDirecciones disponibles:\n");
-    for (int i = 0; i < 4; i++) {
-        if (n->adjacents[i]) {
-            printf("(%d) %s -> %s\n", i + 1, dirNames[i], n->adjacents[i]->state.name);
-        }
+    int maxOpcion = MAXDIR;
+    for (int k = 0; k < numAristas; k++) {
+        int opcion = opcion_de_arista(aristas, k);
+        if (opcion > maxOpcion) maxOpcion = opcion;
+        printf("(%d) %s -> %s", opcion, aristas[k].etiqueta, nombre_escenario(&gs->grafo->nodes[aristas[k].destino]));
+        if (aristas[k].costo > 0) printf(" (costo extra %d)", aristas[k].costo);
+        printf("\n");
     }
 
     char buf[MAXOPTION];
-    printf("\nElige una dirección (1-4): ");
+    printf("\nElige una dirección (1-%d): ", maxOpcion);
     if (!fgets(buf, MAXOPTION, stdin)) {
         puts("Error de lectura.");
         return false;
     }
 
-    int dir = atoi(buf) - 1;
-    if (dir >= 0 && dir < 4 && n->adjacents[dir]) {
-        int pesoTotal = 0;
-        for (Item* it = list_first(gs->inventory); it; it = list_next(gs->inventory))
-            pesoTotal += it->weight;
-
-        int gasto = (pesoTotal + 1 + 9) / 10;
-        gs->currentNode = n->adjacents[dir];
-        gs->tiempoRestante -= gasto;
+    const Arista* arista = arista_por_opcion(gs, atoi(buf));
+    if (arista) {
+        int gasto = mover_por_arista(gs, arista);
 
         printf("\nTe moviste. Gastaste %d de Tiempo. Tiempo restante: %d\n",
                gasto, gs->tiempoRestante);
@@ -644,19 +1221,49 @@ bool moverse(GameState* gs) {
             mostrar_puntaje_final(gs);
             return true; // Partida terminada
         }
+
+        if (partida_sin_salida(gs)) {
+            puts("\n¡Ya no puedes llegar a ningún final! La partida termina.");
+            mostrar_puntaje_final(gs);
+            return true; // Partida terminada
+        }
     } else {
         puts("Dirección inválida.");
     }
     return false;
 }
 
+bool moverse(GameState* gs) {
+    MEDIR_INICIO(inicio);
+    bool terminada = mover(gs);
+    MEDIR_FIN(inicio, MET_MOVERSE);
+    return terminada;
+}
+
+/*
+ * Función: partida_sin_salida
+ * ---------------------------
+ * Indica si el jugador ya no puede ganar: desde su nodo no hay camino a un final, o el
+ * tiempo restante no alcanza ni siquiera con el inventario vacío.
+ *
+ * Consideraciones:
+ *  - O(1): usa el tiempo mínimo hasta un final precalculado al cargar el mapa (ver alcance.h).
+ *  - La partida se pierde al llegar a 0 de tiempo, así que se necesita estrictamente más
+ *    tiempo que ese mínimo.
+ */
+
+bool partida_sin_salida(const GameState* gs) {
+    int distancia = gs->currentNode->state.distanciaFinal;
+    return distancia < 0 || gs->tiempoRestante <= distancia;
+}
+
 /*
  * Función: mostrar_resultados_finales
  * -----------------------------------
- * Muestra los puntajes finales de ambos jugadores en modo multijugador.
+ * Muestra los puntajes finales de todos los jugadores en modo multijugador.
  *
  * Parámetros:
- *  - gs: Puntero a la estructura GameStateMultiplayer con los estados de ambos jugadores.
+ *  - gs: Puntero a la estructura GameStateMultiplayer con los estados de los jugadores.
  *
  * Funcionalidad:
  *  - Imprime el puntaje de cada jugador.
@@ -665,12 +1272,11 @@ bool moverse(GameState* gs) {
 
 void mostrar_resultados_finales(GameStateMultiplayer* gs) {
     int totalPuntaje = 0;
-    for (int i = 0; i < 2; i++) {
-        Player* p = &gs->jugadores[i];
+    for (int i = 0; i < gs->numJugadores; i++) {
+        int puntaje = calcular_puntaje(&gs->jugadores[i]);
         printf("\nJugador %d:\n", i + 1);
-        printf("Puntaje: %d\n", p->puntaje);
-        // Mostrar ítems
-        totalPuntaje += p->puntaje;
+        printf("Puntaje: %d\n", puntaje);
+        totalPuntaje += puntaje;
     }
     printf("\nPuntaje total colaborativo: %d\n", totalPuntaje);
 }
@@ -688,94 +1294,9 @@ void mostrar_resultados_finales(GameStateMultiplayer* gs) {
  */
 
 void mostrar_estado_jugador_actual(GameStateMultiplayer* gs) {
-    Player* actual = &gs->jugadores[gs->turnoActual];
+    GameState* actual = &gs->jugadores[gs->turnoActual];
     printf("\n== TURNO DEL JUGADOR %d ==\n", gs->turnoActual + 1);
-    printf("Escenario actual: %s\n", actual->currentNode->state.name);
+    printf("Escenario actual: %s\n", nombre_escenario(actual->currentNode));
     printf("Tiempo restante: %d\n", actual->tiempoRestante);
     // Puedes extender esto con el inventario, ítems disponibles, etc.
 }
-
-/*
- * Función: sincronizar_items
- * ---------------------------
- * Sincroniza los ítems disponibles entre dos grafos de juego utilizados por dos jugadores
- * diferentes en una partida multijugador. Garantiza que un ítem recogido por un jugador
- * ya no esté disponible en el grafo del otro jugador.
- *
- * Parámetros:
- *  - grafo1: Puntero al grafo del jugador 1.
- *  - grafo2: Puntero al grafo del jugador 2.
- *  - jugador1: Estado del jugador 1 (incluye su inventario).
- *  - jugador2: Estado del jugador 2 (incluye su inventario).
- *
- * Funcionalidad:
- *  - Recorre todos los nodos del grafo2.
- *  - En cada nodo, elimina los ítems que ya están en el inventario del jugador1.
- *  - Luego, recorre todos los nodos del grafo1.
- *  - En cada nodo, elimina los ítems que ya están en el inventario del jugador2.
- *
- * Detalles adicionales:
- *  - Utiliza `list_first`, `list_next`, `list_popCurrent` y `list_current` para recorrer
- *    y modificar las listas de ítems disponibles en cada nodo.
- *  - La comparación de ítems se realiza por nombre (`strcmp`).
- *  - Se evita modificar la lista mientras se recorre con índices, usando punteros
- *    para mantener correctamente la posición tras eliminar un elemento.
- */
-
- void sincronizar_items(Graph* grafo1, Graph* grafo2, GameState* jugador1, GameState* jugador2){
-    // Eliminar del grafo2 los ítems que el jugador1 ya recogió
-    for (int i = 0; i < grafo2->numberOfNodes; i++) {
-        List* itemsNodo = grafo2->nodes[i].state.availableItems;
-        if (!itemsNodo) continue;
-
-        Item* itemNodo = (Item*) list_first(itemsNodo);
-        while (itemNodo) {
-            bool encontrado = false;
-
-            // Buscar si este ítem está en el inventario del jugador1
-            Item* itemInv = (Item*) list_first(jugador1->inventory);
-            while (itemInv) {
-                if (strcmp(itemNodo->name, itemInv->name) == 0) {
-                    encontrado = true;
-                    break;
-                }
-                itemInv = (Item*) list_next(jugador1->inventory);
-            }
-
-            if (encontrado) {
-                list_popCurrent(itemsNodo);
-                itemNodo = (Item*) list_current(itemsNodo);  // Ya está en la posición correcta
-            } else {
-                itemNodo = (Item*) list_next(itemsNodo);
-            }
-        }
-    }
-
-    // Eliminar del grafo1 los ítems que el jugador2 ya recogió
-    for (int i = 0; i < grafo1->numberOfNodes; i++) {
-        List* itemsNodo = grafo1->nodes[i].state.availableItems;
-        if (!itemsNodo) continue;
-
-        Item* itemNodo = (Item*) list_first(itemsNodo);
-        while (itemNodo) {
-            bool encontrado = false;
-
-            // Buscar si este ítem está en el inventario del jugador2
-            Item* itemInv = (Item*) list_first(jugador2->inventory);
-            while (itemInv) {
-                if (strcmp(itemNodo->name, itemInv->name) == 0) {
-                    encontrado = true;
-                    break;
-                }
-                itemInv = (Item*) list_next(jugador2->inventory);
-            }
-
-            if (encontrado) {
-                list_popCurrent(itemsNodo);
-                itemNodo = (Item*) list_current(itemsNodo);
-            } else {
-                itemNodo = (Item*) list_next(itemsNodo);
-            }
-        }
-    }
-}
\ No newline at end of file
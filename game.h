@@ -3,40 +3,69 @@
 #define GAME_H
 
 #define MAXOPTION 256
+#define MAXJUGADORES 512
+#define TIEMPOINICIAL 10        // Tiempo con que comienza cada jugador
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "historial.h"
 
 typedef struct List List;
 typedef struct Node Node;
 typedef struct Graph Graph;
+typedef struct Item Item;
+typedef struct Arista Arista;
 
-typedef struct {
-    List* inventory;
-    int tiempoRestante;
-    Node* currentNode;
-    int puntaje;
-} Player;
-
-typedef struct {
+typedef struct GameState {
     List* inventory;    // inventario único del jugador
     int tiempoRestante; // tiempo que le queda al jugador
     Node* currentNode;  // escenario actual
+    Graph* grafo;       // mundo en el que juega (sus aristas definen los movimientos)
+    int jugador;        // identificador del jugador (dueño de los ítems que reclama)
+    bool automatico;    // lo controla la computadora (ver bot.h)
+    Historial historial;// acciones que se pueden deshacer y rehacer (ver historial.h)
+    int turnos;         // acciones hechas (recoger, descartar, avanzar), sin las deshechas
 } GameState;
 
 typedef struct {
-    Player jugadores[2];
-    Graph* grafo;
-    int turnoActual;
+    GameState* jugadores;   // arreglo con el estado de cada jugador
+    int numJugadores;       // cantidad de jugadores en la partida
+    Graph* grafo;           // único grafo compartido por todos los jugadores
+    int turnoActual;        // índice del jugador que tiene el turno
 } GameStateMultiplayer;
 
 char readOption(char reading[MAXOPTION], int maxOpciones);
 
 void iniciar_partida(Graph* grafo);
 
-void iniciar_partida_multijugador(Graph* grafo);
+// 'automaticos' indica qué jugadores controla la computadora (NULL: ninguno).
+void iniciar_partida_multijugador(Graph* grafo, int numJugadores, const bool* automaticos);
+
+GameStateMultiplayer* crear_partida_compartida(Graph* grafo, int numJugadores);
+
+void liberar_partida_compartida(GameStateMultiplayer* partida);
+
+// Libera el inventario y el historial del jugador.
+void liberar_jugador(GameState* gs);
+
+void recoger_items(GameState* gs);
+
+bool recoger_item(GameState* gs, Item* item);
+
+Item* item_disponible_en(Node* n, int posicion);
 
-void recoger_items(GameState* gs, bool esMultijugador, Node* otroJugadorNode);
+bool descartar_item(GameState* gs, int posicion);
+
+const Arista* arista_por_opcion(const GameState* gs, int opcion);
+
+// Número con que "Moverse" ofrece la arista k del arreglo de aristas de un escenario.
+int opcion_de_arista(const Arista* aristas, int k);
+
+int mover_por_arista(GameState* gs, const Arista* arista);
+
+bool jugador_terminado(const GameState* gs);
+
+int calcular_puntaje(GameState* gs);
 
 void descartar_items(GameState* gs, int indicador);
 
@@ -46,18 +75,27 @@ void mostrar_estado_actual(GameState* gs, int indicador);
 
 bool moverse(GameState* gs);
 
-void iniciar_partida_multijugador(Graph* grafo);
+bool partida_sin_salida(const GameState* gs);
 
 void mostrar_resultados_finales(GameStateMultiplayer* gs);
 
 void mostrar_estado_jugador_actual(GameStateMultiplayer* gs);
 
-void sincronizar_items(Graph* grafo1, Graph* grafo2, GameState* jugador1, GameState* jugador2);
+void buscar_item_por_nombre(Graph* grafo);
+
+void saltar_a_escenario(GameState* gs, Graph* grafo);
+
+void deshacer_o_rehacer(GameState* gs);
 
 void showPrincipalOptions();
 
 void showGameOptions();
 
+int cantidadOpcionesJuego();
+
+// Habilita comandos de depuración en la partida (se activa con --debug).
+extern bool modoDepuracion;
+
 
 
 #endif // GAME_H
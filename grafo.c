@@ -2,6 +2,15 @@
 #include "extra.h"
 #include "list.h"
 #include "game.h"
+#include "indice.h"
+#include "validador.h"
+#include "cadenas.h"
+#include "metricas.h"
+#include "memoria.h"
+#include "objetos.h"
+#include "plano.h"
+#include "consejo.h"
+#include "catalogo.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,187 +19,487 @@
 #include <ctype.h>
 
 Graph graph;
+const char* const nombresDirecciones[MAXDIR] = {"Arriba", "Abajo", "Izquierda", "Derecha"};
+OpcionesCarga opcionesCarga = { .estricto = false, .descripcionesDiferidas = false, .nombresDiferidos = false,
+                                .comprimirDescripciones = false, .orden = ORDEN_ARCHIVO,
+                                .silencioso = false };
+
+/*
+ * cargar_texto
+ * ------------
+ * Registra un campo de texto del CSV (recortado a 'maximo' - 1 bytes): siempre su posición
+ * y largo dentro del archivo y, si se indica un pool, además su copia única en ese pool.
+ * Sin pool, el texto queda diferido y se leerá desde el archivo al mostrarse.
+ * Retorna false si no hubo memoria para copiarlo.
+ */
+
+static bool cargar_texto(Texto* texto, const char* campo, const InfoLineaCsv* info, PoolCadenas* pool, int maximo) {
+    size_t largo = strlen(campo);
+    if (largo > (size_t)maximo - 1) largo = (size_t)maximo - 1;
+
+    texto->largo = (int)largo;
+    texto->desplazamiento = info->desplazamiento + (long)(campo - info->linea);
+    texto->comprimido = false;
+    texto->cadena = pool ? pool_agregar(pool, campo, largo) : NULL;
+    return !pool || texto->cadena;
+}
+
+/*
+ * comprimir_descripciones
+ * -----------------------
+ * Entrena un diccionario con las descripciones cargadas (que todavía están en un pool
+ * temporal) y reemplaza cada una por su versión comprimida, guardada sin repetidos en
+ * el pool del grafo. El diccionario queda en la fuente de textos del grafo, que es
+ * quien las descomprime al mostrarlas. Si no hay memoria para el diccionario, las
+ * descripciones se copian sin comprimir y retorna false.
+ */
+
+static bool comprimir_descripciones(Graph* g) {
+    const char** textos = mem_reservar(MEM_GRAFO, sizeof(char*) * g->numberOfNodes);
+    Diccionario* dic = NULL;
+    if (textos) {
+        for (int i = 0; i < g->numberOfNodes; i++) {
+            const char* cadena = g->nodes[i].state.description.cadena;
+            textos[i] = cadena ? cadena : "";
+        }
+        dic = diccionario_entrenar(textos, g->numberOfNodes);
+        mem_liberar(textos);
+    }
+
+    char comprimido[2 * MAXDESC];
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        Texto* t = &g->nodes[i].state.description;
+        if (!t->cadena) continue;
+        if (!dic) {
+            t->cadena = pool_agregar(g->cadenas, t->cadena, (size_t)t->largo);
+            continue;
+        }
+        size_t largo = diccionario_comprimir(dic, t->cadena, (size_t)t->largo, comprimido);
+        t->cadena = pool_agregar(g->cadenas, comprimido, largo);
+        t->largo = (int)largo;
+        t->comprimido = true;
+    }
+
+    if (!dic) return false;
+    g->estadisticas.bytesDiccionario = diccionario_tam(dic);
+    fuente_asignar_diccionario(g->textos, dic);
+    return true;
+}
+
+/*
+ * cargar_aristas
+ * --------------
+ * Arma las aristas del grafo en formato compacto a partir de las ya validadas y resueltas.
+ * Los nodos se numeran en el orden del archivo, así que basta recorrer las filas en orden.
+ * Las etiquetas de las aristas extendidas se completan después, al leer cada fila.
+ * Retorna false si no hay memoria (y deja las aristas en NULL).
+ */
+
+static bool cargar_aristas(Graph* g, const ValidacionMapa* validacion) {
+    g->inicioAristas = mem_reservar(MEM_GRAFO, sizeof(int) * (g->numberOfNodes + 1));
+    g->aristas = mem_reservar(MEM_GRAFO, sizeof(Arista) * (validacion->aristasValidas + 1));
+    g->numAristas = 0;
+    if (!g->inicioAristas || !g->aristas) {
+        mem_liberar(g->inicioAristas);
+        mem_liberar(g->aristas);
+        g->inicioAristas = NULL;
+        g->aristas = NULL;
+        return false;
+    }
+
+    for (int r = 0; r < validacion->numFilas; r++) {
+        const FilaMapa* f = &validacion->filas[r];
+        if (f->nodo < 0) continue;
+        g->inicioAristas[f->nodo] = g->numAristas;
+        for (int k = f->primeraArista; k < f->primeraArista + f->numAristas; k++) {
+            const AristaMapa* a = &validacion->aristas[k];
+            if (a->destino < 0) continue;
+            Arista* arista = &g->aristas[g->numAristas++];
+            arista->destino = a->destino;
+            arista->costo = (short)a->costo;
+            arista->direccion = (short)a->direccion;
+            arista->etiqueta = a->direccion >= 0 ? nombresDirecciones[a->direccion] : "";
+        }
+    }
+    g->inicioAristas[g->numberOfNodes] = g->numAristas;
+    return true;
+}
+
+/*
+ * mostrar_resumen_plano
+ * ---------------------
+ * Informa el tamaño del plano y, si las direcciones no encajan en una grilla, cuántas
+ * aristas quedaron sin dibujar como vecinas.
+ */
+
+static void mostrar_resumen_plano(const Graph* g) {
+    if (!g->plano) return;
+    ResumenPlano r = plano_resumen(g->plano);
+    printf("Plano: %d x %d casillas en %d %s", r.ancho, r.alto, r.islas, r.islas == 1 ? "isla" : "islas");
+    if (r.conflictos > 0) printf(", %d aristas cardinales no encajan en la grilla", r.conflictos);
+    puts(".");
+}
+
+/*
+ * mostrar_resumen_alcance
+ * -----------------------
+ * Informa cuántos escenarios no tienen camino a un final y si el inicio lo tiene.
+ */
+
+static void mostrar_resumen_alcance(const Graph* g) {
+    printf("Alcance: %d componentes fuertemente conexas, %d escenarios sin camino a un final.\n",
+           g->alcance.componentes, g->alcance.sinSalida);
+    if (g->alcance.distanciaInicio < 0) {
+        puts("Advertencia: desde el escenario inicial no se puede llegar a ningún final.");
+    } else {
+        printf("Llegar del inicio a un final cuesta al menos %d de tiempo.\n", g->alcance.distanciaInicio);
+    }
+}
+
+/*
+ * mostrar_estadisticas_textos
+ * ---------------------------
+ * Informa cuánta memoria ocupan los textos cargados en memoria frente a lo que ocuparían
+ * copiados por separado y sin comprimir.
+ */
+
+static void mostrar_estadisticas_textos(const Graph* g) {
+    const EstadisticasCarga* e = &g->estadisticas;
+    if (e->bytesTexto == 0) return;
+    double ahorro = 100.0 * (1.0 - (double)e->bytesTextoGuardados / (double)e->bytesTexto);
+    printf("Textos en memoria: %zu cadenas (%zu distintas), %.1f KB en vez de %.1f KB (ahorro de %.1f KB, %.0f%%).\n",
+           e->cadenas, e->cadenasUnicas, e->bytesTextoGuardados / 1024.0, e->bytesTexto / 1024.0,
+           ((double)e->bytesTexto - (double)e->bytesTextoGuardados) / 1024.0, ahorro);
+    if (e->bytesDiccionario > 0) {
+        printf("Descripciones comprimidas con un diccionario de %.1f KB.\n", e->bytesDiccionario / 1024.0);
+    }
+}
 
 /**
  * leer_escenarios
  * ----------------
- * Carga los datos de los escenarios desde un archivo CSV indicado por el usuario
- * y los almacena en la estructura global 'graph'. Cada fila del archivo representa
- * un nodo del grafo con sus propiedades: nombre, descripción, ítems disponibles,
- * adyacencias y si es un nodo final.
- *
- * Funcionamiento:
- *  - Solicita al usuario el nombre del archivo CSV a cargar.
- *  - Abre el archivo y lee los encabezados.
- *  - Realiza una primera pasada para crear los nodos con sus atributos.
- *  - En una segunda pasada, establece las adyacencias entre nodos (arriba, abajo, etc).
- *  - Informa cuántos escenarios fueron cargados correctamente.
- *
- * Consideraciones:
- *  - Si el archivo no existe o no puede abrirse, muestra un error y no altera el grafo.
- *  - Expande dinámicamente la memoria si hay más nodos que la capacidad inicial.
- *  - Usa listas para representar los ítems en cada nodo.
+ * Solicita al usuario el nombre del archivo CSV, o el número de un mapa ya leído, y lo
+ * deja en la estructura global 'graph' mediante catalogo_cargar (los mapas del catálogo
+ * no se vuelven a leer).
  */
 
 void leer_escenarios() {
     limpiarPantalla();
-    if (graph.nodes != NULL) liberarEscenarios(&graph);
     puts("======== Leer Escenarios ========");
+    catalogo_mostrar();
     char nombreArchivo[100];
-    printf("Ingrese el nombre del archivo CSV (ej: graphquest.csv): ");
+    if (catalogo_cantidad() > 0) printf("Ingrese el nombre del archivo CSV o el número de un mapa del catálogo: ");
+    else printf("Ingrese el nombre del archivo CSV (ej: graphquest.csv): ");
     fgets(nombreArchivo, sizeof(nombreArchivo), stdin);
     nombreArchivo[strcspn(nombreArchivo, "\n")] = 0;
 
-    FILE *archivo = fopen(nombreArchivo, "r");
-    if (archivo == NULL) {
-        printf("No se pudo abrir el archivo \"%s\".\n", nombreArchivo);
-        perror("Error");
+    int numero;
+    const char* ruta = nombreArchivo;
+    if (texto_a_entero(nombreArchivo, &numero) && catalogo_ruta(numero - 1)) ruta = catalogo_ruta(numero - 1);
+
+    MEDIR_INICIO(inicio);
+    catalogo_cargar(ruta);
+    MEDIR_FIN(inicio, MET_LEER_ESCENARIOS);
+}
+
+// Avisos de la carga: no impiden usar el mapa y no se muestran en una carga silenciosa.
+static void advertir(const OpcionesCarga* opciones, const char* mensaje) {
+    if (!opciones->silencioso) printf("Advertencia: %s\n", mensaje);
+}
+
+/*
+ * liberar_mapa_incompleto
+ * -----------------------
+ * Libera un grafo que construir_mapa dejó a medio armar (con nodos o sin ellos).
+ */
+
+static void liberar_mapa_incompleto(Graph* g) {
+    if (g->nodes) {
+        liberarEscenarios(g);
         return;
     }
+    fuente_cerrar(g->textos);
+    pool_liberar(g->cadenas);
+}
 
-    size_t contadorEscenarios = 0;
-    char **campos;
-    int capacidad = 100; 
-    graph.nodes = malloc(sizeof(Node) * capacidad);
-    graph.numberOfNodes = 0;
+/*
+ * construir_mapa
+ * --------------
+ * Arma en 'g' (vacío) los nodos, textos, aristas e ítems del mapa ya validado, leyendo
+ * el archivo de nuevo desde el comienzo. Si las descripciones se van a comprimir, deja
+ * en *temporal el pool en que quedaron. Retorna false si falta memoria; lo ya armado
+ * queda en 'g' para que quien llama lo libere.
+ */
 
-    campos = leer_linea_csv(archivo, ','); 
+static bool construir_mapa(Graph* g, FILE* archivo, const ValidacionMapa* validacion, const char* nombreArchivo,
+                           const OpcionesCarga* opciones, PoolCadenas** temporal) {
+    // Nodos en cero: si falta memoria a mitad de camino, los que no se llenaron no tienen listas
+    g->capacidad = validacion->numNodos;
+    g->nodes = mem_reservar_ceros(MEM_GRAFO, (size_t)g->capacidad, sizeof(Node));
+    if (!g->nodes) return false;
+    g->numberOfNodes = validacion->numNodos;
+
+    // Textos en memoria: un pool sin repetidos. Las descripciones a comprimir pasan antes
+    // por un pool temporal, del que se entrena el diccionario.
+    g->cadenas = pool_crear();
+    g->textos = fuente_crear();
+    if (!g->cadenas || !g->textos) return false;
+    PoolCadenas* poolNombres = g->cadenas;
+    PoolCadenas* poolDescripciones = g->cadenas;
+    if (opciones->comprimirDescripciones && !opciones->descripcionesDiferidas) {
+        *temporal = pool_crear();
+        if (*temporal) poolDescripciones = *temporal;
+    }
 
-    // Primera pasada: leer nodos
-    while ((campos = leer_linea_csv(archivo, ',')) != NULL) {
-        if (graph.numberOfNodes >= capacidad) {
-            capacidad *= 2;
-            graph.nodes = realloc(graph.nodes, sizeof(Node) * capacidad);
+    // Textos diferidos: se guarda solo su posición en el archivo, que queda abierto
+    if (opciones->descripcionesDiferidas || opciones->nombresDiferidos) {
+        if (!fuente_abrir(g->textos, nombreArchivo, opciones->copiarArchivo)) {
+            advertir(opciones, "no se pudo abrir el archivo; los textos se cargarán en memoria.");
+        } else {
+            if (opciones->descripcionesDiferidas) poolDescripciones = NULL;
+            if (opciones->nombresDiferidos) poolNombres = NULL;
         }
+    }
 
-        int id = atoi(campos[0]);
-        Node *node = &graph.nodes[id - 1];
-        graph.numberOfNodes++;
-        contadorEscenarios++;
+    if (!cargar_aristas(g, validacion)) return false;
 
-        
-        strncpy(node->state.name, campos[1], MAXNAME);
-        strncpy(node->state.description, campos[2], MAXDESC);
-        node->state.availableItems = list_create();
-        node->state.playerInventory = list_create();
-        node->state.tiempoRestante = 0;
+    char **campos;
+    InfoLineaCsv info;
 
-        
-        List* items = split_string(campos[3], ";");
-        for (char *item = list_first(items); item != NULL; item = list_next(items)) {
-            List *values = split_string(item, ",");
-            if (values == NULL || list_size(values) < 3) continue;
-
-            Item *newItem = malloc(sizeof(Item));
-            strncpy(newItem->name, list_first(values), MAXITEMNAME - 1);
-            newItem->name[MAXITEMNAME - 1] = '\0';
-            newItem->value = atoi(list_next(values));
-            newItem->weight = atoi(list_next(values));
-
-            list_pushBack(node->state.availableItems, newItem);
-            list_clean(values);
-            free(values);
-        }
-        list_clean(items);
-        free(items);
+    rewind(archivo);
+    leer_linea_csv(archivo, ',', NULL);
 
-        
-        char *es_final = campos[8];
-        for (int i = 0; es_final[i]; i++) es_final[i] = tolower(es_final[i]);
-        node->state.esFinal = (strncmp(es_final, "sí", 2) == 0 || strncmp(es_final, "si", 2) == 0);
+    for (int fila = 0; fila < validacion->numFilas && (campos = leer_linea_csv(archivo, ',', &info)) != NULL; fila++) {
+        const FilaMapa* datos = &validacion->filas[fila];
+        if (datos->nodo < 0) continue;
 
-        
-        node->adjacents = calloc(4, sizeof(Node*));
-    }
+        Node *node = &g->nodes[datos->nodo];
+        node->state.id = datos->id;
 
-    // Segunda pasada: establecer adyacencias
-    rewind(archivo);
-    leer_linea_csv(archivo, ',');
-    int idx = 0;
-    while ((campos = leer_linea_csv(archivo, ',')) != NULL) {
-        Node *node = &graph.nodes[idx++];
-
-        int arriba    = atoi(campos[4]);
-        int abajo     = atoi(campos[5]);
-        int izquierda = atoi(campos[6]);
-        int derecha   = atoi(campos[7]);
-
-        if (arriba != -1)    node->adjacents[0] = &graph.nodes[arriba - 1];
-        if (abajo != -1)     node->adjacents[1] = &graph.nodes[abajo - 1];
-        if (izquierda != -1) node->adjacents[2] = &graph.nodes[izquierda - 1];
-        if (derecha != -1)   node->adjacents[3] = &graph.nodes[derecha - 1];
-    }
+        node->state.fuente = g->textos;
+        node->state.availableItems = lista_items_crear();
+        node->state.playerInventory = lista_items_crear();
+        node->state.tiempoRestante = 0;
+        if (!cargar_texto(&node->state.name, campos[1], &info, poolNombres, MAXNAME) ||
+            !cargar_texto(&node->state.description, campos[2], &info, poolDescripciones, MAXDESC) ||
+            !node->state.availableItems || !node->state.playerInventory) {
+            return false;
+        }
 
-    // Después de cargar todos los nodos y sus adyacencias:
-    if (graph.numberOfNodes > 0) {
-        graph.start = &graph.nodes[0];
-    } else {
-        graph.start = NULL;
+        
+        // Ítems leídos directamente del campo, sin copias intermedias
+        const char* cursor = campos[3];
+        ItemCsv leido;
+        while (leer_item_csv(&cursor, &leido)) {
+            if (leido.estado != ITEM_CSV_VALIDO) continue;   // Ya reportado por la validación
+
+            size_t largoNombre = leido.largoNombre;
+            if (largoNombre > MAXITEMNAME - 1) largoNombre = MAXITEMNAME - 1;
+
+            Item *newItem = item_crear();
+            if (!newItem) return false;
+            newItem->name = pool_agregar(g->cadenas, leido.nombre, largoNombre);
+            newItem->value = leido.valor;
+            newItem->weight = leido.peso;
+            atomic_init(&newItem->dueno, ITEM_LIBRE);
+
+            int antes = list_size(node->state.availableItems);
+            if (newItem->name) list_pushBack(node->state.availableItems, newItem);
+            if (list_size(node->state.availableItems) == antes) {
+                item_liberar(newItem);
+                return false;
+            }
+        }
+
+        node->state.esFinal = datos->esFinal;
+
+        // Etiquetas de las aristas extendidas (las cardinales ya la tienen)
+        int siguiente = g->inicioAristas[datos->nodo];
+        for (int k = datos->primeraArista; k < datos->primeraArista + datos->numAristas; k++) {
+            const AristaMapa* a = &validacion->aristas[k];
+            if (a->destino < 0) continue;
+            if (a->direccion < 0) {
+                const char* etiqueta = pool_agregar(g->cadenas, campos[CAMPOARISTAS] + a->inicioEtiqueta,
+                                                    (size_t)a->largoEtiqueta);
+                g->aristas[siguiente].etiqueta = etiqueta ? etiqueta : "";
+            }
+            siguiente++;
+        }
     }
 
-    fclose(archivo);
-    printf("\nSe cargaron %zu escenarios desde \"%s\" correctamente.\n", contadorEscenarios, nombreArchivo);
+    g->start = &g->nodes[validacion->inicio];
+    return true;
 }
 
 /**
- * mostrar_grafo
- * --------------
- * Muestra por consola todos los nodos cargados en el grafo, junto con sus atributos.
- * Esta función es útil para depurar, verificar que el archivo se cargó correctamente,
- * o simplemente para mostrar al jugador los escenarios disponibles.
+ * cargar_escenarios
+ * ------------------
+ * Carga los datos de los escenarios desde el archivo CSV indicado y los almacena
+ * en la estructura global 'graph'. Cada fila del archivo representa un nodo del
+ * grafo con sus propiedades: nombre, descripción, ítems disponibles, adyacencias
+ * y si es un nodo final.
+ *
+ * Funcionamiento:
+ *  - Abre el archivo y lo valida completo (ver validar_mapa), mostrando cada problema
+ *    encontrado con su línea y columna.
+ *  - Si el mapa no tiene escenarios válidos, o tiene errores y está activo el modo
+ *    estricto (opciones->estricto), rechaza la carga y conserva el grafo anterior.
+ *    Lo mismo si falta memoria para armar los nodos, textos, aristas o ítems: el mapa
+ *    se arma aparte y solo reemplaza al anterior cuando está completo.
+ *  - En una segunda pasada crea los nodos aceptados con sus atributos y conecta las
+ *    adyacencias ya resueltas por la validación (arriba, abajo, etc).
+ *  - Construye los índices por nombre de escenarios e ítems (ver indice.h).
+ *  - Informa cuántos escenarios fueron cargados y cuánta memoria ocupan sus textos.
+ *
+ * Textos en memoria:
+ *  - Nombres, descripciones y nombres de ítems se guardan en un pool de cadenas del grafo,
+ *    donde los textos repetidos se almacenan una sola vez (ver cadenas.h).
+ *  - Con opciones->comprimirDescripciones, las descripciones además se comprimen con
+ *    un diccionario de palabras frecuentes entrenado con el propio mapa.
  *
- * Para cada nodo, se imprime:
- *  - ID y nombre del nodo.
- *  - Descripción del escenario.
- *  - Lista de ítems disponibles (nombre, valor en puntos, peso en kg).
- *  - Las adyacencias del nodo en cada dirección cardinal.
- *  - Si el nodo representa un escenario final.
+ * Textos diferidos:
+ *  - Con opciones->descripcionesDiferidas (y/o nombresDiferidos) no se copia el texto,
+ *    solo su posición en el archivo, que queda abierto; se materializa al mostrarse
+ *    (ver textos.h). Así la memoria residente de mapas grandes baja a una fracción.
  *
  * Consideraciones:
- *  - Si no se han cargado nodos previamente, muestra una advertencia.
- *  - Usa nombres legibles y un formato limpio para facilitar la lectura.
+ *  - Si el archivo no existe o no puede abrirse, muestra un error y no altera el grafo.
+ *  - Fuera del modo estricto, las filas, aristas o ítems con errores se omiten.
+ *  - El nodo inicial es el escenario de menor ID.
+ *  - Usa listas para representar los ítems en cada nodo.
+ *  - No lee estado global: las opciones llegan por parámetro, y 'reemplazar' (si no es
+ *    NULL) se llama cuando el mapa ya está armado, antes de escribir en 'destino'.
+ *    cargar_escenarios lo usa para pasar el mapa anterior al catálogo.
+ *
+ * Retorna:
+ *  - true si el mapa se cargó, false si se rechazó.
  */
 
-void mostrar_grafo() {
-    limpiarPantalla();
+static bool leer_mapa(Graph* destino, const char* nombreArchivo, const OpcionesCarga* opciones, void (*reemplazar)(void)) {
+    bool silencioso = opciones->silencioso;
+    FILE *archivo = fopen(nombreArchivo, "r");
+    if (archivo == NULL) {
+        if (!silencioso) {
+            printf("No se pudo abrir el archivo \"%s\".\n", nombreArchivo);
+            perror("Error");
+        }
+        return false;
+    }
 
-    if (graph.numberOfNodes == 0){
-        puts("====- Advertencia -====");
-        puts("Debes incluir el archivo .csv con los escenarios!");
-        return;
+    ValidacionMapa* validacion = validar_mapa(archivo);
+    if (validacion == NULL) {
+        if (!silencioso) puts("No hay memoria suficiente para validar el mapa.");
+        fclose(archivo);
+        return false;
+    }
+    if (!silencioso) mostrar_diagnosticos(validacion);
+
+    if (validacion->numNodos == 0 || (opciones->estricto && validacion->errores > 0)) {
+        if (!silencioso) printf("\nNo se cargó \"%s\"%s.\n", nombreArchivo,
+               validacion->numNodos == 0 ? ": no contiene escenarios válidos" : " (modo estricto: el mapa tiene errores)");
+        liberar_validacion(validacion);
+        fclose(archivo);
+        return false;
     }
 
-    const char* direcciones[] = {"Arriba", "Abajo", "Izquierda", "Derecha"};
-    
-    for (int i = 0; i < graph.numberOfNodes; i++) {
-        if (i == 0) { puts("================ Mostrar Escenarios del Grafo ================");  }
-        Node* node = &graph.nodes[i];
-        printf("Nodo        : %d\n", i + 1);
-        printf("Nombre      : '%s'\n", node->state.name);
-        printf("\nDescripción:\n'%s'\n", node->state.description);
-
-        if (list_size(node->state.availableItems) == 0){
-            puts("\nNo hay ítems en este escenario.");
-        } else {
-            printf("\nLista de Ítems disponibles:\n");
-            for (Item* item = list_first(node->state.availableItems); item != NULL; item = list_next(node->state.availableItems)) {
-                printf("    - %s (%d pts, %d kg)\n", item->name, item->value, item->weight);
-            }
-        }
+    // Se arma en un grafo aparte: si falta memoria, se descarta y el mapa vigente no cambia
+    Graph nuevo = { 0 };
+    PoolCadenas* temporal = NULL;
+    bool construido = construir_mapa(&nuevo, archivo, validacion, nombreArchivo, opciones, &temporal);
+    fclose(archivo);
+    if (!construido) {
+        pool_liberar(temporal);
+        liberar_mapa_incompleto(&nuevo);
+        liberar_validacion(validacion);
+        if (!silencioso) printf("\nNo se cargó \"%s\": no hay memoria suficiente.\n", nombreArchivo);
+        return false;
+    }
+    Graph* g = &nuevo;
+
+    // Estadísticas de los textos en memoria (y compresión de descripciones si se pidió)
+    EstadisticasPool pedidos = pool_estadisticas(g->cadenas);
+    EstadisticasPool pedidosTemporal = pool_estadisticas(temporal);
+    g->estadisticas.cadenas = pedidos.cadenas + pedidosTemporal.cadenas;
+    g->estadisticas.bytesTexto = pedidos.bytesPedidos + pedidosTemporal.bytesPedidos;
+    g->estadisticas.bytesDiccionario = 0;
+    if (temporal) {
+        if (!comprimir_descripciones(g)) advertir(opciones, "no hay memoria para el diccionario; las descripciones no se comprimirán.");
+        pool_liberar(temporal);
+    }
+    EstadisticasPool guardados = pool_estadisticas(g->cadenas);
+    g->estadisticas.cadenasUnicas = guardados.unicas;
+    g->estadisticas.bytesTextoGuardados = guardados.bytesGuardados + g->estadisticas.bytesDiccionario;
 
-        printf("\nLista de Nodos Adyacentes:\n");
-        for (int j = 0; j < 4; j++) {
-            if (node->adjacents[j] != NULL) {
-                int id_adyacente = (int)(node->adjacents[j] - graph.nodes) + 1; // calcular ID relativo
-                printf("    %s → Nodo %d\n", direcciones[j], id_adyacente);
-            } else {
-                printf("    %s → Ninguno\n", direcciones[j]);
-            }
-        }
+    g->esCopia = false;
+    if (!reordenar_nodos(g, opciones->orden)) {
+        advertir(opciones, "no hay memoria para reordenar los escenarios; se mantiene el orden del archivo.");
+    }
+    g->indice = indice_construir(g);
+    if (g->indice == NULL) {
+        advertir(opciones, "no se pudo construir el índice de nombres.");
+    }
+    if (!analizar_alcance(g)) {
+        advertir(opciones, "no se pudo analizar el alcance de los escenarios.");
+    }
+    g->plano = plano_construir(g);
+    if (g->plano == NULL) {
+        advertir(opciones, "no se pudo construir el plano del mapa.");
+    }
+    g->ordenItems = orden_items_construir(g);
+    if (g->ordenItems == NULL) {
+        advertir(opciones, "no se pudo construir el índice de ítems.");
+    }
+    g->huella = huella_mapa(g);
+
+    if (reemplazar) reemplazar();       // El mapa ya está armado: recién ahora se libera el anterior
+    *destino = nuevo;
+    g = destino;
+
+    if (!silencioso) {
+        mostrar_estadisticas_textos(g);
+        mostrar_resumen_alcance(g);
+        mostrar_resumen_plano(g);
+        printf("\nSe cargaron %d escenarios desde \"%s\"%s.\n", g->numberOfNodes, nombreArchivo,
+               validacion->errores > 0 ? " (se omitieron las partes con errores)" : " correctamente");
+    }
+    liberar_validacion(validacion);
+    return true;
+}
 
-        printf("\n¿Es final?: %s\n", node->state.esFinal ? "Sí" : "No");
-        puts("===============================================================");
+bool cargar_escenarios(const char* nombreArchivo) {
+    return leer_mapa(&graph, nombreArchivo, &opcionesCarga, catalogo_guardar_actual);  // El anterior pasa al catálogo
+}
+
+/**
+ * cargar_mapa_en
+ * --------------
+ * Igual que cargar_escenarios, pero deja el mapa en 'g' sin tocar el grafo global ni el
+ * catálogo y sin mostrar nada, con las opciones indicadas. No usa ningún estado global,
+ * así que varios hilos pueden leer mapas a la vez (ver recarga.h, torneo.h y libgraphquest.h).
+ */
+
+bool cargar_mapa_en(Graph* g, const char* nombreArchivo, const OpcionesCarga* opciones) {
+    OpcionesCarga silenciosas = *opciones;
+    silenciosas.silencioso = true;
+    return leer_mapa(g, nombreArchivo, &silenciosas, NULL);
+}
+
+// Agrega a 'lista' una copia de 'item'. Retorna false si no hay memoria.
+static bool copiar_item(List* lista, const Item* item) {
+    Item* copia = item_crear();
+    if (!copia) return false;
+    // Campo por campo: 'dueno' lo pueden estar leyendo otros hilos que copian el mismo original
+    copia->name = item->name;
+    copia->weight = item->weight;
+    copia->value = item->value;
+    atomic_init(&copia->dueno, atomic_load_explicit(&item->dueno, memory_order_relaxed));
+    ListNode* anterior = lista->tail;
+    list_pushBack(lista, copia);
+    if (lista->tail == anterior) {
+        item_liberar(copia);
+        return false;
     }
+    return true;
 }
 
 /**
@@ -204,61 +513,76 @@ void mostrar_grafo() {
  *  - Su ID, nombre, descripción, y estado final.
  *  - La lista de ítems disponibles, con copias independientes de cada ítem.
  *  - Se inicializa un inventario vacío.
- *  - Las conexiones (adyacencias) se actualizan tras copiar todos los nodos.
  *
  * Consideraciones:
  *  - El puntero `start` del nuevo grafo apunta al nodo equivalente al original.
  *  - No se copian los jugadores ni estados de partida; solo la estructura base.
+ *  - No modifica el original, así que varios hilos pueden copiarlo a la vez.
+ *  - Los datos de solo lectura (índice de nombres, pool de cadenas, fuente de textos y
+ *    aristas) se comparten con el original,
+ *    por lo que la copia debe liberarse antes que el grafo del que proviene.
  *  - Es responsabilidad del usuario liberar la copia con `liberarEscenarios` al terminar.
+ *  - Retorna NULL si falta memoria para cualquier parte: nunca una copia con ítems de menos.
  */
 
-Graph* copiar_grafo(const Graph* original) {
+static Graph* copiar(const Graph* original) {
     if (!original) return NULL;
 
-    Graph* copia = malloc(sizeof(Graph));
+    Graph* copia = mem_reservar(MEM_GRAFO, sizeof(Graph));
     if (!copia) return NULL;
 
     copia->numberOfNodes = original->numberOfNodes;
     copia->capacidad = original->capacidad;
+    copia->indice = original->indice;   // Los índices usan posiciones, válidas también en la copia
+    copia->textos = original->textos;
+    copia->cadenas = original->cadenas;
+    copia->estadisticas = original->estadisticas;
+    copia->alcance = original->alcance;
+    copia->plano = original->plano;     // También usa posiciones: se comparte
+    copia->ordenItems = original->ordenItems;
+    copia->inicioAristas = original->inicioAristas;   // Las aristas usan índices: se comparten
+    copia->aristas = original->aristas;
+    copia->numAristas = original->numAristas;
+    copia->huella = original->huella;
+    copia->esCopia = true;
+    copia->esEstatico = false;
 
     // Reserva el arreglo de nodos
     if (copia->capacidad <= 0) {
         copia->capacidad = copia->numberOfNodes > 0 ? copia->numberOfNodes : 1;
     }
-    copia->nodes = malloc(sizeof(Node) * copia->capacidad);
+    copia->nodes = mem_reservar(MEM_GRAFO, sizeof(Node) * copia->capacidad);
     if (!copia->nodes) {
-        free(copia);
+        mem_liberar(copia);
         return NULL;
     }
 
     // Copiar cada nodo uno a uno
-    for (int i = 0; i < copia->numberOfNodes; i++) {
+    bool completa = true;
+    for (int i = 0; i < copia->numberOfNodes && completa; i++) {
         // Copiar estructura Node (incluye State)
         copia->nodes[i] = original->nodes[i];
 
-        // 1) Copiar cadenas (opcional, si no están garantizadas independientes)
-        // Normalmente no hace falta porque memcpy copia los arrays estáticos
-
-        // 2) Crear nuevas listas vacías para availableItems y playerInventory
-        copia->nodes[i].state.availableItems = list_create();
-        copia->nodes[i].state.playerInventory = list_create();
-
-        // 3) Copiar items de availableItems (lista de Item*)
-        for (Item* it = list_first(original->nodes[i].state.availableItems);
-             it != NULL;
-             it = list_next(original->nodes[i].state.availableItems)) {
-            Item* nuevoItem = malloc(sizeof(Item));
-            if (nuevoItem) {
-                *nuevoItem = *it;  // copia el contenido de Item
-                list_pushBack(copia->nodes[i].state.availableItems, nuevoItem);
-            }
+        // Crear nuevas listas vacías para availableItems y playerInventory
+        State* estado = &copia->nodes[i].state;
+        estado->availableItems = lista_items_crear();
+        estado->playerInventory = lista_items_crear();
+        completa = estado->availableItems && estado->playerInventory;
+
+        // Copiar items de availableItems (lista de Item*). Se recorren sus nodos sin mover
+        // el cursor: varios hilos pueden copiar el mismo original a la vez (ver torneo.h)
+        List* items = original->nodes[i].state.availableItems;
+        for (ListNode* ln = items ? items->head : NULL; ln != NULL && completa; ln = ln->next) {
+            completa = copiar_item(estado->availableItems, ln->data);
         }
 
-        // No copiamos playerInventory (usualmente vacío al inicio)
-        // Si quieres copiar inventarios, hazlo igual que arriba
-
-        // 4) Reservar espacio para punteros de adyacentes, iniciar en NULL
-        copia->nodes[i].adjacents = calloc(4, sizeof(Node*));
+        // Los nodos que siguen todavía apuntan a las listas del original: no se liberan
+        if (!completa) copia->numberOfNodes = i + 1;
+    }
+    if (!completa) {
+        liberarEscenarios(copia);
+        mem_liberar(copia);
+        return NULL;
     }
 
     // 5) Calcular el nodo start dentro de la copia
@@ -269,20 +593,159 @@ Graph* copiar_grafo(const Graph* original) {
         copia->start = NULL;
     }
 
-    // 6) Asignar punteros adjacentes en copia, apuntando a nodos de la copia
-    for (int i = 0; i < copia->numberOfNodes; i++) {
-        for (int j = 0; j < 4; j++) {
-            if (original->nodes[i].adjacents[j]) {
-                ptrdiff_t adj_offset = original->nodes[i].adjacents[j] - original->nodes;
-                copia->nodes[i].adjacents[j] = &copia->nodes[adj_offset];
-            } else {
-                copia->nodes[i].adjacents[j] = NULL;
-            }
+    return copia;
+}
+
+Graph* copiar_grafo(const Graph* original) {
+    MEDIR_INICIO(inicio);
+    Graph* copia = copiar(original);
+    MEDIR_FIN(inicio, MET_COPIAR_GRAFO);
+    return copia;
+}
+
+/**
+ * aristas_de
+ * -----------
+ * Retorna las aristas que salen del nodo n del grafo g (contiguas en memoria) y deja su
+ * cantidad en *cantidad. Sirve tanto para el grafo original como para sus copias.
+ */
+
+const Arista* aristas_de(const Graph* g, const Node* n, int* cantidad) {
+    int i = (int)(n - g->nodes);
+    *cantidad = g->inicioAristas[i + 1] - g->inicioAristas[i];
+    return g->aristas + g->inicioAristas[i];
+}
+
+/**
+ * huella_mapa
+ * -----------
+ * Resume en 64 bits lo que hace distinto a un mapa al jugarlo: el ID de cada escenario,
+ * si es final, sus ítems (nombre, valor y peso) y sus aristas (ID del destino, costo,
+ * dirección y etiqueta), más el escenario inicial. Sirve para reconocer el mismo mapa
+ * entre ejecuciones (ver puntajes.h).
+ *
+ * Consideraciones:
+ *  - Cada escenario se resume con FNV-1a y los resúmenes se mezclan y suman, así que el
+ *    resultado no depende del orden de los nodos en memoria (--reorder).
+ *  - No lee nombres ni descripciones: funciona igual con textos diferidos o comprimidos.
+ */
+
+static unsigned long long fnv_bytes(unsigned long long h, const void* datos, size_t largo) {
+    const unsigned char* p = datos;
+    for (size_t i = 0; i < largo; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static unsigned long long fnv_entero(unsigned long long h, int valor) {
+    return fnv_bytes(h, &valor, sizeof(valor));
+}
+
+// Finalizador de splitmix64: reparte los bits antes de sumar los resúmenes.
+static unsigned long long mezclar(unsigned long long h) {
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+}
+
+unsigned long long huella_mapa(const Graph* g) {
+    unsigned long long suma = 0;
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        const State* st = &g->nodes[i].state;
+        unsigned long long h = fnv_entero(14695981039346656037ULL, st->id);
+        h = fnv_entero(h, st->esFinal);
+        for (const ListNode* ln = st->availableItems ? st->availableItems->head : NULL; ln; ln = ln->next) {
+            const Item* it = ln->data;
+            h = fnv_bytes(h, it->name, strlen(it->name) + 1);
+            h = fnv_entero(fnv_entero(h, it->value), it->weight);
+        }
+        for (int k = g->inicioAristas ? g->inicioAristas[i] : 0; g->inicioAristas && k < g->inicioAristas[i + 1]; k++) {
+            const Arista* a = &g->aristas[k];
+            h = fnv_entero(h, g->nodes[a->destino].state.id);
+            h = fnv_entero(fnv_entero(h, a->costo), a->direccion);
+            h = fnv_bytes(h, a->etiqueta, strlen(a->etiqueta) + 1);
         }
+        suma += mezclar(h);
     }
+    return mezclar(suma ^ (unsigned long long)(g->start ? g->start->state.id : -1));
+}
 
-    return copia;
+/**
+ * nombre_escenario / descripcion_escenario
+ * -----------------------------------------
+ * Retornan el nombre y la descripción del escenario. Si el texto es diferido, se lee
+ * desde el archivo fuente a través de la caché de textos (ver texto_obtener).
+ */
+
+const char* nombre_escenario(const Node* n) {
+    return texto_obtener(n->state.fuente, &n->state.name);
 }
 
+const char* descripcion_escenario(const Node* n) {
+    return texto_obtener(n->state.fuente, &n->state.description);
+}
 
+/**
+ * reclamar_item
+ * --------------
+ * Intenta asignar el ítem al jugador indicado mediante una operación atómica
+ * compare-and-swap sobre su campo 'dueno'. Es la única forma de sacar un ítem
+ * del mundo compartido, por lo que dos jugadores (humanos o bots, en el mismo
+ * hilo o en hilos distintos) nunca pueden quedarse con el mismo ítem.
+ *
+ * Retorna:
+ *  - true si el jugador ganó el ítem.
+ *  - false si otro jugador lo había reclamado antes.
+ */
+
+bool reclamar_item(Item* item, int jugador) {
+    MEDIR_INICIO(inicio);
+    int esperado = ITEM_LIBRE;
+    bool reclamado = atomic_compare_exchange_strong(&item->dueno, &esperado, jugador);
+    MEDIR_FIN(inicio, MET_RECLAMAR_ITEM);
+    return reclamado;
+}
+
+/**
+ * item_disponible
+ * ----------------
+ * Indica si el ítem sigue libre en el escenario (nadie lo ha reclamado).
+ */
+
+bool item_disponible(Item* item) {
+    return atomic_load(&item->dueno) == ITEM_LIBRE;
+}
+
+/**
+ * soltar_item
+ * -----------
+ * Inverso de reclamar_item: devuelve el ítem al mundo si el dueño es el jugador indicado,
+ * con el mismo compare-and-swap. Desde ese momento los demás jugadores lo ven disponible.
+ */
+
+bool soltar_item(Item* item, int jugador) {
+    int esperado = jugador;
+    return atomic_compare_exchange_strong(&item->dueno, &esperado, ITEM_LIBRE);
+}
+
+/*
+ * Los ítems del mapa, los de cada copia del mundo y los de los inventarios salen de un
+ * pool de objetos: iniciar, reiniciar y terminar partidas reutiliza siempre los mismos
+ * ítems en vez de reservar y liberar uno por uno (ver objetos.h).
+ */
+
+static PoolObjetos poolItems = POOL_OBJETOS("items", Item, MEM_ITEMS);
 
+Item* item_crear(void) {
+    return objeto_reservar(&poolItems);
+}
+
+void item_liberar(void* item) {
+    objeto_liberar(&poolItems, item);
+}
+
+List* lista_items_crear(void) {
+    return list_createWith(item_liberar);
+}
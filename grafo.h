@@ -2,54 +2,152 @@
 #define GRAFO_H
 
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include "textos.h"
+#include "alcance.h"
+#include "orden.h"
 
 #define MAXDESC 1000
 #define MAXITEMNAME 256
 #define MAXDIR 4
 #define MAXNODES 1000
 #define MAXNAME 256
+#define ITEM_LIBRE -1           // Valor de 'dueno' para un ítem que nadie ha reclamado
 
 typedef struct List List;
+typedef struct IndiceNombres IndiceNombres;
+typedef struct PoolCadenas PoolCadenas;
+typedef struct Plano Plano;
+typedef struct OrdenItems OrdenItems;
 
-typedef struct {
-    char    name[MAXITEMNAME];  // Nombre del ítem (ej: "Espada mágica", "Poción curativa")
+typedef struct Item {
+    const char* name;           // Nombre del ítem (ej: "Espada mágica"), guardado en el pool de cadenas del grafo
     int     weight;             // Peso del ítem en kilogramos (afecta capacidad del jugador)
     int     value;              // Valor del ítem en puntos (relevante para el puntaje del jugador)
+    _Atomic int dueno;          // Jugador que reclamó el ítem (ITEM_LIBRE si sigue disponible)
 } Item;
 
 typedef struct State {
-    char    name[MAXNAME];         // Nombre del escenario (ej: "Bosque encantado")
-    char    description[MAXDESC];  // Descripción narrativa del escenario (se muestra al jugador)
+    int     id;                    // ID del escenario en el archivo CSV
+    Texto   name;                  // Nombre del escenario (ej: "Bosque encantado"), ver nombre_escenario
+    Texto   description;           // Descripción narrativa del escenario, ver descripcion_escenario
+    const FuenteTexto* fuente;     // Archivo del que se leen los textos diferidos (NULL si no hay)
 
     List*   availableItems;        // Lista de ítems disponibles en el escenario (List de Item*)
     List*   playerInventory;       // Inventario del jugador en este nodo (usualmente vacío inicialmente)
     
     int     tiempoRestante;        // Tiempo restante para completar acciones en este nodo
     bool    esFinal;               // Marca si este escenario es un nodo final del juego (true = sí, false = no)
+
+    int     componente;            // Componente fuertemente conexa del nodo (ver alcance.h)
+    int     distanciaFinal;        // Tiempo mínimo hasta un final sin ítems (-1 si no hay camino)
+    int     pasosFinal;            // Aristas de ese camino (el de menos aristas si hay varios)
 } State;
 
 typedef struct Node {
     State   state;              // Estado del nodo: incluye descripción, ítems, si es final, etc.
-    struct  Node** adjacents;   // Puntero a arreglo de 4 punteros a nodos adyacentes (arriba, abajo, izquierda, derecha)
 } Node;
 
+// Arista dirigida. Las aristas de todos los nodos se guardan juntas en formato compacto
+// (CSR): las que salen del nodo i son graph.aristas[graph.inicioAristas[i] .. graph.inicioAristas[i + 1]).
+typedef struct Arista {
+    int     destino;            // Índice del nodo destino en graph.nodes
+    short   costo;              // Costo base del movimiento, que se suma al costo por peso
+    short   direccion;          // Dirección cardinal (0-3, ver nombresDirecciones) o -1 si es extendida
+    const char* etiqueta;       // Nombre que ve el jugador ("Arriba", "Teletransportador", ...)
+} Arista;
+
+// Estadísticas de memoria de los textos del mapa, calculadas al cargarlo.
+typedef struct {
+    size_t  cadenas;            // Textos guardados en memoria (contando repetidos)
+    size_t  cadenasUnicas;      // Textos distintos en el pool
+    size_t  bytesTexto;         // Bytes que ocuparían copiados por separado y sin comprimir
+    size_t  bytesTextoGuardados;// Bytes que ocupan realmente (pool + diccionario)
+    size_t  bytesDiccionario;   // Bytes del diccionario de compresión (0 si no se usa)
+} EstadisticasCarga;
+
 typedef struct Graph {
     Node*   nodes;              // Arreglo dinámico de nodos (escenarios del juego)
     int     numberOfNodes;      // Número actual de nodos cargados desde el CSV
     int     capacidad;          // Capacidad del arreglo de nodos
     Node*   start;              // Nodo inicial donde comienza el jugador
+    int*    inicioAristas;      // numberOfNodes + 1 posiciones en 'aristas' (ver Arista)
+    Arista* aristas;            // Aristas de todos los nodos, agrupadas por nodo de origen
+    int     numAristas;
+    IndiceNombres* indice;      // Índices por nombre de escenarios e ítems (ver indice.h)
+    FuenteTexto* textos;        // Fuente de los textos diferidos o comprimidos
+    PoolCadenas* cadenas;       // Pool con los textos en memoria (nombres, descripciones, ítems)
+    EstadisticasCarga estadisticas; // Uso de memoria de los textos
+    ResumenAlcance alcance;     // Componentes y escenarios sin salida del mapa
+    Plano*  plano;              // Coordenadas de los escenarios e índice espacial (ver plano.h)
+    OrdenItems* ordenItems;     // Ítems de cada escenario ordenados por valor (ver consejo.h)
+    bool    esCopia;            // true si comparte con el grafo original sus datos de solo lectura
+    bool    esEstatico;         // true si sus datos son tablas incrustadas en el ejecutable (ver incrustado.h)
+    unsigned long long huella;  // Identifica el contenido del mapa (ver huella_mapa)
 } Graph;
 
-// Función para leer los escenarios desde un archivo .csv
+// Opciones que controlan cómo se carga un mapa.
+typedef struct {
+    bool    estricto;           // Rechazar el mapa completo si la validación encuentra errores
+    bool    descripcionesDiferidas; // Guardar solo la posición de cada descripción en el archivo
+    bool    nombresDiferidos;   // Ídem para los nombres de los escenarios
+    bool    comprimirDescripciones; // Comprimir con diccionario las descripciones en memoria
+    OrdenNodos orden;           // Orden de los nodos en memoria (ver orden.h)
+    bool    silencioso;         // No mostrar diagnósticos ni el resumen de la carga (modo guion)
+    bool    copiarArchivo;      // Los textos diferidos se copian del archivo al cargar (--watch, ver textos.h)
+} OpcionesCarga;
+
+// Función para leer los escenarios desde un archivo .csv (pregunta el nombre al usuario)
 void leer_escenarios();
 
-// Función para mostrar los escenarios del archivo leído
-void mostrar_grafo();
+// Carga los escenarios del archivo indicado en el grafo global. Retorna false si se rechazó.
+bool cargar_escenarios(const char* nombreArchivo);
+
+// Carga el mapa en 'g' con esas opciones, sin mostrar nada ni tocar el grafo global.
+// Retorna false si se rechazó.
+bool cargar_mapa_en(Graph* g, const char* nombreArchivo, const OpcionesCarga* opciones);
 
 // Función que devuelve un puntero a una copia del grafo original recibido por la función.
 Graph* copiar_grafo(const Graph* original);
 
+// Huella de 64 bits del contenido jugable del mapa: escenarios, ítems, aristas y finales.
+// No depende del orden de los nodos en memoria ni de los textos descriptivos.
+unsigned long long huella_mapa(const Graph* g);
+
+// Retorna las aristas que salen del nodo y deja su cantidad en *cantidad.
+const Arista* aristas_de(const Graph* g, const Node* n, int* cantidad);
+
+// Retorna el nombre del escenario (lo lee desde el archivo si es diferido).
+const char* nombre_escenario(const Node* n);
+
+// Retorna la descripción del escenario (la lee desde el archivo si es diferida).
+const char* descripcion_escenario(const Node* n);
+
+// Reclama atómicamente un ítem para un jugador. Retorna false si ya tenía dueño.
+bool reclamar_item(Item* item, int jugador);
+
+// Devuelve al mundo un ítem que había reclamado el jugador (al deshacer). Retorna false
+// si el ítem no era suyo.
+bool soltar_item(Item* item, int jugador);
+
+// Indica si el ítem todavía no ha sido reclamado por ningún jugador.
+bool item_disponible(Item* item);
+
+// Reserva un ítem del pool de ítems (contenido indefinido) y lo devuelve al pool.
+Item* item_crear(void);
+void item_liberar(void* item);
+
+// Crea una lista vacía de Item* que devuelve sus ítems al pool al destruirse.
+List* lista_items_crear(void);
+
+// Nombres de las direcciones cardinales, indexados por Arista.direccion.
+extern const char* const nombresDirecciones[MAXDIR];
+
 // Grafo global para el manejo de los datos.
 extern Graph graph;
 
+// Opciones de carga vigentes (se ajustan desde la línea de comandos).
+extern OpcionesCarga opcionesCarga;
+
 #endif
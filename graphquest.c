@@ -8,16 +8,77 @@
 #include "extra.h"
 #include "grafo.h"
 #include "game.h"
+#include "metricas.h"
+#include "memoria.h"
+#include "objetos.h"
+#include "guion.h"
+#include "listado.h"
+#include "exportar.h"
+#include "catalogo.h"
+#include "recarga.h"
+#include "incrustado.h"
+#include "bot.h"
+#include "torneo.h"
+#include "puntajes.h"
 
 #define MAXDESC 1000
 #define MAXITEMNAME 256
 #define MAXDIR 4
 #define MAXNODES 1000
 
+/**
+ * leer_numero_jugadores
+ * ---------------------
+ * Solicita al usuario la cantidad de jugadores para el modo multijugador,
+ * repitiendo la pregunta hasta recibir un número entre 2 y MAXJUGADORES.
+ */
+
+int leer_numero_jugadores() {
+    char buf[MAXOPTION];
+    while (1) {
+        printf("Ingrese el número de jugadores (2-%d): ", MAXJUGADORES);
+        if (!fgets(buf, MAXOPTION, stdin)) {
+            clearerr(stdin);
+            continue;
+        }
+
+        char* fin;
+        long numero = strtol(buf, &fin, 10);
+        if (fin != buf && (*fin == '\n' || *fin == '\0') && numero >= 2 && numero <= MAXJUGADORES) {
+            return (int)numero;
+        }
+        puts("Cantidad inválida. Intente nuevamente.");
+    }
+}
+
+/**
+ * leer_jugadores_automaticos
+ * --------------------------
+ * Pregunta qué jugadores controla la computadora (ver bot.h). Acepta los números
+ * separados por espacios o comas; los que están fuera de rango se ignoran. Una línea
+ * vacía deja a todos los jugadores en manos de personas.
+ */
+
+void leer_jugadores_automaticos(int numJugadores, bool automaticos[]) {
+    for (int i = 0; i < numJugadores; i++) automaticos[i] = false;
+
+    char buf[MAXOPTION];
+    printf("Jugadores que controla la computadora (números separados por espacios, ENTER para ninguno): ");
+    if (!fgets(buf, MAXOPTION, stdin)) {
+        clearerr(stdin);
+        return;
+    }
+    for (char* p = strtok(buf, " ,\t\n"); p; p = strtok(NULL, " ,\t\n")) {
+        int numero = atoi(p);
+        if (numero >= 1 && numero <= numJugadores) automaticos[numero - 1] = true;
+    }
+}
+
 /**
  * seleccionar_modo_y_comenzar_partida
  * -----------------------------------
- * Permite al usuario elegir entre modo de un jugador o multijugador.
+ * Permite al usuario elegir entre modo de un jugador o multijugador (N jugadores
+ * compartiendo un mismo grafo).
  * En el modo de un jugador, se realiza una copia profunda del grafo original
  * (`graph`) a una copia temporal (`graphCpy`) que se usará en la partida.
  *
@@ -36,7 +97,7 @@ void seleccionar_modo_y_comenzar_partida(Graph** grafo) {
     puts("======- Iniciar Partida -======");
     puts("Selecciona el número de jugadores:");
     puts("(1)   Un jugador");
-    puts("(2)   Dos jugadores");
+    printf("(2)   Multijugador (2-%d jugadores)\n", MAXJUGADORES);
 
     char buf[MAXOPTION];
     char eleccion = readOption(buf, 2);
@@ -49,19 +110,27 @@ void seleccionar_modo_y_comenzar_partida(Graph** grafo) {
     if (eleccion == '1') {
         if (*grafo) {
             liberarJuego(*grafo);
-            free(*grafo);
+            mem_liberar(*grafo);
             *grafo = NULL;
         }
 
+        int lector = recarga_entrar();     // La copia comparte datos con 'graph'
         *grafo = copiar_grafo(&graph);
         if (!*grafo) {
             puts("Error al crear la copia del grafo.");
+            recarga_salir(lector);
             return;
         }
         iniciar_partida(*grafo);
+        recarga_salir(lector);
     }
     else if (eleccion == '2') {
-        iniciar_partida_multijugador(&graph);
+        int numJugadores = leer_numero_jugadores();
+        bool automaticos[MAXJUGADORES];
+        leer_jugadores_automaticos(numJugadores, automaticos);
+        int lector = recarga_entrar();
+        iniciar_partida_multijugador(&graph, numJugadores, automaticos);
+        recarga_salir(lector);
     }
 }
 
@@ -74,24 +143,211 @@ void seleccionar_modo_y_comenzar_partida(Graph** grafo) {
  *  - Muestra un menú con las opciones principales del juego.
  *  - Lee la opción seleccionada por el usuario.
  *  - Ejecuta una acción según la opción:
- *      - '1': Carga los escenarios desde archivo (función leer_escenarios).
- *      - '2': Muestra el grafo del juego (función mostrar_grafo).
+ *      - '1': Carga los escenarios desde archivo o del catálogo (función leer_escenarios).
+ *      - '2': Muestra los escenarios, con filtros y por páginas (función listar_escenarios).
  *      - '3': Inicia la partida en modo uno o dos jugadores (función seleccionar_modo_y_comenzar_partida).
  *      - '4': Libera la memoria y termina el juego.
  *      - Otra: Informa que la opción es inválida.
  *  - El ciclo continúa hasta que el usuario elija salir ('4').
  *
+ * Argumentos de línea de comandos:
+ *  - --debug: habilita comandos de depuración en la partida (saltar a un escenario).
+ *  - --strict: rechaza por completo los mapas en los que la validación encuentre errores.
+ *  - --lazy-text / --lazy-names: guarda descripciones / nombres como posiciones en el archivo
+ *    y los lee solo al mostrarlos.
+ *  - --compress-text: comprime con un diccionario las descripciones que quedan en memoria.
+ *  - --text-cache N: cantidad de textos recientes que se guardan en la caché (4 a 64).
+ *  - --mem-report: al salir, informa en stderr la memoria usada por subsistema y las fugas.
+ *  - --stats: mide los puntos calientes y, al salir, escribe un reporte JSON en stderr.
+ *  - --reorder bfs|rcm: reordena los escenarios en memoria para que los vecinos queden juntos.
+ *  - --map-cache MB: memoria para los mapas ya leídos que se conservan al cambiar de mapa
+ *    (por defecto 256; 0 no conserva ninguno, ver catalogo.h).
+ *  - --export dot|json MAPA SALIDA: carga el mapa y lo exporta a SALIDA ("-" para la
+ *    salida estándar) sin entrar al menú (ver exportar.h).
+ *  - --embed MAPA SALIDA.c: carga el mapa y lo escribe como tablas de C para compilarlo
+ *    dentro del ejecutable con -DMAPA_INCRUSTADO (ver incrustado.h).
+ *  - --watch: vuelve a leer el mapa actual en segundo plano cuando su archivo cambia y lo
+ *    instala para las partidas siguientes (ver recarga.h).
+ *  - --script ARCHIVO: ejecuta los comandos del archivo ("-" para la entrada estándar) sin
+ *    menús ni pausas y escribe un resultado JSON por comando (ver guion.h).
+ *  - --scores ARCHIVO: tabla de posiciones en la que se anotan las partidas terminadas
+ *    (por defecto ARCHIVOPUNTAJES; en modo guion solo se abre con esta opción, ver puntajes.h).
+ *
  * Detalles adicionales:
  *  - Utiliza `showPrincipalOptions` para mostrar el menú.
  *  - Usa `readOption` para capturar la opción con validación de entrada.
  *  - Llama a `presioneTeclaParaContinuar` al final de cada iteración para dar tiempo al usuario.
  */
 
-int main(){
+/*
+ * Escribe los reportes pedidos por línea de comandos y devuelve los pools al sistema.
+ * Se llama al salir, con el grafo ya liberado.
+ */
+
+static void reportes_finales(bool reporteMemoria) {
+    if (metricasActivas) metricas_reportar(stderr);
+    if (reporteMemoria) objetos_reportar(stderr);
+    objetos_liberar_todo();     // Ya no quedan ítems ni listas en uso
+    if (reporteMemoria) {
+        mem_reportar(stderr);
+        mem_reportar_fugas(stderr);
+    }
+}
+
+/*
+ * Carga el mapa sin mostrar diagnósticos y lo exporta (opción --export) o lo escribe
+ * como tablas de C (opción --embed, si 'incrustar'). Retorna el código de salida del programa.
+ */
+
+static int exportar_mapa(const char* mapa, FormatoExportacion formato, bool incrustar, const char* salida) {
+    opcionesCarga.silencioso = true;
+    if (!cargar_escenarios(mapa)) {
+        fprintf(stderr, "No se pudo cargar el mapa \"%s\".\n", mapa);
+        return 1;
+    }
+    FILE* destino = strcmp(salida, "-") == 0 ? stdout : fopen(salida, "w");
+    if (!destino) {
+        fprintf(stderr, "No se pudo crear \"%s\".\n", salida);
+        return 1;
+    }
+    bool exportado = incrustar ? incrustar_mapa(&graph, mapa, destino)
+                               : exportar_grafo(&graph, NULL, 0, formato, destino);
+    if (destino != stdout && fclose(destino) != 0) exportado = false;
+    if (!exportado) {
+        fprintf(stderr, "No se pudo escribir \"%s\".\n", salida);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]){
+    bool reporteMemoria = false;
+    const char* guion = NULL;
+    const char* mapaExportar = NULL;
+    const char* salidaExportar = NULL;
+    FormatoExportacion formatoExportar = EXPORTAR_DOT;
+    bool incrustar = false;
+    bool torneo = false;
+    const char* tablaPuntajes = NULL;
+    OpcionesTorneo opcionesTorneo = { .mapas = NULL, .estrategias = NULL, .partidas = 10, .hilos = 0, .salida = "-" };
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--debug") == 0) {
+            modoDepuracion = true;
+        } else if (strcmp(argv[i], "--strict") == 0) {
+            opcionesCarga.estricto = true;
+        } else if (strcmp(argv[i], "--lazy-text") == 0) {
+            opcionesCarga.descripcionesDiferidas = true;
+        } else if (strcmp(argv[i], "--lazy-names") == 0) {
+            opcionesCarga.nombresDiferidos = true;
+        } else if (strcmp(argv[i], "--compress-text") == 0) {
+            opcionesCarga.comprimirDescripciones = true;
+        } else if (strcmp(argv[i], "--text-cache") == 0 && i + 1 < argc) {
+            textos_configurar_cache(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            metricas_activar(true);
+        } else if (strcmp(argv[i], "--mem-report") == 0) {
+            reporteMemoria = true;
+        } else if (strcmp(argv[i], "--export") == 0 && i + 3 < argc) {
+            if (!formato_exportacion(argv[i + 1], &formatoExportar)) {
+                printf("Formato de exportación desconocido: %s (use dot o json)\n", argv[i + 1]);
+                return 1;
+            }
+            mapaExportar = argv[i + 2];
+            salidaExportar = argv[i + 3];
+            i += 3;
+        } else if (strcmp(argv[i], "--embed") == 0 && i + 2 < argc) {
+            incrustar = true;
+            mapaExportar = argv[i + 1];
+            salidaExportar = argv[i + 2];
+            i += 2;
+        } else if (strcmp(argv[i], "--map-cache") == 0 && i + 1 < argc) {
+            int megabytes = atoi(argv[++i]);
+            catalogo_configurar_presupuesto(megabytes > 0 ? (size_t)megabytes * 1024 * 1024 : 0);
+        } else if (strcmp(argv[i], "--watch") == 0) {
+            if (!recarga_activar()) {
+                puts("No se puede vigilar el mapa en este sistema (se necesita inotify).");
+                return 1;
+            }
+            opcionesCarga.copiarArchivo = true;     // El archivo se reescribe con partidas en curso
+        } else if (strcmp(argv[i], "--bot-budget") == 0 && i + 1 < argc) {
+            bot_configurar_presupuesto(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "tournament") == 0) {
+            torneo = true;
+        } else if (strcmp(argv[i], "--maps") == 0 && i + 1 < argc) {
+            opcionesTorneo.mapas = argv[++i];
+        } else if (strcmp(argv[i], "--strategies") == 0 && i + 1 < argc) {
+            opcionesTorneo.estrategias = argv[++i];
+        } else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) {
+            opcionesTorneo.partidas = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            opcionesTorneo.hilos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            opcionesTorneo.salida = argv[++i];
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            guion = argv[++i];
+        } else if (strcmp(argv[i], "--scores") == 0 && i + 1 < argc) {
+            tablaPuntajes = argv[++i];
+        } else if (strcmp(argv[i], "--reorder") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "bfs") == 0) {
+                opcionesCarga.orden = ORDEN_BFS;
+            } else if (strcmp(argv[i], "rcm") == 0) {
+                opcionesCarga.orden = ORDEN_RCM;
+            } else {
+                printf("Orden desconocido: %s (use bfs o rcm)\n", argv[i]);
+                return 1;
+            }
+        } else {
+            printf("Opción desconocida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
     graph.nodes = NULL;
     graph.numberOfNodes = 0;
     graph.capacidad = 0;
     graph.start = NULL;
+    graph.inicioAristas = NULL;
+    graph.aristas = NULL;
+    graph.numAristas = 0;
+    graph.indice = NULL;
+    graph.esCopia = false;
+    graph.textos = NULL;
+    graph.cadenas = NULL;
+
+#ifdef MAPA_INCRUSTADO
+    // El mapa incrustado queda como mapa actual desde el inicio; cargar otro lo reemplaza
+    if (!mapaExportar) grafo_desde_estatico(&graph, &mapaIncrustado);
+#endif
+
+    if (mapaExportar) {
+        int codigo = exportar_mapa(mapaExportar, formatoExportar, incrustar, salidaExportar);
+        catalogo_liberar();
+        recarga_detener();
+        reportes_finales(reporteMemoria);
+        return codigo;
+    }
+
+    if (torneo) {
+        int codigo = ejecutar_torneo(&opcionesTorneo);
+        catalogo_liberar();
+        recarga_detener();
+        reportes_finales(reporteMemoria);
+        return codigo;
+    }
+
+    if (guion) {
+        if (tablaPuntajes && !puntajes_abrir(tablaPuntajes)) return 1;
+        int codigo = ejecutar_guion(guion);
+        puntajes_cerrar();
+        catalogo_liberar();
+        recarga_detener();
+        reportes_finales(reporteMemoria);
+        return codigo;
+    }
+
+    // Sin tabla de posiciones se juega igual: solo no se anotan los puntajes
+    puntajes_abrir(tablaPuntajes ? tablaPuntajes : ARCHIVOPUNTAJES);
 
     Graph* graphCpy = NULL;
 
@@ -100,19 +356,27 @@ int main(){
         showPrincipalOptions();
         char reading[MAXOPTION];
         option = readOption(reading, 4);
+        if (option != '4') recarga_aplicar();     // Punto seguro: la opción ya usa el mapa nuevo
         switch(option) {
             case '1':
                 leer_escenarios();
                 break;
             case '2':
-                mostrar_grafo();
+                listar_escenarios();
                 break;
             case '3':
                 seleccionar_modo_y_comenzar_partida(&graphCpy);
                 break;
             case '4':
                 puts("Saliendo del juego...");
-                liberarJuego(&graph);
+                if (graphCpy) {
+                    liberarJuego(graphCpy);
+                    mem_liberar(graphCpy);
+                    graphCpy = NULL;
+                }
+                puntajes_cerrar();
+                catalogo_liberar();
+                recarga_detener();
                 break;
             default:
                 puts("\nOpción inválida, intente nuevamente");
@@ -121,4 +385,6 @@ int main(){
         presioneTeclaParaContinuar();
     } while (option != '4');
 
+    reportes_finales(reporteMemoria);
+
 }
@@ -0,0 +1,463 @@
+#include "guion.h"
+#include "libgraphquest.h"
+#include "grafo.h"
+#include "extra.h"
+#include "exportar.h"
+#include "catalogo.h"
+#include "recarga.h"
+#include "bot.h"
+#include "puntajes.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MAXLINEAGUION 1024
+
+/*
+ * El guion es un cliente de libgraphquest: la partida es una gq_session de un jugador
+ * sobre el mapa cargado (gq_world_wrap), y cada comando es una llamada a la biblioteca.
+ * Lo propio de la consola (cargar mapas con el catálogo, la recarga con --watch y la
+ * tabla de posiciones) sigue acá.
+ */
+
+// Partida en curso del guion. 'sesion' es NULL mientras no haya partida.
+typedef struct {
+    gq_world*   mundo;
+    gq_session* sesion;
+    int         lector;     // Registro de la partida (ver recarga.h)
+    int         linea;      // Línea del comando que se está ejecutando
+    bool        anotada;    // La partida ya se anotó en la tabla de posiciones
+} SesionGuion;
+
+static void terminar_partida(SesionGuion* s) {
+    if (!s->sesion) return;
+    gq_session_free(s->sesion);
+    gq_world_release(s->mundo);
+    s->sesion = NULL;
+    s->mundo = NULL;
+    recarga_salir(s->lector);
+}
+
+// Deja al jugador en el inicio con el inventario vacío. Con 'mundoNuevo' además vuelve a
+// copiar el grafo cargado, así que todos los ítems reaparecen.
+static bool comenzar_partida(SesionGuion* s, bool mundoNuevo) {
+    if (mundoNuevo || !s->sesion) {
+        terminar_partida(s);
+        if (graph.numberOfNodes == 0) return false;
+        s->lector = recarga_entrar();
+        s->mundo = gq_world_wrap(&graph);
+        s->sesion = s->mundo ? gq_session_new(s->mundo, 1) : NULL;
+        if (!s->sesion) {
+            gq_world_release(s->mundo);
+            s->mundo = NULL;
+            recarga_salir(s->lector);
+            return false;
+        }
+        gq_session_set_bot_budget(s->sesion, bot_presupuesto());
+    } else {
+        gq_session_restart(s->sesion, 0);
+    }
+    s->anotada = false;
+    return true;
+}
+
+static const char* const nombresEstados[] = {"jugando", "final", "sin_tiempo", "sin_salida"};     // Por gq_status
+static const char* const nombresAcciones[] = {"", "pick", "drop", "move"};                      // Por gq_action_type
+
+/*
+ * Cada resultado es un objeto JSON en una línea: "linea", "accion" y "ok", luego los
+ * campos propios de la acción y, si hay partida, su estado (escenario, tiempo, puntaje,
+ * cantidad de ítems en el inventario y "estado"). Los errores llevan "error" en su lugar.
+ */
+
+static void abrir_resultado(const SesionGuion* s, const char* accion, bool ok) {
+    printf("{\"linea\":%d,\"accion\":\"%s\",\"ok\":%s", s->linea, accion, ok ? "true" : "false");
+}
+
+static void cerrar_resultado(SesionGuion* s) {
+    gq_state estado;
+    if (s->sesion && gq_session_state(s->sesion, 0, &estado) == GQ_OK) {
+        printf(",\"escenario\":%d,\"tiempo\":%d,\"puntaje\":%d,\"inventario\":%d,\"estado\":\"%s\"",
+               estado.escenario, estado.tiempo, estado.puntaje, estado.inventario, nombresEstados[estado.estado]);
+    }
+    puts("}");
+}
+
+static void informar_error(SesionGuion* s, const char* accion, const char* mensaje) {
+    abrir_resultado(s, accion, false);
+    printf(",\"error\":\"%s\"", mensaje);
+    cerrar_resultado(s);
+}
+
+static bool partida_terminada(const SesionGuion* s) {
+    gq_state estado;
+    return gq_session_state(s->sesion, 0, &estado) == GQ_OK && estado.estado != GQ_JUGANDO;
+}
+
+// Verifica que haya una partida en la que todavía se pueda jugar.
+static bool partida_en_juego(SesionGuion* s, const char* accion) {
+    if (!s->sesion) {
+        informar_error(s, accion, "no hay partida: use load o start");
+        return false;
+    }
+    if (partida_terminada(s)) {
+        informar_error(s, accion, "la partida terminó: use start o restart");
+        return false;
+    }
+    return true;
+}
+
+static void comando_load(SesionGuion* s, const char* argumento) {
+    if (!*argumento) {
+        informar_error(s, "load", "falta el nombre del archivo");
+        return;
+    }
+    terminar_partida(s);    // La copia comparte datos con el grafo que se va a reemplazar
+    ResultadoCatalogo resultado = catalogo_cargar(argumento);
+    if (resultado == CATALOGO_ERROR) {
+        informar_error(s, "load", "no se pudo cargar el mapa");
+        return;
+    }
+    if (!comenzar_partida(s, true)) {
+        informar_error(s, "load", "no hay memoria para la partida");
+        return;
+    }
+    abrir_resultado(s, "load", true);
+    printf(",\"escenarios\":%d,\"catalogo\":%s", gq_world_scenarios(s->mundo), resultado == CATALOGO_EN_CACHE ? "true" : "false");
+    cerrar_resultado(s);
+}
+
+static void comando_start(SesionGuion* s) {
+    if (!comenzar_partida(s, true)) {
+        informar_error(s, "start", graph.numberOfNodes == 0 ? "no hay mapa cargado" : "no hay memoria para la partida");
+        return;
+    }
+    abrir_resultado(s, "start", true);
+    cerrar_resultado(s);
+}
+
+static void comando_restart(SesionGuion* s) {
+    if (!s->sesion) {
+        informar_error(s, "restart", "no hay partida: use load o start");
+        return;
+    }
+    comenzar_partida(s, false);
+    abrir_resultado(s, "restart", true);
+    cerrar_resultado(s);
+}
+
+static void comando_pick(SesionGuion* s, const char* argumento) {
+    if (!partida_en_juego(s, "pick")) return;
+    int posicion;
+    if (!texto_a_entero(argumento, &posicion)) {
+        informar_error(s, "pick", "se esperaba el número del ítem");
+        return;
+    }
+    gq_action hecha;
+    gq_result resultado = gq_session_pick(s->sesion, 0, posicion, &hecha);
+    if (resultado != GQ_OK) {
+        informar_error(s, "pick", resultado == GQ_TOMADO ? "el ítem ya fue tomado" : "no hay un ítem disponible en esa posición");
+        return;
+    }
+    abrir_resultado(s, "pick", true);
+    printf(",\"valor\":%d,\"peso\":%d", hecha.item.valor, hecha.item.peso);
+    cerrar_resultado(s);
+}
+
+static void comando_drop(SesionGuion* s, const char* argumento) {
+    if (!partida_en_juego(s, "drop")) return;
+    int numero;
+    if (!texto_a_entero(argumento, &numero)) {
+        informar_error(s, "drop", "se esperaba el número del ítem");
+        return;
+    }
+    if (gq_session_drop(s->sesion, 0, numero, NULL) != GQ_OK) {
+        informar_error(s, "drop", "no hay un ítem en esa posición del inventario");
+        return;
+    }
+    abrir_resultado(s, "drop", true);
+    cerrar_resultado(s);
+}
+
+static void comando_move(SesionGuion* s, const char* argumento) {
+    if (!partida_en_juego(s, "move")) return;
+    gq_action hecha;
+    if (gq_session_move(s->sesion, 0, argumento, &hecha) != GQ_OK) {
+        informar_error(s, "move", "dirección inválida");
+        return;
+    }
+    abrir_resultado(s, "move", true);
+    printf(",\"gasto\":%d", hecha.gasto);
+    cerrar_resultado(s);
+}
+
+// Deshacer se permite aunque la partida haya terminado: se vuelve a la jugada anterior.
+static void comando_undo(SesionGuion* s) {
+    if (!s->sesion) {
+        informar_error(s, "undo", "no hay partida: use load o start");
+        return;
+    }
+    gq_action_type tipo;
+    if (gq_session_undo(s->sesion, 0, &tipo) != GQ_OK) {
+        informar_error(s, "undo", "no hay acciones para deshacer");
+        return;
+    }
+    abrir_resultado(s, "undo", true);
+    printf(",\"deshizo\":\"%s\"", nombresAcciones[tipo]);
+    cerrar_resultado(s);
+}
+
+static void comando_redo(SesionGuion* s) {
+    if (!s->sesion) {
+        informar_error(s, "redo", "no hay partida: use load o start");
+        return;
+    }
+    gq_action_type tipo;
+    gq_result resultado = gq_session_redo(s->sesion, 0, &tipo);
+    if (resultado != GQ_OK) {
+        informar_error(s, "redo", resultado == GQ_TOMADO ? "el ítem ya fue tomado" : "no hay acciones para rehacer");
+        return;
+    }
+    abrir_resultado(s, "redo", true);
+    printf(",\"rehizo\":\"%s\"", nombresAcciones[tipo]);
+    cerrar_resultado(s);
+}
+
+// Una acción elegida por el jugador automático. Retorna false si no hizo nada.
+static bool jugada_bot(SesionGuion* s) {
+    gq_action hecha;
+    gq_result resultado = gq_session_bot(s->sesion, 0, &hecha);
+    if (resultado != GQ_OK) {
+        informar_error(s, "bot", resultado == GQ_TOMADO ? "no se pudo aplicar la acción" : "no hay ninguna acción posible");
+        return false;
+    }
+    abrir_resultado(s, "bot", true);
+    printf(",\"hizo\":\"%s\",\"profundidad\":%d", nombresAcciones[hecha.tipo], hecha.profundidad);
+    if (hecha.tipo == GQ_RECOGER) printf(",\"valor\":%d,\"peso\":%d", hecha.item.valor, hecha.item.peso);
+    if (hecha.tipo == GQ_DESCARTAR) printf(",\"item\":%d", hecha.item.numero);
+    if (hecha.tipo == GQ_MOVER) printf(",\"gasto\":%d", hecha.gasto);
+    cerrar_resultado(s);
+    return true;
+}
+
+// Con "all" juega hasta que termine la partida, informando cada acción.
+static void comando_bot(SesionGuion* s, const char* argumento) {
+    bool todas = strcmp(argumento, "all") == 0;
+    if (!todas && *argumento) {
+        informar_error(s, "bot", "use: bot o bot all");
+        return;
+    }
+    if (!partida_en_juego(s, "bot")) return;
+    while (jugada_bot(s) && todas && !partida_terminada(s)) {}
+}
+
+static void escribir_texto_json(const char* texto) {
+    putchar('"');
+    for (; *texto; texto++) {
+        if (*texto == '"' || *texto == '\\') putchar('\\');
+        putchar(*texto);
+    }
+    putchar('"');
+}
+
+static void comando_suggest(SesionGuion* s) {
+    if (!partida_en_juego(s, "suggest")) return;
+    gq_advice consejo;
+    gq_session_suggest(s->sesion, 0, &consejo);
+    abrir_resultado(s, "suggest", true);
+    printf(",\"llega\":%s,\"recoger\":[", consejo.llega ? "true" : "false");
+    for (int i = 0; i < consejo.numRecoger; i++) {
+        const gq_item* item = &consejo.recoger[i];
+        printf("%s{\"item\":%d,\"nombre\":", i > 0 ? "," : "", item->numero);
+        escribir_texto_json(item->nombre);
+        printf(",\"valor\":%d,\"peso\":%d}", item->valor, item->peso);
+    }
+    printf("],\"descartar\":[");
+    for (int i = 0; i < consejo.numDescartar; i++) printf("%s%d", i > 0 ? "," : "", consejo.descartar[i]);
+    printf("],\"puntaje\":%d,\"peso\":%d,\"tiempo_final\":%d,\"siguiente\":", consejo.puntaje, consejo.peso,
+           consejo.tiempoFinal);
+    if (consejo.siguiente.tipo == GQ_NINGUNA) printf("\"move\"");
+    else printf("\"%s %d\"", nombresAcciones[consejo.siguiente.tipo], consejo.siguiente.item.numero);
+    cerrar_resultado(s);
+}
+
+static void comando_export(SesionGuion* s, char* argumento) {
+    char* archivo = argumento;
+    while (*archivo && !isspace((unsigned char)*archivo)) archivo++;
+    if (*archivo) *archivo++ = '\0';
+    while (isspace((unsigned char)*archivo)) archivo++;
+
+    FormatoExportacion formato;
+    if (!formato_exportacion(argumento, &formato) || !*archivo) {
+        informar_error(s, "export", "use: export dot|json ARCHIVO");
+        return;
+    }
+    FILE* destino = fopen(archivo, "w");
+    if (!destino) {
+        informar_error(s, "export", "no se pudo crear el archivo");
+        return;
+    }
+    bool exportado = s->sesion ? gq_session_export(s->sesion, argumento, destino)
+                               : exportar_grafo(&graph, NULL, 0, formato, destino);
+    if (fclose(destino) != 0) exportado = false;
+    if (!exportado) {
+        informar_error(s, "export", graph.numberOfNodes == 0 ? "no hay mapa cargado" : "no se pudo escribir el archivo");
+        return;
+    }
+    abrir_resultado(s, "export", true);
+    cerrar_resultado(s);
+}
+
+// Anota la partida terminada con el nombre indicado (una vez por partida).
+static void comando_record(SesionGuion* s, const char* argumento) {
+    if (!puntajes_activos()) {
+        informar_error(s, "record", "no hay tabla de posiciones: use --scores ARCHIVO");
+        return;
+    }
+    if (!s->sesion) {
+        informar_error(s, "record", "no hay partida: use load o start");
+        return;
+    }
+    if (!partida_terminada(s)) {
+        informar_error(s, "record", "la partida todavía no terminó");
+        return;
+    }
+    if (s->anotada) {
+        informar_error(s, "record", "la partida ya se anotó");
+        return;
+    }
+    if (!*argumento) {
+        informar_error(s, "record", "falta el nombre del jugador");
+        return;
+    }
+    gq_state estado;
+    gq_session_state(s->sesion, 0, &estado);
+    int posicion = puntajes_anotar(gq_world_fingerprint(s->mundo), argumento, estado.puntaje, estado.tiempo, estado.turnos);
+    s->anotada = true;
+    abrir_resultado(s, "record", true);
+    printf(",\"posicion\":%d", posicion);
+    cerrar_resultado(s);
+}
+
+// Mejores puntajes del mapa de la partida en curso (o del mapa cargado).
+static void comando_top(SesionGuion* s) {
+    if (!puntajes_activos()) {
+        informar_error(s, "top", "no hay tabla de posiciones: use --scores ARCHIVO");
+        return;
+    }
+    if (!s->sesion && graph.numberOfNodes == 0) {
+        informar_error(s, "top", "no hay mapa cargado");
+        return;
+    }
+    int cantidad;
+    const RegistroPuntaje* mejores = puntajes_mejores(s->mundo ? gq_world_fingerprint(s->mundo) : graph.huella, &cantidad);
+    abrir_resultado(s, "top", true);
+    printf(",\"mejores\":[");
+    for (int i = 0; i < cantidad; i++) {
+        printf("%s{\"nombre\":", i > 0 ? "," : "");
+        escribir_texto_json(mejores[i].nombre);
+        printf(",\"puntaje\":%d,\"tiempo\":%d,\"turnos\":%d}", mejores[i].puntaje, mejores[i].tiempoRestante,
+               mejores[i].turnos);
+    }
+    putchar(']');
+    cerrar_resultado(s);
+}
+
+// Ejecuta una línea ya sin comentario ni espacios en los extremos. Retorna false con quit.
+static bool ejecutar_comando(SesionGuion* s, char* linea) {
+    char* argumento = linea;
+    while (*argumento && !isspace((unsigned char)*argumento)) argumento++;
+    if (*argumento) *argumento++ = '\0';
+    while (isspace((unsigned char)*argumento)) argumento++;
+
+    if (strcmp(linea, "load") == 0) {
+        comando_load(s, argumento);
+    } else if (strcmp(linea, "start") == 0) {
+        comando_start(s);
+    } else if (strcmp(linea, "restart") == 0) {
+        comando_restart(s);
+    } else if (strcmp(linea, "pick") == 0) {
+        comando_pick(s, argumento);
+    } else if (strcmp(linea, "drop") == 0) {
+        comando_drop(s, argumento);
+    } else if (strcmp(linea, "move") == 0) {
+        comando_move(s, argumento);
+    } else if (strcmp(linea, "undo") == 0) {
+        comando_undo(s);
+    } else if (strcmp(linea, "redo") == 0) {
+        comando_redo(s);
+    } else if (strcmp(linea, "bot") == 0) {
+        comando_bot(s, argumento);
+    } else if (strcmp(linea, "suggest") == 0) {
+        comando_suggest(s);
+    } else if (strcmp(linea, "export") == 0) {
+        comando_export(s, argumento);
+    } else if (strcmp(linea, "record") == 0) {
+        comando_record(s, argumento);
+    } else if (strcmp(linea, "top") == 0) {
+        comando_top(s);
+    } else if (strcmp(linea, "quit") == 0) {
+        abrir_resultado(s, "quit", true);
+        cerrar_resultado(s);
+        return false;
+    } else {
+        informar_error(s, "desconocida", "comando desconocido");
+    }
+    return true;
+}
+
+/*
+ * ejecutar_guion
+ * --------------
+ * Lee los comandos línea por línea y ejecuta cada uno con libgraphquest, que usa las
+ * acciones del motor del juego (recoger_item, descartar_item, mover_por_arista), las
+ * mismas que los menús, así que un guion reproduce exactamente una partida interactiva.
+ *
+ * Consideraciones:
+ *  - La carga es silenciosa: sus diagnósticos no se mezclan con los resultados.
+ *  - Un comando inválido solo produce un resultado con "ok": false; el guion sigue.
+ *  - Al terminar (quit o fin del archivo) se libera la partida en curso.
+ */
+
+int ejecutar_guion(const char* nombreArchivo) {
+    FILE* entrada = strcmp(nombreArchivo, "-") == 0 ? stdin : fopen(nombreArchivo, "r");
+    if (!entrada) {
+        fprintf(stderr, "No se pudo abrir el guion \"%s\".\n", nombreArchivo);
+        return 1;
+    }
+    opcionesCarga.silencioso = true;
+
+    SesionGuion sesion = { .mundo = NULL, .sesion = NULL, .linea = 0, .anotada = false };
+    char linea[MAXLINEAGUION];
+    bool continuar = true;
+    while (continuar && fgets(linea, sizeof(linea), entrada)) {
+        sesion.linea++;
+        if (recarga_aplicar()) {
+            abrir_resultado(&sesion, "recarga", true);
+            printf(",\"escenarios\":%d", graph.numberOfNodes);
+            cerrar_resultado(&sesion);
+        }
+        size_t largo = strcspn(linea, "\n");
+        if (linea[largo] != '\n' && !feof(entrada)) {
+            int c;
+            while ((c = fgetc(entrada)) != EOF && c != '\n');
+            informar_error(&sesion, "desconocida", "línea demasiado larga");
+            continue;
+        }
+        linea[strcspn(linea, "#\r\n")] = '\0';
+
+        char* inicio = linea;
+        while (isspace((unsigned char)*inicio)) inicio++;
+        char* fin = inicio + strlen(inicio);
+        while (fin > inicio && isspace((unsigned char)fin[-1])) *--fin = '\0';
+        if (*inicio == '\0') continue;
+
+        continuar = ejecutar_comando(&sesion, inicio);
+    }
+
+    terminar_partida(&sesion);
+    if (entrada != stdin) fclose(entrada);
+    fflush(stdout);
+    return 0;
+}
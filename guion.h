@@ -0,0 +1,52 @@
+#ifndef GUION_H
+#define GUION_H
+
+/*
+ * Modo guion: juega partidas de un jugador a partir de una secuencia de comandos, sin
+ * menús, pantallas ni pausas, e informa el resultado de cada comando en una línea JSON.
+ * Sirve para reproducir sesiones grabadas contra el binario real (pruebas de regresión
+ * y de rendimiento).
+ *
+ * Un comando por línea; las líneas vacías y lo que sigue a '#' se ignoran:
+ *  - load ARCHIVO   Carga el mapa y comienza una partida. Los mapas ya cargados se toman
+ *                   del catálogo (ver catalogo.h) y el resultado lo indica con "catalogo".
+ *  - start          Comienza una partida nueva con el mundo intacto.
+ *  - pick N         Recoge el ítem N (desde 0, como en "Recoger Ítem").
+ *  - drop N         Descarta el ítem N del inventario (desde 1, como en "Descartar Ítem").
+ *  - move DIR       Avanza por el número de la dirección (como en "Moverse"), por su
+ *                   nombre ("Arriba", "Teletransportador", ...) o por up/down/left/right.
+ *  - restart        Reinicia la partida como la opción del menú: el jugador vuelve al
+ *                   inicio con el inventario vacío y los ítems recogidos no reaparecen.
+ *  - undo / redo    Deshace la última acción (pick, drop o move; también después de que
+ *                   la partida terminó) o rehace la última deshecha (ver historial.h).
+ *                   El resultado indica cuál en "deshizo" o "rehizo".
+ *  - bot [all]      La computadora elige y hace una acción (ver bot.h); con "all" juega
+ *                   hasta que termine la partida. Cada acción es una línea con "hizo"
+ *                   ("pick", "drop" o "move") y los campos de esa acción.
+ *  - suggest        Qué ítems conviene recoger aquí ("recoger", con su número para pick)
+ *                   y soltar ("descartar", números para drop, en el orden en que se
+ *                   descartan) para llegar al final con el mayor puntaje (ver consejo.h).
+ *                   "siguiente" es la primera acción: "pick N", "drop N" o "move".
+ *  - export FORMATO ARCHIVO
+ *                   Exporta el mundo de la partida en curso, con la posición del jugador
+ *                   y los ítems tomados (o el mapa cargado si no hay partida) en formato
+ *                   "dot" o "json" (ver exportar.h).
+ *  - record NOMBRE  Anota la partida terminada en la tabla de posiciones con ese nombre
+ *                   (una vez por partida). El resultado indica su "posicion" entre los
+ *                   mejores del mapa, o 0 si no entró (ver puntajes.h).
+ *  - top            Lista los mejores puntajes del mapa en "mejores".
+ *  - quit           Termina el guion.
+ *
+ * record y top necesitan la opción --scores: en modo guion la tabla de posiciones solo se
+ * abre si se indica su archivo.
+ *
+ * Con --watch, antes de cada comando se instala la última versión del mapa si su archivo
+ * cambió, y se informa con una línea de acción "recarga". La partida en curso sigue con
+ * el mapa con que comenzó; las que empiecen con start o load usan la versión nueva.
+ */
+
+// Ejecuta los comandos del archivo ("-" para la entrada estándar) y escribe los
+// resultados en la salida estándar. Retorna el código de salida del programa.
+int ejecutar_guion(const char* nombreArchivo);
+
+#endif // GUION_H
@@ -0,0 +1,125 @@
+#include "historial.h"
+#include "game.h"
+#include "grafo.h"
+#include "list.h"
+#include "memoria.h"
+
+/*
+ * Dueño de los nodos: una descartada hecha guarda el nodo que quitó del inventario, y
+ * una recogida deshecha, el que sacó al deshacerla. En los demás casos el nodo está en
+ * el inventario y es de la lista.
+ */
+
+static bool guarda_nodo(const Historial* h, int i) {
+    TipoAccion tipo = h->acciones[i].tipo;
+    return i < h->hechas ? tipo == ACCION_DESCARTAR : tipo == ACCION_RECOGER;
+}
+
+// Olvida las acciones desde la posición 'desde', liberando los nodos que guardaban.
+static void recortar(GameState* gs, int desde) {
+    Historial* h = &gs->historial;
+    for (int i = desde; i < h->cantidad; i++) {
+        if (guarda_nodo(h, i)) list_freeNode(gs->inventory, h->acciones[i].nodo);
+    }
+    h->cantidad = desde;
+    if (h->hechas > desde) h->hechas = desde;
+}
+
+void historial_iniciar(Historial* h) {
+    *h = (Historial){ 0 };
+}
+
+void historial_liberar(GameState* gs) {
+    recortar(gs, 0);
+    mem_liberar(gs->historial.acciones);
+    historial_iniciar(&gs->historial);
+}
+
+// Agrega la acción después de las hechas. Retorna false (y vacía el historial) sin memoria.
+static bool anotar(GameState* gs, AccionRegistrada accion) {
+    Historial* h = &gs->historial;
+    recortar(gs, h->hechas);
+    if (h->cantidad == h->capacidad) {
+        int capacidad = h->capacidad ? h->capacidad * 2 : 16;
+        AccionRegistrada* acciones = mem_redimensionar(MEM_PARTIDAS, h->acciones, sizeof(AccionRegistrada) * (size_t)capacidad);
+        if (!acciones) {
+            recortar(gs, 0);
+            return false;
+        }
+        h->acciones = acciones;
+        h->capacidad = capacidad;
+    }
+    h->acciones[h->cantidad++] = accion;
+    h->hechas = h->cantidad;
+    return true;
+}
+
+void historial_recoger(GameState* gs, Item* item, ListNode* nodo, ListNode* anterior) {
+    anotar(gs, (AccionRegistrada){ .tipo = ACCION_RECOGER, .item = item, .nodo = nodo, .anterior = anterior, .tiempo = 1 });
+}
+
+void historial_descartar(GameState* gs, ListNode* nodo, ListNode* anterior) {
+    if (!anotar(gs, (AccionRegistrada){ .tipo = ACCION_DESCARTAR, .nodo = nodo, .anterior = anterior, .tiempo = 1 })) {
+        list_freeNode(gs->inventory, nodo);
+    }
+}
+
+void historial_mover(GameState* gs, Node* escenario, const Arista* arista, int tiempo) {
+    anotar(gs, (AccionRegistrada){ .tipo = ACCION_MOVER, .escenario = escenario, .arista = arista, .tiempo = tiempo });
+}
+
+const AccionRegistrada* historial_por_deshacer(const GameState* gs) {
+    const Historial* h = &gs->historial;
+    return h->hechas > 0 ? &h->acciones[h->hechas - 1] : NULL;
+}
+
+const AccionRegistrada* historial_por_rehacer(const GameState* gs) {
+    const Historial* h = &gs->historial;
+    return h->hechas < h->cantidad ? &h->acciones[h->hechas] : NULL;
+}
+
+bool deshacer_accion(GameState* gs) {
+    Historial* h = &gs->historial;
+    if (h->hechas == 0) return false;
+    AccionRegistrada* a = &h->acciones[--h->hechas];
+    switch (a->tipo) {
+        case ACCION_RECOGER:
+            list_removeAfter(gs->inventory, a->anterior);
+            soltar_item(a->item, gs->jugador);
+            break;
+        case ACCION_DESCARTAR:
+            list_insertAfter(gs->inventory, a->anterior, a->nodo);
+            break;
+        case ACCION_MOVER:
+            gs->currentNode = a->escenario;
+            break;
+    }
+    gs->tiempoRestante += a->tiempo;
+    gs->turnos--;
+    return true;
+}
+
+bool rehacer_accion(GameState* gs) {
+    Historial* h = &gs->historial;
+    if (h->hechas == h->cantidad) return false;
+    AccionRegistrada* a = &h->acciones[h->hechas];
+    switch (a->tipo) {
+        case ACCION_RECOGER:
+            if (!reclamar_item(a->item, gs->jugador)) {
+                recortar(gs, h->hechas);    // Lo que sigue suponía tener el ítem
+                return false;
+            }
+            list_insertAfter(gs->inventory, a->anterior, a->nodo);
+            break;
+        case ACCION_DESCARTAR:
+            list_removeAfter(gs->inventory, a->anterior);
+            break;
+        case ACCION_MOVER:
+            gs->currentNode = &gs->grafo->nodes[a->arista->destino];
+            break;
+    }
+    gs->tiempoRestante -= a->tiempo;
+    gs->turnos++;
+    h->hechas++;
+    return true;
+}
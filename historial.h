@@ -0,0 +1,73 @@
+#ifndef HISTORIAL_H
+#define HISTORIAL_H
+
+#include <stdbool.h>
+
+/*
+ * Deshacer y rehacer las acciones de un jugador. Cada acción del motor (recoger_item,
+ * descartar_item, mover_por_arista) anota su inversa: qué ítem y en qué lugar del
+ * inventario, el escenario anterior y el tiempo que gastó. Deshacer y rehacer aplican
+ * esas anotaciones en O(1), sin copiar el estado:
+ *  - El inventario guarda el nodo de lista que se agregó o quitó y el que lo precede;
+ *    como se deshace en orden inverso, el anterior siempre sigue en su lugar. Un ítem
+ *    descartado no se libera mientras la acción se pueda deshacer.
+ *  - Deshacer una recogida devuelve el ítem al mundo (soltar_item): en multijugador los
+ *    demás jugadores vuelven a verlo y pueden tomarlo. Si lo toman, rehacer la recogida
+ *    falla y se descarta lo que quedaba por rehacer.
+ *  - Una acción nueva descarta lo que quedaba por rehacer.
+ */
+
+typedef struct GameState GameState;
+typedef struct Node Node;
+typedef struct Item Item;
+typedef struct Arista Arista;
+typedef struct ListNode ListNode;
+
+typedef enum {
+    ACCION_RECOGER,
+    ACCION_DESCARTAR,
+    ACCION_MOVER
+} TipoAccion;
+
+typedef struct {
+    TipoAccion    tipo;
+    Item*         item;         // RECOGER: ítem del mundo que se reclamó
+    ListNode*     nodo;         // RECOGER / DESCARTAR: nodo que se agregó o quitó del inventario
+    ListNode*     anterior;     // Nodo que lo precede en el inventario (NULL si es el primero)
+    Node*         escenario;    // MOVER: escenario desde el que se avanzó
+    const Arista* arista;       // MOVER
+    int           tiempo;       // Tiempo que gastó la acción
+} AccionRegistrada;
+
+typedef struct {
+    AccionRegistrada* acciones;
+    int               cantidad;     // Anotadas, hechas o deshechas
+    int               hechas;       // Las primeras 'hechas' están aplicadas; las demás se pueden rehacer
+    int               capacidad;
+} Historial;
+
+// Deja el historial vacío (sin reservar memoria).
+void historial_iniciar(Historial* h);
+
+// Libera el historial del jugador y los ítems descartados que guardaba. Se llama antes
+// de destruir su inventario.
+void historial_liberar(GameState* gs);
+
+// Anotan una acción recién hecha. Si no hay memoria para anotarla, el historial se vacía
+// (las acciones anteriores dejan de poder deshacerse) y el nodo descartado se libera.
+void historial_recoger(GameState* gs, Item* item, ListNode* nodo, ListNode* anterior);
+void historial_descartar(GameState* gs, ListNode* nodo, ListNode* anterior);
+void historial_mover(GameState* gs, Node* escenario, const Arista* arista, int tiempo);
+
+// Acción que desharía o reharía el siguiente paso (NULL si no hay).
+const AccionRegistrada* historial_por_deshacer(const GameState* gs);
+const AccionRegistrada* historial_por_rehacer(const GameState* gs);
+
+// Deshace la última acción hecha. Retorna false si no había ninguna.
+bool deshacer_accion(GameState* gs);
+
+// Rehace la última acción deshecha. Retorna false si no había ninguna o si otro jugador
+// tomó el ítem de una recogida (en ese caso ya no queda nada por rehacer).
+bool rehacer_accion(GameState* gs);
+
+#endif // HISTORIAL_H
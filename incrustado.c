@@ -0,0 +1,178 @@
+#include "incrustado.h"
+#include "escritor.h"
+#include "list.h"
+#include "indice.h"
+#include "plano.h"
+#include "consejo.h"
+#include "memoria.h"
+
+#include <string.h>
+
+static void escribir_texto(Escritor* e, const char* texto) {
+    escritor_literal_c(e, texto, strlen(texto));
+}
+
+// Escribe un Texto en memoria (sin fuente ni compresión) con el contenido dado.
+static void escribir_campo_texto(Escritor* e, const char* texto) {
+    escritor_cadena(e, "{ ");
+    escribir_texto(e, texto);
+    escritor_printf(e, ", 0, %zu, false }", strlen(texto));
+}
+
+/*
+ * escribir_items
+ * --------------
+ * Los ítems de todos los escenarios van en un solo arreglo, en el orden de sus listas.
+ * Cada ítem tiene su nodo de lista en 'nodosLista', ya encadenado al siguiente del mismo
+ * escenario, y cada escenario con ítems tiene su List en 'listas' (los escenarios sin
+ * ítems usan NULL, que las funciones de list.h tratan como una lista vacía). Retorna la
+ * cantidad total de ítems.
+ */
+
+static int escribir_items(Escritor* e, const Graph* g) {
+    int total = 0;
+    for (int i = 0; i < g->numberOfNodes; i++) total += list_size(g->nodes[i].state.availableItems);
+    if (total == 0) return 0;
+
+    escritor_printf(e, "static const Item items[%d] = {\n", total);
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        List* lista = g->nodes[i].state.availableItems;
+        for (Item* it = list_first(lista); it; it = list_next(lista)) {
+            escritor_cadena(e, "    { ");
+            escribir_texto(e, it->name);
+            escritor_printf(e, ", %d, %d, ITEM_LIBRE },\n", it->weight, it->value);
+        }
+    }
+
+    escritor_printf(e, "};\n\nstatic const ListNode nodosLista[%d] = {", total);
+    int k = 0;
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        int cantidad = list_size(g->nodes[i].state.availableItems);
+        for (int j = 0; j < cantidad; j++, k++) {
+            escritor_cadena(e, k % 4 == 0 ? "\n    " : " ");
+            if (j + 1 < cantidad) escritor_printf(e, "{ (void*)&items[%d], (ListNode*)&nodosLista[%d] },", k, k + 1);
+            else                  escritor_printf(e, "{ (void*)&items[%d], NULL },", k);
+        }
+    }
+
+    escritor_cadena(e, "\n};\n\n// Se escriben al recorrerlas (cursor de la lista)\nstatic List listas[] = {");
+    k = 0;
+    int listas = 0;
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        int cantidad = list_size(g->nodes[i].state.availableItems);
+        if (cantidad == 0) continue;
+        escritor_cadena(e, listas++ % 2 == 0 ? "\n    " : " ");
+        escritor_printf(e, "{ (ListNode*)&nodosLista[%d], (ListNode*)&nodosLista[%d], NULL, %d, NULL },",
+                        k, k + cantidad - 1, cantidad);
+        k += cantidad;
+    }
+    escritor_cadena(e, "\n};\n\n");
+    return total;
+}
+
+static void escribir_nodos(Escritor* e, const Graph* g) {
+    escritor_printf(e, "static const Node nodos[%d] = {\n", g->numberOfNodes);
+    int listas = 0;
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        const State* s = &g->nodes[i].state;
+        escritor_printf(e, "    { { .id = %d, .name = ", s->id);
+        escribir_campo_texto(e, nombre_escenario(&g->nodes[i]));
+        escritor_cadena(e, ",\n        .description = ");
+        escribir_campo_texto(e, descripcion_escenario(&g->nodes[i]));
+        if (list_size(s->availableItems) > 0) escritor_printf(e, ",\n        .availableItems = &listas[%d]", listas++);
+        escritor_printf(e, ",\n        .esFinal = %s, .componente = %d, .distanciaFinal = %d, .pasosFinal = %d } },\n",
+                        s->esFinal ? "true" : "false", s->componente, s->distanciaFinal, s->pasosFinal);
+    }
+    escritor_cadena(e, "};\n\n");
+}
+
+static void escribir_aristas(Escritor* e, const Graph* g) {
+    escritor_printf(e, "static const int inicioAristas[%d] = {", g->numberOfNodes + 1);
+    for (int i = 0; i <= g->numberOfNodes; i++) {
+        escritor_cadena(e, i % 12 == 0 ? "\n    " : " ");
+        escritor_entero(e, g->inicioAristas[i]);
+        escritor_cadena(e, ",");
+    }
+    // Al menos una posición: un arreglo de C no puede estar vacío
+    escritor_printf(e, "\n};\n\nstatic const Arista aristas[%d] = {\n", g->numAristas > 0 ? g->numAristas : 1);
+    for (int k = 0; k < g->numAristas; k++) {
+        const Arista* a = &g->aristas[k];
+        escritor_printf(e, "    { %d, %d, %d, ", a->destino, a->costo, a->direccion);
+        escribir_texto(e, a->etiqueta);
+        escritor_cadena(e, " },\n");
+    }
+    if (g->numAristas == 0) escritor_cadena(e, "    { 0, 0, -1, \"\" },\n");
+    escritor_cadena(e, "};\n\n");
+}
+
+/**
+ * incrustar_mapa
+ * --------------
+ * Escribe, en este orden: los ítems y sus listas, los nodos (con los textos ya
+ * materializados, aunque el mapa se haya leído con textos diferidos o comprimidos), las
+ * aristas en formato CSR, el índice de nombres (indice_generar_c), el plano
+ * (plano_generar_c), el orden de los ítems (orden_items_generar_c) y la estructura 'mapaIncrustado' que los reúne.
+ *
+ * Consideraciones:
+ *  - Los textos son literales: el enlazador guarda una sola vez los repetidos.
+ *  - Los nodos quedan en el orden que tienen en memoria (--reorder se aplica al generar).
+ *  - Como todo se escribe en flujo por un Escritor, sirve para mapas de millones de escenarios.
+ */
+
+bool incrustar_mapa(const Graph* g, const char* nombre, FILE* destino) {
+    if (!g || g->numberOfNodes == 0) return false;
+
+    Escritor* e = mem_reservar(MEM_INTERFAZ, sizeof(Escritor));
+    if (!e) return false;
+    escritor_iniciar(e, destino);
+
+    escritor_cadena(e, "// Generado por graphquest --embed a partir de ");
+    escritor_cadena(e, nombre);
+    escritor_cadena(e, ". No editar.\n\n#ifndef MAPA_INCRUSTADO\n#define MAPA_INCRUSTADO\n#endif\n\n"
+                       "#include \"incrustado.h\"\n#include \"list.h\"\n#include \"indice.h\"\n#include \"plano.h\"\n#include \"consejo.h\"\n\n");
+
+    escribir_items(e, g);
+    escribir_nodos(e, g);
+    escribir_aristas(e, g);
+    if (g->indice) indice_generar_c(g->indice, e);
+    if (g->plano) plano_generar_c(g->plano, g->numberOfNodes, e);
+    if (g->ordenItems) orden_items_generar_c(g->ordenItems, g->numberOfNodes, e);
+
+    escritor_cadena(e, "const MapaEstatico mapaIncrustado = {\n    ");
+    escribir_texto(e, nombre);
+    escritor_printf(e, ", nodos, %d, %d, inicioAristas, aristas, %d,\n", g->numberOfNodes,
+                    g->start ? (int)(g->start - g->nodes) : 0, g->numAristas);
+    escritor_printf(e, "    %s, %s, { %d, %d, %d }, 0x%016llxULL, %s\n};\n", g->indice ? "&indice" : "NULL",
+                    g->plano ? "&plano" : "NULL", g->alcance.componentes, g->alcance.sinSalida,
+                    g->alcance.distanciaInicio, g->huella, g->ordenItems ? "&ordenItems" : "NULL");
+
+    escritor_vaciar(e);
+    mem_liberar(e);
+    return !ferror(destino);
+}
+
+/**
+ * grafo_desde_estatico
+ * --------------------
+ * Los punteros del grafo no son const, pero ni el grafo original ni sus copias escriben
+ * en los nodos, aristas, índice o plano: el juego solo modifica las copias que hace
+ * copiar_grafo, que reservan nodos e ítems propios.
+ */
+
+void grafo_desde_estatico(Graph* g, const MapaEstatico* mapa) {
+    *g = (Graph){
+        .nodes = (Node*)mapa->nodos,
+        .numberOfNodes = mapa->numNodos,
+        .capacidad = mapa->numNodos,
+        .start = (Node*)&mapa->nodos[mapa->inicio],
+        .inicioAristas = (int*)mapa->inicioAristas,
+        .aristas = (Arista*)mapa->aristas,
+        .numAristas = mapa->numAristas,
+        .indice = (IndiceNombres*)mapa->indice,
+        .plano = (Plano*)mapa->plano,
+        .alcance = mapa->alcance,
+        .huella = mapa->huella,
+        .ordenItems = (OrdenItems*)mapa->ordenItems,
+        .esEstatico = true
+    };
+}
@@ -0,0 +1,49 @@
+#ifndef INCRUSTADO_H
+#define INCRUSTADO_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "grafo.h"
+
+/*
+ * Mapas incrustados en el ejecutable. La opción --embed lee un mapa y escribe un archivo
+ * de C con sus escenarios, aristas, ítems, textos, índices y plano como tablas
+ * 'static const', con todos los índices ya resueltos. Compilando ese archivo junto al
+ * juego con -DMAPA_INCRUSTADO, el juego comienza con el mapa cargado:
+ * grafo_desde_estatico solo apunta el grafo a las tablas, sin leer ni reservar nada.
+ *
+ * Las tablas quedan en las páginas de solo lectura del ejecutable, compartidas entre
+ * todos los procesos que lo ejecutan. Las únicas que se escriben son las listas de ítems
+ * (su cursor avanza al recorrerlas). Las partidas juegan sobre copias, igual que con
+ * un mapa leído del CSV.
+ */
+
+// Tablas de un mapa incrustado, generadas por incrustar_mapa.
+typedef struct {
+    const char*   nombre;           // Archivo del que se generó
+    const Node*   nodos;
+    int           numNodos;
+    int           inicio;           // Índice del nodo inicial en 'nodos'
+    const int*    inicioAristas;
+    const Arista* aristas;
+    int           numAristas;
+    const IndiceNombres* indice;
+    const Plano*  plano;
+    ResumenAlcance alcance;
+    unsigned long long huella;      // Ver huella_mapa
+    const OrdenItems* ordenItems;
+} MapaEstatico;
+
+// Escribe el grafo como archivo de C que define 'mapaIncrustado'. 'nombre' es el archivo
+// del que se leyó. Retorna false si falló la escritura o no hay memoria para el búfer.
+bool incrustar_mapa(const Graph* g, const char* nombre, FILE* destino);
+
+// Deja en 'g' el mapa incrustado, apuntando a sus tablas (sin reservar memoria). El grafo
+// queda marcado como estático: liberarEscenarios no toca sus datos.
+void grafo_desde_estatico(Graph* g, const MapaEstatico* mapa);
+
+#ifdef MAPA_INCRUSTADO
+extern const MapaEstatico mapaIncrustado;
+#endif
+
+#endif // INCRUSTADO_H
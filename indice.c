@@ -0,0 +1,232 @@
+#include "indice.h"
+#include "grafo.h"
+#include "list.h"
+#include "memoria.h"
+#include "escritor.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// FNV-1a de 64 bits sobre el nombre normalizado.
+static unsigned long long hash_nombre(const char* nombre) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (const unsigned char* p = (const unsigned char*)nombre; *p; p++) {
+        h ^= (unsigned char)tolower(*p);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static bool nombres_iguales(const char* normalizado, const char* nombre) {
+    const unsigned char* a = (const unsigned char*)normalizado;
+    const unsigned char* b = (const unsigned char*)nombre;
+    while (*a && *a == (unsigned char)tolower(*b)) { a++; b++; }
+    return *a == '\0' && *b == '\0';
+}
+
+static bool tabla_crear(TablaIndice* t, size_t elementos) {
+    t->capacidad = 8;
+    while (t->capacidad < elementos * 2) t->capacidad *= 2;
+    t->entradas = mem_reservar(MEM_GRAFO, sizeof(EntradaIndice) * t->capacidad);
+    if (!t->entradas) return false;
+    for (size_t i = 0; i < t->capacidad; i++) {
+        t->entradas[i].clave = -1;
+        t->entradas[i].cantidad = 0;
+    }
+    return true;
+}
+
+// Retorna la casilla con el nombre, o la casilla vacía donde debería insertarse.
+static EntradaIndice* tabla_casilla(const TablaIndice* t, const char* textos, const char* nombre, unsigned long long h) {
+    size_t mascara = t->capacidad - 1;
+    for (size_t i = h & mascara;; i = (i + 1) & mascara) {
+        EntradaIndice* e = &t->entradas[i];
+        if (e->clave < 0) return e;
+        if (e->hash == h && nombres_iguales(textos + e->clave, nombre)) return e;
+    }
+}
+
+// Busca el nombre y, si no está, lo inserta copiando su forma normalizada a 'textos'.
+static EntradaIndice* tabla_obtener(IndiceNombres* indice, TablaIndice* t, const char* nombre, bool* nueva) {
+    unsigned long long h = hash_nombre(nombre);
+    EntradaIndice* e = tabla_casilla(t, indice->textos, nombre, h);
+    *nueva = (e->clave < 0);
+    if (*nueva) {
+        e->hash = h;
+        e->clave = (int)indice->usoTextos;
+        for (const char* p = nombre; *p; p++) {
+            indice->textos[indice->usoTextos++] = (char)tolower((unsigned char)*p);
+        }
+        indice->textos[indice->usoTextos++] = '\0';
+    }
+    return e;
+}
+
+/**
+ * indice_construir
+ * -----------------
+ * Construye, en tiempo lineal, los índices por nombre de un grafo recién cargado:
+ *  - nombre de escenario → índice del nodo en graph.nodes.
+ *  - nombre de ítem → lista de ubicaciones (nodo, posición en availableItems).
+ *
+ * Consideraciones:
+ *  - Si dos escenarios comparten nombre, el índice conserva el primero.
+ *  - Las ubicaciones se expresan como índices, por lo que también son válidas
+ *    en las copias del grafo hechas con copiar_grafo.
+ *  - Retorna NULL si no hay memoria suficiente.
+ */
+
+IndiceNombres* indice_construir(const Graph* g) {
+    IndiceNombres* indice = mem_reservar_ceros(MEM_GRAFO, 1, sizeof(IndiceNombres));
+    if (!indice) return NULL;
+
+    size_t totalItems = 0, totalTexto = 0;
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        List* items = g->nodes[i].state.availableItems;
+        totalTexto += strlen(nombre_escenario(&g->nodes[i])) + 1;
+        for (Item* it = list_first(items); it != NULL; it = list_next(items)) {
+            totalTexto += strlen(it->name) + 1;
+            totalItems++;
+        }
+    }
+
+    indice->textos = mem_reservar(MEM_GRAFO, totalTexto + 1);
+    indice->ubicaciones = mem_reservar(MEM_GRAFO, sizeof(UbicacionItem) * (totalItems + 1));
+    if (!indice->textos || !indice->ubicaciones ||
+        !tabla_crear(&indice->escenarios, g->numberOfNodes) ||
+        !tabla_crear(&indice->items, totalItems)) {
+        indice_liberar(indice);
+        return NULL;
+    }
+    indice->bytes = sizeof(IndiceNombres) + totalTexto + 1 + sizeof(UbicacionItem) * (totalItems + 1) +
+                    sizeof(EntradaIndice) * (indice->escenarios.capacidad + indice->items.capacidad);
+
+    // Primera pasada: escenarios y conteo de ubicaciones por ítem
+    bool nueva;
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        EntradaIndice* e = tabla_obtener(indice, &indice->escenarios, nombre_escenario(&g->nodes[i]), &nueva);
+        if (nueva) e->valor = i;
+
+        List* items = g->nodes[i].state.availableItems;
+        for (Item* it = list_first(items); it != NULL; it = list_next(items)) {
+            tabla_obtener(indice, &indice->items, it->name, &nueva)->cantidad++;
+        }
+    }
+
+    // Reservar un tramo contiguo de ubicaciones para cada ítem
+    int desplazamiento = 0;
+    for (size_t k = 0; k < indice->items.capacidad; k++) {
+        EntradaIndice* e = &indice->items.entradas[k];
+        if (e->clave < 0) continue;
+        e->valor = desplazamiento;
+        desplazamiento += e->cantidad;
+        e->cantidad = 0;
+    }
+
+    // Segunda pasada: llenar las ubicaciones
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        List* items = g->nodes[i].state.availableItems;
+        int posicion = 0;
+        for (Item* it = list_first(items); it != NULL; it = list_next(items), posicion++) {
+            EntradaIndice* e = tabla_casilla(&indice->items, indice->textos, it->name, hash_nombre(it->name));
+            UbicacionItem* u = &indice->ubicaciones[e->valor + e->cantidad++];
+            u->nodo = i;
+            u->posicion = posicion;
+        }
+    }
+
+    return indice;
+}
+
+void indice_liberar(IndiceNombres* indice) {
+    if (!indice) return;
+    mem_liberar(indice->escenarios.entradas);
+    mem_liberar(indice->items.entradas);
+    mem_liberar(indice->ubicaciones);
+    mem_liberar(indice->textos);
+    mem_liberar(indice);
+}
+
+size_t indice_memoria(const IndiceNombres* indice) {
+    return indice ? indice->bytes : 0;
+}
+
+/**
+ * indice_buscar_escenario
+ * ------------------------
+ * Búsqueda O(1) esperada del nodo cuyo escenario tiene el nombre dado
+ * (sin distinguir mayúsculas). Retorna -1 si no existe.
+ */
+
+int indice_buscar_escenario(const IndiceNombres* indice, const char* nombre) {
+    if (!indice || !nombre) return -1;
+    EntradaIndice* e = tabla_casilla(&indice->escenarios, indice->textos, nombre, hash_nombre(nombre));
+    return e->clave < 0 ? -1 : e->valor;
+}
+
+/**
+ * indice_buscar_item
+ * -------------------
+ * Búsqueda O(1) esperada de todas las ubicaciones del ítem con el nombre dado.
+ * Retorna un puntero a las ubicaciones (válido mientras viva el índice) y deja
+ * su número en 'cantidad'; si el ítem no existe retorna NULL y cantidad = 0.
+ */
+
+const UbicacionItem* indice_buscar_item(const IndiceNombres* indice, const char* nombre, int* cantidad) {
+    *cantidad = 0;
+    if (!indice || !nombre) return NULL;
+    EntradaIndice* e = tabla_casilla(&indice->items, indice->textos, nombre, hash_nombre(nombre));
+    if (e->clave < 0) return NULL;
+    *cantidad = e->cantidad;
+    return &indice->ubicaciones[e->valor];
+}
+
+static void generar_tabla(const TablaIndice* t, const char* nombre, Escritor* e) {
+    escritor_printf(e, "static const EntradaIndice %s[%zu] = {", nombre, t->capacidad);
+    for (size_t k = 0; k < t->capacidad; k++) {
+        const EntradaIndice* entrada = &t->entradas[k];
+        escritor_cadena(e, k % 4 == 0 ? "\n    " : " ");
+        if (entrada->clave < 0) {
+            escritor_cadena(e, "{ 0, -1, 0, 0 },");
+        } else {
+            escritor_printf(e, "{ 0x%016llxULL, %d, %d, %d },", entrada->hash, entrada->clave, entrada->valor,
+                            entrada->cantidad);
+        }
+    }
+    escritor_cadena(e, "\n};\n\n");
+}
+
+/**
+ * indice_generar_c
+ * ----------------
+ * Escribe las tablas del índice (indiceEscenarios, indiceItems, indiceUbicaciones e
+ * indiceTextos) y la estructura 'indice' que las reúne, todas 'static const'. Las
+ * casillas quedan en las mismas posiciones, así que las búsquedas no cambian.
+ */
+
+void indice_generar_c(const IndiceNombres* indice, Escritor* e) {
+    generar_tabla(&indice->escenarios, "indiceEscenarios", e);
+    generar_tabla(&indice->items, "indiceItems", e);
+
+    size_t ubicaciones = 0;
+    for (size_t k = 0; k < indice->items.capacidad; k++) {
+        if (indice->items.entradas[k].clave >= 0) ubicaciones += (size_t)indice->items.entradas[k].cantidad;
+    }
+    escritor_printf(e, "static const UbicacionItem indiceUbicaciones[%zu] = {", ubicaciones + 1);
+    for (size_t k = 0; k < ubicaciones; k++) {
+        escritor_cadena(e, k % 8 == 0 ? "\n    " : " ");
+        escritor_printf(e, "{ %d, %d },", indice->ubicaciones[k].nodo, indice->ubicaciones[k].posicion);
+    }
+    escritor_cadena(e, "\n};\n\nstatic const char indiceTextos[] =\n    ");
+    escritor_literal_c(e, indice->textos, indice->usoTextos);
+    escritor_cadena(e, ";\n\n");
+
+    escritor_printf(e,
+        "static const IndiceNombres indice = {\n"
+        "    { (EntradaIndice*)indiceEscenarios, %zu },\n"
+        "    { (EntradaIndice*)indiceItems, %zu },\n"
+        "    (UbicacionItem*)indiceUbicaciones, (char*)indiceTextos, %zu, 0\n"
+        "};\n\n",
+        indice->escenarios.capacidad, indice->items.capacidad, indice->usoTextos);
+}
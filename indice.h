@@ -0,0 +1,67 @@
+#ifndef INDICE_H
+#define INDICE_H
+
+#include <stddef.h>
+
+typedef struct Graph Graph;
+typedef struct Escritor Escritor;
+
+// Posición de un ítem dentro del grafo: nodo (índice en graph.nodes) y posición en su lista de ítems.
+typedef struct {
+    int nodo;
+    int posicion;
+} UbicacionItem;
+
+/*
+ * Índices por nombre con direccionamiento abierto (sondeo lineal).
+ *
+ * Las claves se guardan normalizadas (letras ASCII en minúscula) en un único
+ * bloque de texto propio del índice, así que las búsquedas no distinguen
+ * mayúsculas y el índice no depende de la vida del grafo del que se construyó.
+ * Las ubicaciones de cada ítem quedan contiguas en un solo arreglo: la entrada
+ * del ítem guarda dónde empiezan y cuántas son.
+ *
+ * Las estructuras son públicas para que los mapas incrustados (ver incrustado.h) traigan
+ * el índice ya construido; el resto del código usa las funciones.
+ */
+
+typedef struct {
+    unsigned long long hash;
+    int clave;      // Desplazamiento del nombre en 'textos' (-1 si la casilla está vacía)
+    int valor;      // Escenarios: índice del nodo. Ítems: primera ubicación en 'ubicaciones'
+    int cantidad;   // Ítems: cantidad de ubicaciones (en escenarios no se usa)
+} EntradaIndice;
+
+typedef struct {
+    EntradaIndice* entradas;
+    size_t capacidad;   // Siempre potencia de 2
+} TablaIndice;
+
+typedef struct IndiceNombres {
+    TablaIndice escenarios;
+    TablaIndice items;
+    UbicacionItem* ubicaciones;
+    char* textos;
+    size_t usoTextos;
+    size_t bytes;       // Memoria reservada por el índice (0 si es estático, ver indice_memoria)
+} IndiceNombres;
+
+// Construye los índices por nombre (escenarios e ítems) del grafo recién cargado.
+IndiceNombres* indice_construir(const Graph* g);
+
+// Libera los índices construidos con indice_construir.
+void indice_liberar(IndiceNombres* indice);
+
+// Bytes que ocupa el índice en memoria.
+size_t indice_memoria(const IndiceNombres* indice);
+
+// Retorna el índice del nodo cuyo escenario se llama 'nombre', o -1 si no existe.
+int indice_buscar_escenario(const IndiceNombres* indice, const char* nombre);
+
+// Retorna las ubicaciones del ítem 'nombre' y deja su cantidad en 'cantidad' (NULL si no existe).
+const UbicacionItem* indice_buscar_item(const IndiceNombres* indice, const char* nombre, int* cantidad);
+
+// Escribe el índice como tablas de C 'static const' (ver incrustado.h).
+void indice_generar_c(const IndiceNombres* indice, Escritor* e);
+
+#endif // INDICE_H
@@ -0,0 +1,364 @@
+#include "libgraphquest.h"
+#include "grafo.h"
+#include "game.h"
+#include "extra.h"
+#include "list.h"
+#include "memoria.h"
+#include "bot.h"
+#include "consejo.h"
+#include "exportar.h"
+#include "historial.h"
+
+#include <string.h>
+#include <ctype.h>
+#include <stdatomic.h>
+
+_Static_assert(GQ_MAXRECOGER == MAXCANDIDATOSCONSEJO && GQ_MAXDESCARTAR == MAXINVENTARIOCONSEJO,
+               "gq_advice debe poder guardar cualquier Consejo");
+
+struct gq_world {
+    Graph*      grafo;          // &propio, o el grafo de quien llamó a gq_world_wrap
+    Graph       propio;
+    bool        esPropio;
+    _Atomic int referencias;    // La de quien lo creó más una por sesión
+};
+
+struct gq_session {
+    gq_world*             mundo;
+    GameStateMultiplayer* partida;      // Copia del mundo y estado de cada jugador
+    int                   presupuestoBot;
+};
+
+/* ------------------------------------------------------------------ */
+/*  Mundos                                                             */
+/* ------------------------------------------------------------------ */
+
+gq_world* gq_world_load(const char* ruta, const gq_options* opciones) {
+    static const OrdenNodos ordenes[] = { ORDEN_ARCHIVO, ORDEN_BFS, ORDEN_RCM };
+    gq_options pedidas = opciones ? *opciones : (gq_options){ 0 };
+    OpcionesCarga carga = {
+        .estricto = pedidas.estricto,
+        .descripcionesDiferidas = pedidas.descripcionesDiferidas,
+        .nombresDiferidos = pedidas.nombresDiferidos,
+        .comprimirDescripciones = pedidas.comprimirDescripciones,
+        .orden = pedidas.orden <= GQ_ORDEN_RCM ? ordenes[pedidas.orden] : ORDEN_ARCHIVO,
+        .silencioso = true
+    };
+
+    gq_world* mundo = mem_reservar_ceros(MEM_GRAFO, 1, sizeof(gq_world));
+    if (!mundo) return NULL;
+    if (!cargar_mapa_en(&mundo->propio, ruta, &carga)) {
+        mem_liberar(mundo);
+        return NULL;
+    }
+    mundo->grafo = &mundo->propio;
+    mundo->esPropio = true;
+    atomic_init(&mundo->referencias, 1);
+    return mundo;
+}
+
+gq_world* gq_world_wrap(const Graph* grafo) {
+    if (!grafo || grafo->numberOfNodes == 0) return NULL;
+    gq_world* mundo = mem_reservar_ceros(MEM_GRAFO, 1, sizeof(gq_world));
+    if (!mundo) return NULL;
+    mundo->grafo = (Graph*)grafo;       // Solo se lee: las sesiones juegan sobre copias
+    atomic_init(&mundo->referencias, 1);
+    return mundo;
+}
+
+// El último en soltarlo lo libera. El orden acquire/release hace que ese hilo vea todo lo
+// que las sesiones hicieron antes de soltarlo.
+static void soltar_mundo(gq_world* mundo) {
+    if (atomic_fetch_sub_explicit(&mundo->referencias, 1, memory_order_acq_rel) != 1) return;
+    if (mundo->esPropio) liberarJuego(&mundo->propio);
+    mem_liberar(mundo);
+}
+
+void gq_world_release(gq_world* mundo) {
+    if (mundo) soltar_mundo(mundo);
+}
+
+int gq_world_scenarios(const gq_world* mundo) {
+    return mundo->grafo->numberOfNodes;
+}
+
+unsigned long long gq_world_fingerprint(const gq_world* mundo) {
+    return mundo->grafo->huella;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Sesiones                                                           */
+/* ------------------------------------------------------------------ */
+
+gq_session* gq_session_new(gq_world* mundo, int jugadores) {
+    if (!mundo) return NULL;
+    gq_session* sesion = mem_reservar(MEM_PARTIDAS, sizeof(gq_session));
+    if (!sesion) return NULL;
+    sesion->partida = crear_partida_compartida(mundo->grafo, jugadores);
+    if (!sesion->partida) {
+        mem_liberar(sesion);
+        return NULL;
+    }
+    atomic_fetch_add_explicit(&mundo->referencias, 1, memory_order_relaxed);
+    sesion->mundo = mundo;
+    sesion->presupuestoBot = PRESUPUESTOBOT;
+    return sesion;
+}
+
+void gq_session_free(gq_session* sesion) {
+    if (!sesion) return;
+    liberar_partida_compartida(sesion->partida);
+    soltar_mundo(sesion->mundo);
+    mem_liberar(sesion);
+}
+
+void gq_session_set_bot_budget(gq_session* sesion, int microsegundos) {
+    sesion->presupuestoBot = microsegundos < 10 ? 10 : microsegundos;
+}
+
+static GameState* jugador_de(const gq_session* sesion, int jugador) {
+    if (!sesion || jugador < 0 || jugador >= sesion->partida->numJugadores) return NULL;
+    return &sesion->partida->jugadores[jugador];
+}
+
+// Jugador que existe y todavía puede jugar. Deja el resultado de no poder en *error.
+static GameState* jugador_en_juego(const gq_session* sesion, int jugador, gq_result* error) {
+    GameState* gs = jugador_de(sesion, jugador);
+    *error = !gs ? GQ_INVALIDA : GQ_TERMINADA;
+    return gs && !jugador_terminado(gs) ? gs : NULL;
+}
+
+gq_result gq_session_restart(gq_session* sesion, int jugador) {
+    GameState* gs = jugador_de(sesion, jugador);
+    if (!gs) return GQ_INVALIDA;
+    liberar_jugador(gs);
+    gs->currentNode = gs->grafo->start;
+    gs->inventory = lista_items_crear();
+    gs->tiempoRestante = TIEMPOINICIAL;
+    gs->turnos = 0;
+    historial_iniciar(&gs->historial);
+    return GQ_OK;
+}
+
+gq_result gq_session_state(const gq_session* sesion, int jugador, gq_state* estado) {
+    const GameState* gs = jugador_de(sesion, jugador);
+    if (!gs) return GQ_INVALIDA;
+    *estado = (gq_state){ .escenario = gs->currentNode->state.id, .tiempo = gs->tiempoRestante, .turnos = gs->turnos };
+    // Sin el cursor de la lista (list_first): la consulta no modifica la sesión
+    for (const ListNode* ln = gs->inventory->head; ln; ln = ln->next) {
+        const Item* item = ln->data;
+        estado->puntaje += item->value;
+        estado->peso += item->weight;
+        estado->inventario++;
+    }
+    if (gs->tiempoRestante <= 0) estado->estado = GQ_SIN_TIEMPO;
+    else if (gs->currentNode->state.esFinal) estado->estado = GQ_FINAL;
+    else if (partida_sin_salida(gs)) estado->estado = GQ_SIN_SALIDA;
+    else estado->estado = GQ_JUGANDO;
+    return GQ_OK;
+}
+
+size_t gq_session_scenario_text(const gq_session* sesion, int jugador, bool descripcion, char* texto, size_t tam) {
+    const GameState* gs = jugador_de(sesion, jugador);
+    if (!gs) return 0;
+    const char* fuente = descripcion ? descripcion_escenario(gs->currentNode) : nombre_escenario(gs->currentNode);
+    size_t largo = strlen(fuente);
+    if (tam > 0) {
+        size_t copiar = largo < tam - 1 ? largo : tam - 1;
+        memcpy(texto, fuente, copiar);
+        texto[copiar] = '\0';
+    }
+    return largo;
+}
+
+static gq_item describir_item(const Item* item, int numero) {
+    return (gq_item){ numero, item->name, item->value, item->weight };
+}
+
+// Número con que gq_session_pick recoge el ítem del escenario actual (ver item_disponible_en).
+static int numero_en_escenario(const GameState* gs, const Item* item) {
+    int numero = 0;
+    const List* lista = gs->currentNode->state.availableItems;
+    for (const ListNode* ln = lista ? lista->head : NULL; ln; ln = ln->next) {
+        if (ln->data == item) return numero;
+        if (item_disponible(ln->data)) numero++;
+    }
+    return -1;
+}
+
+int gq_session_items(const gq_session* sesion, int jugador, bool inventario, gq_item* items, int max) {
+    const GameState* gs = jugador_de(sesion, jugador);
+    if (!gs) return -1;
+    const List* lista = inventario ? gs->inventory : gs->currentNode->state.availableItems;
+    int cantidad = 0;
+    for (const ListNode* ln = lista ? lista->head : NULL; ln; ln = ln->next) {
+        if (!inventario && !item_disponible(ln->data)) continue;
+        if (cantidad < max) items[cantidad] = describir_item(ln->data, inventario ? cantidad + 1 : cantidad);
+        cantidad++;
+    }
+    return cantidad;
+}
+
+int gq_session_exits(const gq_session* sesion, int jugador, gq_exit* salidas, int max) {
+    const GameState* gs = jugador_de(sesion, jugador);
+    if (!gs) return -1;
+    int numAristas;
+    const Arista* aristas = aristas_de(gs->grafo, gs->currentNode, &numAristas);
+    for (int k = 0; k < numAristas && k < max; k++) {
+        salidas[k] = (gq_exit){ opcion_de_arista(aristas, k), aristas[k].etiqueta,
+                                gs->grafo->nodes[aristas[k].destino].state.id, aristas[k].costo };
+    }
+    return numAristas;
+}
+
+static void anotar_hecha(gq_action* hecha, gq_action accion) {
+    if (hecha) *hecha = accion;
+}
+
+gq_result gq_session_pick(gq_session* sesion, int jugador, int numero, gq_action* hecha) {
+    gq_result error;
+    GameState* gs = jugador_en_juego(sesion, jugador, &error);
+    if (!gs) return error;
+    Item* item = item_disponible_en(gs->currentNode, numero);
+    if (!item) return GQ_INVALIDA;
+    if (!recoger_item(gs, item)) return GQ_TOMADO;
+    anotar_hecha(hecha, (gq_action){ .tipo = GQ_RECOGER, .item = describir_item(item, numero) });
+    return GQ_OK;
+}
+
+gq_result gq_session_drop(gq_session* sesion, int jugador, int numero, gq_action* hecha) {
+    gq_result error;
+    GameState* gs = jugador_en_juego(sesion, jugador, &error);
+    if (!gs) return error;
+    // Se describe antes: al descartarlo, el ítem pasa al historial
+    const ListNode* ln = gs->inventory->head;
+    for (int i = 1; ln && i < numero; i++) ln = ln->next;
+    if (numero < 1 || !ln) return GQ_INVALIDA;
+    gq_item item = describir_item(ln->data, numero);
+    descartar_item(gs, numero - 1);
+    anotar_hecha(hecha, (gq_action){ .tipo = GQ_DESCARTAR, .item = item });
+    return GQ_OK;
+}
+
+static bool iguales_sin_mayusculas(const char* a, const char* b) {
+    while (*a && tolower((unsigned char)*a) == tolower((unsigned char)*b)) { a++; b++; }
+    return *a == '\0' && *b == '\0';
+}
+
+// Busca la arista por número de opción, por nombre de dirección o etiqueta, o por su
+// nombre en inglés (up, down, left, right).
+static const Arista* buscar_arista(const GameState* gs, const char* texto) {
+    int opcion;
+    if (texto_a_entero(texto, &opcion)) return arista_por_opcion(gs, opcion);
+
+    static const char* const alias[MAXDIR] = {"up", "down", "left", "right"};
+    int numAristas;
+    const Arista* aristas = aristas_de(gs->grafo, gs->currentNode, &numAristas);
+    for (int k = 0; k < numAristas; k++) {
+        const Arista* a = &aristas[k];
+        if (iguales_sin_mayusculas(a->etiqueta, texto)) return a;
+        if (a->direccion >= 0 && iguales_sin_mayusculas(alias[a->direccion], texto)) return a;
+    }
+    return NULL;
+}
+
+static int opcion_de(const GameState* gs, const Arista* arista) {
+    int numAristas;
+    const Arista* aristas = aristas_de(gs->grafo, gs->currentNode, &numAristas);
+    return opcion_de_arista(aristas, (int)(arista - aristas));
+}
+
+gq_result gq_session_move(gq_session* sesion, int jugador, const char* direccion, gq_action* hecha) {
+    gq_result error;
+    GameState* gs = jugador_en_juego(sesion, jugador, &error);
+    if (!gs) return error;
+    const Arista* arista = buscar_arista(gs, direccion);
+    if (!arista) return GQ_INVALIDA;
+    int opcion = opcion_de(gs, arista);
+    int gasto = mover_por_arista(gs, arista);
+    anotar_hecha(hecha, (gq_action){ .tipo = GQ_MOVER, .opcion = opcion, .gasto = gasto });
+    return GQ_OK;
+}
+
+static const gq_action_type tiposAccion[] = { GQ_RECOGER, GQ_DESCARTAR, GQ_MOVER };  // Por TipoAccion
+
+gq_result gq_session_undo(gq_session* sesion, int jugador, gq_action_type* tipo) {
+    GameState* gs = jugador_de(sesion, jugador);
+    const AccionRegistrada* accion = gs ? historial_por_deshacer(gs) : NULL;
+    if (!accion) return GQ_INVALIDA;
+    if (tipo) *tipo = tiposAccion[accion->tipo];
+    deshacer_accion(gs);
+    return GQ_OK;
+}
+
+gq_result gq_session_redo(gq_session* sesion, int jugador, gq_action_type* tipo) {
+    GameState* gs = jugador_de(sesion, jugador);
+    const AccionRegistrada* accion = gs ? historial_por_rehacer(gs) : NULL;
+    if (!accion) return GQ_INVALIDA;
+    if (tipo) *tipo = tiposAccion[accion->tipo];
+    return rehacer_accion(gs) ? GQ_OK : GQ_TOMADO;
+}
+
+// Jugadores de la sesión que siguen en juego, sin contar a 'gs'.
+static int rivales_de(const gq_session* sesion, const GameState* gs) {
+    int rivales = 0;
+    for (int i = 0; i < sesion->partida->numJugadores; i++) {
+        const GameState* otro = &sesion->partida->jugadores[i];
+        if (otro != gs && !jugador_terminado(otro)) rivales++;
+    }
+    return rivales;
+}
+
+// La decisión como gq_action, con los números que tiene antes de aplicarla.
+static gq_action describir_decision(const GameState* gs, const DecisionBot* decision) {
+    gq_action accion = { .tipo = GQ_NINGUNA, .profundidad = decision->profundidad };
+    if (decision->tipo == BOT_RECOGER) {
+        accion.tipo = GQ_RECOGER;
+        accion.item = describir_item(decision->item, numero_en_escenario(gs, decision->item));
+    } else if (decision->tipo == BOT_DESCARTAR) {
+        const ListNode* ln = gs->inventory->head;
+        for (int i = 0; ln && i < decision->posicion; i++) ln = ln->next;
+        accion.tipo = GQ_DESCARTAR;
+        if (ln) accion.item = describir_item(ln->data, decision->posicion + 1);
+    } else if (decision->tipo == BOT_MOVER) {
+        accion.tipo = GQ_MOVER;
+        accion.opcion = opcion_de(gs, decision->arista);
+    }
+    return accion;
+}
+
+gq_result gq_session_bot(gq_session* sesion, int jugador, gq_action* hecha) {
+    gq_result error;
+    GameState* gs = jugador_en_juego(sesion, jugador, &error);
+    if (!gs) return error;
+    DecisionBot decision = bot_decidir_con(gs, rivales_de(sesion, gs), sesion->presupuestoBot);
+    if (decision.tipo == BOT_NINGUNA) return GQ_TERMINADA;
+    gq_action accion = describir_decision(gs, &decision);
+    if (!bot_aplicar(gs, &decision, &accion.gasto)) return GQ_TOMADO;
+    anotar_hecha(hecha, accion);
+    return GQ_OK;
+}
+
+gq_result gq_session_suggest(const gq_session* sesion, int jugador, gq_advice* consejo) {
+    gq_result error;
+    const GameState* gs = jugador_en_juego(sesion, jugador, &error);
+    if (!gs) return error;
+    Consejo c;
+    aconsejar_items(gs, &c);
+    *consejo = (gq_advice){ .llega = c.llega, .numRecoger = c.numRecoger, .numDescartar = c.numDescartar,
+                            .puntaje = c.puntaje, .peso = c.peso, .tiempoFinal = c.tiempoFinal };
+    for (int i = 0; i < c.numRecoger; i++) {
+        consejo->recoger[i] = describir_item(c.recoger[i], numero_en_escenario(gs, c.recoger[i]));
+    }
+    for (int i = 0; i < c.numDescartar; i++) consejo->descartar[i] = c.descartar[i] + 1;
+    DecisionBot siguiente = siguiente_consejo(&c);
+    consejo->siguiente = describir_decision(gs, &siguiente);
+    return GQ_OK;
+}
+
+bool gq_session_export(const gq_session* sesion, const char* formato, FILE* destino) {
+    FormatoExportacion elegido;
+    if (!formato_exportacion(formato, &elegido)) return false;
+    return exportar_grafo(sesion->partida->grafo, sesion->partida->jugadores, sesion->partida->numJugadores,
+                          elegido, destino);
+}
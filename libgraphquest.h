@@ -0,0 +1,192 @@
+#ifndef LIBGRAPHQUEST_H
+#define LIBGRAPHQUEST_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * libgraphquest: el motor del juego como biblioteca reentrante, para usarlo desde otros
+ * programas (servidores, herramientas, pruebas) sin pasar por los menús.
+ *
+ *  - gq_world: un mapa cargado. No cambia después de cargarlo, así que cualquier cantidad
+ *    de hilos puede crear sesiones sobre él a la vez. Cuenta referencias: cada sesión
+ *    retiene su mundo, y se libera cuando se sueltan el mundo y todas sus sesiones.
+ *  - gq_session: una partida de uno o más jugadores sobre una copia propia del mundo (los
+ *    ítems reclamados, las posiciones y los inventarios son de la sesión). Se usa desde
+ *    un hilo a la vez; sesiones distintas no comparten nada que se escriba.
+ *
+ * Nada de esto usa el estado global del programa de consola (graph, opcionesCarga, el
+ * presupuesto de --bot-budget, la tabla de posiciones): todo llega por parámetro o vive
+ * en el mundo o la sesión. Lo único común al proceso son los contadores de memoria y de
+ * métricas (atómicos) y los pools de objetos (con caché por hilo).
+ *
+ * Las acciones son las del juego, con sus reglas y costos (ver game.h): recoger y
+ * descartar gastan 1 de tiempo y avanzar el costo de la arista más (peso + 10) / 10.
+ * Los números de ítems y direcciones son los de la pantalla de juego y del modo guion:
+ * ítems del escenario desde 0, del inventario desde 1, y direcciones 1-4 para las
+ * cardinales y desde 5 para las extendidas.
+ *
+ * El modo guion (--script) es un cliente de esta biblioteca; ver guion.c como ejemplo.
+ */
+
+typedef struct gq_world gq_world;
+typedef struct gq_session gq_session;
+struct Graph;
+
+typedef enum {
+    GQ_ORDEN_ARCHIVO,       // El del archivo CSV
+    GQ_ORDEN_BFS,           // Recorrido en anchura desde el inicio (ver orden.h)
+    GQ_ORDEN_RCM            // Cuthill–McKee inverso
+} gq_order;
+
+// Opciones de carga (las de la línea de comandos del juego). Todo en false/0 es lo normal.
+typedef struct {
+    bool     estricto;                  // Rechazar el mapa si tiene errores
+    bool     descripcionesDiferidas;    // Leer las descripciones del archivo al pedirlas (si se
+                                        // reescribe con el mundo cargado, se leen vacías)
+    bool     nombresDiferidos;          // Ídem para los nombres de los escenarios
+    bool     comprimirDescripciones;
+    gq_order orden;
+} gq_options;
+
+typedef enum {
+    GQ_OK,
+    GQ_TERMINADA,           // La partida de ese jugador ya terminó
+    GQ_INVALIDA,            // Jugador, ítem o dirección inexistente, o nada que deshacer/rehacer
+    GQ_TOMADO               // Otro jugador de la sesión reclamó el ítem antes
+} gq_result;
+
+typedef enum {
+    GQ_JUGANDO,
+    GQ_FINAL,               // Llegó a un escenario final
+    GQ_SIN_TIEMPO,
+    GQ_SIN_SALIDA           // Ya no le alcanza el tiempo para llegar a ningún final
+} gq_status;
+
+typedef struct {
+    int       escenario;    // ID del escenario actual en el CSV
+    int       tiempo;       // Tiempo restante
+    int       puntaje;      // Suma del valor del inventario
+    int       inventario;   // Cantidad de ítems en el inventario
+    int       peso;
+    int       turnos;       // Acciones hechas (deshacer las descuenta)
+    gq_status estado;
+} gq_state;
+
+typedef struct {
+    int         numero;     // Escenario: para gq_session_pick; inventario: para gq_session_drop
+    const char* nombre;     // Válido mientras viva la sesión
+    int         valor;
+    int         peso;
+} gq_item;
+
+typedef struct {
+    int         opcion;     // Para gq_session_move
+    const char* etiqueta;   // "Arriba", "Teletransportador", ... (válida mientras viva la sesión)
+    int         destino;    // ID del escenario de destino
+    int         costo;      // Costo base de la arista, sin contar el peso
+} gq_exit;
+
+typedef enum {
+    GQ_NINGUNA,
+    GQ_RECOGER,
+    GQ_DESCARTAR,
+    GQ_MOVER
+} gq_action_type;
+
+typedef struct {
+    gq_action_type tipo;
+    gq_item        item;        // GQ_RECOGER y GQ_DESCARTAR (numero como antes de hacerla)
+    int            opcion;      // GQ_MOVER: dirección
+    int            gasto;       // GQ_MOVER: tiempo gastado (solo en acciones hechas)
+    int            profundidad; // gq_session_bot: profundidad de búsqueda completada
+} gq_action;
+
+#define GQ_MAXRECOGER 32
+#define GQ_MAXDESCARTAR 64
+
+// Consejo de qué recoger y soltar en el escenario actual (ver consejo.h).
+typedef struct {
+    bool      llega;                        // Siguiéndolo se llega a un final
+    gq_item   recoger[GQ_MAXRECOGER];       // Ítems del escenario, de más a menos valor
+    int       numRecoger;
+    int       descartar[GQ_MAXDESCARTAR];   // Números del inventario (desde 1), en el orden en que se descartan
+    int       numDescartar;
+    int       puntaje;                      // Puntaje, peso y tiempo al llegar al final
+    int       peso;
+    int       tiempoFinal;
+    gq_action siguiente;                    // Primera acción (GQ_NINGUNA: conviene avanzar)
+} gq_advice;
+
+/* Mundos */
+
+// Lee el mapa CSV sin mostrar nada. 'opciones' puede ser NULL. Retorna NULL si el archivo
+// no se pudo abrir, el mapa se rechazó o no hay memoria.
+gq_world* gq_world_load(const char* ruta, const gq_options* opciones);
+
+// Mundo sobre un grafo que sigue siendo de quien llama (el programa de consola lo usa con
+// el mapa cargado). El grafo debe vivir más que el mundo y sus sesiones.
+gq_world* gq_world_wrap(const struct Graph* grafo);
+
+// Suelta la referencia de quien creó el mundo. Las sesiones abiertas lo mantienen vivo.
+void gq_world_release(gq_world* mundo);
+
+int gq_world_scenarios(const gq_world* mundo);
+
+// Huella del contenido del mapa: la misma para el mismo mapa, se cargue como se cargue.
+unsigned long long gq_world_fingerprint(const gq_world* mundo);
+
+/* Sesiones */
+
+// Partida nueva de 'jugadores' jugadores (entre 1 y MAXJUGADORES), todos en el inicio con
+// el inventario vacío y el tiempo inicial. Retorna NULL sin memoria o con 'jugadores' inválido.
+gq_session* gq_session_new(gq_world* mundo, int jugadores);
+
+void gq_session_free(gq_session* sesion);
+
+// Devuelve al jugador al inicio con el inventario vacío y el tiempo inicial, como
+// "Reiniciar partida": los ítems que ya se recogieron no reaparecen.
+gq_result gq_session_restart(gq_session* sesion, int jugador);
+
+// Microsegundos que piensa gq_session_bot por acción (por defecto los de bot.h).
+void gq_session_set_bot_budget(gq_session* sesion, int microsegundos);
+
+gq_result gq_session_state(const gq_session* sesion, int jugador, gq_state* estado);
+
+// Copia en 'texto' (con '\0', recortado a 'tam') el nombre o la descripción del escenario
+// actual del jugador. Retorna el largo completo, o 0 si el jugador no existe.
+size_t gq_session_scenario_text(const gq_session* sesion, int jugador, bool descripcion, char* texto, size_t tam);
+
+// Ítems disponibles en el escenario actual, o en el inventario si 'inventario' es true.
+// Llena hasta 'max' y retorna cuántos hay en total (-1 si el jugador no existe).
+int gq_session_items(const gq_session* sesion, int jugador, bool inventario, gq_item* items, int max);
+
+// Direcciones del escenario actual. Llena hasta 'max' y retorna cuántas hay (-1 si el
+// jugador no existe).
+int gq_session_exits(const gq_session* sesion, int jugador, gq_exit* salidas, int max);
+
+// Acciones. 'hecha' (puede ser NULL) recibe lo que se hizo.
+gq_result gq_session_pick(gq_session* sesion, int jugador, int numero, gq_action* hecha);
+gq_result gq_session_drop(gq_session* sesion, int jugador, int numero, gq_action* hecha);
+
+// 'direccion' es el número de opción, el nombre ("Arriba", "Teletransportador", sin
+// distinguir mayúsculas) o up/down/left/right.
+gq_result gq_session_move(gq_session* sesion, int jugador, const char* direccion, gq_action* hecha);
+
+// Deshacer se permite aunque la partida haya terminado (ver historial.h). 'tipo' recibe
+// qué se deshizo o rehízo. Rehacer una recogida da GQ_TOMADO si otro jugador tomó el ítem.
+gq_result gq_session_undo(gq_session* sesion, int jugador, gq_action_type* tipo);
+gq_result gq_session_redo(gq_session* sesion, int jugador, gq_action_type* tipo);
+
+// La computadora elige y hace una acción por el jugador (ver bot.h).
+gq_result gq_session_bot(gq_session* sesion, int jugador, gq_action* hecha);
+
+// Consejo de ítems para el escenario actual, sin hacer nada.
+gq_result gq_session_suggest(const gq_session* sesion, int jugador, gq_advice* consejo);
+
+// Exporta el mundo de la sesión con sus jugadores en formato "dot" o "json" (ver
+// exportar.h). Retorna false con un formato desconocido o si falló la escritura.
+bool gq_session_export(const gq_session* sesion, const char* formato, FILE* destino);
+
+#endif // LIBGRAPHQUEST_H
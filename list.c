@@ -1,29 +1,31 @@
 #include <stdlib.h>
 #include "list.h"
+#include "memoria.h"
+#include "objetos.h"
 
-typedef struct ListNode {
-    void* data;
-    struct ListNode* next;
-} ListNode;
-
-struct List {
-    ListNode* head;
-    ListNode* tail;
-    ListNode* current;
-    int size;
-};
+// Las listas y sus nodos se reservan de pools: crear y destruir inventarios y listas de
+// ítems en cada partida reutiliza los mismos objetos en vez de volver a malloc.
+static PoolObjetos poolListas = POOL_OBJETOS("listas", List, MEM_LISTAS);
+static PoolObjetos poolNodos = POOL_OBJETOS("nodos", ListNode, MEM_LISTAS);
 
 List* list_create() {
-    List* list = malloc(sizeof(List));
+    return list_createWith(mem_liberar);
+}
+
+List* list_createWith(void (*freeData)(void*)) {
+    List* list = objeto_reservar(&poolListas);
+    if (!list) return NULL;
     list->head = NULL;
     list->tail = NULL;
     list->current = NULL;
     list->size = 0;
+    list->freeData = freeData;
     return list;
 }
 
 void list_pushBack(List* list, void* data) {
-    ListNode* newNode = malloc(sizeof(ListNode));
+    ListNode* newNode = objeto_reservar(&poolNodos);
+    if (!newNode) return;
     newNode->data = data;
     newNode->next = NULL;
 
@@ -55,8 +57,8 @@ void list_clean(List* list) {
     while (node) {
         ListNode* temp = node;
         node = node->next;
-        free(temp->data);  // Asumiendo que el contenido fue reservado dinámicamente
-        free(temp);
+        list->freeData(temp->data);
+        objeto_liberar(&poolNodos, temp);
     }
     list->head = NULL;
     list->tail = NULL;
@@ -67,13 +69,18 @@ void list_clean(List* list) {
 void list_destroy(List* list) {
     if (!list) return;
     list_clean(list);
-    free(list);
+    objeto_liberar(&poolListas, list);
 }
 
 int list_size(List* list) {
     return list ? list->size : 0;
 }
 
+// Bytes que ocupan la lista y sus nodos (sin contar los datos).
+size_t list_bytes(List* list) {
+    return list ? sizeof(List) + sizeof(ListNode) * (size_t)list->size : 0;
+}
+
 void* list_current(List* list) {
     if (!list || !list->current) return NULL;
     return list->current->data;
@@ -103,8 +110,34 @@ void list_popCurrent(List* list) {
     }
 
     list->current = node->next;
-    free(node->data);
-    free(node);
+    list->freeData(node->data);
+    objeto_liberar(&poolNodos, node);
+    list->size--;
+}
+
+
+void list_insertAfter(List* list, ListNode* prev, ListNode* node) {
+    ListNode** enlace = prev ? &prev->next : &list->head;
+    node->next = *enlace;
+    *enlace = node;
+    if (list->tail == prev) list->tail = node;
+    list->size++;
+}
+
+ListNode* list_removeAfter(List* list, ListNode* prev) {
+    ListNode** enlace = prev ? &prev->next : &list->head;
+    ListNode* node = *enlace;
+    if (!node) return NULL;
+    *enlace = node->next;
+    if (list->tail == node) list->tail = prev;
+    if (list->current == node) list->current = NULL;
+    node->next = NULL;
     list->size--;
+    return node;
 }
 
+void list_freeNode(List* list, ListNode* node) {
+    if (!node) return;
+    list->freeData(node->data);
+    objeto_liberar(&poolNodos, node);
+}
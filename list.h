@@ -1,15 +1,43 @@
 #ifndef LIST_H
 #define LIST_H
 
-typedef struct List List;
+#include <stddef.h>
+
+/*
+ * Las estructuras son públicas para que los mapas incrustados (ver incrustado.h) definan
+ * sus listas de ítems en tiempo de compilación y para recorrer una lista compartida entre
+ * hilos por sus nodos, sin mover su cursor. El resto del código usa las funciones.
+ */
+
+typedef struct ListNode {
+    void* data;
+    struct ListNode* next;
+} ListNode;
+
+typedef struct List {
+    ListNode* head;
+    ListNode* tail;
+    ListNode* current;
+    int size;
+    void (*freeData)(void*);    // Libera el contenido al sacarlo de la lista (NULL en las estáticas)
+} List;
 
 List* list_create();
+List* list_createWith(void (*freeData)(void*));
 void* list_first(List* list);
 void* list_next(List* list);
 void* list_current(List* list);
 void list_pushBack(List* list, void* data);
 void list_popCurrent(List* list);
+
+// Enlazan o desenlazan un nodo sin copiar ni liberar nada, en O(1). 'prev' es el nodo
+// anterior (NULL para el primero). Sirven para deshacer acciones (ver historial.h).
+void list_insertAfter(List* list, ListNode* prev, ListNode* node);
+ListNode* list_removeAfter(List* list, ListNode* prev);
+// Libera un nodo ya desenlazado y su contenido.
+void list_freeNode(List* list, ListNode* node);
 int list_size(List* list);
+size_t list_bytes(List* list);
 void list_clean(List* list);
 void list_destroy(List* list);
 
@@ -0,0 +1,325 @@
+#include "listado.h"
+#include "escritor.h"
+#include "extra.h"
+#include "list.h"
+#include "metricas.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+
+#define NUMBARRAS 8             // Columnas de los histogramas (la última junta "8 o más")
+#define LARGOBARRA 40
+
+void filtro_por_defecto(FiltroEscenarios* filtro) {
+    filtro->idDesde = INT_MIN;
+    filtro->idHasta = INT_MAX;
+    filtro->porPagina = ESCENARIOSPORPAGINA;
+    filtro->soloFinales = false;
+    filtro->conItems = false;
+    filtro->alcanzables = false;
+    filtro->soloResumen = false;
+    filtro->nombre[0] = '\0';
+}
+
+/*
+ * leer_filtro_escenarios
+ * ----------------------
+ * Opciones separadas por espacios, en cualquier orden:
+ *  - finales, items, alcanzables, resumen: activan el filtro o modo del mismo nombre.
+ *  - ids=A-B (o ids=A): rango de IDs del archivo.
+ *  - pagina=N: escenarios por página (0 para no paginar).
+ *  - nombre=TEXTO: subcadena del nombre; toma el resto de la línea, así que va al final.
+ */
+
+bool leer_filtro_escenarios(const char* texto, FiltroEscenarios* filtro) {
+    filtro_por_defecto(filtro);
+    const char* p = texto;
+    while (*p) {
+        while (isspace((unsigned char)*p)) p++;
+        if (!*p) break;
+        const char* fin = p;
+        while (*fin && !isspace((unsigned char)*fin)) fin++;
+        size_t largo = (size_t)(fin - p);
+
+        if (largo == 7 && strncmp(p, "finales", largo) == 0) {
+            filtro->soloFinales = true;
+        } else if (largo == 5 && strncmp(p, "items", largo) == 0) {
+            filtro->conItems = true;
+        } else if (largo == 11 && strncmp(p, "alcanzables", largo) == 0) {
+            filtro->alcanzables = true;
+        } else if (largo == 7 && strncmp(p, "resumen", largo) == 0) {
+            filtro->soloResumen = true;
+        } else if (strncmp(p, "ids=", 4) == 0) {
+            const char* guion = memchr(p + 4, '-', largo - 4);
+            const char* finDesde = guion ? guion : fin;
+            if (!texto_a_entero_n(p + 4, (size_t)(finDesde - (p + 4)), &filtro->idDesde) ||
+                (guion && !texto_a_entero_n(guion + 1, (size_t)(fin - (guion + 1)), &filtro->idHasta))) {
+                printf("Rango inválido: %.*s (use ids=A-B)\n", (int)largo, p);
+                return false;
+            }
+            if (!guion) filtro->idHasta = filtro->idDesde;
+        } else if (strncmp(p, "pagina=", 7) == 0) {
+            if (!texto_a_entero_n(p + 7, largo - 7, &filtro->porPagina) || filtro->porPagina < 0) {
+                printf("Tamaño de página inválido: %.*s\n", (int)largo, p);
+                return false;
+            }
+        } else if (strncmp(p, "nombre=", 7) == 0) {
+            const char* nombre = p + 7;
+            size_t largoNombre = strlen(nombre);
+            while (largoNombre > 0 && isspace((unsigned char)nombre[largoNombre - 1])) largoNombre--;
+            if (largoNombre >= MAXNAME) largoNombre = MAXNAME - 1;
+            for (size_t i = 0; i < largoNombre; i++) filtro->nombre[i] = (char)tolower((unsigned char)nombre[i]);
+            filtro->nombre[largoNombre] = '\0';
+            break;
+        } else {
+            printf("Opción de filtro desconocida: %.*s\n", (int)largo, p);
+            return false;
+        }
+        p = fin;
+    }
+    return true;
+}
+
+// Busca 'buscado' (ya en minúsculas) dentro de 'texto' sin distinguir mayúsculas.
+static bool contiene_sin_mayusculas(const char* texto, const char* buscado) {
+    if (!*buscado) return true;
+    for (; *texto; texto++) {
+        const char* t = texto;
+        const char* b = buscado;
+        while (*t && *b && tolower((unsigned char)*t) == (unsigned char)*b) { t++; b++; }
+        if (!*b) return true;
+    }
+    return false;
+}
+
+static bool cumple_filtro(const Node* node, const FiltroEscenarios* filtro, const bool* alcanzables, int posicion) {
+    if (node->state.id < filtro->idDesde || node->state.id > filtro->idHasta) return false;
+    if (filtro->soloFinales && !node->state.esFinal) return false;
+    if (filtro->conItems && list_size(node->state.availableItems) == 0) return false;
+    if (alcanzables && !alcanzables[posicion]) return false;
+    if (filtro->nombre[0] && !contiene_sin_mayusculas(nombre_escenario(node), filtro->nombre)) return false;
+    return true;
+}
+
+/*
+ * escribir_nodo
+ * -------------
+ * Escribe un escenario con el mismo formato de siempre: ID, nombre, descripción, ítems,
+ * las cuatro direcciones cardinales, las aristas extendidas y si es final.
+ */
+
+static void escribir_nodo(Escritor* e, Node* node) {
+    escritor_printf(e, "Nodo        : %d\n", node->state.id);
+    escritor_printf(e, "Nombre      : '%s'\n", nombre_escenario(node));
+    escritor_printf(e, "\nDescripción:\n'%s'\n", descripcion_escenario(node));
+
+    if (list_size(node->state.availableItems) == 0){
+        escritor_printf(e, "\nNo hay ítems en este escenario.\n");
+    } else {
+        escritor_printf(e, "\nLista de Ítems disponibles:\n");
+        for (ListNode* ln = node->state.availableItems->head; ln != NULL; ln = ln->next) {
+            Item* item = ln->data;
+            escritor_printf(e, "    - %s (%d pts, %d kg)\n", item->name, item->value, item->weight);
+        }
+    }
+
+    escritor_printf(e, "\nLista de Nodos Adyacentes:\n");
+    int numAristas;
+    const Arista* aristas = aristas_de(&graph, node, &numAristas);
+    for (int d = 0; d < MAXDIR; d++) {
+        int destino = -1;
+        for (int k = 0; k < numAristas; k++) {
+            if (aristas[k].direccion == d) destino = aristas[k].destino;
+        }
+        if (destino >= 0) {
+            escritor_printf(e, "    %s → Nodo %d\n", nombresDirecciones[d], graph.nodes[destino].state.id);
+        } else {
+            escritor_printf(e, "    %s → Ninguno\n", nombresDirecciones[d]);
+        }
+    }
+    for (int k = 0; k < numAristas; k++) {
+        if (aristas[k].direccion >= 0) continue;
+        escritor_printf(e, "    %s → Nodo %d", aristas[k].etiqueta, graph.nodes[aristas[k].destino].state.id);
+        if (aristas[k].costo > 0) escritor_printf(e, " (costo %d)", aristas[k].costo);
+        escritor_printf(e, "\n");
+    }
+
+    escritor_printf(e, "\n¿Es final?: %s\n", node->state.esFinal ? "Sí" : "No");
+    escritor_printf(e, "===============================================================\n");
+}
+
+static void escribir_histograma(Escritor* e, const char* titulo, const int barras[NUMBARRAS + 1]) {
+    int maximo = 1;
+    for (int i = 0; i <= NUMBARRAS; i++) if (barras[i] > maximo) maximo = barras[i];
+
+    escritor_printf(e, "\n%s:\n", titulo);
+    for (int i = 0; i <= NUMBARRAS; i++) {
+        if (i < NUMBARRAS) escritor_printf(e, "   %2d  ", i);
+        else               escritor_printf(e, "  %2d+  ", i);
+        int largo = (int)((long long)barras[i] * LARGOBARRA / maximo);
+        if (barras[i] > 0 && largo == 0) largo = 1;
+        for (int j = 0; j < largo; j++) escritor_texto(e, "#", 1);
+        escritor_printf(e, " %d\n", barras[i]);
+    }
+}
+
+/*
+ * escribir_resumen
+ * ----------------
+ * Conteos de los escenarios que cumplen el filtro y dos histogramas: aristas que salen
+ * de cada escenario (grado de salida) e ítems por escenario.
+ */
+
+static void escribir_resumen(Escritor* e, const FiltroEscenarios* filtro, const bool* alcanzables) {
+    int coinciden = 0, finales = 0, conItems = 0;
+    long long items = 0, aristas = 0;
+    int grados[NUMBARRAS + 1] = {0};
+    int itemsPorNodo[NUMBARRAS + 1] = {0};
+
+    for (int i = 0; i < graph.numberOfNodes; i++) {
+        Node* node = &graph.nodes[i];
+        if (!cumple_filtro(node, filtro, alcanzables, i)) continue;
+        coinciden++;
+        if (node->state.esFinal) finales++;
+        int cantidadItems = list_size(node->state.availableItems);
+        if (cantidadItems > 0) conItems++;
+        items += cantidadItems;
+        int grado = graph.inicioAristas[i + 1] - graph.inicioAristas[i];
+        aristas += grado;
+        grados[grado < NUMBARRAS ? grado : NUMBARRAS]++;
+        itemsPorNodo[cantidadItems < NUMBARRAS ? cantidadItems : NUMBARRAS]++;
+    }
+
+    escritor_printf(e, "================ Resumen de Escenarios ================\n");
+    escritor_printf(e, "Escenarios que cumplen el filtro: %d de %d\n", coinciden, graph.numberOfNodes);
+    escritor_printf(e, "Finales: %d   Con ítems: %d   Ítems en total: %lld\n", finales, conItems, items);
+    escritor_printf(e, "Aristas que salen: %lld (%.2f por escenario)\n", aristas,
+                    coinciden > 0 ? (double)aristas / coinciden : 0.0);
+    escribir_histograma(e, "Grado de salida", grados);
+    escribir_histograma(e, "Ítems por escenario", itemsPorNodo);
+}
+
+// Escribe hasta 'cantidad' escenarios (0 = todos) que cumplan el filtro, desde la posición
+// *siguiente, y deja ahí la posición donde seguir. Retorna cuántos escribió.
+static int escribir_pagina(Escritor* e, const FiltroEscenarios* filtro, const bool* alcanzables, int* siguiente, int cantidad) {
+    MEDIR_INICIO(inicio);
+    int escritos = 0;
+    while (*siguiente < graph.numberOfNodes && (cantidad == 0 || escritos < cantidad)) {
+        Node* node = &graph.nodes[*siguiente];
+        if (cumple_filtro(node, filtro, alcanzables, *siguiente)) {
+            escribir_nodo(e, node);
+            escritos++;
+        }
+        (*siguiente)++;
+    }
+    escritor_vaciar(e);
+    MEDIR_FIN(inicio, MET_RENDER_GRAFO);
+    return escritos;
+}
+
+// Pausa entre páginas. Retorna false si el usuario pidió terminar (o no hay más entrada).
+static bool siguiente_pagina(int mostrados) {
+    printf("\n-- %d escenarios mostrados. ENTER: siguiente página, q: terminar -- ", mostrados);
+    fflush(stdout);
+    char buf[MAXNAME];
+    if (!fgets(buf, sizeof(buf), stdin)) return false;
+    return buf[0] != 'q' && buf[0] != 'Q';
+}
+
+/**
+ * mostrar_grafo
+ * --------------
+ * Muestra por consola los escenarios cargados que cumplen el filtro, junto con sus
+ * atributos, o solo un resumen con conteos e histogramas.
+ *
+ * Consideraciones:
+ *  - Si no se han cargado nodos previamente, muestra una advertencia.
+ *  - Toda la salida pasa por un Escritor, que la escribe en bloques grandes; entre
+ *    páginas se vacía y se espera al usuario.
+ *  - El filtro "alcanzables" recorre el grafo una vez desde el inicio (O(V + E)).
+ *  - La métrica de renderizado mide cada página, sin contar la espera entre páginas.
+ */
+
+void mostrar_grafo(const FiltroEscenarios* filtro) {
+    FiltroEscenarios porDefecto;
+    if (!filtro) {
+        filtro_por_defecto(&porDefecto);
+        filtro = &porDefecto;
+    }
+
+    if (graph.numberOfNodes == 0){
+        puts("====- Advertencia -====");
+        puts("Debes incluir el archivo .csv con los escenarios!");
+        return;
+    }
+
+    bool* alcanzables = NULL;
+    if (filtro->alcanzables) {
+        alcanzables = marcar_alcanzables(&graph, (int)(graph.start - graph.nodes));
+        if (!alcanzables) {
+            puts("No hay memoria para calcular los escenarios alcanzables.");
+            return;
+        }
+    }
+
+    Escritor* e = mem_reservar(MEM_INTERFAZ, sizeof(Escritor));
+    if (!e) {
+        mem_liberar(alcanzables);
+        puts("No hay memoria para mostrar los escenarios.");
+        return;
+    }
+    escritor_iniciar(e, stdout);
+
+    if (filtro->soloResumen) {
+        MEDIR_INICIO(inicio);
+        escribir_resumen(e, filtro, alcanzables);
+        escritor_vaciar(e);
+        MEDIR_FIN(inicio, MET_RENDER_GRAFO);
+    } else {
+        escritor_printf(e, "================ Mostrar Escenarios del Grafo ================\n");
+        int siguiente = 0;
+        int mostrados = 0;
+        do {
+            mostrados += escribir_pagina(e, filtro, alcanzables, &siguiente, filtro->porPagina);
+            while (siguiente < graph.numberOfNodes && !cumple_filtro(&graph.nodes[siguiente], filtro, alcanzables, siguiente)) {
+                siguiente++;
+            }
+        } while (siguiente < graph.numberOfNodes && siguiente_pagina(mostrados));
+        if (mostrados == 0) {
+            escritor_printf(e, "Ningún escenario cumple el filtro.\n");
+            escritor_vaciar(e);
+        }
+    }
+
+    mem_liberar(e);
+    mem_liberar(alcanzables);
+}
+
+/*
+ * listar_escenarios
+ * -----------------
+ * Pide los filtros en una línea (ENTER para ver todos) y muestra los escenarios.
+ */
+
+void listar_escenarios(void) {
+    limpiarPantalla();
+    if (graph.numberOfNodes == 0) {
+        mostrar_grafo(NULL);
+        return;
+    }
+
+    printf("Se cargaron %d escenarios.\n", graph.numberOfNodes);
+    puts("Filtros: finales, items, alcanzables, resumen, ids=A-B, pagina=N (0 = sin pausas), nombre=TEXTO");
+    printf("Ingrese los filtros (ENTER para ver todos, de a %d): ", ESCENARIOSPORPAGINA);
+    char linea[MAXNAME + 128];
+    if (!fgets(linea, sizeof(linea), stdin)) return;
+    linea[strcspn(linea, "\n")] = '\0';
+
+    FiltroEscenarios filtro;
+    if (!leer_filtro_escenarios(linea, &filtro)) return;
+    limpiarPantalla();
+    mostrar_grafo(&filtro);
+}
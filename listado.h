@@ -0,0 +1,34 @@
+#ifndef LISTADO_H
+#define LISTADO_H
+
+#include <stdbool.h>
+#include "grafo.h"
+
+#define ESCENARIOSPORPAGINA 20  // Página por defecto al listar desde el menú
+
+// Qué escenarios muestra mostrar_grafo y cómo.
+typedef struct {
+    int  idDesde;               // Rango de IDs del archivo (inclusive)
+    int  idHasta;
+    int  porPagina;             // Escenarios por página (0 = todo seguido, sin pausas)
+    bool soloFinales;
+    bool conItems;              // Solo escenarios con al menos un ítem
+    bool alcanzables;           // Solo los alcanzables desde el escenario inicial
+    bool soloResumen;           // Solo conteos e histogramas, sin listar los escenarios
+    char nombre[MAXNAME];       // Subcadena del nombre, en minúsculas (vacía = cualquiera)
+} FiltroEscenarios;
+
+// Deja el filtro que muestra todos los escenarios, en páginas de ESCENARIOSPORPAGINA.
+void filtro_por_defecto(FiltroEscenarios* filtro);
+
+// Completa el filtro a partir de un texto como "finales items ids=10-50 nombre=bosque".
+// Retorna false (informando el motivo) si el texto tiene una opción desconocida.
+bool leer_filtro_escenarios(const char* texto, FiltroEscenarios* filtro);
+
+// Muestra los escenarios del grafo cargado que cumplen el filtro (NULL = por defecto).
+void mostrar_grafo(const FiltroEscenarios* filtro);
+
+// Pide los filtros al usuario y muestra los escenarios (opción del menú principal).
+void listar_escenarios(void);
+
+#endif // LISTADO_H
@@ -0,0 +1,196 @@
+#include "memoria.h"
+#include "metricas.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+/*
+ * Cada bloque lleva delante una cabecera con su tamaño y su subsistema, para poder
+ * descontarlo al liberarlo sin que quien libera tenga que saber de dónde vino. La
+ * cabecera ocupa lo mismo que max_align_t, así que el bloque entregado conserva la
+ * alineación de malloc. Los contadores son atómicos: se puede reservar desde varios hilos.
+ */
+
+typedef union {
+    struct {
+        size_t     bytes;
+        Subsistema subsistema;
+    } datos;
+    max_align_t alineacion;
+} Cabecera;
+
+typedef struct {
+    _Atomic size_t   actual;
+    _Atomic size_t   pico;
+    _Atomic uint64_t reservas;
+    _Atomic uint64_t liberaciones;
+} Contadores;
+
+static Contadores contadores[NUM_SUBSISTEMAS];
+
+static const char* nombresSubsistemas[NUM_SUBSISTEMAS] = {
+    "cargador", "grafo", "items", "listas", "partidas", "interfaz", "puntajes"
+};
+
+#ifndef SIN_CONTEO_MEMORIA
+
+static void sumar(Subsistema s, size_t bytes) {
+    Contadores* c = &contadores[s];
+    size_t actual = atomic_fetch_add_explicit(&c->actual, bytes, memory_order_relaxed) + bytes;
+    atomic_fetch_add_explicit(&c->reservas, 1, memory_order_relaxed);
+    size_t pico = atomic_load_explicit(&c->pico, memory_order_relaxed);
+    while (actual > pico &&
+           !atomic_compare_exchange_weak_explicit(&c->pico, &pico, actual, memory_order_relaxed, memory_order_relaxed));
+    CONTAR_RESERVA(bytes);
+}
+
+static void restar(Subsistema s, size_t bytes) {
+    atomic_fetch_sub_explicit(&contadores[s].actual, bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&contadores[s].liberaciones, 1, memory_order_relaxed);
+}
+
+static void* entregar(Cabecera* cabecera, Subsistema s, size_t bytes) {
+    if (!cabecera) return NULL;
+    cabecera->datos.bytes = bytes;
+    cabecera->datos.subsistema = s;
+    sumar(s, bytes);
+    return cabecera + 1;
+}
+
+void* mem_reservar(Subsistema subsistema, size_t bytes) {
+    return entregar(malloc(sizeof(Cabecera) + bytes), subsistema, bytes);
+}
+
+void* mem_reservar_ceros(Subsistema subsistema, size_t cantidad, size_t bytes) {
+    if (bytes && cantidad > (SIZE_MAX - sizeof(Cabecera)) / bytes) return NULL;
+    return entregar(calloc(1, sizeof(Cabecera) + cantidad * bytes), subsistema, cantidad * bytes);
+}
+
+void* mem_redimensionar(Subsistema subsistema, void* puntero, size_t bytes) {
+    if (!puntero) return mem_reservar(subsistema, bytes);
+    Cabecera* cabecera = (Cabecera*)puntero - 1;
+    Subsistema anterior = cabecera->datos.subsistema;
+    size_t anteriores = cabecera->datos.bytes;
+    Cabecera* nueva = realloc(cabecera, sizeof(Cabecera) + bytes);
+    if (!nueva) return NULL;
+    restar(anterior, anteriores);
+    return entregar(nueva, subsistema, bytes);
+}
+
+void mem_liberar(void* puntero) {
+    if (!puntero) return;
+    Cabecera* cabecera = (Cabecera*)puntero - 1;
+    restar(cabecera->datos.subsistema, cabecera->datos.bytes);
+    free(cabecera);
+}
+
+#else
+
+void* mem_reservar(Subsistema subsistema, size_t bytes) {
+    (void)subsistema;
+    return malloc(bytes);
+}
+
+void* mem_reservar_ceros(Subsistema subsistema, size_t cantidad, size_t bytes) {
+    (void)subsistema;
+    return calloc(cantidad, bytes);
+}
+
+void* mem_redimensionar(Subsistema subsistema, void* puntero, size_t bytes) {
+    (void)subsistema;
+    return realloc(puntero, bytes);
+}
+
+void mem_liberar(void* puntero) {
+    free(puntero);
+}
+
+#endif
+
+char* mem_duplicar(Subsistema subsistema, const char* texto) {
+    size_t largo = strlen(texto) + 1;
+    char* copia = mem_reservar(subsistema, largo);
+    if (copia) memcpy(copia, texto, largo);
+    return copia;
+}
+
+UsoMemoria mem_uso(Subsistema subsistema) {
+    const Contadores* c = &contadores[subsistema];
+    UsoMemoria uso;
+    uso.actual = atomic_load_explicit(&c->actual, memory_order_relaxed);
+    uso.pico = atomic_load_explicit(&c->pico, memory_order_relaxed);
+    uso.reservas = atomic_load_explicit(&c->reservas, memory_order_relaxed);
+    uso.liberaciones = atomic_load_explicit(&c->liberaciones, memory_order_relaxed);
+    return uso;
+}
+
+// El pico total es la suma de los picos: una cota superior (no se dieron necesariamente juntos).
+UsoMemoria mem_uso_total(void) {
+    UsoMemoria total = {0, 0, 0, 0};
+    for (int s = 0; s < NUM_SUBSISTEMAS; s++) {
+        UsoMemoria uso = mem_uso((Subsistema)s);
+        total.actual += uso.actual;
+        total.pico += uso.pico;
+        total.reservas += uso.reservas;
+        total.liberaciones += uso.liberaciones;
+    }
+    return total;
+}
+
+const char* mem_nombre_subsistema(Subsistema subsistema) {
+    return subsistema < NUM_SUBSISTEMAS ? nombresSubsistemas[subsistema] : "?";
+}
+
+size_t mem_pico_residente(void) {
+#ifndef _WIN32
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return 0;
+#ifdef __APPLE__
+    return (size_t)uso.ru_maxrss;           // macOS lo informa en bytes
+#else
+    return (size_t)uso.ru_maxrss * 1024;    // Linux y BSD, en KB
+#endif
+#else
+    return 0;
+#endif
+}
+
+/**
+ * mem_reportar
+ * -------------
+ * Escribe una tabla con el uso de memoria de cada subsistema (actual, pico, reservas y
+ * liberaciones), el total y la memoria residente máxima del proceso.
+ */
+
+void mem_reportar(FILE* salida) {
+    fprintf(salida, "\n------ Uso de memoria por subsistema ------\n");
+    fprintf(salida, "%-10s %14s %14s %12s %12s\n", "subsistema", "actual (B)", "pico (B)", "reservas", "liberaciones");
+    for (int s = 0; s < NUM_SUBSISTEMAS; s++) {
+        UsoMemoria uso = mem_uso((Subsistema)s);
+        fprintf(salida, "%-10s %14zu %14zu %12llu %12llu\n", nombresSubsistemas[s], uso.actual, uso.pico,
+                (unsigned long long)uso.reservas, (unsigned long long)uso.liberaciones);
+    }
+    UsoMemoria total = mem_uso_total();
+    fprintf(salida, "%-10s %14zu %14zu %12llu %12llu\n", "total", total.actual, total.pico,
+            (unsigned long long)total.reservas, (unsigned long long)total.liberaciones);
+    size_t residente = mem_pico_residente();
+    if (residente > 0) fprintf(salida, "Memoria residente máxima: %.1f MB\n", residente / (1024.0 * 1024.0));
+}
+
+bool mem_reportar_fugas(FILE* salida) {
+    bool hayFugas = false;
+    for (int s = 0; s < NUM_SUBSISTEMAS; s++) {
+        UsoMemoria uso = mem_uso((Subsistema)s);
+        if (uso.actual == 0 && uso.reservas == uso.liberaciones) continue;
+        fprintf(salida, "Fuga en %s: %zu bytes en %llu bloque(s) sin liberar.\n", nombresSubsistemas[s], uso.actual,
+                (unsigned long long)(uso.reservas - uso.liberaciones));
+        hayFugas = true;
+    }
+    if (!hayFugas) fprintf(salida, "Sin fugas de memoria.\n");
+    return hayFugas;
+}
@@ -0,0 +1,55 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Reservas de memoria con contabilidad por subsistema: bytes actuales, pico y cantidad
+ * de reservas y liberaciones. Todo el código del juego reserva a través de estas
+ * funciones; compilando con -DSIN_CONTEO_MEMORIA se reducen a malloc/free directos.
+ */
+
+typedef enum {
+    MEM_CARGADOR,       // Validación y lectura del CSV (temporal durante la carga)
+    MEM_GRAFO,          // Nodos, aristas, textos, índices y análisis del mapa
+    MEM_ITEMS,          // Ítems de los escenarios y de los inventarios
+    MEM_LISTAS,         // Listas y sus nodos
+    MEM_PARTIDAS,       // Estados de partida y copias del mundo
+    MEM_INTERFAZ,       // Búferes de pantallas y reportes
+    MEM_PUNTAJES,       // Tabla de posiciones y puntajes por guardar (ver puntajes.h)
+    NUM_SUBSISTEMAS
+} Subsistema;
+
+typedef struct {
+    size_t   actual;        // Bytes reservados en este momento
+    size_t   pico;          // Máximo de bytes reservados al mismo tiempo
+    uint64_t reservas;      // Cantidad de reservas hechas
+    uint64_t liberaciones;  // Cantidad de liberaciones hechas
+} UsoMemoria;
+
+void* mem_reservar(Subsistema subsistema, size_t bytes);
+void* mem_reservar_ceros(Subsistema subsistema, size_t cantidad, size_t bytes);
+void* mem_redimensionar(Subsistema subsistema, void* puntero, size_t bytes);
+char* mem_duplicar(Subsistema subsistema, const char* texto);
+void  mem_liberar(void* puntero);
+
+// Uso de memoria de un subsistema, o de todos juntos.
+UsoMemoria mem_uso(Subsistema subsistema);
+UsoMemoria mem_uso_total(void);
+
+// Nombre legible del subsistema ("cargador", "grafo", ...).
+const char* mem_nombre_subsistema(Subsistema subsistema);
+
+// Memoria residente máxima del proceso en bytes (0 si el sistema no la informa).
+size_t mem_pico_residente(void);
+
+// Escribe una tabla con el uso por subsistema y el pico de memoria residente.
+void mem_reportar(FILE* salida);
+
+// Informa los subsistemas que todavía tienen memoria reservada. Retorna true si hay fugas.
+bool mem_reportar_fugas(FILE* salida);
+
+#endif // MEMORIA_H
@@ -0,0 +1,136 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "metricas.h"
+
+#include <stdatomic.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+/*
+ * Histograma log-lineal de latencias: los valores menores que 16 ns tienen una cubeta
+ * cada uno; desde ahí, cada potencia de 2 se divide en 8 cubetas, así que el percentil
+ * informado está a menos de un 12,5% del real. Todo se actualiza con operaciones
+ * atómicas relajadas, para poder medir también código que corre en varios hilos.
+ */
+
+#define SUBCUBETAS 8
+#define NUMCUBETAS (16 + (64 - 4) * SUBCUBETAS)
+
+typedef struct {
+    _Atomic uint64_t llamadas;
+    _Atomic uint64_t total;
+    _Atomic uint64_t maximo;
+    _Atomic uint64_t cubetas[NUMCUBETAS];
+} DatosMetrica;
+
+static const char* nombresMetricas[NUM_METRICAS] = {
+    "leer_escenarios", "leer_linea_csv", "split_string", "copiar_grafo", "reclamar_item",
+    "moverse", "limpiarPantalla", "render_menu", "render_estado", "render_grafo", "decision_bot",
+    "leer_puntajes", "anotar_puntaje", "consejo_items"
+};
+
+static DatosMetrica datos[NUM_METRICAS];
+static _Atomic uint64_t reservas;
+static _Atomic uint64_t bytesReservados;
+
+bool metricasActivas = false;
+
+void metricas_activar(bool activar) {
+    metricasActivas = activar;
+}
+
+uint64_t metricas_reloj(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frecuencia;
+    LARGE_INTEGER ahora;
+    if (frecuencia.QuadPart == 0) QueryPerformanceFrequency(&frecuencia);
+    QueryPerformanceCounter(&ahora);
+    return (uint64_t)(ahora.QuadPart / frecuencia.QuadPart) * 1000000000u +
+           (uint64_t)(ahora.QuadPart % frecuencia.QuadPart) * 1000000000u / (uint64_t)frecuencia.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static int cubeta_de(uint64_t valor) {
+    if (valor < 16) return (int)valor;
+    int exponente = 63;
+    while (!(valor >> exponente)) exponente--;
+    int sub = (int)((valor >> (exponente - 3)) & (SUBCUBETAS - 1));
+    return 16 + (exponente - 4) * SUBCUBETAS + sub;
+}
+
+// Mayor valor que cae en la cubeta (los percentiles se informan por exceso).
+static uint64_t limite_de(int cubeta) {
+    if (cubeta < 16) return (uint64_t)cubeta;
+    int exponente = (cubeta - 16) / SUBCUBETAS + 4;
+    uint64_t sub = (uint64_t)((cubeta - 16) % SUBCUBETAS);
+    uint64_t base = (uint64_t)1 << exponente;
+    uint64_t ancho = base / SUBCUBETAS;
+    return base + (sub + 1) * ancho - 1;
+}
+
+void metricas_registrar(Metrica metrica, uint64_t nanosegundos) {
+    DatosMetrica* d = &datos[metrica];
+    atomic_fetch_add_explicit(&d->llamadas, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&d->total, nanosegundos, memory_order_relaxed);
+    atomic_fetch_add_explicit(&d->cubetas[cubeta_de(nanosegundos)], 1, memory_order_relaxed);
+
+    uint64_t maximo = atomic_load_explicit(&d->maximo, memory_order_relaxed);
+    while (nanosegundos > maximo &&
+           !atomic_compare_exchange_weak_explicit(&d->maximo, &maximo, nanosegundos,
+                                                  memory_order_relaxed, memory_order_relaxed));
+}
+
+void metricas_contar_reserva(size_t bytes) {
+    atomic_fetch_add_explicit(&reservas, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&bytesReservados, bytes, memory_order_relaxed);
+}
+
+static uint64_t percentil(const DatosMetrica* d, uint64_t llamadas, int porcentaje) {
+    uint64_t objetivo = (llamadas * (uint64_t)porcentaje + 99) / 100;
+    if (objetivo == 0) objetivo = 1;
+    uint64_t acumulado = 0;
+    for (int c = 0; c < NUMCUBETAS; c++) {
+        acumulado += atomic_load_explicit(&d->cubetas[c], memory_order_relaxed);
+        if (acumulado >= objetivo) return limite_de(c);
+    }
+    return 0;
+}
+
+/**
+ * metricas_reportar
+ * ------------------
+ * Escribe el reporte de métricas en JSON. Por cada punto medido informa la cantidad de
+ * llamadas, el tiempo total y los percentiles 50 y 99 y el máximo de su latencia, todo
+ * en nanosegundos; al final, la cantidad de reservas de memoria y sus bytes.
+ */
+
+void metricas_reportar(FILE* salida) {
+    fprintf(salida, "{\n  \"metricas\": {\n");
+    for (int m = 0; m < NUM_METRICAS; m++) {
+        const DatosMetrica* d = &datos[m];
+        uint64_t llamadas = atomic_load_explicit(&d->llamadas, memory_order_relaxed);
+        uint64_t maximo = atomic_load_explicit(&d->maximo, memory_order_relaxed);
+        uint64_t p50 = llamadas ? percentil(d, llamadas, 50) : 0;
+        uint64_t p99 = llamadas ? percentil(d, llamadas, 99) : 0;
+        if (p50 > maximo) p50 = maximo;
+        if (p99 > maximo) p99 = maximo;
+        fprintf(salida, "    \"%s\": {\"llamadas\": %llu, \"total_ns\": %llu, \"p50_ns\": %llu, "
+                        "\"p99_ns\": %llu, \"max_ns\": %llu}%s\n",
+                nombresMetricas[m], (unsigned long long)llamadas,
+                (unsigned long long)atomic_load_explicit(&d->total, memory_order_relaxed),
+                (unsigned long long)p50, (unsigned long long)p99,
+                (unsigned long long)maximo, m + 1 < NUM_METRICAS ? "," : "");
+    }
+    fprintf(salida, "  },\n  \"reservas\": {\"cantidad\": %llu, \"bytes\": %llu}\n}\n",
+            (unsigned long long)atomic_load_explicit(&reservas, memory_order_relaxed),
+            (unsigned long long)atomic_load_explicit(&bytesReservados, memory_order_relaxed));
+}
@@ -0,0 +1,64 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Instrumentación de los puntos calientes del juego: tiempos (reloj monotónico) con
+ * histograma de latencias, cantidad de llamadas y reservas de memoria. Se activa con
+ * --stats y se elimina por completo compilando con -DSIN_METRICAS.
+ */
+
+// Puntos medidos. Agregar uno nuevo aquí y en nombresMetricas (metricas.c).
+typedef enum {
+    MET_LEER_ESCENARIOS,
+    MET_LEER_LINEA_CSV,
+    MET_SPLIT_STRING,
+    MET_COPIAR_GRAFO,
+    MET_RECLAMAR_ITEM,
+    MET_MOVERSE,
+    MET_LIMPIAR_PANTALLA,
+    MET_RENDER_MENU,
+    MET_RENDER_ESTADO,
+    MET_RENDER_GRAFO,
+    MET_DECISION_BOT,
+    MET_LEER_PUNTAJES,
+    MET_ANOTAR_PUNTAJE,
+    MET_CONSEJO_ITEMS,
+    NUM_METRICAS
+} Metrica;
+
+#ifdef SIN_METRICAS
+#define MEDIR_INICIO(marca)
+#define MEDIR_FIN(marca, metrica)
+#define CONTAR_RESERVA(bytes)
+#else
+#define MEDIR_INICIO(marca) uint64_t marca = metricasActivas ? metricas_reloj() : 0
+#define MEDIR_FIN(marca, metrica) \
+    do { if (metricasActivas) metricas_registrar((metrica), metricas_reloj() - (marca)); } while (0)
+#define CONTAR_RESERVA(bytes) \
+    do { if (metricasActivas) metricas_contar_reserva(bytes); } while (0)
+#endif
+
+// true mientras se estén recolectando métricas (ver metricas_activar).
+extern bool metricasActivas;
+
+// Comienza (o detiene) la recolección de métricas.
+void metricas_activar(bool activar);
+
+// Tiempo monotónico en nanosegundos.
+uint64_t metricas_reloj(void);
+
+// Registra una llamada a la métrica que tardó 'nanosegundos'.
+void metricas_registrar(Metrica metrica, uint64_t nanosegundos);
+
+// Registra una reserva de memoria de 'bytes'.
+void metricas_contar_reserva(size_t bytes);
+
+// Escribe en 'salida' el reporte en JSON: llamadas, total, p50, p99 y máximo por métrica.
+void metricas_reportar(FILE* salida);
+
+#endif // METRICAS_H
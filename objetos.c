@@ -0,0 +1,242 @@
+#include "objetos.h"
+
+#include <stdbool.h>
+
+#ifndef SIN_POOL_OBJETOS
+
+/*
+ * Un objeto libre guarda en su propio espacio el enlace al siguiente objeto libre y,
+ * si encabeza un lote en la lista común del pool, el enlace al siguiente lote. Por eso
+ * cada objeto ocupa al menos dos punteros; además se redondea a la alineación de
+ * max_align_t para que todos queden alineados como los entregaría malloc.
+ */
+
+typedef struct Libre {
+    struct Libre* siguiente;
+    struct Libre* siguienteLote;
+} Libre;
+
+typedef union Bloque {
+    union Bloque* siguiente;
+    max_align_t   alineacion;
+} Bloque;
+
+typedef struct {
+    Libre* objetos;
+    int    cantidad;
+} CacheHilo;
+
+static PoolObjetos* registrados[MAXPOOLSOBJETOS];
+static int numRegistrados;
+static atomic_flag cerrojoRegistro = ATOMIC_FLAG_INIT;
+
+static void bloquear(atomic_flag* cerrojo) {
+    while (atomic_flag_test_and_set_explicit(cerrojo, memory_order_acquire));
+}
+
+static void desbloquear(atomic_flag* cerrojo) {
+    atomic_flag_clear_explicit(cerrojo, memory_order_release);
+}
+
+static size_t tam_real(const PoolObjetos* pool) {
+    size_t tam = pool->tamObjeto < sizeof(Libre) ? sizeof(Libre) : pool->tamObjeto;
+    size_t alineacion = _Alignof(max_align_t);
+    return (tam + alineacion - 1) / alineacion * alineacion;
+}
+
+static _Thread_local CacheHilo caches[MAXPOOLSOBJETOS];
+
+/*
+ * Asigna al pool su posición en las cachés la primera vez que se usa. Si ya se usaron
+ * MAXPOOLSOBJETOS pools, retorna -1 y el pool reserva cada objeto por separado.
+ */
+
+static int registrar(PoolObjetos* pool) {
+    int id = atomic_load_explicit(&pool->id, memory_order_acquire);
+    if (id >= 0) return id;
+
+    bloquear(&cerrojoRegistro);
+    id = atomic_load_explicit(&pool->id, memory_order_relaxed);
+    if (id < 0 && numRegistrados < MAXPOOLSOBJETOS) {
+        id = numRegistrados++;
+        registrados[id] = pool;
+        atomic_store_explicit(&pool->id, id, memory_order_release);
+    }
+    desbloquear(&cerrojoRegistro);
+    return id;
+}
+
+// Llena la caché vacía con un lote devuelto o, si no hay, con objetos nuevos del último bloque.
+static bool rellenar(PoolObjetos* pool, CacheHilo* cache) {
+    bloquear(&pool->cerrojo);
+    Libre* lote = pool->lotes;
+    if (lote) {
+        pool->lotes = lote->siguienteLote;
+        pool->lotesTomados++;
+        desbloquear(&pool->cerrojo);
+
+        int cantidad = 0;
+        for (Libre* o = lote; o; o = o->siguiente) cantidad++;
+        cache->objetos = lote;
+        cache->cantidad = cantidad;
+        return true;
+    }
+
+    size_t tam = tam_real(pool);
+    if (pool->restantes == 0) {
+        Bloque* bloque = mem_reservar(pool->subsistema, sizeof(Bloque) + tam * OBJETOSPORBLOQUE);
+        if (!bloque) {
+            desbloquear(&pool->cerrojo);
+            return false;
+        }
+        bloque->siguiente = pool->bloques;
+        pool->bloques = bloque;
+        pool->siguiente = (char*)(bloque + 1);
+        pool->restantes = OBJETOSPORBLOQUE;
+    }
+
+    size_t cantidad = pool->restantes < OBJETOSPORLOTE ? pool->restantes : OBJETOSPORLOTE;
+    char* inicio = pool->siguiente;
+    pool->siguiente += cantidad * tam;
+    pool->restantes -= cantidad;
+    pool->objetosCreados += cantidad;
+    desbloquear(&pool->cerrojo);
+
+    for (size_t i = 0; i < cantidad; i++) {
+        Libre* objeto = (Libre*)(inicio + i * tam);
+        objeto->siguiente = i + 1 < cantidad ? (Libre*)(inicio + (i + 1) * tam) : NULL;
+    }
+    cache->objetos = (Libre*)inicio;
+    cache->cantidad = (int)cantidad;
+    return true;
+}
+
+// Pasa a la lista común del pool los primeros 'cantidad' objetos de la caché.
+static void devolver_lote(PoolObjetos* pool, CacheHilo* cache, int cantidad) {
+    Libre* lote = cache->objetos;
+    Libre* ultimo = lote;
+    for (int i = 1; i < cantidad; i++) ultimo = ultimo->siguiente;
+    cache->objetos = ultimo->siguiente;
+    cache->cantidad -= cantidad;
+    ultimo->siguiente = NULL;
+
+    bloquear(&pool->cerrojo);
+    lote->siguienteLote = pool->lotes;
+    pool->lotes = lote;
+    pool->lotesDevueltos++;
+    desbloquear(&pool->cerrojo);
+}
+
+void* objeto_reservar(PoolObjetos* pool) {
+    int id = registrar(pool);
+    if (id < 0) return mem_reservar(pool->subsistema, pool->tamObjeto);
+
+    CacheHilo* cache = &caches[id];
+    if (!cache->objetos && !rellenar(pool, cache)) return NULL;
+
+    Libre* objeto = cache->objetos;
+    cache->objetos = objeto->siguiente;
+    cache->cantidad--;
+    return objeto;
+}
+
+void objeto_liberar(PoolObjetos* pool, void* objeto) {
+    if (!objeto) return;
+    int id = atomic_load_explicit(&pool->id, memory_order_acquire);
+    if (id < 0) {
+        mem_liberar(objeto);
+        return;
+    }
+
+    CacheHilo* cache = &caches[id];
+    Libre* libre = objeto;
+    libre->siguiente = cache->objetos;
+    cache->objetos = libre;
+    // Con dos lotes guardados se devuelve uno: la caché no crece sin límite y un hilo
+    // que solo libera (por ejemplo, el que cierra partidas de otros) alimenta a los demás.
+    if (++cache->cantidad >= 2 * OBJETOSPORLOTE) devolver_lote(pool, cache, OBJETOSPORLOTE);
+}
+
+void objetos_soltar_cache_hilo(void) {
+    bloquear(&cerrojoRegistro);
+    int cantidadPools = numRegistrados;
+    desbloquear(&cerrojoRegistro);
+
+    for (int id = 0; id < cantidadPools; id++) {
+        CacheHilo* cache = &caches[id];
+        while (cache->cantidad > 0) {
+            int cantidad = cache->cantidad < OBJETOSPORLOTE ? cache->cantidad : OBJETOSPORLOTE;
+            devolver_lote(registrados[id], cache, cantidad);
+        }
+    }
+}
+
+void objetos_liberar_todo(void) {
+    bloquear(&cerrojoRegistro);
+    for (int id = 0; id < numRegistrados; id++) {
+        PoolObjetos* pool = registrados[id];
+        bloquear(&pool->cerrojo);
+        Bloque* bloque = pool->bloques;
+        while (bloque) {
+            Bloque* siguiente = bloque->siguiente;
+            mem_liberar(bloque);
+            bloque = siguiente;
+        }
+        pool->bloques = NULL;
+        pool->lotes = NULL;
+        pool->siguiente = NULL;
+        pool->restantes = 0;
+        desbloquear(&pool->cerrojo);
+
+        caches[id].objetos = NULL;
+        caches[id].cantidad = 0;
+    }
+    desbloquear(&cerrojoRegistro);
+}
+
+/**
+ * objetos_reportar
+ * ----------------
+ * Escribe, para cada pool usado, cuántos objetos se crearon (el máximo que estuvo en
+ * uso al mismo tiempo, redondeado a lotes), cuántos bloques se pidieron al sistema y
+ * cuántos lotes se intercambiaron entre las cachés de los hilos y la lista común.
+ */
+
+void objetos_reportar(FILE* salida) {
+    fprintf(salida, "\n------ Pools de objetos ------\n");
+    fprintf(salida, "%-10s %10s %12s %10s %14s %14s\n", "pool", "bytes c/u", "objetos", "bloques",
+            "lotes tomados", "lotes devueltos");
+    bloquear(&cerrojoRegistro);
+    for (int id = 0; id < numRegistrados; id++) {
+        PoolObjetos* pool = registrados[id];
+        bloquear(&pool->cerrojo);
+        size_t bloques = (pool->objetosCreados + OBJETOSPORBLOQUE - 1) / OBJETOSPORBLOQUE;
+        fprintf(salida, "%-10s %10zu %12zu %10zu %14zu %14zu\n", pool->nombre, tam_real(pool),
+                pool->objetosCreados, bloques, pool->lotesTomados, pool->lotesDevueltos);
+        desbloquear(&pool->cerrojo);
+    }
+    desbloquear(&cerrojoRegistro);
+}
+
+#else
+
+void* objeto_reservar(PoolObjetos* pool) {
+    return mem_reservar(pool->subsistema, pool->tamObjeto);
+}
+
+void objeto_liberar(PoolObjetos* pool, void* objeto) {
+    (void)pool;
+    mem_liberar(objeto);
+}
+
+void objetos_soltar_cache_hilo(void) {
+}
+
+void objetos_liberar_todo(void) {
+}
+
+void objetos_reportar(FILE* salida) {
+    fprintf(salida, "\nPools de objetos desactivados (compilado con SIN_POOL_OBJETOS).\n");
+}
+
+#endif
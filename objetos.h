@@ -0,0 +1,62 @@
+#ifndef OBJETOS_H
+#define OBJETOS_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "memoria.h"
+
+/*
+ * Pools de objetos de tamaño fijo (ítems, nodos de lista, ...). Los objetos liberados
+ * no vuelven al sistema: quedan en una caché del hilo que los liberó y se reutilizan
+ * en la siguiente reserva, así que partidas y reinicios sucesivos no vuelven a pasar
+ * por malloc. Las cachés intercambian lotes de OBJETOSPORLOTE objetos con una lista
+ * común del pool, protegida por un cerrojo que solo se toma una vez por lote.
+ *
+ * Compilando con -DSIN_POOL_OBJETOS cada objeto se reserva y libera por separado con
+ * mem_reservar / mem_liberar.
+ */
+
+#define MAXPOOLSOBJETOS 8       // Pools distintos que puede usar el programa
+#define OBJETOSPORLOTE 64       // Objetos que una caché toma o devuelve de una vez
+#define OBJETOSPORBLOQUE 1024   // Objetos que se piden al sistema de una vez
+
+typedef struct PoolObjetos {
+    const char*  nombre;
+    size_t       tamObjeto;
+    Subsistema   subsistema;    // Subsistema al que se cargan los bloques reservados
+
+    // Estado interno, inicializado por POOL_OBJETOS
+    _Atomic int  id;            // Posición en las cachés de cada hilo (-1 hasta el primer uso)
+    atomic_flag  cerrojo;
+    void*        lotes;         // Lotes de objetos libres devueltos por las cachés
+    void*        bloques;       // Bloques pedidos al sistema
+    char*        siguiente;     // Parte todavía sin usar del último bloque
+    size_t       restantes;     // Objetos que quedan en esa parte
+    size_t       objetosCreados;
+    size_t       lotesTomados;
+    size_t       lotesDevueltos;
+} PoolObjetos;
+
+// Inicializador estático: static PoolObjetos poolItems = POOL_OBJETOS("items", Item, MEM_ITEMS);
+#define POOL_OBJETOS(nombre, tipo, subsistema) \
+    { (nombre), sizeof(tipo), (subsistema), -1, ATOMIC_FLAG_INIT, NULL, NULL, NULL, 0, 0, 0, 0 }
+
+// Reserva un objeto del pool (contenido indefinido). Retorna NULL si no hay memoria.
+void* objeto_reservar(PoolObjetos* pool);
+
+// Devuelve el objeto al pool. Puede hacerse desde cualquier hilo.
+void objeto_liberar(PoolObjetos* pool, void* objeto);
+
+// Devuelve al pool los objetos que guarda la caché del hilo actual. Llamar antes de
+// terminar un hilo que haya usado pools, para que sus objetos se puedan reutilizar.
+void objetos_soltar_cache_hilo(void);
+
+// Devuelve al sistema los bloques de todos los pools. Solo al final del programa, sin
+// objetos en uso ni otros hilos activos.
+void objetos_liberar_todo(void);
+
+// Escribe el uso de cada pool: objetos creados, bloques y lotes intercambiados.
+void objetos_reportar(FILE* salida);
+
+#endif // OBJETOS_H
@@ -0,0 +1,227 @@
+#include "orden.h"
+#include "grafo.h"
+#include "memoria.h"
+
+#include <stdlib.h>
+
+/*
+ * Reordenamiento de nodos
+ * -----------------------
+ * En mapas generados el orden de los IDs no tiene relación con la forma del laberinto,
+ * así que recorrer vecinos salta por toda la memoria. Estas funciones calculan un orden
+ * en que los vecinos quedan cerca entre sí y mueven los nodos a ese orden.
+ *
+ * El ID original de cada escenario se conserva en state.id, que es el que se muestra.
+ */
+
+/*
+ * construir_vecinos
+ * -----------------
+ * Arma la lista de vecinos sin dirección (aristas salientes y entrantes) en formato
+ * compacto: los vecinos de v son vecinos[inicio[v] .. inicio[v + 1]). Los repetidos
+ * (arista de ida y de vuelta) se dejan: solo cuentan una vez al visitar.
+ */
+
+static bool construir_vecinos(const Graph* g, int** inicio, int** vecinos) {
+    int n = g->numberOfNodes;
+    int m = g->inicioAristas[n];
+    int* ini = mem_reservar_ceros(MEM_GRAFO, n + 1, sizeof(int));
+    int* vec = mem_reservar(MEM_GRAFO, sizeof(int) * (2 * (size_t)m + 1));
+    int* pos = mem_reservar(MEM_GRAFO, sizeof(int) * (n + 1));
+    if (!ini || !vec || !pos) {
+        mem_liberar(ini); mem_liberar(vec); mem_liberar(pos);
+        return false;
+    }
+
+    for (int v = 0; v < n; v++)
+        for (int k = g->inicioAristas[v]; k < g->inicioAristas[v + 1]; k++) {
+            ini[v + 1]++;
+            ini[g->aristas[k].destino + 1]++;
+        }
+    for (int v = 0; v < n; v++) ini[v + 1] += ini[v];
+    for (int v = 0; v <= n; v++) pos[v] = ini[v];
+    for (int v = 0; v < n; v++)
+        for (int k = g->inicioAristas[v]; k < g->inicioAristas[v + 1]; k++) {
+            int w = g->aristas[k].destino;
+            vec[pos[v]++] = w;
+            vec[pos[w]++] = v;
+        }
+
+    mem_liberar(pos);
+    *inicio = ini;
+    *vecinos = vec;
+    return true;
+}
+
+// Par (grado, nodo) para ordenar vecinos de menor a mayor grado.
+typedef struct {
+    int grado;
+    int nodo;
+} ParGrado;
+
+static int comparar_grados(const void* a, const void* b) {
+    const ParGrado* x = a;
+    const ParGrado* y = b;
+    if (x->grado != y->grado) return x->grado < y->grado ? -1 : 1;
+    return x->nodo - y->nodo;
+}
+
+// Ordena por grado ascendente (estable respecto del índice, para un resultado determinista).
+static void ordenar_por_grado(int* nodos, int cantidad, const int* inicio, ParGrado* pares) {
+    if (cantidad < 2) return;
+    for (int i = 0; i < cantidad; i++) {
+        pares[i].grado = inicio[nodos[i] + 1] - inicio[nodos[i]];
+        pares[i].nodo = nodos[i];
+    }
+    qsort(pares, cantidad, sizeof(ParGrado), comparar_grados);
+    for (int i = 0; i < cantidad; i++) nodos[i] = pares[i].nodo;
+}
+
+/*
+ * calcular_orden
+ * --------------
+ * Llena `orden` (posición nueva -> índice viejo) con un recorrido en anchura sobre el
+ * grafo sin dirección. Con `porGrado` los vecinos se visitan de menor a mayor grado y
+ * cada componente parte desde su nodo de menor grado (Cuthill–McKee), salvo la del
+ * inicio, que siempre parte desde él. Retorna false si no hay memoria.
+ */
+
+static bool calcular_orden(const Graph* g, const int* inicio, const int* vecinos,
+                           bool porGrado, int* orden, bool* visitado) {
+    int n = g->numberOfNodes;
+    int fondo = 0;
+    int raizInicio = g->start ? (int)(g->start - g->nodes) : 0;
+
+    // Candidatos a raíz: en orden de archivo, o de menor a mayor grado para Cuthill–McKee
+    int maxGrado = 0;
+    for (int v = 0; v < n; v++) {
+        if (inicio[v + 1] - inicio[v] > maxGrado) maxGrado = inicio[v + 1] - inicio[v];
+    }
+    int* candidatos = mem_reservar(MEM_GRAFO, sizeof(int) * n);
+    int* cuenta = mem_reservar_ceros(MEM_GRAFO, maxGrado + 2, sizeof(int));
+    ParGrado* pares = mem_reservar(MEM_GRAFO, sizeof(ParGrado) * (maxGrado + 1));
+    if (!candidatos || !cuenta || !pares) {
+        mem_liberar(candidatos); mem_liberar(cuenta); mem_liberar(pares);
+        return false;
+    }
+    if (porGrado) {
+        for (int v = 0; v < n; v++) cuenta[inicio[v + 1] - inicio[v] + 1]++;
+        for (int k = 1; k < maxGrado + 2; k++) cuenta[k] += cuenta[k - 1];
+        for (int v = 0; v < n; v++) candidatos[cuenta[inicio[v + 1] - inicio[v]]++] = v;
+    } else {
+        for (int v = 0; v < n; v++) candidatos[v] = v;
+    }
+    mem_liberar(cuenta);
+
+    for (int siguiente = -1; fondo < n; siguiente++) {
+        int raiz;
+        if (siguiente < 0) {
+            raiz = raizInicio;
+        } else {
+            while (siguiente < n && visitado[candidatos[siguiente]]) siguiente++;
+            if (siguiente >= n) break;
+            raiz = candidatos[siguiente];
+        }
+        if (visitado[raiz]) continue;
+
+        int frente = fondo;
+        orden[fondo++] = raiz;
+        visitado[raiz] = true;
+        while (frente < fondo) {
+            int v = orden[frente++];
+            int primero = fondo;
+            for (int k = inicio[v]; k < inicio[v + 1]; k++) {
+                int w = vecinos[k];
+                if (!visitado[w]) {
+                    visitado[w] = true;
+                    orden[fondo++] = w;
+                }
+            }
+            if (porGrado) ordenar_por_grado(orden + primero, fondo - primero, inicio, pares);
+        }
+    }
+
+    mem_liberar(candidatos);
+    mem_liberar(pares);
+    return true;
+}
+
+/**
+ * reordenar_nodos
+ * ----------------
+ * Mueve los nodos del grafo al orden pedido (BFS desde el inicio o Cuthill–McKee inverso)
+ * y reescribe sus aristas (en el nuevo orden de origen) y el puntero al inicio.
+ *
+ * Consideraciones:
+ *  - Debe llamarse antes de construir los índices y el análisis de alcance, que guardan
+ *    posiciones de nodos.
+ *  - Costo O(nodos + aristas); la memoria auxiliar se libera al terminar.
+ *  - Retorna false si no hay memoria; en ese caso el grafo queda como estaba.
+ */
+
+bool reordenar_nodos(Graph* g, OrdenNodos modo) {
+    int n = g->numberOfNodes;
+    if (modo == ORDEN_ARCHIVO || n <= 1) return true;
+
+    int* inicio = NULL;
+    int* vecinos = NULL;
+    if (!construir_vecinos(g, &inicio, &vecinos)) return false;
+
+    int* orden = mem_reservar(MEM_GRAFO, sizeof(int) * n);
+    int* nuevaPosicion = mem_reservar(MEM_GRAFO, sizeof(int) * n);
+    bool* visitado = mem_reservar_ceros(MEM_GRAFO, n, sizeof(bool));
+    Node* nodos = mem_reservar(MEM_GRAFO, sizeof(Node) * g->capacidad);
+    if (!orden || !nuevaPosicion || !visitado || !nodos) {
+        mem_liberar(inicio); mem_liberar(vecinos); mem_liberar(orden); mem_liberar(nuevaPosicion); mem_liberar(visitado); mem_liberar(nodos);
+        return false;
+    }
+
+    bool ok = calcular_orden(g, inicio, vecinos, modo == ORDEN_RCM, orden, visitado);
+    mem_liberar(inicio);
+    mem_liberar(vecinos);
+    mem_liberar(visitado);
+    if (!ok) {
+        mem_liberar(orden); mem_liberar(nuevaPosicion); mem_liberar(nodos);
+        return false;
+    }
+
+    if (modo == ORDEN_RCM) {
+        for (int i = 0, j = n - 1; i < j; i++, j--) {
+            int aux = orden[i];
+            orden[i] = orden[j];
+            orden[j] = aux;
+        }
+    }
+    for (int i = 0; i < n; i++) nuevaPosicion[orden[i]] = i;
+
+    // Mover los nodos con sus aristas, apuntando estas a las nuevas posiciones
+    int* inicioAristas = mem_reservar(MEM_GRAFO, sizeof(int) * (n + 1));
+    Arista* aristas = mem_reservar(MEM_GRAFO, sizeof(Arista) * (g->numAristas + 1));
+    if (!inicioAristas || !aristas) {
+        mem_liberar(inicioAristas); mem_liberar(aristas); mem_liberar(orden); mem_liberar(nuevaPosicion); mem_liberar(nodos);
+        return false;
+    }
+    int numAristas = 0;
+    for (int i = 0; i < n; i++) {
+        int viejo = orden[i];
+        nodos[i] = g->nodes[viejo];
+        inicioAristas[i] = numAristas;
+        for (int k = g->inicioAristas[viejo]; k < g->inicioAristas[viejo + 1]; k++) {
+            aristas[numAristas] = g->aristas[k];
+            aristas[numAristas].destino = nuevaPosicion[g->aristas[k].destino];
+            numAristas++;
+        }
+    }
+    inicioAristas[n] = numAristas;
+    if (g->start) g->start = &nodos[nuevaPosicion[g->start - g->nodes]];
+
+    mem_liberar(g->inicioAristas);
+    mem_liberar(g->aristas);
+    g->inicioAristas = inicioAristas;
+    g->aristas = aristas;
+    mem_liberar(g->nodes);
+    g->nodes = nodos;
+    mem_liberar(orden);
+    mem_liberar(nuevaPosicion);
+    return true;
+}
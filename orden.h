@@ -0,0 +1,18 @@
+#ifndef ORDEN_H
+#define ORDEN_H
+
+#include <stdbool.h>
+
+typedef struct Graph Graph;
+
+// Orden en que quedan los nodos en memoria después de cargar el mapa.
+typedef enum {
+    ORDEN_ARCHIVO,      // El del archivo CSV (por defecto)
+    ORDEN_BFS,          // Recorrido en anchura desde el escenario inicial
+    ORDEN_RCM           // Cuthill–McKee inverso (minimiza la distancia entre vecinos)
+} OrdenNodos;
+
+// Renumera los nodos del grafo según el orden pedido y reescribe las aristas y el inicio.
+bool reordenar_nodos(Graph* g, OrdenNodos orden);
+
+#endif // ORDEN_H
@@ -0,0 +1,300 @@
+#include "plano.h"
+#include "grafo.h"
+#include "list.h"
+#include "memoria.h"
+#include "escritor.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+
+#define MAXRADIOMINIMAPA 10
+
+// Desplazamiento de cada dirección cardinal, indexado por Arista.direccion.
+static const int dx[MAXDIR] = { 0, 0, -1, 1 };
+static const int dy[MAXDIR] = { -1, 1, 0, 0 };
+
+static uint32_t hash_coordenada(int x, int y, int isla) {
+    uint32_t h = (uint32_t)x * 0x9E3779B1u ^ (uint32_t)y * 0x85EBCA77u ^ (uint32_t)isla * 0xC2B2AE3Du;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    return h;
+}
+
+static int buscar_casilla(const Plano* p, int x, int y, int isla) {
+    uint32_t i = hash_coordenada(x, y, isla) & p->mascara;
+    while (p->casillas[i].nodo >= 0) {
+        const CasillaPlano* c = &p->casillas[i];
+        if (c->x == x && c->y == y && c->isla == isla) return c->nodo;
+        i = (i + 1) & p->mascara;
+    }
+    return -1;
+}
+
+static void insertar_casilla(Plano* p, int x, int y, int isla, int nodo) {
+    uint32_t i = hash_coordenada(x, y, isla) & p->mascara;
+    while (p->casillas[i].nodo >= 0) i = (i + 1) & p->mascara;
+    p->casillas[i] = (CasillaPlano){ x, y, isla, nodo };
+}
+
+/*
+ * ubicar_isla
+ * -----------
+ * Recorrido en anchura desde 'semilla' por las aristas cardinales, con la semilla en
+ * (0, 0). Un vecino cuya casilla ya está ocupada en esta isla queda sin ubicar y más
+ * adelante inicia una isla propia. Deja los nodos ubicados en 'cola' y retorna su
+ * cantidad.
+ */
+
+static int ubicar_isla(Plano* p, const Graph* g, int semilla, int isla, int* islaDe, int* cola) {
+    Coordenada* pos = p->posiciones;
+    int cabeza = 0, fin = 0;
+    pos[semilla] = (Coordenada){ 0, 0 };
+    islaDe[semilla] = isla;
+    insertar_casilla(p, 0, 0, isla, semilla);
+    cola[fin++] = semilla;
+
+    while (cabeza < fin) {
+        int u = cola[cabeza++];
+        for (int k = g->inicioAristas[u]; k < g->inicioAristas[u + 1]; k++) {
+            const Arista* a = &g->aristas[k];
+            int v = a->destino;
+            if (a->direccion < 0 || islaDe[v] >= 0) continue;
+            int x = pos[u].x + dx[a->direccion];
+            int y = pos[u].y + dy[a->direccion];
+            if (buscar_casilla(p, x, y, isla) >= 0) continue;
+            pos[v] = (Coordenada){ x, y };
+            islaDe[v] = isla;
+            insertar_casilla(p, x, y, isla, v);
+            cola[fin++] = v;
+        }
+    }
+    return fin;
+}
+
+/**
+ * plano_construir
+ * ---------------
+ * Ubica primero la isla del escenario inicial y luego, en orden, una isla por cada nodo
+ * que quedó sin ubicar (no alcanzable por aristas cardinales o en conflicto). Cada isla
+ * se coloca a la derecha de las anteriores, alineada arriba con la primera, así que
+ * ninguna casilla queda ocupada dos veces. Al final se rehace el índice con las
+ * coordenadas definitivas y se cuentan las aristas cardinales que no encajan.
+ */
+
+Plano* plano_construir(const Graph* g) {
+    int n = g->numberOfNodes;
+    if (n <= 0) return NULL;
+
+    Plano* p = mem_reservar(MEM_GRAFO, sizeof(Plano));
+    int* islaDe = mem_reservar(MEM_GRAFO, sizeof(int) * n);
+    int* cola = mem_reservar(MEM_GRAFO, sizeof(int) * n);
+    uint32_t capacidad = 16;
+    while (capacidad < 2u * (uint32_t)n) capacidad <<= 1;
+    if (p) {
+        p->posiciones = mem_reservar(MEM_GRAFO, sizeof(Coordenada) * n);
+        p->casillas = mem_reservar(MEM_GRAFO, sizeof(CasillaPlano) * capacidad);
+    }
+    if (!p || !islaDe || !cola || !p->posiciones || !p->casillas) {
+        if (p) { mem_liberar(p->posiciones); mem_liberar(p->casillas); }
+        mem_liberar(p); mem_liberar(islaDe); mem_liberar(cola);
+        return NULL;
+    }
+    p->mascara = capacidad - 1;
+    for (uint32_t i = 0; i < capacidad; i++) p->casillas[i].nodo = -1;
+    for (int i = 0; i < n; i++) islaDe[i] = -1;
+
+    int islas = 0;
+    int minY = 0, maxY = 0, siguienteX = 0;
+    int primero = g->start ? (int)(g->start - g->nodes) : 0;
+    for (int s = -1; s < n; s++) {
+        int semilla = s < 0 ? primero : s;
+        if (islaDe[semilla] >= 0) continue;
+
+        int cantidad = ubicar_isla(p, g, semilla, islas, islaDe, cola);
+        int islaMinX = INT_MAX, islaMaxX = INT_MIN, islaMinY = INT_MAX, islaMaxY = INT_MIN;
+        for (int i = 0; i < cantidad; i++) {
+            Coordenada c = p->posiciones[cola[i]];
+            if (c.x < islaMinX) islaMinX = c.x;
+            if (c.x > islaMaxX) islaMaxX = c.x;
+            if (c.y < islaMinY) islaMinY = c.y;
+            if (c.y > islaMaxY) islaMaxY = c.y;
+        }
+
+        // La primera isla queda donde está; las demás a su derecha, con una columna libre
+        int desplX = 0, desplY = 0;
+        if (islas == 0) {
+            minY = islaMinY;
+            maxY = islaMaxY;
+            siguienteX = islaMaxX + 2;
+        } else {
+            desplX = siguienteX - islaMinX;
+            desplY = minY - islaMinY;
+            for (int i = 0; i < cantidad; i++) {
+                p->posiciones[cola[i]].x += desplX;
+                p->posiciones[cola[i]].y += desplY;
+            }
+            siguienteX += islaMaxX - islaMinX + 2;
+            if (islaMaxY + desplY > maxY) maxY = islaMaxY + desplY;
+        }
+        islas++;
+    }
+
+    int minX = INT_MAX;
+    for (uint32_t i = 0; i < capacidad; i++) p->casillas[i].nodo = -1;
+    for (int v = 0; v < n; v++) {
+        insertar_casilla(p, p->posiciones[v].x, p->posiciones[v].y, 0, v);
+        if (p->posiciones[v].x < minX) minX = p->posiciones[v].x;
+    }
+
+    int conflictos = 0;
+    for (int u = 0; u < n; u++) {
+        for (int k = g->inicioAristas[u]; k < g->inicioAristas[u + 1]; k++) {
+            const Arista* a = &g->aristas[k];
+            if (a->direccion < 0) continue;
+            Coordenada desde = p->posiciones[u], hasta = p->posiciones[a->destino];
+            if (hasta.x != desde.x + dx[a->direccion] || hasta.y != desde.y + dy[a->direccion]) conflictos++;
+        }
+    }
+
+    p->resumen.islas = islas;
+    p->resumen.conflictos = conflictos;
+    p->minimo = (Coordenada){ minX, minY };
+    p->maximo = (Coordenada){ siguienteX - 2, maxY };
+    p->resumen.ancho = p->maximo.x - minX + 1;
+    p->resumen.alto = maxY - minY + 1;
+    mem_liberar(islaDe);
+    mem_liberar(cola);
+    return p;
+}
+
+void plano_liberar(Plano* plano) {
+    if (!plano) return;
+    mem_liberar(plano->posiciones);
+    mem_liberar(plano->casillas);
+    mem_liberar(plano);
+}
+
+size_t plano_memoria(const Plano* plano, int numNodos) {
+    if (!plano) return 0;
+    return sizeof(Plano) + sizeof(Coordenada) * (size_t)numNodos + sizeof(CasillaPlano) * ((size_t)plano->mascara + 1);
+}
+
+/**
+ * plano_generar_c
+ * ---------------
+ * Escribe las coordenadas (planoPosiciones), las casillas del índice espacial
+ * (planoCasillas) y la estructura 'plano' que las reúne, todas 'static const'.
+ */
+
+void plano_generar_c(const Plano* plano, int numNodos, Escritor* e) {
+    escritor_printf(e, "static const Coordenada planoPosiciones[%d] = {", numNodos);
+    for (int i = 0; i < numNodos; i++) {
+        escritor_cadena(e, i % 8 == 0 ? "\n    " : " ");
+        escritor_printf(e, "{ %d, %d },", plano->posiciones[i].x, plano->posiciones[i].y);
+    }
+    escritor_printf(e, "\n};\n\nstatic const CasillaPlano planoCasillas[%lu] = {", (unsigned long)plano->mascara + 1);
+    for (uint32_t i = 0; i <= plano->mascara; i++) {
+        const CasillaPlano* c = &plano->casillas[i];
+        escritor_cadena(e, i % 6 == 0 ? "\n    " : " ");
+        if (c->nodo < 0) escritor_cadena(e, "{ 0, 0, 0, -1 },");
+        else             escritor_printf(e, "{ %d, %d, 0, %d },", c->x, c->y, c->nodo);
+    }
+    const ResumenPlano* r = &plano->resumen;
+    escritor_printf(e,
+        "\n};\n\n"
+        "static const Plano plano = {\n"
+        "    (Coordenada*)planoPosiciones, (CasillaPlano*)planoCasillas, %lu,\n"
+        "    { %d, %d }, { %d, %d }, { %d, %d, %d, %d }\n"
+        "};\n\n",
+        (unsigned long)plano->mascara, plano->minimo.x, plano->minimo.y, plano->maximo.x, plano->maximo.y,
+        r->islas, r->conflictos, r->ancho, r->alto);
+}
+
+ResumenPlano plano_resumen(const Plano* plano) {
+    return plano->resumen;
+}
+
+Coordenada plano_posicion(const Plano* plano, int nodo) {
+    return plano->posiciones[nodo];
+}
+
+int plano_nodo_en(const Plano* plano, int x, int y) {
+    return buscar_casilla(plano, x, y, 0);
+}
+
+// true si 'desde' tiene una arista en la dirección 'direccion' que llega a 'hasta'.
+static bool conectados(const Graph* g, int desde, int hasta, int direccion) {
+    for (int k = g->inicioAristas[desde]; k < g->inicioAristas[desde + 1]; k++) {
+        if (g->aristas[k].direccion == direccion && g->aristas[k].destino == hasta) return true;
+    }
+    return false;
+}
+
+static char simbolo_casilla(const Graph* g, const Node* actual, int nodo) {
+    const Node* node = &g->nodes[nodo];
+    if (node == actual) return '@';
+    if (node->state.esFinal) return 'F';
+    for (ListNode* ln = node->state.availableItems->head; ln; ln = ln->next) {
+        if (item_disponible(ln->data)) return '*';
+    }
+    return 'o';
+}
+
+// Imprime la fila con sangría y sin los espacios del final.
+static void imprimir_fila(char* fila, int largo) {
+    while (largo > 0 && fila[largo - 1] == ' ') largo--;
+    fila[largo] = '\0';
+    if (largo > 0) printf("  %s\n", fila);
+    else puts("");
+}
+
+/**
+ * mostrar_minimapa
+ * ----------------
+ * Cada casilla se resuelve con una búsqueda en el índice espacial y sus conexiones con
+ * las aristas de sus dos nodos, así que el costo depende solo del radio y no del tamaño
+ * del mapa. La ventana se recorta a los bordes del plano. Una conexión se dibuja si cualquiera de los dos escenarios lleva al otro
+ * (las direcciones opuestas difieren solo en el último bit: Arriba/Abajo e Izquierda/Derecha).
+ */
+
+void mostrar_minimapa(const Graph* g, const Node* actual, int radio) {
+    const Plano* p = g->plano;
+    if (!p || !actual) return;
+    if (radio > MAXRADIOMINIMAPA) radio = MAXRADIOMINIMAPA;
+
+    enum { ABAJO = 1, DERECHA = 3 };
+    Coordenada centro = plano_posicion(p, (int)(actual - g->nodes));
+    int desdeX = centro.x - radio < p->minimo.x ? p->minimo.x : centro.x - radio;
+    int hastaX = centro.x + radio > p->maximo.x ? p->maximo.x : centro.x + radio;
+    int desdeY = centro.y - radio < p->minimo.y ? p->minimo.y : centro.y - radio;
+    int hastaY = centro.y + radio > p->maximo.y ? p->maximo.y : centro.y + radio;
+    char casillas[4 * MAXRADIOMINIMAPA + 4], uniones[4 * MAXRADIOMINIMAPA + 4];
+
+    puts("Mapa (@ estás aquí, F final, * ítems):");
+    for (int y = desdeY; y <= hastaY; y++) {
+        int largo = 0;
+        bool hayUniones = false;
+        for (int x = desdeX; x <= hastaX; x++) {
+            int nodo = plano_nodo_en(p, x, y);
+            casillas[largo] = nodo >= 0 ? simbolo_casilla(g, actual, nodo) : ' ';
+            casillas[largo + 1] = ' ';
+            uniones[largo] = uniones[largo + 1] = ' ';
+            if (nodo >= 0) {
+                int derecha = x < hastaX ? plano_nodo_en(p, x + 1, y) : -1;
+                int abajo = y < hastaY ? plano_nodo_en(p, x, y + 1) : -1;
+                if (derecha >= 0 && (conectados(g, nodo, derecha, DERECHA) || conectados(g, derecha, nodo, DERECHA ^ 1))) {
+                    casillas[largo + 1] = '-';
+                }
+                if (abajo >= 0 && (conectados(g, nodo, abajo, ABAJO) || conectados(g, abajo, nodo, ABAJO ^ 1))) {
+                    uniones[largo] = '|';
+                    hayUniones = true;
+                }
+            }
+            largo += 2;
+        }
+        imprimir_fila(casillas, largo);
+        if (y < hastaY) imprimir_fila(uniones, hayUniones ? largo : 0);
+    }
+}
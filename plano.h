@@ -0,0 +1,75 @@
+#ifndef PLANO_H
+#define PLANO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct Graph Graph;
+typedef struct Node Node;
+typedef struct Escritor Escritor;
+
+#define RADIOMINIMAPA 3         // Casillas que muestra el minimapa hacia cada lado
+
+/*
+ * Plano del mapa: coordenadas enteras (x, y) para cada escenario, deducidas de las
+ * direcciones cardinales (Arriba resta 1 a y, Derecha suma 1 a x), y un índice espacial
+ * de coordenada a escenario. Se construye una vez al cargar el mapa y las copias del
+ * grafo lo comparten, así que el minimapa no recorre el grafo en cada turno.
+ */
+
+typedef struct {
+    int x;
+    int y;
+} Coordenada;
+
+// Resumen del plano, para informarlo al cargar el mapa.
+typedef struct {
+    int islas;          // Grupos de escenarios ubicados por separado (1 si todo encaja)
+    int conflictos;     // Aristas cardinales que no unen casillas vecinas en su dirección
+    int ancho;          // Tamaño del rectángulo que ocupa el plano
+    int alto;
+} ResumenPlano;
+
+// Casilla del índice espacial (direccionamiento abierto). 'nodo' es -1 si está vacía.
+typedef struct {
+    int x;
+    int y;
+    int isla;               // Solo se usa mientras se ubican las islas; después es 0
+    int nodo;
+} CasillaPlano;
+
+// Pública para que los mapas incrustados (ver incrustado.h) traigan el plano ya construido.
+typedef struct Plano {
+    Coordenada* posiciones;     // Coordenada de cada nodo, por índice en g->nodes
+    CasillaPlano* casillas;
+    uint32_t mascara;           // Cantidad de casillas - 1 (potencia de 2)
+    Coordenada minimo;          // Esquinas del rectángulo que ocupa el plano
+    Coordenada maximo;
+    ResumenPlano resumen;
+} Plano;
+
+// Ubica los escenarios del grafo (ya reordenado) y construye el índice espacial.
+// Retorna NULL si no hay memoria.
+Plano* plano_construir(const Graph* g);
+
+void plano_liberar(Plano* plano);
+
+// Bytes que ocupa el plano en memoria.
+size_t plano_memoria(const Plano* plano, int numNodos);
+
+ResumenPlano plano_resumen(const Plano* plano);
+
+// Coordenada del nodo (índice en g->nodes).
+Coordenada plano_posicion(const Plano* plano, int nodo);
+
+// Índice del nodo ubicado en (x, y), o -1 si la casilla está vacía.
+int plano_nodo_en(const Plano* plano, int x, int y);
+
+// Escribe el plano como tablas de C 'static const' (ver incrustado.h).
+void plano_generar_c(const Plano* plano, int numNodos, Escritor* e);
+
+// Dibuja las casillas a distancia 'radio' o menos del nodo actual, con sus conexiones.
+void mostrar_minimapa(const Graph* g, const Node* actual, int radio);
+
+#endif // PLANO_H
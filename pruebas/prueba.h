@@ -0,0 +1,25 @@
+#ifndef PRUEBA_H
+#define PRUEBA_H
+
+#include <stdio.h>
+
+/*
+ * Comprobaciones de las pruebas. Cada falla se informa en stderr con su archivo y línea
+ * sin detener la prueba; FIN_PRUEBA retorna de main con 1 si hubo alguna.
+ */
+
+static int fallas = 0;
+
+#define COMPROBAR(condicion) do { \
+        if (!(condicion)) { \
+            fprintf(stderr, "%s:%d: falló: %s\n", __FILE__, __LINE__, #condicion); \
+            fallas++; \
+        } \
+    } while (0)
+
+#define FIN_PRUEBA() do { \
+        if (fallas > 0) fprintf(stderr, "%d comprobaciones fallaron.\n", fallas); \
+        return fallas > 0 ? 1 : 0; \
+    } while (0)
+
+#endif // PRUEBA_H
@@ -0,0 +1,165 @@
+#include "prueba.h"
+#include "grafo.h"
+#include "alcance.h"
+#include "extra.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Análisis de alcance (ver alcance.c): componentes fuertemente conexas y tiempo mínimo
+ * hasta un final, con la cantidad de aristas del camino. Se compara contra una versión
+ * directa (Floyd–Warshall y clausura transitiva) sobre mapas al azar con aristas
+ * extendidas de distintos costos, cargados en el orden del archivo y reordenados.
+ */
+
+#define MAXNODOSPRUEBA 40
+#define MAPAS 300
+#define INFINITO 1000000
+
+typedef struct {
+    int n;
+    int costo[MAXNODOSPRUEBA][MAXNODOSPRUEBA];     // Tiempo de la arista más barata (INFINITO si no hay)
+    int pasos[MAXNODOSPRUEBA][MAXNODOSPRUEBA];
+    bool llega[MAXNODOSPRUEBA][MAXNODOSPRUEBA];
+    bool esFinal[MAXNODOSPRUEBA];
+} Referencia;
+
+static void agregar_arista(Referencia* r, int desde, int hasta, int costoBase) {
+    int t = costoBase + 1;      // Costo con el inventario vacío
+    if (t < r->costo[desde][hasta]) r->costo[desde][hasta] = t;
+    r->llega[desde][hasta] = true;
+}
+
+// Escribe un mapa al azar de 'n' escenarios y deja en 'r' sus aristas por ID - 1.
+static bool escribir_mapa(const char* ruta, int n, Referencia* r) {
+    FILE* f = fopen(ruta, "w");
+    if (!f) return false;
+    r->n = n;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) {
+            r->costo[i][j] = i == j ? 0 : INFINITO;
+            r->pasos[i][j] = 0;
+            r->llega[i][j] = i == j;
+        }
+
+    fputs("ID,Nombre,Descripcion,Items,Arriba,Abajo,Izquierda,Derecha,EsFinal,Aristas\n", f);
+    for (int i = 0; i < n; i++) {
+        r->esFinal[i] = i > 0 && rand() % 6 == 0;
+        fprintf(f, "%d,Sala %d,Sala,,", i + 1, i + 1);
+        for (int d = 0; d < MAXDIR; d++) {
+            int destino = rand() % 3 == 0 ? rand() % n : -1;
+            if (destino >= 0) agregar_arista(r, i, destino, 0);
+            fprintf(f, "%d,", destino >= 0 ? destino + 1 : -1);
+        }
+        fprintf(f, "%s,\"", r->esFinal[i] ? "Si" : "No");
+        int extendidas = rand() % 3;
+        for (int k = 0; k < extendidas; k++) {
+            int destino = rand() % n, costo = rand() % 3;
+            agregar_arista(r, i, destino, costo);
+            fprintf(f, "%sPuerta %d,%d,%d", k > 0 ? ";" : "", k, destino + 1, costo);
+        }
+        fputs("\"\n", f);
+    }
+    return fclose(f) == 0;
+}
+
+// Floyd–Warshall sobre (tiempo, aristas) en orden lexicográfico, y clausura transitiva.
+static void resolver(Referencia* r) {
+    int n = r->n;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            if (i != j && r->costo[i][j] < INFINITO) r->pasos[i][j] = 1;
+    for (int k = 0; k < n; k++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++) {
+                if (r->llega[i][k] && r->llega[k][j]) r->llega[i][j] = true;
+                if (r->costo[i][k] >= INFINITO || r->costo[k][j] >= INFINITO) continue;
+                int c = r->costo[i][k] + r->costo[k][j], p = r->pasos[i][k] + r->pasos[k][j];
+                if (c < r->costo[i][j] || (c == r->costo[i][j] && p < r->pasos[i][j])) {
+                    r->costo[i][j] = c;
+                    r->pasos[i][j] = p;
+                }
+            }
+}
+
+static void comprobar_mapa(const Graph* g, const Referencia* r) {
+    int n = r->n;
+    COMPROBAR(g->numberOfNodes == n);
+    if (g->numberOfNodes != n) return;
+
+    int nodoDe[MAXNODOSPRUEBA];     // Posición en g->nodes de cada ID - 1
+    for (int v = 0; v < n; v++) nodoDe[g->nodes[v].state.id - 1] = v;
+
+    int componentes = 0, sinSalida = 0;
+    for (int i = 0; i < n; i++) {
+        // La primera de su componente en orden de ID cuenta una componente nueva
+        bool primera = true;
+        for (int j = 0; j < i; j++)
+            if (r->llega[i][j] && r->llega[j][i]) primera = false;
+        if (primera) componentes++;
+
+        int distancia = -1, pasos = 0;
+        for (int j = 0; j < n; j++) {
+            if (!r->esFinal[j] || r->costo[i][j] >= INFINITO) continue;
+            if (distancia < 0 || r->costo[i][j] < distancia || (r->costo[i][j] == distancia && r->pasos[i][j] < pasos)) {
+                distancia = r->costo[i][j];
+                pasos = r->pasos[i][j];
+            }
+        }
+        if (distancia < 0) sinSalida++;
+
+        const State* s = &g->nodes[nodoDe[i]].state;
+        COMPROBAR(s->distanciaFinal == distancia);
+        COMPROBAR(distancia < 0 || s->pasosFinal == pasos);
+        for (int j = 0; j < n; j++) {
+            bool misma = r->llega[i][j] && r->llega[j][i];
+            COMPROBAR((s->componente == g->nodes[nodoDe[j]].state.componente) == misma);
+        }
+    }
+    COMPROBAR(g->alcance.componentes == componentes);
+    COMPROBAR(g->alcance.sinSalida == sinSalida);
+
+    // El inicio es el ID 1: lo que marca el recorrido desde él es su clausura
+    bool* alcanzables = marcar_alcanzables(g, nodoDe[0]);
+    COMPROBAR(alcanzables != NULL);
+    for (int j = 0; alcanzables && j < n; j++) COMPROBAR(alcanzables[nodoDe[j]] == r->llega[0][j]);
+    mem_liberar(alcanzables);
+}
+
+int main(void) {
+    // Mapa fijo: 1 <-> 2 <-> 3, con el final en 3
+    Graph g;
+    OpcionesCarga opciones = { 0 };
+    COMPROBAR(cargar_mapa_en(&g, DIR_MAPAS "/valido.csv", &opciones));
+    if (g.nodes) {
+        COMPROBAR(g.alcance.componentes == 1);
+        COMPROBAR(g.alcance.sinSalida == 0);
+        COMPROBAR(g.alcance.distanciaInicio == 2);
+        COMPROBAR(g.nodes[1].state.distanciaFinal == 1 && g.nodes[1].state.pasosFinal == 1);
+        liberarEscenarios(&g);
+    }
+
+    srand(31);
+    const char* ruta = DIR_SALIDA "/alcance.csv";
+    static Referencia r;
+    for (int m = 0; m < MAPAS; m++) {
+        COMPROBAR(escribir_mapa(ruta, 2 + rand() % (MAXNODOSPRUEBA - 1), &r));
+        resolver(&r);
+        for (OrdenNodos orden = ORDEN_ARCHIVO; orden <= ORDEN_RCM; orden++) {
+            opciones.orden = orden;
+            bool cargado = cargar_mapa_en(&g, ruta, &opciones);
+            COMPROBAR(cargado);
+            if (!cargado) continue;
+            comprobar_mapa(&g, &r);
+            liberarEscenarios(&g);
+        }
+    }
+
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
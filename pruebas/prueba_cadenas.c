@@ -0,0 +1,141 @@
+#include "prueba.h"
+#include "cadenas.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Pool de cadenas y diccionario de descripciones (ver cadenas.h):
+ *  - El pool devuelve la misma copia para los mismos bytes (también binarios) y sigue
+ *    encontrando todo después de crecer muchas veces.
+ *  - Comprimir y descomprimir devuelve el texto original, incluidos los bytes del rango
+ *    de los códigos (0x0F-0x1F, que se escapan) y palabras cuyo código termina en 0x00.
+ *  - Descomprimir nunca escribe más de 'capacidad' bytes: el resultado es el prefijo del
+ *    original que entra, terminado en '\0'.
+ */
+
+#define PALABRAS 600            // Más de 512: hay códigos 0, 256 y 512, con segundo byte 0x00
+#define CADENASPOOL 20000
+#define CENTINELA 0x7E
+
+static void probar_pool(void) {
+    PoolCadenas* pool = pool_crear();
+    COMPROBAR(pool != NULL);
+    if (!pool) return;
+
+    const char* a = pool_agregar(pool, "hola", 4);
+    COMPROBAR(a && strcmp(a, "hola") == 0 && pool_agregar(pool, "hola", 4) == a);
+    const char binario[] = { 'x', '\0', 'y' };
+    const char* b = pool_agregar(pool, binario, 3);
+    const char* c = pool_agregar(pool, binario, 1);
+    COMPROBAR(b && c && b != c && memcmp(b, binario, 3) == 0 && strcmp(c, "x") == 0);
+
+    // Muchas cadenas distintas: la tabla crece y todas se siguen encontrando
+    static const char* copias[CADENASPOOL];
+    char texto[32];
+    for (int i = 0; i < CADENASPOOL; i++) {
+        int largo = snprintf(texto, sizeof(texto), "cadena %d", i);
+        copias[i] = pool_agregar(pool, texto, (size_t)largo);
+        COMPROBAR(copias[i] != NULL);
+    }
+    for (int i = 0; i < CADENASPOOL; i++) {
+        int largo = snprintf(texto, sizeof(texto), "cadena %d", i);
+        COMPROBAR(pool_agregar(pool, texto, (size_t)largo) == copias[i]);
+    }
+    EstadisticasPool e = pool_estadisticas(pool);
+    COMPROBAR(e.unicas == 3 + CADENASPOOL);
+    COMPROBAR(e.cadenas == 4 + 2 * CADENASPOOL);
+    pool_liberar(pool);
+}
+
+// Comprime y descomprime con todas las capacidades desde 1 hasta el largo más uno.
+static void ida_y_vuelta(const Diccionario* dic, const char* texto, size_t largo, bool* hayCodigoCero) {
+    char* comprimido = mem_reservar(MEM_INTERFAZ, 2 * largo + 1);
+    char* salida = mem_reservar(MEM_INTERFAZ, largo + 16);
+    COMPROBAR(comprimido && salida);
+    if (!comprimido || !salida) {
+        mem_liberar(comprimido);
+        mem_liberar(salida);
+        return;
+    }
+
+    size_t tam = diccionario_comprimir(dic, texto, largo, comprimido);
+    COMPROBAR(tam <= 2 * largo);
+    for (size_t i = 0; i + 1 < tam; i++) {
+        unsigned char c = (unsigned char)comprimido[i];
+        if (c == 0x0F) i++;                         // Escape: el siguiente es literal
+        else if (c >= 0x10 && c <= 0x1F) {
+            if (comprimido[i + 1] == '\0') *hayCodigoCero = true;
+            i++;
+        }
+    }
+
+    for (size_t capacidad = 1; capacidad <= largo + 1; capacidad++) {
+        memset(salida, CENTINELA, largo + 16);
+        size_t escrito = diccionario_descomprimir(dic, comprimido, tam, salida, capacidad);
+        size_t esperado = largo < capacidad - 1 ? largo : capacidad - 1;
+        COMPROBAR(escrito == esperado);
+        COMPROBAR(memcmp(salida, texto, esperado) == 0 && salida[esperado] == '\0');
+        for (size_t i = capacidad; i < largo + 16; i++) {
+            if (salida[i] != CENTINELA) {
+                COMPROBAR(salida[i] == CENTINELA);
+                break;
+            }
+        }
+    }
+    mem_liberar(comprimido);
+    mem_liberar(salida);
+}
+
+static void probar_diccionario(void) {
+    // Entrenamiento: PALABRAS palabras, cada una dos veces
+    static char entrenamiento[PALABRAS * 24];
+    size_t uso = 0;
+    for (int vuelta = 0; vuelta < 2; vuelta++)
+        for (int i = 0; i < PALABRAS; i++)
+            uso += (size_t)snprintf(entrenamiento + uso, sizeof(entrenamiento) - uso, "palabra%03d ", i);
+    const char* textos[] = { entrenamiento };
+    Diccionario* dic = diccionario_entrenar(textos, 1);
+    COMPROBAR(dic != NULL);
+    if (!dic) return;
+
+    // Todas las palabras (con todos los códigos), separadas por bytes del rango escapado,
+    // palabras cortas y desconocidas, y espacios al principio y al final
+    static char texto[PALABRAS * 40];
+    size_t largo = 0;
+    texto[largo++] = ' ';
+    for (int i = 0; i < PALABRAS; i++) {
+        largo += (size_t)snprintf(texto + largo, sizeof(texto) - largo, "palabra%03d ", i);
+        if (i % 7 == 0) largo += (size_t)snprintf(texto + largo, sizeof(texto) - largo, "ab nueva%d ", i);
+        if (i % 5 == 0) {
+            for (int c = 0x0F; c <= 0x1F; c++) texto[largo++] = (char)c;
+            texto[largo++] = ' ';
+            texto[largo++] = (char)0x0F;
+            texto[largo++] = (char)0xFF;
+            texto[largo++] = ' ';
+        }
+    }
+    texto[largo++] = (char)0x10;     // Un byte de código al final, sin segundo byte
+    bool hayCodigoCero = false;
+    ida_y_vuelta(dic, texto, largo, &hayCodigoCero);
+    COMPROBAR(hayCodigoCero);
+
+    // Textos chicos
+    const char* chicos[] = { "", " ", "palabra001", "\x0f", "\x1f", "a\x0f" "b", "palabra000 palabra256 palabra512" };
+    for (size_t i = 0; i < sizeof(chicos) / sizeof(chicos[0]); i++) {
+        ida_y_vuelta(dic, chicos[i], strlen(chicos[i]), &hayCodigoCero);
+    }
+    diccionario_liberar(dic);
+}
+
+int main(void) {
+    probar_pool();
+    probar_diccionario();
+
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
@@ -0,0 +1,143 @@
+#include "prueba.h"
+#include "grafo.h"
+#include "game.h"
+#include "list.h"
+#include "extra.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Reclamo de ítems sin bloqueos (ver reclamar_item): JUGADORES hilos, cada uno con su
+ * GameState sobre el mismo mundo, intentan recoger a la vez todos los ítems del mapa
+ * eligiéndolos por número con item_disponible_en, que todos recorren a la vez.
+ * Cada ítem tiene que terminar en exactamente un inventario, el de su dueño, y la suma
+ * de las recogidas exitosas tiene que ser la cantidad de ítems.
+ */
+
+#define JUGADORES 256
+#define ESCENARIOS 40
+#define ITEMSPORESCENARIO 25
+#define TOTALITEMS (ESCENARIOS * ITEMSPORESCENARIO)
+#define RONDAS 5
+
+typedef struct {
+    GameState* gs;
+    pthread_barrier_t* largada;
+    int recogidos;
+} Competidor;
+
+// Mapa en línea recta con ITEMSPORESCENARIO ítems en cada escenario, llamados "Objeto N".
+static bool escribir_mapa(const char* ruta) {
+    FILE* f = fopen(ruta, "w");
+    if (!f) return false;
+    fputs("ID,Nombre,Descripcion,Items,Arriba,Abajo,Izquierda,Derecha,EsFinal\n", f);
+    for (int e = 1; e <= ESCENARIOS; e++) {
+        fprintf(f, "%d,Sala %d,Una sala,\"", e, e);
+        for (int k = 0; k < ITEMSPORESCENARIO; k++) {
+            int n = (e - 1) * ITEMSPORESCENARIO + k;
+            fprintf(f, "%sObjeto %d,%d,%d", k > 0 ? ";" : "", n, n % 9 + 1, n % 4 + 1);
+        }
+        fprintf(f, "\",-1,-1,-1,%d,%s\n", e < ESCENARIOS ? e + 1 : -1, e < ESCENARIOS ? "No" : "Si");
+    }
+    return fclose(f) == 0;
+}
+
+static void* competir(void* argumento) {
+    Competidor* c = argumento;
+    Graph* g = c->gs->grafo;
+    pthread_barrier_wait(c->largada);
+    // Cada jugador empieza por un escenario y un número distintos para que los choques se
+    // repartan. Se elige por número, como "Recoger ítem", el modo guion y gq_session_pick:
+    // lo que ya se llevaron corre los números, así que se insiste hasta vaciar el escenario
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        Node* escenario = &g->nodes[(i + c->gs->jugador) % g->numberOfNodes];
+        int numero = c->gs->jugador % ITEMSPORESCENARIO;
+        for (;;) {
+            Item* item = item_disponible_en(escenario, numero);
+            if (!item) item = item_disponible_en(escenario, numero = 0);
+            if (!item) break;
+            if (recoger_item(c->gs, item)) c->recogidos++;
+        }
+    }
+    objetos_soltar_cache_hilo();
+    return NULL;
+}
+
+static int numero_de(const Item* item) {
+    int n = -1;
+    if (sscanf(item->name, "Objeto %d", &n) != 1 || n < 0 || n >= TOTALITEMS) return -1;
+    return n;
+}
+
+static void ronda(Graph* mapa) {
+    GameStateMultiplayer* partida = crear_partida_compartida(mapa, JUGADORES);
+    COMPROBAR(partida != NULL);
+    if (!partida) return;
+
+    pthread_barrier_t largada;
+    pthread_barrier_init(&largada, NULL, JUGADORES);
+    static Competidor competidores[JUGADORES];
+    pthread_t hilos[JUGADORES];
+    for (int j = 0; j < JUGADORES; j++) {
+        competidores[j] = (Competidor){ .gs = &partida->jugadores[j], .largada = &largada, .recogidos = 0 };
+        COMPROBAR(pthread_create(&hilos[j], NULL, competir, &competidores[j]) == 0);
+    }
+    int total = 0;
+    for (int j = 0; j < JUGADORES; j++) {
+        pthread_join(hilos[j], NULL);
+        total += competidores[j].recogidos;
+    }
+    pthread_barrier_destroy(&largada);
+    COMPROBAR(total == TOTALITEMS);
+
+    // Dueño de cada ítem según el mundo, y en qué inventarios quedó
+    int dueno[TOTALITEMS], apariciones[TOTALITEMS] = { 0 }, enInventarioDe[TOTALITEMS];
+    Graph* g = partida->grafo;
+    for (int i = 0; i < g->numberOfNodes; i++) {
+        for (ListNode* ln = g->nodes[i].state.availableItems->head; ln != NULL; ln = ln->next) {
+            int n = numero_de(ln->data);
+            COMPROBAR(n >= 0);
+            if (n >= 0) dueno[n] = atomic_load(&((Item*)ln->data)->dueno);
+        }
+    }
+    for (int j = 0; j < JUGADORES; j++) {
+        GameState* gs = &partida->jugadores[j];
+        COMPROBAR(list_size(gs->inventory) == competidores[j].recogidos);
+        COMPROBAR(gs->turnos == competidores[j].recogidos);
+        for (ListNode* ln = gs->inventory->head; ln != NULL; ln = ln->next) {
+            int n = numero_de(ln->data);
+            COMPROBAR(n >= 0);
+            if (n < 0) continue;
+            apariciones[n]++;
+            enInventarioDe[n] = j;
+        }
+    }
+    for (int n = 0; n < TOTALITEMS; n++) {
+        COMPROBAR(apariciones[n] == 1);
+        COMPROBAR(apariciones[n] != 1 || enInventarioDe[n] == dueno[n]);
+    }
+    liberar_partida_compartida(partida);
+}
+
+int main(void) {
+    const char* ruta = DIR_SALIDA "/concurrencia.csv";
+    COMPROBAR(escribir_mapa(ruta));
+
+    Graph mapa;
+    OpcionesCarga opciones = { 0 };
+    bool cargado = cargar_mapa_en(&mapa, ruta, &opciones);
+    COMPROBAR(cargado);
+    if (!cargado) FIN_PRUEBA();
+    COMPROBAR(mapa.numberOfNodes == ESCENARIOS);
+
+    for (int r = 0; r < RONDAS; r++) ronda(&mapa);
+
+    liberarEscenarios(&mapa);
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
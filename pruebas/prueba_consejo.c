@@ -0,0 +1,209 @@
+#include "prueba.h"
+#include "grafo.h"
+#include "game.h"
+#include "consejo.h"
+#include "list.h"
+#include "extra.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Consejero de recogida (ver consejo.h): sobre mapas chicos al azar, con inventarios y
+ * tiempos al azar e ítems del escenario que ya tomó otro jugador, se compara contra la
+ * fuerza bruta que prueba todas las formas de conservar o descartar cada ítem del
+ * inventario y de dejar o recoger cada ítem disponible. Deben coincidir el puntaje, el
+ * gasto (con los mismos desempates) y el peso, y el consejo tiene que reconstruirlos.
+ */
+
+#define MAXNODOSPRUEBA 8
+#define MAXITEMSNODO 6
+#define MAXINVENTARIO 5
+#define MAPAS 150
+#define PRUEBASMAPA 20
+
+static const char* nombresInventario[MAXINVENTARIO] = { "Anillo", "Botas", "Capa", "Daga", "Escudo" };
+
+// Escribe un mapa al azar de 'n' escenarios: aristas extendidas de costo 0 a 2 y de 0 a
+// MAXITEMSNODO ítems por escenario, con valor de 0 a 20 y peso de 0 a 25.
+static bool escribir_mapa(const char* ruta, int n) {
+    FILE* f = fopen(ruta, "w");
+    if (!f) return false;
+    fputs("ID,Nombre,Descripcion,Items,Arriba,Abajo,Izquierda,Derecha,EsFinal,Aristas\n", f);
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%d,Sala %d,Sala,\"", i + 1, i + 1);
+        int items = rand() % (MAXITEMSNODO + 1);
+        for (int k = 0; k < items; k++) {
+            fprintf(f, "%sObjeto %d,%d,%d", k > 0 ? ";" : "", k, rand() % 21, rand() % 26);
+        }
+        bool esFinal = i == n - 1 || (i > 0 && rand() % 5 == 0);
+        fprintf(f, "\",-1,-1,-1,-1,%s,\"", esFinal ? "Si" : "No");
+        int extendidas = 1 + rand() % 2;
+        for (int k = 0; k < extendidas; k++) {
+            int destino = k == 0 && i + 1 < n ? i + 1 : rand() % n;
+            fprintf(f, "%sPuerta %d,%d,%d", k > 0 ? ";" : "", k, destino + 1, rand() % 3);
+        }
+        fputs("\"\n", f);
+    }
+    return fclose(f) == 0;
+}
+
+typedef struct {
+    bool llega;
+    int  puntaje;
+    int  gasto;
+    int  peso;
+} Referencia;
+
+// Todas las combinaciones: el mayor puntaje, y entre iguales el menor gasto y el menor peso.
+static Referencia fuerza_bruta(const GameState* gs, Item* const* disponibles, int numDisponibles) {
+    Referencia r = { .llega = false };
+    const State* st = &gs->currentNode->state;
+    int pasos = st->pasosFinal > 0 ? st->pasosFinal : 1;
+    int presupuesto = gs->tiempoRestante - st->distanciaFinal - 1;
+    if (st->distanciaFinal < 0) return r;
+
+    Item* inventario[MAXINVENTARIO];
+    int numInventario = 0;
+    for (ListNode* ln = gs->inventory->head; ln; ln = ln->next) inventario[numInventario++] = ln->data;
+
+    int total = numInventario + numDisponibles;
+    for (unsigned mascara = 0; mascara < 1u << total; mascara++) {
+        int acciones = 0, puntaje = 0, peso = 0;
+        for (int k = 0; k < total; k++) {
+            bool marcado = (mascara >> k) & 1;      // Descartar o recoger
+            const Item* it = k < numInventario ? inventario[k] : disponibles[k - numInventario];
+            if (marcado) acciones++;
+            if (marcado == (k >= numInventario)) {
+                puntaje += it->value;
+                peso += it->weight;
+            }
+        }
+        int gasto = acciones + pasos * (peso / 10);
+        if (gasto > presupuesto) continue;
+        if (!r.llega || puntaje > r.puntaje || (puntaje == r.puntaje && (gasto < r.gasto ||
+            (gasto == r.gasto && peso < r.peso)))) {
+            r = (Referencia){ true, puntaje, gasto, peso };
+        }
+    }
+    return r;
+}
+
+static void comprobar_consejo(const GameState* gs, const Consejo* consejo, const Referencia* r,
+                              Item* const* disponibles, int numDisponibles) {
+    const State* st = &gs->currentNode->state;
+    COMPROBAR(consejo->llega == r->llega);
+    if (!consejo->llega || !r->llega) {
+        COMPROBAR(consejo->numDescartar == 0 && consejo->numRecoger == 0);
+        COMPROBAR(siguiente_consejo(consejo).tipo == BOT_NINGUNA);
+        return;
+    }
+    COMPROBAR(consejo->puntaje == r->puntaje);
+    COMPROBAR(consejo->peso == r->peso);
+    COMPROBAR(consejo->tiempoFinal == gs->tiempoRestante - st->distanciaFinal - r->gasto);
+    COMPROBAR(consejo->tiempoFinal >= 1);
+
+    // Lo que queda después de seguirlo da el puntaje, el peso y el gasto anunciados
+    int puntaje = 0, peso = 0, posicion = 0;
+    for (ListNode* ln = gs->inventory->head; ln; ln = ln->next, posicion++) {
+        const Item* it = ln->data;
+        bool descartado = false;
+        for (int d = 0; d < consejo->numDescartar; d++)
+            if (consejo->descartar[d] == posicion) descartado = true;
+        if (!descartado) {
+            puntaje += it->value;
+            peso += it->weight;
+        }
+    }
+    for (int d = 0; d < consejo->numDescartar; d++) {
+        COMPROBAR(consejo->descartar[d] >= 0 && consejo->descartar[d] < posicion);
+        COMPROBAR(d == 0 || consejo->descartar[d] < consejo->descartar[d - 1]);
+    }
+    for (int k = 0; k < consejo->numRecoger; k++) {
+        Item* it = consejo->recoger[k];
+        bool disponible = false;
+        for (int j = 0; j < numDisponibles; j++)
+            if (disponibles[j] == it) disponible = true;
+        COMPROBAR(disponible);
+        for (int j = 0; j < k; j++) COMPROBAR(consejo->recoger[j] != it);
+        COMPROBAR(k == 0 || consejo->recoger[k - 1]->value >= it->value);
+        puntaje += it->value;
+        peso += it->weight;
+    }
+    int pasos = st->pasosFinal > 0 ? st->pasosFinal : 1;
+    COMPROBAR(puntaje == consejo->puntaje && peso == consejo->peso);
+    COMPROBAR(consejo->numDescartar + consejo->numRecoger + pasos * (peso / 10) == r->gasto);
+
+    DecisionBot primera = siguiente_consejo(consejo);
+    if (consejo->numDescartar > 0) COMPROBAR(primera.tipo == BOT_DESCARTAR && primera.posicion == consejo->descartar[0]);
+    else if (consejo->numRecoger > 0) COMPROBAR(primera.tipo == BOT_RECOGER && primera.item == consejo->recoger[0]);
+    else COMPROBAR(primera.tipo == BOT_NINGUNA);
+}
+
+// Una situación al azar en el mapa: escenario, tiempo, inventario e ítems que tomó el rival.
+static void probar_situacion(GameState* gs, GameState* rival) {
+    Graph* g = gs->grafo;
+    gs->currentNode = &g->nodes[rand() % g->numberOfNodes];
+    gs->tiempoRestante = rand() % (TIEMPOINICIAL + 2) - 1;
+
+    int numInventario = rand() % (MAXINVENTARIO + 1);
+    for (int k = 0; k < numInventario; k++) {
+        Item* it = item_crear();
+        COMPROBAR(it != NULL);
+        if (!it) break;
+        it->name = nombresInventario[k];
+        it->value = rand() % 21;
+        it->weight = rand() % 26;
+        atomic_init(&it->dueno, gs->jugador);
+        list_pushBack(gs->inventory, it);
+    }
+
+    Item* tomados[MAXITEMSNODO];
+    Item* disponibles[MAXITEMSNODO];
+    int numTomados = 0, numDisponibles = 0;
+    for (ListNode* ln = gs->currentNode->state.availableItems->head; ln; ln = ln->next) {
+        Item* it = ln->data;
+        if (rand() % 4 == 0 && reclamar_item(it, rival->jugador)) tomados[numTomados++] = it;
+        else disponibles[numDisponibles++] = it;
+    }
+
+    Consejo consejo;
+    bool aconsejado = aconsejar_items(gs, &consejo);
+    COMPROBAR(aconsejado == !jugador_terminado(gs));
+    if (aconsejado) {
+        Referencia r = fuerza_bruta(gs, disponibles, numDisponibles);
+        comprobar_consejo(gs, &consejo, &r, disponibles, numDisponibles);
+    } else {
+        COMPROBAR(!consejo.llega && consejo.numDescartar == 0 && consejo.numRecoger == 0);
+    }
+
+    for (int k = 0; k < numTomados; k++) COMPROBAR(soltar_item(tomados[k], rival->jugador));
+    list_clean(gs->inventory);
+}
+
+int main(void) {
+    srand(49);
+    const char* ruta = DIR_SALIDA "/consejo.csv";
+    OpcionesCarga opciones = { .silencioso = true };
+    for (int m = 0; m < MAPAS; m++) {
+        COMPROBAR(escribir_mapa(ruta, 2 + rand() % (MAXNODOSPRUEBA - 1)));
+        Graph mapa;
+        bool cargado = cargar_mapa_en(&mapa, ruta, &opciones);
+        COMPROBAR(cargado);
+        if (!cargado) continue;
+        GameStateMultiplayer* partida = crear_partida_compartida(&mapa, 2);
+        COMPROBAR(partida != NULL);
+        if (partida) {
+            for (int i = 0; i < PRUEBASMAPA; i++) probar_situacion(&partida->jugadores[0], &partida->jugadores[1]);
+            liberar_partida_compartida(partida);
+        }
+        liberarEscenarios(&mapa);
+    }
+
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
@@ -0,0 +1,132 @@
+#include "prueba.h"
+#include "grafo.h"
+#include "game.h"
+#include "historial.h"
+#include "list.h"
+#include "extra.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Deshacer y rehacer (ver historial.h): después de recoger, descartar y moverse, cada
+ * deshacer devuelve exactamente el estado anterior (tiempo, turnos, escenario, inventario
+ * en su orden y dueño de cada ítem) y cada rehacer el siguiente. Además, una acción nueva
+ * descarta lo que quedaba por rehacer, y rehacer una recogida falla si otro jugador tomó
+ * el ítem mientras estaba deshecha.
+ */
+
+#define PASOS 4
+
+typedef struct {
+    int   tiempo;
+    int   turnos;
+    Node* escenario;
+    char  inventario[128];      // Nombres en orden, separados por ';'
+    int   duenoLlave;
+    int   duenoLinterna;
+} Foto;
+
+static Item *llave, *linterna;
+
+static Foto fotografiar(GameState* gs) {
+    Foto f = { .tiempo = gs->tiempoRestante, .turnos = gs->turnos, .escenario = gs->currentNode,
+               .duenoLlave = atomic_load(&llave->dueno), .duenoLinterna = atomic_load(&linterna->dueno) };
+    for (ListNode* ln = gs->inventory->head; ln != NULL; ln = ln->next) {
+        strncat(f.inventario, ((Item*)ln->data)->name, sizeof(f.inventario) - strlen(f.inventario) - 2);
+        strcat(f.inventario, ";");
+    }
+    return f;
+}
+
+static bool iguales(const Foto* a, const Foto* b) {
+    return a->tiempo == b->tiempo && a->turnos == b->turnos && a->escenario == b->escenario &&
+           strcmp(a->inventario, b->inventario) == 0 &&
+           a->duenoLlave == b->duenoLlave && a->duenoLinterna == b->duenoLinterna;
+}
+
+int main(void) {
+    Graph mapa;
+    OpcionesCarga opciones = { .silencioso = true };
+    bool cargado = cargar_mapa_en(&mapa, DIR_MAPAS "/valido.csv", &opciones);
+    COMPROBAR(cargado);
+    if (!cargado) FIN_PRUEBA();
+    GameStateMultiplayer* partida = crear_partida_compartida(&mapa, 2);
+    COMPROBAR(partida != NULL);
+    if (!partida) FIN_PRUEBA();
+    GameState* gs = &partida->jugadores[0];
+    GameState* otro = &partida->jugadores[1];
+
+    // En la entrada están la Llave (peso 5) y la Linterna (peso 3)
+    Node* entrada = gs->currentNode;
+    llave = item_disponible_en(entrada, 0);
+    linterna = item_disponible_en(entrada, 1);
+    COMPROBAR(llave && linterna && strcmp(llave->name, "Llave") == 0 && strcmp(linterna->name, "Linterna") == 0);
+    if (!llave || !linterna) FIN_PRUEBA();
+    COMPROBAR(historial_por_deshacer(gs) == NULL && !deshacer_accion(gs));
+
+    Foto fotos[PASOS + 1];
+    fotos[0] = fotografiar(gs);
+    COMPROBAR(recoger_item(gs, llave));
+    fotos[1] = fotografiar(gs);
+    COMPROBAR(recoger_item(gs, linterna));
+    fotos[2] = fotografiar(gs);
+    COMPROBAR(descartar_item(gs, 0));
+    fotos[3] = fotografiar(gs);
+    int numAristas;
+    const Arista* aristas = aristas_de(gs->grafo, entrada, &numAristas);
+    COMPROBAR(numAristas == 1);
+    COMPROBAR(mover_por_arista(gs, &aristas[0]) == 1);       // Costo 0 más (3 + 10) / 10
+    fotos[4] = fotografiar(gs);
+
+    COMPROBAR(fotos[2].tiempo == TIEMPOINICIAL - 2 && strcmp(fotos[2].inventario, "Llave;Linterna;") == 0);
+    COMPROBAR(fotos[3].duenoLlave == 0 && strcmp(fotos[3].inventario, "Linterna;") == 0);
+    COMPROBAR(fotos[4].escenario != entrada && fotos[4].turnos == PASOS);
+
+    // Ida y vuelta completa, dos veces
+    for (int vuelta = 0; vuelta < 2; vuelta++) {
+        for (int i = PASOS; i > 0; i--) {
+            COMPROBAR(historial_por_deshacer(gs) != NULL);
+            COMPROBAR(deshacer_accion(gs));
+            Foto f = fotografiar(gs);
+            COMPROBAR(iguales(&f, &fotos[i - 1]));
+        }
+        COMPROBAR(!deshacer_accion(gs));
+        COMPROBAR(item_disponible(llave) && item_disponible(linterna));
+        for (int i = 1; i <= PASOS; i++) {
+            COMPROBAR(historial_por_rehacer(gs) != NULL);
+            COMPROBAR(rehacer_accion(gs));
+            Foto f = fotografiar(gs);
+            COMPROBAR(iguales(&f, &fotos[i]));
+        }
+        COMPROBAR(!rehacer_accion(gs));
+    }
+
+    // Una acción nueva descarta lo que quedaba por rehacer
+    COMPROBAR(deshacer_accion(gs));
+    COMPROBAR(historial_por_rehacer(gs) != NULL);
+    COMPROBAR(descartar_item(gs, 0));
+    COMPROBAR(historial_por_rehacer(gs) == NULL && !rehacer_accion(gs));
+    COMPROBAR(list_size(gs->inventory) == 0);
+
+    // Deshecha la recogida, la Llave vuelve al mundo; si otro la toma, rehacer falla
+    while (deshacer_accion(gs)) {}
+    COMPROBAR(list_size(gs->inventory) == 0 && gs->tiempoRestante == TIEMPOINICIAL && gs->turnos == 0);
+    COMPROBAR(item_disponible(llave));
+    COMPROBAR(recoger_item(otro, llave));
+    COMPROBAR(atomic_load(&llave->dueno) == otro->jugador);
+    Foto antes = fotografiar(gs);
+    COMPROBAR(!rehacer_accion(gs));
+    Foto despues = fotografiar(gs);
+    COMPROBAR(iguales(&antes, &despues));
+    COMPROBAR(historial_por_rehacer(gs) == NULL);
+    COMPROBAR(item_disponible(linterna));
+
+    liberar_partida_compartida(partida);
+    liberarEscenarios(&mapa);
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
@@ -0,0 +1,101 @@
+#include "prueba.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Pools de objetos (ver objetos.h): cada objeto entregado es distinto de los que siguen
+ * en uso y está alineado, los liberados se reutilizan en vez de pedir bloques nuevos,
+ * y liberar desde otro hilo que el que reservó es seguro. HILOS hilos reservan, llenan
+ * y verifican sus objetos, y en la segunda mitad cada uno libera los de su vecino.
+ */
+
+#define HILOS 16
+#define OBJETOSPORHILO 3000
+#define VUELTAS 20
+
+typedef struct {
+    uint64_t dueno;
+    uint64_t numero;
+    char     relleno[40];
+} Muestra;
+
+static PoolObjetos poolMuestras = POOL_OBJETOS("muestras", Muestra, MEM_INTERFAZ);
+
+static Muestra* objetos[HILOS][OBJETOSPORHILO];
+static pthread_barrier_t barrera;
+static _Atomic int errores = 0;
+
+static uint64_t marca(int hilo, int vuelta, int i) {
+    return ((uint64_t)hilo << 48) | ((uint64_t)vuelta << 32) | (uint64_t)i;
+}
+
+static void* trabajar(void* argumento) {
+    int hilo = (int)(intptr_t)argumento;
+    int vecino = (hilo + 1) % HILOS;
+    for (int vuelta = 0; vuelta < VUELTAS; vuelta++) {
+        for (int i = 0; i < OBJETOSPORHILO; i++) {
+            Muestra* m = objeto_reservar(&poolMuestras);
+            if (!m || (uintptr_t)m % _Alignof(max_align_t) != 0) atomic_fetch_add(&errores, 1);
+            if (!m) continue;
+            m->dueno = (uint64_t)hilo;
+            m->numero = marca(hilo, vuelta, i);
+            objetos[hilo][i] = m;
+        }
+        pthread_barrier_wait(&barrera);
+
+        // Si dos hilos hubieran recibido el mismo objeto, alguna marca estaría pisada
+        for (int i = 0; i < OBJETOSPORHILO; i++) {
+            Muestra* m = objetos[hilo][i];
+            if (m && (m->dueno != (uint64_t)hilo || m->numero != marca(hilo, vuelta, i))) atomic_fetch_add(&errores, 1);
+        }
+        pthread_barrier_wait(&barrera);
+
+        // La mitad de las vueltas cada hilo libera los objetos de su vecino
+        int deQuien = vuelta % 2 == 0 ? hilo : vecino;
+        for (int i = 0; i < OBJETOSPORHILO; i++) {
+            if (objetos[deQuien][i]) objeto_liberar(&poolMuestras, objetos[deQuien][i]);
+        }
+        pthread_barrier_wait(&barrera);
+        for (int i = 0; i < OBJETOSPORHILO; i++) objetos[hilo][i] = NULL;
+        pthread_barrier_wait(&barrera);
+    }
+    objetos_soltar_cache_hilo();
+    return NULL;
+}
+
+int main(void) {
+    // Un hilo: reservar, liberar y volver a reservar no crea objetos nuevos
+    static Muestra* propios[OBJETOSPORHILO];
+    for (int i = 0; i < OBJETOSPORHILO; i++) propios[i] = objeto_reservar(&poolMuestras);
+    size_t creados = poolMuestras.objetosCreados;
+    for (int i = 0; i < OBJETOSPORHILO; i++) objeto_liberar(&poolMuestras, propios[i]);
+    for (int i = 0; i < OBJETOSPORHILO; i++) propios[i] = objeto_reservar(&poolMuestras);
+#ifndef SIN_POOL_OBJETOS
+    COMPROBAR(poolMuestras.objetosCreados == creados);
+#endif
+    for (int i = 0; i < OBJETOSPORHILO; i++) objeto_liberar(&poolMuestras, propios[i]);
+    objetos_soltar_cache_hilo();
+
+    // Varios hilos, con liberaciones cruzadas
+    pthread_barrier_init(&barrera, NULL, HILOS);
+    pthread_t hilos[HILOS];
+    for (int h = 0; h < HILOS; h++) COMPROBAR(pthread_create(&hilos[h], NULL, trabajar, (void*)(intptr_t)h) == 0);
+    for (int h = 0; h < HILOS; h++) pthread_join(hilos[h], NULL);
+    pthread_barrier_destroy(&barrera);
+    COMPROBAR(atomic_load(&errores) == 0);
+
+#ifndef SIN_POOL_OBJETOS
+    // Los objetos vuelven al pool: lo creado no pasa de lo que estuvo en uso a la vez más
+    // lo que puede quedar retenido en las cachés y en el último bloque
+    size_t enUso = (size_t)HILOS * OBJETOSPORHILO;
+    COMPROBAR(poolMuestras.objetosCreados <= enUso + (size_t)HILOS * 2 * OBJETOSPORLOTE + OBJETOSPORBLOQUE);
+#endif
+
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
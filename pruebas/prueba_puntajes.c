@@ -0,0 +1,131 @@
+#define _POSIX_C_SOURCE 200809L
+#include "prueba.h"
+#include "puntajes.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Tabla de posiciones (ver puntajes.h): los mejores de cada mapa quedan ordenados
+ * (puntaje, tiempo restante, turnos y antigüedad), se reconstruyen iguales al reabrir
+ * el archivo, un registro cortado a la mitad al final se descarta y lo que se anota
+ * después queda alineado, y un archivo que no es una tabla se rechaza.
+ */
+
+#define MAPAA 0x1111111111111111ULL
+#define MAPAB 0x2222222222222222ULL
+
+typedef struct {
+    int cantidad;
+    RegistroPuntaje registros[TOPPUNTAJES];
+} Mejores;
+
+static Mejores mejores(uint64_t huella) {
+    Mejores m = { 0 };
+    const RegistroPuntaje* r = puntajes_mejores(huella, &m.cantidad);
+    COMPROBAR(m.cantidad >= 0 && m.cantidad <= TOPPUNTAJES);
+    if (r && m.cantidad > 0) memcpy(m.registros, r, sizeof(RegistroPuntaje) * (size_t)m.cantidad);
+    return m;
+}
+
+static bool mismos(const Mejores* a, const Mejores* b) {
+    if (a->cantidad != b->cantidad) return false;
+    for (int i = 0; i < a->cantidad; i++) {
+        const RegistroPuntaje *x = &a->registros[i], *y = &b->registros[i];
+        if (x->huella != y->huella || x->puntaje != y->puntaje || x->tiempoRestante != y->tiempoRestante ||
+            x->turnos != y->turnos || strcmp(x->nombre, y->nombre) != 0) return false;
+    }
+    return true;
+}
+
+static long tamano(const char* ruta) {
+    struct stat datos;
+    return stat(ruta, &datos) == 0 ? (long)datos.st_size : -1;
+}
+
+static void anotar_iniciales(void) {
+    // Mapa A: más de TOPPUNTAJES partidas; solo entran las mejores
+    for (int i = 0; i < TOPPUNTAJES + 2; i++) {
+        char nombre[16];
+        snprintf(nombre, sizeof(nombre), "Jugador %d", i);
+        int posicion = puntajes_anotar(MAPAA, nombre, 10 * i, 0, 5);
+        COMPROBAR(posicion == 1);       // Cada uno supera a todos los anteriores
+    }
+    COMPROBAR(puntajes_anotar(MAPAA, "Cero", 0, 0, 0) == 0);
+
+    // Mapa B: desempates por tiempo restante, turnos y antigüedad
+    COMPROBAR(puntajes_anotar(MAPAB, "Primero", 50, 3, 7) == 1);
+    COMPROBAR(puntajes_anotar(MAPAB, "Segundo", 50, 3, 7) == 2);
+    COMPROBAR(puntajes_anotar(MAPAB, "Menos turnos", 50, 3, 6) == 1);
+    COMPROBAR(puntajes_anotar(MAPAB, "Mas tiempo", 50, 4, 9) == 1);
+    COMPROBAR(puntajes_anotar(MAPAB, "Un nombre demasiado largo para la tabla", 10, 0, 0) == 5);
+}
+
+int main(void) {
+    const char* ruta = DIR_SALIDA "/prueba.puntajes";
+    unlink(ruta);
+
+    COMPROBAR(puntajes_abrir(ruta));
+    COMPROBAR(puntajes_activos());
+    anotar_iniciales();
+    Mejores a = mejores(MAPAA), b = mejores(MAPAB);
+    COMPROBAR(a.cantidad == TOPPUNTAJES);
+    for (int i = 0; i < a.cantidad; i++) COMPROBAR(a.registros[i].puntaje == 10 * (TOPPUNTAJES + 1 - i));
+    COMPROBAR(b.cantidad == 5);
+    const char* ordenB[] = { "Mas tiempo", "Menos turnos", "Primero", "Segundo", "Un nombre demasiado" };
+    for (int i = 0; i < b.cantidad; i++) COMPROBAR(strcmp(b.registros[i].nombre, ordenB[i]) == 0);
+    COMPROBAR(strlen(b.registros[4].nombre) == MAXNOMBREPUNTAJE - 1);
+    COMPROBAR(mejores(0x3333).cantidad == 0);
+    puntajes_cerrar();
+    COMPROBAR(!puntajes_activos());
+
+    // Al reabrir se reconstruye lo mismo
+    long conIniciales = tamano(ruta);
+    COMPROBAR(puntajes_abrir(ruta));
+    Mejores otraVez = mejores(MAPAA);
+    COMPROBAR(mismos(&a, &otraVez));
+    otraVez = mejores(MAPAB);
+    COMPROBAR(mismos(&b, &otraVez));
+
+    // Un registro que queda cortado por la mitad al final se descarta
+    COMPROBAR(puntajes_anotar(MAPAA, "Cortado", 1000, 0, 0) == 1);
+    puntajes_cerrar();
+    COMPROBAR(tamano(ruta) == conIniciales + (long)sizeof(RegistroPuntaje));
+    COMPROBAR(truncate(ruta, conIniciales + (long)sizeof(RegistroPuntaje) / 2) == 0);
+    COMPROBAR(puntajes_abrir(ruta));
+    COMPROBAR(tamano(ruta) == conIniciales);
+    otraVez = mejores(MAPAA);
+    COMPROBAR(mismos(&a, &otraVez));
+
+    // Lo que se anota después del corte queda alineado con los registros anteriores
+    COMPROBAR(puntajes_anotar(MAPAB, "Despues del corte", 90, 0, 0) == 1);
+    puntajes_cerrar();
+    COMPROBAR(puntajes_abrir(ruta));
+    otraVez = mejores(MAPAA);
+    COMPROBAR(mismos(&a, &otraVez));
+    otraVez = mejores(MAPAB);
+    COMPROBAR(otraVez.cantidad == 6 && strcmp(otraVez.registros[0].nombre, "Despues del corte") == 0);
+    puntajes_cerrar();
+
+    // Un archivo que no es una tabla de posiciones se rechaza sin tocarlo
+    const char* ajeno = DIR_SALIDA "/ajeno.puntajes";
+    FILE* f = fopen(ajeno, "w");
+    COMPROBAR(f != NULL);
+    if (f) {
+        fputs("ID,Nombre,Descripcion\n", f);
+        fclose(f);
+    }
+    long tamanoAjeno = tamano(ajeno);
+    COMPROBAR(!puntajes_abrir(ajeno));
+    COMPROBAR(!puntajes_activos());
+    COMPROBAR(puntajes_anotar(MAPAA, "Nadie", 5, 0, 0) == 0);
+    COMPROBAR(tamano(ajeno) == tamanoAjeno);
+
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
@@ -0,0 +1,153 @@
+#define _POSIX_C_SOURCE 200809L
+#include "prueba.h"
+#include "grafo.h"
+#include "recarga.h"
+#include "extra.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Recarga en caliente (ver recarga.h) y textos diferidos (ver textos.h):
+ *  - Un mapa retirado no se libera mientras siga registrada una partida que comenzó
+ *    antes de retirarlo, y sí cuando solo quedan partidas que comenzaron después.
+ *  - Con textos diferidos, reescribir el archivo en el lugar no rompe a quien lo sigue
+ *    leyendo: sin copia los textos quedan vacíos, con copia (--watch) siguen intactos,
+ *    y reemplazarlo renombrando otro encima conserva los originales.
+ *  - Con el vigilante activo, una partida que comenzó antes de reescribir el archivo
+ *    sigue leyendo los textos de su versión después de instalada la nueva.
+ */
+
+static const char* const descripciones[] = { "Primera sala del mapa original.", "Segunda sala.", "La salida." };
+
+static bool escribir_mapa(const char* ruta, int escenarios, const char* prefijo) {
+    FILE* f = fopen(ruta, "w");
+    if (!f) return false;
+    fputs("ID,Nombre,Descripcion,Items,Arriba,Abajo,Izquierda,Derecha,EsFinal\n", f);
+    for (int i = 1; i <= escenarios; i++) {
+        fprintf(f, "%d,Sala %d,%s%s,,-1,-1,%d,%d,%s\n", i, i, prefijo,
+                i <= 3 ? descripciones[i - 1] : "Otra sala.",
+                i > 1 ? i - 1 : -1, i < escenarios ? i + 1 : -1, i == escenarios ? "Si" : "No");
+    }
+    return fclose(f) == 0;
+}
+
+static size_t memoria_grafos(void) {
+    return mem_uso(MEM_GRAFO).actual;
+}
+
+static void probar_epocas(const char* ruta) {
+    OpcionesCarga opciones = { .silencioso = true };
+    size_t base = memoria_grafos();
+
+    // Una partida que comenzó antes del retiro lo mantiene vivo
+    Graph g;
+    COMPROBAR(cargar_mapa_en(&g, ruta, &opciones));
+    size_t conMapa = memoria_grafos();
+    int antes = recarga_entrar();
+    recarga_retirar(&g);
+    COMPROBAR(g.nodes == NULL);
+    recarga_aplicar();
+    COMPROBAR(memoria_grafos() >= conMapa);
+
+    // Una que comenzó después no lo ve, así que no lo retiene
+    int despues = recarga_entrar();
+    recarga_salir(antes);
+    recarga_aplicar();
+    COMPROBAR(memoria_grafos() == base);
+    recarga_salir(despues);
+}
+
+static void probar_textos(const char* ruta, const char* rutaNueva) {
+    OpcionesCarga opciones = { .silencioso = true, .descripcionesDiferidas = true, .nombresDiferidos = true };
+    Graph sinCopia, conCopia, renombrado;
+
+    COMPROBAR(escribir_mapa(ruta, 3, ""));
+    COMPROBAR(cargar_mapa_en(&sinCopia, ruta, &opciones));
+    opciones.copiarArchivo = true;
+    COMPROBAR(cargar_mapa_en(&conCopia, ruta, &opciones));
+    COMPROBAR(strcmp(descripcion_escenario(&sinCopia.nodes[2]), descripciones[2]) == 0);
+
+    // Más corto que el original: antes leía fuera del archivo y terminaba con SIGBUS
+    FILE* f = fopen(ruta, "w");
+    COMPROBAR(f != NULL);
+    if (f) {
+        fputs("ID\n", f);
+        fclose(f);
+    }
+    // Sin copia, lo que no estaba en la caché del hilo queda vacío (nunca bytes del archivo nuevo)
+    for (int i = 0; i < 3; i++) {
+        COMPROBAR(strcmp(descripcion_escenario(&sinCopia.nodes[i]), i == 2 ? descripciones[2] : "") == 0);
+        COMPROBAR(strcmp(descripcion_escenario(&conCopia.nodes[i]), descripciones[i]) == 0);
+    }
+
+    COMPROBAR(escribir_mapa(ruta, 3, ""));
+    opciones.copiarArchivo = false;
+    COMPROBAR(cargar_mapa_en(&renombrado, ruta, &opciones));
+    COMPROBAR(escribir_mapa(rutaNueva, 5, "Cambiada: "));
+    COMPROBAR(rename(rutaNueva, ruta) == 0);
+    for (int i = 0; i < 3; i++) {
+        COMPROBAR(strcmp(descripcion_escenario(&renombrado.nodes[i]), descripciones[i]) == 0);
+    }
+
+    liberarEscenarios(&sinCopia);
+    liberarEscenarios(&conCopia);
+    liberarEscenarios(&renombrado);
+}
+
+static void probar_vigilante(const char* ruta) {
+    opcionesCarga = (OpcionesCarga){ .silencioso = true, .descripcionesDiferidas = true, .copiarArchivo = true };
+    COMPROBAR(escribir_mapa(ruta, 3, ""));
+    COMPROBAR(cargar_escenarios(ruta));
+    recarga_vigilar(ruta);
+    if (!recarga_activar()) {
+        puts("Sin inotify: se omite la recarga con el vigilante.");
+        return;
+    }
+
+    // Una partida en curso, con su copia del mundo
+    int lector = recarga_entrar();
+    Graph* partida = copiar_grafo(&graph);
+    COMPROBAR(partida != NULL);
+
+    // El vigilante empieza a observar el directorio en su hilo: si la primera escritura
+    // llega antes, se vuelve a escribir
+    struct timespec espera = { 0, 2 * 1000 * 1000 };
+    bool instalada = false;
+    for (int i = 0; i < 2500 && !instalada; i++) {
+        if (i % 100 == 0) COMPROBAR(escribir_mapa(ruta, 4, "Cambiada: "));
+        nanosleep(&espera, NULL);
+        instalada = recarga_aplicar();
+    }
+    COMPROBAR(instalada);
+    COMPROBAR(graph.numberOfNodes == 4);
+    COMPROBAR(strncmp(descripcion_escenario(&graph.nodes[0]), "Cambiada: ", 10) == 0);
+    for (int i = 0; partida && i < 3; i++) {
+        COMPROBAR(strcmp(descripcion_escenario(&partida->nodes[i]), descripciones[i]) == 0);
+    }
+
+    if (partida) {
+        liberarEscenarios(partida);
+        mem_liberar(partida);
+    }
+    recarga_salir(lector);
+}
+
+int main(void) {
+    const char* ruta = DIR_SALIDA "/recarga.csv";
+    const char* rutaNueva = DIR_SALIDA "/recarga.csv.nuevo";
+    COMPROBAR(escribir_mapa(ruta, 3, ""));
+
+    probar_epocas(ruta);
+    probar_textos(ruta, rutaNueva);
+    probar_vigilante(ruta);
+
+    recarga_detener();
+    liberarEscenarios(&graph);
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
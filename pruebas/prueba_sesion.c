@@ -0,0 +1,185 @@
+#include "prueba.h"
+#include "libgraphquest.h"
+#include "game.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * libgraphquest de punta a punta (ver libgraphquest.h): cargar un mundo, abrir una
+ * sesión de dos jugadores y recorrer todas las operaciones sobre el mapa válido de las
+ * pruebas (Entrada -> Pasillo -> Salida), incluidos el conflicto entre jugadores al
+ * rehacer una recogida, las entradas inválidas y las acciones con la partida terminada.
+ */
+
+static gq_state estado_de(const gq_session* s, int jugador) {
+    gq_state e = { 0 };
+    COMPROBAR(gq_session_state(s, jugador, &e) == GQ_OK);
+    return e;
+}
+
+static bool tiene_item(const gq_item* items, int cantidad, const char* nombre) {
+    for (int i = 0; i < cantidad; i++)
+        if (strcmp(items[i].nombre, nombre) == 0) return true;
+    return false;
+}
+
+static void probar_mundo(void) {
+    COMPROBAR(gq_world_load(DIR_MAPAS "/no_existe.csv", NULL) == NULL);
+    gq_options estricto = { .estricto = true };
+    COMPROBAR(gq_world_load(DIR_MAPAS "/errores.csv", &estricto) == NULL);
+
+    // La huella no depende del orden en que se cargan los nodos
+    gq_world* archivo = gq_world_load(DIR_MAPAS "/valido.csv", NULL);
+    gq_options rcm = { .orden = GQ_ORDEN_RCM, .descripcionesDiferidas = true };
+    gq_world* reordenado = gq_world_load(DIR_MAPAS "/valido.csv", &rcm);
+    COMPROBAR(archivo && reordenado);
+    if (archivo && reordenado) {
+        COMPROBAR(gq_world_scenarios(archivo) == 3 && gq_world_scenarios(reordenado) == 3);
+        COMPROBAR(gq_world_fingerprint(archivo) == gq_world_fingerprint(reordenado));
+    }
+    if (archivo) gq_world_release(archivo);
+    if (reordenado) gq_world_release(reordenado);
+}
+
+static void probar_consultas(gq_session* s) {
+    gq_item items[8];
+    gq_exit salidas[8];
+    gq_action_type tipo;
+
+    gq_state e = estado_de(s, 0);
+    COMPROBAR(e.escenario == 1 && e.tiempo == TIEMPOINICIAL && e.inventario == 0 && e.turnos == 0 && e.estado == GQ_JUGANDO);
+    char texto[4];
+    COMPROBAR(gq_session_scenario_text(s, 0, false, texto, sizeof(texto)) == strlen("Entrada"));
+    COMPROBAR(strcmp(texto, "Ent") == 0);
+    COMPROBAR(gq_session_items(s, 0, false, items, 8) == 2);
+    COMPROBAR(strcmp(items[0].nombre, "Llave") == 0 && items[0].numero == 0);
+    COMPROBAR(strcmp(items[1].nombre, "Linterna") == 0 && items[1].numero == 1);
+    COMPROBAR(gq_session_items(s, 0, true, items, 8) == 0);
+    COMPROBAR(gq_session_exits(s, 0, salidas, 8) == 1);
+    COMPROBAR(salidas[0].destino == 2 && salidas[0].costo == 0 && strcmp(salidas[0].etiqueta, "Abajo") == 0);
+
+    // Entradas inválidas: jugador, ítem o dirección inexistente, o nada que deshacer
+    COMPROBAR(gq_session_state(s, 2, &e) == GQ_INVALIDA);
+    COMPROBAR(gq_session_items(s, -1, false, items, 8) == -1);
+    COMPROBAR(gq_session_exits(s, 2, salidas, 8) == -1);
+    COMPROBAR(gq_session_scenario_text(s, 2, true, texto, sizeof(texto)) == 0);
+    COMPROBAR(gq_session_pick(s, 5, 0, NULL) == GQ_INVALIDA);
+    COMPROBAR(gq_session_pick(s, 0, 2, NULL) == GQ_INVALIDA);
+    COMPROBAR(gq_session_pick(s, 0, -1, NULL) == GQ_INVALIDA);
+    COMPROBAR(gq_session_drop(s, 0, 1, NULL) == GQ_INVALIDA);
+    COMPROBAR(gq_session_move(s, 0, "Izquierda", NULL) == GQ_INVALIDA);
+    COMPROBAR(gq_session_move(s, 0, "a ningún lado", NULL) == GQ_INVALIDA);
+    COMPROBAR(gq_session_undo(s, 0, &tipo) == GQ_INVALIDA);
+    COMPROBAR(gq_session_redo(s, 0, &tipo) == GQ_INVALIDA);
+    COMPROBAR(gq_session_restart(s, 2) == GQ_INVALIDA);
+    COMPROBAR(gq_session_suggest(s, -1, &(gq_advice){ 0 }) == GQ_INVALIDA);
+    COMPROBAR(gq_session_bot(s, 2, NULL) == GQ_INVALIDA);
+    e = estado_de(s, 0);
+    COMPROBAR(e.tiempo == TIEMPOINICIAL && e.turnos == 0);
+}
+
+static void probar_acciones(gq_session* s) {
+    gq_item items[8];
+    gq_action hecha;
+    gq_action_type tipo;
+
+    // Recoger y deshacer: la Llave vuelve al escenario y el otro jugador la toma
+    COMPROBAR(gq_session_pick(s, 0, 0, &hecha) == GQ_OK);
+    COMPROBAR(hecha.tipo == GQ_RECOGER && strcmp(hecha.item.nombre, "Llave") == 0);
+    gq_state e = estado_de(s, 0);
+    COMPROBAR(e.tiempo == TIEMPOINICIAL - 1 && e.inventario == 1 && e.turnos == 1 && e.puntaje == hecha.item.valor);
+    COMPROBAR(gq_session_items(s, 1, false, items, 8) == 1 && strcmp(items[0].nombre, "Linterna") == 0);
+    COMPROBAR(gq_session_undo(s, 0, &tipo) == GQ_OK && tipo == GQ_RECOGER);
+    COMPROBAR(gq_session_items(s, 1, false, items, 8) == 2);
+    COMPROBAR(gq_session_pick(s, 1, 0, &hecha) == GQ_OK && strcmp(hecha.item.nombre, "Llave") == 0);
+    COMPROBAR(gq_session_redo(s, 0, &tipo) == GQ_TOMADO);
+    COMPROBAR(gq_session_redo(s, 0, &tipo) == GQ_INVALIDA);
+    e = estado_de(s, 0);
+    COMPROBAR(e.tiempo == TIEMPOINICIAL && e.inventario == 0 && e.turnos == 0);
+
+    // Recoger, descartar y deshacer el descarte
+    COMPROBAR(gq_session_items(s, 0, false, items, 8) == 1);
+    COMPROBAR(gq_session_pick(s, 0, 0, &hecha) == GQ_OK && strcmp(hecha.item.nombre, "Linterna") == 0);
+    int pesoLinterna = hecha.item.peso;
+    COMPROBAR(gq_session_items(s, 0, true, items, 8) == 1 && items[0].numero == 1);
+    COMPROBAR(gq_session_drop(s, 0, 0, NULL) == GQ_INVALIDA);
+    COMPROBAR(gq_session_drop(s, 0, 1, &hecha) == GQ_OK);
+    COMPROBAR(hecha.tipo == GQ_DESCARTAR && strcmp(hecha.item.nombre, "Linterna") == 0);
+    COMPROBAR(estado_de(s, 0).inventario == 0);
+    COMPROBAR(gq_session_undo(s, 0, &tipo) == GQ_OK && tipo == GQ_DESCARTAR);
+    e = estado_de(s, 0);
+    COMPROBAR(e.inventario == 1 && e.peso == pesoLinterna && e.tiempo == TIEMPOINICIAL - 1);
+
+    // Consejo: desde la entrada se llega al final
+    gq_advice consejo;
+    COMPROBAR(gq_session_suggest(s, 0, &consejo) == GQ_OK);
+    COMPROBAR(consejo.llega && consejo.tiempoFinal >= 0);
+
+    // Avanzar (por nombre en inglés y por número), deshacer y rehacer
+    COMPROBAR(gq_session_move(s, 0, "down", &hecha) == GQ_OK);
+    COMPROBAR(hecha.tipo == GQ_MOVER && hecha.opcion == 2 && hecha.gasto == (pesoLinterna + 10) / 10);
+    e = estado_de(s, 0);
+    COMPROBAR(e.escenario == 2 && e.tiempo == TIEMPOINICIAL - 1 - hecha.gasto);
+    COMPROBAR(gq_session_undo(s, 0, &tipo) == GQ_OK && tipo == GQ_MOVER && estado_de(s, 0).escenario == 1);
+    COMPROBAR(gq_session_redo(s, 0, &tipo) == GQ_OK && tipo == GQ_MOVER && estado_de(s, 0).escenario == 2);
+    COMPROBAR(gq_session_undo(s, 0, &tipo) == GQ_OK);
+    COMPROBAR(gq_session_move(s, 0, "2", NULL) == GQ_OK && estado_de(s, 0).escenario == 2);
+
+    // Exportar el mundo de la sesión
+    FILE* destino = tmpfile();
+    COMPROBAR(destino != NULL);
+    if (destino) {
+        COMPROBAR(gq_session_export(s, "json", destino));
+        COMPROBAR(ftell(destino) > 0);
+        COMPROBAR(!gq_session_export(s, "xml", destino));
+        fclose(destino);
+    }
+
+    // La computadora termina la partida; después solo se puede deshacer o reiniciar
+    gq_session_set_bot_budget(s, 2000);
+    for (int i = 0; i < 20 && estado_de(s, 0).estado == GQ_JUGANDO; i++) COMPROBAR(gq_session_bot(s, 0, &hecha) == GQ_OK);
+    e = estado_de(s, 0);
+    COMPROBAR(e.estado == GQ_FINAL && e.escenario == 3);
+    COMPROBAR(gq_session_bot(s, 0, NULL) == GQ_TERMINADA);
+    COMPROBAR(gq_session_move(s, 0, "left", NULL) == GQ_TERMINADA);
+    COMPROBAR(gq_session_pick(s, 0, 0, NULL) == GQ_TERMINADA);
+    COMPROBAR(gq_session_undo(s, 0, &tipo) == GQ_OK);
+    COMPROBAR(estado_de(s, 0).estado == GQ_JUGANDO);
+
+    // Reiniciar: al inicio, sin inventario, y los ítems recogidos no reaparecen
+    COMPROBAR(gq_session_restart(s, 0) == GQ_OK);
+    e = estado_de(s, 0);
+    COMPROBAR(e.escenario == 1 && e.tiempo == TIEMPOINICIAL && e.inventario == 0 && e.turnos == 0 && e.estado == GQ_JUGANDO);
+    int cantidad = gq_session_items(s, 0, false, items, 8);
+    COMPROBAR(cantidad >= 0 && !tiene_item(items, cantidad, "Llave"));
+    COMPROBAR(gq_session_undo(s, 0, &tipo) == GQ_INVALIDA);
+
+    // El otro jugador no se vio afectado
+    e = estado_de(s, 1);
+    COMPROBAR(e.escenario == 1 && e.inventario == 1 && e.tiempo == TIEMPOINICIAL - 1);
+}
+
+int main(void) {
+    probar_mundo();
+
+    gq_world* mundo = gq_world_load(DIR_MAPAS "/valido.csv", NULL);
+    COMPROBAR(mundo != NULL);
+    if (!mundo) FIN_PRUEBA();
+    COMPROBAR(gq_session_new(mundo, 0) == NULL);
+    COMPROBAR(gq_session_new(mundo, MAXJUGADORES + 1) == NULL);
+    gq_session* sesion = gq_session_new(mundo, 2);
+    COMPROBAR(sesion != NULL);
+    gq_world_release(mundo);        // La sesión lo mantiene vivo
+    if (!sesion) FIN_PRUEBA();
+
+    probar_consultas(sesion);
+    probar_acciones(sesion);
+    gq_session_free(sesion);
+
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+#include "prueba.h"
+#include "trabajo.h"
+#include "torneo.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+
+/*
+ * Pool con robo de trabajo (ver trabajo.h) y torneo (ver torneo.h):
+ *  - Cada unidad se ejecuta exactamente una vez, con cualquier cantidad de hilos y de
+ *    unidades, y el número de trabajador está en rango.
+ *  - Si las unidades del primer rango son lentas, otros hilos se las roban.
+ *  - Varias llamadas a la vez desde hilos distintos no se pisan los rangos.
+ *  - Un torneo con estrategias deterministas da las mismas filas con 1 y con 8 hilos.
+ */
+
+#define MAXUNIDADES 5000
+
+typedef struct {
+    _Atomic int veces[MAXUNIDADES];
+    _Atomic int fueraDeRango;
+    _Atomic int robadas;        // Unidades del rango del hilo 0 que ejecutó otro hilo
+    int numHilos;
+    int rangoLento;             // Las unidades 0 .. rangoLento-1 tardan un milisegundo
+} Registro;
+
+static void contar(void* contexto, int unidad, int hilo) {
+    Registro* r = contexto;
+    atomic_fetch_add(&r->veces[unidad], 1);
+    if (hilo < 0 || hilo >= r->numHilos) atomic_fetch_add(&r->fueraDeRango, 1);
+    if (unidad < r->rangoLento) {
+        struct timespec espera = { 0, 1000 * 1000 };
+        nanosleep(&espera, NULL);
+        if (hilo != 0) atomic_fetch_add(&r->robadas, 1);
+    }
+}
+
+static void probar_reparto(int unidades, int hilos, bool lento) {
+    static Registro r;
+    memset(&r, 0, sizeof(r));
+    r.numHilos = hilos;
+    r.rangoLento = lento ? unidades / hilos : 0;
+    trabajo_ejecutar(unidades, hilos, contar, &r);
+    for (int u = 0; u < unidades; u++) COMPROBAR(atomic_load(&r.veces[u]) == 1);
+    COMPROBAR(atomic_load(&r.fueraDeRango) == 0);
+    if (lento && hilos > 1) COMPROBAR(atomic_load(&r.robadas) > 0);
+}
+
+#define LLAMADORES 4
+#define UNIDADESLLAMADOR 300    // De un milisegundo cada una, para que las llamadas se superpongan
+
+static Registro registros[LLAMADORES];
+static pthread_barrier_t largada;
+
+static void* llamar(void* argumento) {
+    Registro* r = argumento;
+    pthread_barrier_wait(&largada);
+    trabajo_ejecutar(UNIDADESLLAMADOR, r->numHilos, contar, r);
+    objetos_soltar_cache_hilo();
+    return NULL;
+}
+
+static void probar_llamadas_simultaneas(void) {
+    pthread_barrier_init(&largada, NULL, LLAMADORES);
+    pthread_t hilos[LLAMADORES];
+    for (int k = 0; k < LLAMADORES; k++) {
+        memset(&registros[k], 0, sizeof(registros[k]));
+        registros[k].numHilos = 2 + k;
+        registros[k].rangoLento = UNIDADESLLAMADOR;
+        COMPROBAR(pthread_create(&hilos[k], NULL, llamar, &registros[k]) == 0);
+    }
+    for (int k = 0; k < LLAMADORES; k++) pthread_join(hilos[k], NULL);
+    pthread_barrier_destroy(&largada);
+    for (int k = 0; k < LLAMADORES; k++) {
+        for (int u = 0; u < UNIDADESLLAMADOR; u++) COMPROBAR(atomic_load(&registros[k].veces[u]) == 1);
+        COMPROBAR(atomic_load(&registros[k].fueraDeRango) == 0);
+    }
+}
+
+// Lee el archivo y ordena sus líneas (el orden de las filas depende de qué termina antes).
+static int leer_lineas(const char* ruta, char lineas[][256], int max) {
+    FILE* f = fopen(ruta, "r");
+    if (!f) return -1;
+    int n = 0;
+    while (n < max && fgets(lineas[n], 256, f)) n++;
+    fclose(f);
+    qsort(lineas, (size_t)n, sizeof(lineas[0]), (int (*)(const void*, const void*))strcmp);
+    return n;
+}
+
+static bool copiar_archivo(const char* origen, const char* destino) {
+    FILE* entrada = fopen(origen, "rb");
+    FILE* salida = fopen(destino, "wb");
+    bool copiado = entrada && salida;
+    char bufer[4096];
+    size_t leidos;
+    while (copiado && (leidos = fread(bufer, 1, sizeof(bufer), entrada)) > 0) {
+        copiado = fwrite(bufer, 1, leidos, salida) == leidos;
+    }
+    if (entrada) fclose(entrada);
+    if (salida && fclose(salida) != 0) copiado = false;
+    return copiado;
+}
+
+static void probar_torneo(void) {
+    // Directorio con dos mapas jugables: el del juego y el válido de las pruebas
+    const char* directorio = DIR_SALIDA "/torneo";
+    char comando[512];
+    snprintf(comando, sizeof(comando), "mkdir -p '%s'", directorio);
+    COMPROBAR(system(comando) == 0);
+    COMPROBAR(copiar_archivo(DIR_MAPAS "/../../graphquest.csv", DIR_SALIDA "/torneo/graphquest.csv"));
+    COMPROBAR(copiar_archivo(DIR_MAPAS "/valido.csv", DIR_SALIDA "/torneo/valido.csv"));
+
+    // Sin "bot": su búsqueda depende del tiempo y no es determinista
+    OpcionesTorneo opciones = { .mapas = directorio, .estrategias = "greedy,rush,suggest,random",
+                                .partidas = 8, .hilos = 1, .salida = DIR_SALIDA "/torneo_1.csv" };
+    COMPROBAR(ejecutar_torneo(&opciones) == 0);
+    opciones.hilos = 8;
+    opciones.salida = DIR_SALIDA "/torneo_8.csv";
+    COMPROBAR(ejecutar_torneo(&opciones) == 0);
+
+    static char uno[64][256], ocho[64][256];
+    int n1 = leer_lineas(DIR_SALIDA "/torneo_1.csv", uno, 64);
+    int n8 = leer_lineas(DIR_SALIDA "/torneo_8.csv", ocho, 64);
+    COMPROBAR(n1 == 1 + 3 * 6);        // Encabezado, 6 pares en 2 mapas y en el total
+    COMPROBAR(n1 == n8);
+    for (int i = 0; i < n1 && i < n8; i++) COMPROBAR(strcmp(uno[i], ocho[i]) == 0);
+}
+
+int main(void) {
+    const int unidades[] = { 0, 1, 7, 64, 1000, MAXUNIDADES };
+    const int hilos[] = { 1, 4, 64 };
+    for (size_t i = 0; i < sizeof(unidades) / sizeof(unidades[0]); i++)
+        for (size_t j = 0; j < sizeof(hilos) / sizeof(hilos[0]); j++) probar_reparto(unidades[i], hilos[j], false);
+    probar_reparto(256, 4, true);
+    probar_reparto(64, 8, true);
+    probar_llamadas_simultaneas();
+
+    probar_torneo();
+
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
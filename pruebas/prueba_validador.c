@@ -0,0 +1,109 @@
+#include "prueba.h"
+#include "validador.h"
+#include "grafo.h"
+#include "extra.h"
+#include "list.h"
+#include "objetos.h"
+#include "memoria.h"
+
+#include <stdio.h>
+
+/*
+ * Diagnósticos del validador sobre los mapas de pruebas/mapas, con su línea, columna,
+ * severidad y tipo, y qué hace el cargador con cada mapa (normal y en modo estricto).
+ */
+
+typedef struct {
+    int             linea;
+    int             columna;
+    Severidad       severidad;
+    TipoDiagnostico tipo;
+} Esperado;
+
+static ValidacionMapa* validar(const char* nombre) {
+    char ruta[512];
+    snprintf(ruta, sizeof(ruta), "%s/%s", DIR_MAPAS, nombre);
+    FILE* archivo = fopen(ruta, "r");
+    COMPROBAR(archivo != NULL);
+    if (!archivo) return NULL;
+    ValidacionMapa* v = validar_mapa(archivo);
+    fclose(archivo);
+    COMPROBAR(v != NULL);
+    return v;
+}
+
+static void comprobar_diagnosticos(const char* nombre, const Esperado* esperados, int cantidad) {
+    ValidacionMapa* v = validar(nombre);
+    if (!v) return;
+    COMPROBAR(v->numDiagnosticos == cantidad);
+    for (int i = 0; i < cantidad && i < v->numDiagnosticos; i++) {
+        const Diagnostico* d = &v->diagnosticos[i];
+        if (d->linea != esperados[i].linea || d->columna != esperados[i].columna ||
+            d->severidad != esperados[i].severidad || d->tipo != esperados[i].tipo) {
+            fprintf(stderr, "%s, diagnóstico %d: %d:%d \"%s\"\n", nombre, i, d->linea, d->columna, d->mensaje);
+            COMPROBAR(!"diagnóstico distinto del esperado");
+        }
+    }
+    liberar_validacion(v);
+}
+
+static bool cargar(Graph* g, const char* nombre, bool estricto) {
+    char ruta[512];
+    snprintf(ruta, sizeof(ruta), "%s/%s", DIR_MAPAS, nombre);
+    OpcionesCarga opciones = { .estricto = estricto };
+    return cargar_mapa_en(g, ruta, &opciones);
+}
+
+int main(void) {
+    comprobar_diagnosticos("valido.csv", NULL, 0);
+
+    // Primero los de cada fila en orden de lectura, después los del grafo completo
+    const Esperado errores[] = {
+        { 2, 35, DIAG_ERROR,       DIAG_ITEM_MALFORMADO },         // Valor "x" del ítem "Roto"
+        { 3, 27, DIAG_ADVERTENCIA, DIAG_FINAL_INVALIDO },          // EsFinal "Quizas"
+        { 5, 1,  DIAG_ERROR,       DIAG_ID_INVALIDO },             // ID "abc"
+        { 6, 15, DIAG_ERROR,       DIAG_CAMPOS_FALTANTES },        // Solo 3 campos
+        { 8, 13, DIAG_ERROR,       DIAG_ADYACENCIA_INVALIDA },     // Arriba "zz"
+        { 4, 1,  DIAG_ERROR,       DIAG_ID_DUPLICADO },            // Segundo ID 2
+        { 3, 25, DIAG_ERROR,       DIAG_ARISTA_COLGANTE },         // Derecha al ID 9
+        { 3, 23, DIAG_ADVERTENCIA, DIAG_ARISTA_ASIMETRICA },       // Izquierda a 1, que no vuelve
+        { 7, 1,  DIAG_ADVERTENCIA, DIAG_NODO_INALCANZABLE },
+        { 8, 1,  DIAG_ADVERTENCIA, DIAG_NODO_INALCANZABLE },
+        { 0, 0,  DIAG_ERROR,       DIAG_SIN_FINAL_ALCANZABLE },
+    };
+    comprobar_diagnosticos("errores.csv", errores, (int)(sizeof(errores) / sizeof(errores[0])));
+
+    const Esperado vacio[] = { { 0, 0, DIAG_ERROR, DIAG_MAPA_VACIO } };
+    comprobar_diagnosticos("vacio.csv", vacio, 1);
+
+    ValidacionMapa* v = validar("errores.csv");
+    if (v) {
+        COMPROBAR(v->numNodos == 4);            // IDs 1, 2, 4 y 5
+        COMPROBAR(v->errores == 7);
+        COMPROBAR(v->advertencias == 4);
+        COMPROBAR(v->aristasValidas == 3);
+        liberar_validacion(v);
+    }
+
+    // El cargador: el mapa con errores se carga sin las partes malas, salvo en modo estricto,
+    // y un mapa rechazado no toca el grafo de destino
+    Graph g;
+    COMPROBAR(cargar(&g, "valido.csv", true));
+    COMPROBAR(g.numberOfNodes == 3);
+    Node* nodos = g.nodes;
+    COMPROBAR(!cargar(&g, "errores.csv", true));
+    COMPROBAR(!cargar(&g, "vacio.csv", false));
+    COMPROBAR(!cargar(&g, "no_existe.csv", false));
+    COMPROBAR(g.nodes == nodos && g.numberOfNodes == 3);
+    liberarEscenarios(&g);
+
+    COMPROBAR(cargar(&g, "errores.csv", false));
+    COMPROBAR(g.numberOfNodes == 4);
+    COMPROBAR(g.numAristas == 3);
+    COMPROBAR(list_size(g.nodes[0].state.availableItems) == 1);    // Solo "Llave"
+    liberarEscenarios(&g);
+
+    objetos_liberar_todo();
+    COMPROBAR(!mem_reportar_fugas(stdout));
+    FIN_PRUEBA();
+}
@@ -0,0 +1,380 @@
+#include "puntajes.h"
+#include "memoria.h"
+#include "metricas.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#define VERSIONPUNTAJES 1
+#define BLOQUEPUNTAJES 32768        // Registros que se leen de una vez al reconstruir
+
+_Static_assert(sizeof(RegistroPuntaje) == 40, "RegistroPuntaje se guarda tal cual: no debe tener relleno");
+
+static const char magiaPuntajes[8] = { 'G', 'Q', 'P', 'U', 'N', 'T', 'A', 'J' };
+
+typedef struct {
+    char     magia[8];
+    uint32_t version;
+    uint32_t tamanoRegistro;
+} CabeceraPuntajes;
+
+// Mejores puntajes de un mapa, ordenados del mejor al peor.
+typedef struct {
+    uint64_t        huella;
+    int             cantidad;
+    RegistroPuntaje mejores[TOPPUNTAJES];
+} TablaMapa;
+
+// Puntajes anotados que todavía no se guardaron.
+typedef struct {
+    RegistroPuntaje* registros;
+    int              cantidad;
+    int              capacidad;
+} LotePuntajes;
+
+static FILE* archivo = NULL;        // Abierto para agregar al final; NULL sin tabla
+
+// Tablas de los mapas y su índice por huella (direccionamiento abierto). Solo las usa el
+// hilo del juego.
+static TablaMapa* tablas = NULL;
+static int numTablas = 0;
+static int capTablas = 0;
+static int* casillas = NULL;        // Posición en 'tablas' + 1 (0: casilla libre)
+static int capCasillas = 0;         // Potencia de 2
+
+// Las anotaciones van al lote activo; el hilo de escritura los intercambia y guarda el
+// otro sin cerrojo. El cerrojo solo protege el intercambio y el agregado de un registro.
+static LotePuntajes lotes[2];
+static int loteActivo = 0;
+static atomic_flag cerrojoLotes = ATOMIC_FLAG_INIT;
+static bool falloEscritura = false; // Después de un error no se escribe más (no desalinear el archivo)
+
+static bool escritorActivo = false;
+#ifndef _WIN32
+static pthread_t escritor;
+static int aviso[2] = { -1, -1 };   // Tubería para despertar al escritor al cerrar
+static _Atomic bool detener = false;
+#endif
+
+/*
+ * Las huellas ya están mezcladas (ver huella_mapa), así que sus bits bajos sirven
+ * directamente de posición en el índice.
+ */
+
+static bool rehacer_indice(int capacidad) {
+    int* nuevas = mem_reservar_ceros(MEM_PUNTAJES, (size_t)capacidad, sizeof(int));
+    if (!nuevas) return false;
+    for (int t = 0; t < numTablas; t++) {
+        size_t i = (size_t)tablas[t].huella & (size_t)(capacidad - 1);
+        while (nuevas[i]) i = (i + 1) & (size_t)(capacidad - 1);
+        nuevas[i] = t + 1;
+    }
+    mem_liberar(casillas);
+    casillas = nuevas;
+    capCasillas = capacidad;
+    return true;
+}
+
+// Retorna la tabla del mapa, creándola vacía si 'crear'. NULL si no existe o no hay memoria.
+// Crear una tabla puede mover las demás.
+static TablaMapa* buscar_tabla(uint64_t huella, bool crear) {
+    if (capCasillas > 0) {
+        size_t mascara = (size_t)capCasillas - 1;
+        for (size_t i = (size_t)huella & mascara; casillas[i]; i = (i + 1) & mascara) {
+            if (tablas[casillas[i] - 1].huella == huella) return &tablas[casillas[i] - 1];
+        }
+    }
+    if (!crear) return NULL;
+
+    if (numTablas == capTablas) {
+        int capacidad = capTablas ? capTablas * 2 : 16;
+        TablaMapa* nuevas = mem_redimensionar(MEM_PUNTAJES, tablas, sizeof(TablaMapa) * (size_t)capacidad);
+        if (!nuevas) return NULL;
+        tablas = nuevas;
+        capTablas = capacidad;
+    }
+    if ((numTablas + 1) * 2 > capCasillas && !rehacer_indice(capCasillas ? capCasillas * 2 : 64)) return NULL;
+
+    TablaMapa* t = &tablas[numTablas++];
+    t->huella = huella;
+    t->cantidad = 0;
+    size_t mascara = (size_t)capCasillas - 1;
+    size_t i = (size_t)huella & mascara;
+    while (casillas[i]) i = (i + 1) & mascara;
+    casillas[i] = numTablas;
+    return t;
+}
+
+static bool supera(const RegistroPuntaje* a, const RegistroPuntaje* b) {
+    if (a->puntaje != b->puntaje) return a->puntaje > b->puntaje;
+    if (a->tiempoRestante != b->tiempoRestante) return a->tiempoRestante > b->tiempoRestante;
+    return a->turnos < b->turnos;
+}
+
+// Ubica el registro entre los mejores de la tabla. Retorna su posición (desde 1) o 0 si
+// no entró, lo que se decide comparando solo con el último.
+static int insertar(TablaMapa* t, const RegistroPuntaje* r) {
+    int i = t->cantidad;
+    if (i == TOPPUNTAJES) {
+        if (!supera(r, &t->mejores[TOPPUNTAJES - 1])) return 0;
+        i--;
+    } else {
+        t->cantidad++;
+    }
+    for (; i > 0 && supera(r, &t->mejores[i - 1]); i--) t->mejores[i] = t->mejores[i - 1];
+    t->mejores[i] = *r;
+    t->mejores[i].nombre[MAXNOMBREPUNTAJE - 1] = '\0';     // Por si el archivo estaba dañado
+    return i + 1;
+}
+
+// Lee los registros desde la posición actual hasta el final y deja su cantidad en *leidos.
+// Retorna false si no hubo memoria.
+static bool reconstruir(FILE* f, long long* leidos) {
+    RegistroPuntaje* bloque = mem_reservar(MEM_PUNTAJES, sizeof(RegistroPuntaje) * BLOQUEPUNTAJES);
+    if (!bloque) return false;
+
+    // Los registros del mismo mapa suelen venir seguidos: se recuerda la última tabla
+    TablaMapa* ultima = NULL;
+    bool completa = true;
+    size_t cantidad;
+    *leidos = 0;
+    while (completa && (cantidad = fread(bloque, sizeof(RegistroPuntaje), BLOQUEPUNTAJES, f)) > 0) {
+        for (size_t k = 0; k < cantidad; k++) {
+            if (!ultima || ultima->huella != bloque[k].huella) ultima = buscar_tabla(bloque[k].huella, true);
+            if (!ultima) {
+                completa = false;
+                break;
+            }
+            insertar(ultima, &bloque[k]);
+        }
+        *leidos += (long long)cantidad;
+    }
+    mem_liberar(bloque);
+    return completa;
+}
+
+static void liberar_tablas(void) {
+    mem_liberar(tablas);
+    mem_liberar(casillas);
+    tablas = NULL;
+    casillas = NULL;
+    numTablas = capTablas = capCasillas = 0;
+}
+
+// Descarta lo que sobra después del último registro completo (un corte a mitad de una
+// escritura), para que lo que se agregue quede alineado.
+static bool recortar_archivo(const char* ruta, long long largo) {
+#ifndef _WIN32
+    return truncate(ruta, (off_t)largo) == 0;
+#else
+    (void)ruta;
+    (void)largo;
+    return false;
+#endif
+}
+
+/*
+ * confirmar
+ * ---------
+ * Guarda el lote que venía recibiendo anotaciones con una sola escritura y un fsync; las
+ * anotaciones siguientes van al otro lote mientras tanto. La llama un solo hilo a la vez:
+ * el de escritura, o el del juego si no hay hilo (o al cerrar, ya detenido).
+ */
+
+static void confirmar(void) {
+    while (atomic_flag_test_and_set_explicit(&cerrojoLotes, memory_order_acquire));
+    LotePuntajes* lote = &lotes[loteActivo];
+    loteActivo = 1 - loteActivo;
+    atomic_flag_clear_explicit(&cerrojoLotes, memory_order_release);
+
+    if (lote->cantidad == 0 || falloEscritura) {
+        lote->cantidad = 0;
+        return;
+    }
+    size_t cantidad = (size_t)lote->cantidad;
+    bool guardado = fwrite(lote->registros, sizeof(RegistroPuntaje), cantidad, archivo) == cantidad &&
+                    fflush(archivo) == 0;
+#ifndef _WIN32
+    if (guardado) guardado = fsync(fileno(archivo)) == 0;
+#endif
+    if (!guardado) {
+        fprintf(stderr, "No se pudieron guardar %zu puntajes; la tabla de posiciones deja de guardarse.\n", cantidad);
+        falloEscritura = true;
+    }
+    lote->cantidad = 0;
+}
+
+#ifndef _WIN32
+// Hilo de escritura: confirma cada INTERVALOPUNTAJES milisegundos, y una última vez al cerrar.
+static void* escribir(void* argumento) {
+    (void)argumento;
+    bool fin = false;
+    while (!fin) {
+        struct pollfd espera = { .fd = aviso[0], .events = POLLIN };
+        poll(&espera, 1, INTERVALOPUNTAJES);
+        fin = atomic_load(&detener);
+        confirmar();
+    }
+    return NULL;
+}
+#endif
+
+/**
+ * puntajes_abrir
+ * --------------
+ * Valida la cabecera y lee todos los registros en bloques de BLOQUEPUNTAJES, ubicando
+ * cada uno en la tabla de su mapa. Casi todos se descartan con una comparación, así que
+ * el costo es básicamente leer el archivo. Luego lo deja abierto para agregar al final
+ * y crea el hilo de escritura (si no se puede, cada anotación se guarda al momento).
+ */
+
+bool puntajes_abrir(const char* ruta) {
+    if (archivo) return true;
+    struct stat datos;
+    bool existe = stat(ruta, &datos) == 0 && datos.st_size > 0;
+
+    if (existe) {
+        FILE* f = fopen(ruta, "rb");
+        if (!f) {
+            printf("No se pudo abrir la tabla de posiciones \"%s\".\n", ruta);
+            return false;
+        }
+        CabeceraPuntajes cabecera;
+        if (fread(&cabecera, sizeof(cabecera), 1, f) != 1 || memcmp(cabecera.magia, magiaPuntajes, 8) != 0 ||
+            cabecera.version != VERSIONPUNTAJES || cabecera.tamanoRegistro != sizeof(RegistroPuntaje)) {
+            printf("\"%s\" no es una tabla de posiciones de esta versión del juego.\n", ruta);
+            fclose(f);
+            return false;
+        }
+
+        MEDIR_INICIO(inicio);
+        long long leidos;
+        bool leida = reconstruir(f, &leidos);
+        MEDIR_FIN(inicio, MET_LEER_PUNTAJES);
+        fclose(f);
+        if (!leida) {
+            puts("No hay memoria para la tabla de posiciones.");
+            liberar_tablas();
+            return false;
+        }
+
+        long long largo = (long long)sizeof(cabecera) + leidos * (long long)sizeof(RegistroPuntaje);
+        if (largo < (long long)datos.st_size && !recortar_archivo(ruta, largo)) {
+            printf("La tabla de posiciones \"%s\" termina con un registro incompleto que no se pudo quitar.\n", ruta);
+            liberar_tablas();
+            return false;
+        }
+        archivo = fopen(ruta, "ab");
+    } else {
+        archivo = fopen(ruta, "wb");
+        CabeceraPuntajes cabecera = { .version = VERSIONPUNTAJES, .tamanoRegistro = sizeof(RegistroPuntaje) };
+        memcpy(cabecera.magia, magiaPuntajes, 8);
+        if (archivo && (fwrite(&cabecera, sizeof(cabecera), 1, archivo) != 1 || fflush(archivo) != 0)) {
+            fclose(archivo);
+            archivo = NULL;
+        }
+    }
+    if (!archivo) {
+        printf("No se pudo abrir la tabla de posiciones \"%s\" para escribir.\n", ruta);
+        liberar_tablas();
+        return false;
+    }
+
+    falloEscritura = false;
+#ifndef _WIN32
+    if (pipe(aviso) == 0) {
+        if (pthread_create(&escritor, NULL, escribir, NULL) == 0) {
+            escritorActivo = true;
+        } else {
+            close(aviso[0]);
+            close(aviso[1]);
+        }
+    }
+#endif
+    return true;
+}
+
+bool puntajes_activos(void) {
+    return archivo != NULL;
+}
+
+// Copia el nombre sin caracteres de control, recortado sin partir un carácter UTF-8.
+static void copiar_nombre(char destino[MAXNOMBREPUNTAJE], const char* nombre) {
+    size_t largo = strlen(nombre);
+    if (largo > MAXNOMBREPUNTAJE - 1) {
+        largo = MAXNOMBREPUNTAJE - 1;
+        while (largo > 0 && ((unsigned char)nombre[largo] & 0xC0) == 0x80) largo--;
+    }
+    memset(destino, 0, MAXNOMBREPUNTAJE);
+    for (size_t i = 0; i < largo; i++) destino[i] = (unsigned char)nombre[i] < 0x20 ? ' ' : nombre[i];
+}
+
+int puntajes_anotar(uint64_t huella, const char* nombre, int puntaje, int tiempoRestante, int turnos) {
+    if (!archivo) return 0;
+    MEDIR_INICIO(inicio);
+    RegistroPuntaje r = { .huella = huella, .puntaje = puntaje, .tiempoRestante = tiempoRestante, .turnos = turnos };
+    copiar_nombre(r.nombre, nombre);
+    TablaMapa* t = buscar_tabla(huella, true);
+    int posicion = t ? insertar(t, &r) : 0;
+
+    // Si el lote está lleno se agranda: el disco nunca frena al juego
+    while (atomic_flag_test_and_set_explicit(&cerrojoLotes, memory_order_acquire));
+    LotePuntajes* lote = &lotes[loteActivo];
+    bool anotado = lote->cantidad < lote->capacidad;
+    if (!anotado) {
+        int capacidad = lote->capacidad ? lote->capacidad * 2 : 64;
+        RegistroPuntaje* registros = mem_redimensionar(MEM_PUNTAJES, lote->registros,
+                                                       sizeof(RegistroPuntaje) * (size_t)capacidad);
+        if (registros) {
+            lote->registros = registros;
+            lote->capacidad = capacidad;
+            anotado = true;
+        }
+    }
+    if (anotado) lote->registros[lote->cantidad++] = r;
+    atomic_flag_clear_explicit(&cerrojoLotes, memory_order_release);
+
+    if (!anotado) puts("Advertencia: no hay memoria para guardar el puntaje.");
+    if (!escritorActivo) confirmar();
+    MEDIR_FIN(inicio, MET_ANOTAR_PUNTAJE);
+    return posicion;
+}
+
+const RegistroPuntaje* puntajes_mejores(uint64_t huella, int* cantidad) {
+    const TablaMapa* t = archivo ? buscar_tabla(huella, false) : NULL;
+    *cantidad = t ? t->cantidad : 0;
+    return t ? t->mejores : NULL;
+}
+
+void puntajes_cerrar(void) {
+    if (!archivo) return;
+#ifndef _WIN32
+    if (escritorActivo) {
+        atomic_store(&detener, true);
+        ssize_t escritos = write(aviso[1], "", 1);
+        (void)escritos;
+        pthread_join(escritor, NULL);
+        close(aviso[0]);
+        close(aviso[1]);
+        escritorActivo = false;
+        atomic_store(&detener, false);
+    }
+#endif
+    confirmar();        // Ya no hay hilo: guarda lo que haya quedado
+    fclose(archivo);
+    archivo = NULL;
+    for (int i = 0; i < 2; i++) {
+        mem_liberar(lotes[i].registros);
+        lotes[i] = (LotePuntajes){ 0 };
+    }
+    loteActivo = 0;
+    liberar_tablas();
+}
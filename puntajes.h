@@ -0,0 +1,57 @@
+#ifndef PUNTAJES_H
+#define PUNTAJES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Tabla de posiciones: cada partida terminada se anota (huella del mapa, nombre, puntaje,
+ * tiempo restante y turnos) al final de un archivo binario que solo crece, y en memoria
+ * se mantienen los TOPPUNTAJES mejores de cada mapa. Al abrir la tabla se reconstruyen
+ * leyendo el archivo de corrido, una sola vez.
+ *
+ * Anotar nunca espera al disco: el registro se copia a un lote en memoria y un hilo de
+ * escritura guarda cada INTERVALOPUNTAJES milisegundos todo lo acumulado con una sola
+ * escritura y un fsync (confirmación en grupo). Al cerrar se guarda lo que quedaba.
+ *
+ * Formato del archivo (en el orden de bytes de la máquina): una cabecera con "GQPUNTAJ",
+ * la versión y el tamaño de registro, y luego registros RegistroPuntaje uno tras otro.
+ * Si el programa se cortó a mitad de un registro, ese resto se descarta al abrirla.
+ *
+ * Los mejores de cada mapa se guardan ya ordenados: un puntaje que no entra se descarta
+ * con una sola comparación y consultar los mejores es O(K), sin ordenar nada.
+ */
+
+#define TOPPUNTAJES 10                      // Mejores puntajes que se conservan por mapa
+#define MAXNOMBREPUNTAJE 20                 // Bytes del nombre, contando el '\0'
+#define INTERVALOPUNTAJES 200               // Milisegundos entre confirmaciones
+#define ARCHIVOPUNTAJES "graphquest.puntajes"
+
+typedef struct {
+    uint64_t huella;                        // Mapa en que se jugó (ver huella_mapa)
+    int32_t  puntaje;
+    int32_t  tiempoRestante;
+    int32_t  turnos;
+    char     nombre[MAXNOMBREPUNTAJE];
+} RegistroPuntaje;
+
+// Abre (o crea) el archivo de puntajes, reconstruye los mejores de cada mapa y comienza
+// a guardar en segundo plano. Retorna false si el archivo no se pudo abrir o no es una
+// tabla de posiciones; en ese caso no se anota nada.
+bool puntajes_abrir(const char* ruta);
+
+// Indica si hay una tabla abierta.
+bool puntajes_activos(void);
+
+// Anota una partida terminada. Retorna su posición entre los mejores del mapa (desde 1)
+// o 0 si no entró. El nombre se recorta a MAXNOMBREPUNTAJE - 1 bytes.
+int puntajes_anotar(uint64_t huella, const char* nombre, int puntaje, int tiempoRestante, int turnos);
+
+// Mejores puntajes del mapa, del mejor al peor: más puntaje, luego más tiempo restante,
+// luego menos turnos (a igualdad, el más antiguo). Deja la cantidad en *cantidad.
+const RegistroPuntaje* puntajes_mejores(uint64_t huella, int* cantidad);
+
+// Guarda lo pendiente, detiene el hilo de escritura y libera la tabla. Se llama al salir.
+void puntajes_cerrar(void);
+
+#endif // PUNTAJES_H
@@ -0,0 +1,282 @@
+#include "recarga.h"
+#include "grafo.h"
+#include "extra.h"
+#include "catalogo.h"
+#include "memoria.h"
+#include "objetos.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+#define MAXRUTA 4096
+
+// Versión de un mapa: recién leída por el vigilante, o retirada esperando a que la
+// dejen de usar las partidas que comenzaron antes.
+typedef struct VersionMapa {
+    Graph     grafo;
+    char      ruta[MAXRUTA];        // Archivo del que se leyó (solo en las publicadas)
+    long long tamano;               // Tamaño y fecha de modificación al leerlo
+    long long modificado;
+    uint64_t  epoca;                // Época en que se retiró
+    struct VersionMapa* siguiente;
+} VersionMapa;
+
+/*
+ * Épocas
+ * ------
+ * Cada retiro avanza la época global. Una partida anota la época vigente al comenzar;
+ * un mapa retirado en la época R puede liberarse cuando todas las partidas registradas
+ * anotaron una época mayor que R, es decir, comenzaron después de retirarlo y por lo
+ * tanto nunca lo vieron. Registrarse y salir son una sola operación atómica sobre la
+ * casilla del lector. Los retiros y la liberación ocurren solo en el hilo principal.
+ */
+
+static _Atomic uint64_t epocaGlobal = 1;
+static _Atomic uint64_t lectores[MAXLECTORES];  // Época de cada partida (0 = casilla libre)
+static _Atomic int sinLector = 0;               // Partidas sin casilla: impiden liberar
+static VersionMapa* retiradas = NULL;
+
+static _Atomic(VersionMapa*) publicada = NULL;  // Última versión leída por el vigilante
+static char rutaActual[MAXRUTA];                // Archivo del mapa actual (hilo principal)
+
+static void liberar_version(VersionMapa* v) {
+    liberarEscenarios(&v->grafo);
+    mem_liberar(v);
+}
+
+// Libera los mapas retirados que ya no puede estar usando ninguna partida.
+static void reclamar(void) {
+    if (atomic_load(&sinLector) > 0) return;
+    uint64_t minimo = UINT64_MAX;
+    for (int i = 0; i < MAXLECTORES; i++) {
+        uint64_t epoca = atomic_load(&lectores[i]);
+        if (epoca != 0 && epoca < minimo) minimo = epoca;
+    }
+    VersionMapa** p = &retiradas;
+    while (*p) {
+        VersionMapa* v = *p;
+        if (v->epoca < minimo) {
+            *p = v->siguiente;
+            liberar_version(v);
+        } else {
+            p = &v->siguiente;
+        }
+    }
+}
+
+int recarga_entrar(void) {
+    uint64_t epoca = atomic_load(&epocaGlobal);
+    for (int i = 0; i < MAXLECTORES; i++) {
+        uint64_t libre = 0;
+        if (atomic_compare_exchange_strong(&lectores[i], &libre, epoca)) return i;
+    }
+    atomic_fetch_add(&sinLector, 1);
+    return -1;
+}
+
+void recarga_salir(int lector) {
+    if (lector < 0) atomic_fetch_sub(&sinLector, 1);
+    else atomic_store(&lectores[lector], 0);
+}
+
+void recarga_retirar(Graph* g) {
+    if (g->nodes == NULL) return;
+    VersionMapa* v = mem_reservar(MEM_GRAFO, sizeof(VersionMapa));
+    if (!v) {
+        puts("Advertencia: no hay memoria para retirar el mapa; se libera de inmediato.");
+        liberarEscenarios(g);
+        return;
+    }
+    v->grafo = *g;
+    *g = (Graph){ 0 };
+    v->epoca = atomic_fetch_add(&epocaGlobal, 1);
+    v->siguiente = retiradas;
+    retiradas = v;
+    reclamar();
+}
+
+/**
+ * recarga_aplicar
+ * ---------------
+ * Toma la versión publicada (un intercambio atómico, sin esperas) y, si es del mapa
+ * actual, la instala en 'graph' y retira la anterior. Las partidas en curso siguen con
+ * la versión con la que comenzaron; las siguientes copian la nueva.
+ */
+
+bool recarga_aplicar(void) {
+    reclamar();
+    VersionMapa* v = atomic_exchange(&publicada, NULL);
+    if (!v) return false;
+    if (graph.nodes == NULL || strcmp(v->ruta, rutaActual) != 0) {
+        liberar_version(v);     // Es de un mapa que dejó de ser el actual
+        return false;
+    }
+
+    Graph anterior = graph;
+    graph = v->grafo;
+    recarga_retirar(&anterior);
+    catalogo_actualizar_actual(v->tamano, v->modificado);
+    if (!opcionesCarga.silencioso) {
+        printf("\nEl mapa \"%s\" cambió: se recargó con %d escenarios.\n", v->ruta, graph.numberOfNodes);
+    }
+    mem_liberar(v);
+    return true;
+}
+
+#ifdef __linux__
+
+static bool activa = false;
+static pthread_t hilo;
+static int aviso[2] = { -1, -1 };               // Tubería para despertar al vigilante
+static _Atomic bool detener = false;
+
+static atomic_flag cerrojoRuta = ATOMIC_FLAG_INIT;
+static char rutaVigilada[MAXRUTA];              // Protegida por cerrojoRuta
+static _Atomic unsigned cambiosRuta = 0;
+
+static void despertar(void) {
+    ssize_t escritos = write(aviso[1], "", 1);
+    (void)escritos;
+}
+
+// Lee el mapa en segundo plano y lo publica. Un mapa que no se pudo leer no reemplaza al vigente.
+static void releer(const char* ruta) {
+    struct stat datos;
+    if (stat(ruta, &datos) != 0) return;
+    VersionMapa* v = mem_reservar(MEM_GRAFO, sizeof(VersionMapa));
+    if (!v) return;
+    if (!cargar_mapa_en(&v->grafo, ruta, &opcionesCarga)) {
+        mem_liberar(v);
+        return;
+    }
+    snprintf(v->ruta, sizeof(v->ruta), "%s", ruta);
+    v->tamano = (long long)datos.st_size;
+    v->modificado = (long long)datos.st_mtime;
+    v->siguiente = NULL;
+
+    VersionMapa* anterior = atomic_exchange(&publicada, v);
+    if (anterior) liberar_version(anterior);    // Nadie llegó a instalarla
+}
+
+/*
+ * vigilar
+ * -------
+ * Hilo vigilante. Observa el directorio del archivo (no el archivo), así detecta tanto
+ * la escritura directa (IN_CLOSE_WRITE) como el reemplazo por renombrado que usan los
+ * editores y los despliegues (IN_MOVED_TO).
+ */
+
+static void* vigilar(void* argumento) {
+    (void)argumento;
+    int fd = inotify_init1(IN_CLOEXEC);
+    int observado = -1;
+    unsigned cambiosVistos = 0;
+    char ruta[MAXRUTA] = "", directorio[MAXRUTA], nombre[MAXRUTA] = "";
+    char eventos[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    while (fd >= 0 && !atomic_load(&detener)) {
+        if (atomic_load(&cambiosRuta) != cambiosVistos) {
+            while (atomic_flag_test_and_set_explicit(&cerrojoRuta, memory_order_acquire));
+            cambiosVistos = atomic_load(&cambiosRuta);
+            snprintf(ruta, sizeof(ruta), "%s", rutaVigilada);
+            atomic_flag_clear_explicit(&cerrojoRuta, memory_order_release);
+
+            const char* barra = strrchr(ruta, '/');
+            snprintf(directorio, sizeof(directorio), "%.*s", barra ? (int)(barra - ruta) + 1 : 1, barra ? ruta : ".");
+            snprintf(nombre, sizeof(nombre), "%s", barra ? barra + 1 : ruta);
+            if (observado >= 0) inotify_rm_watch(fd, observado);
+            observado = inotify_add_watch(fd, directorio, IN_CLOSE_WRITE | IN_MOVED_TO);
+        }
+
+        struct pollfd esperas[2] = { { .fd = fd, .events = POLLIN }, { .fd = aviso[0], .events = POLLIN } };
+        if (poll(esperas, 2, -1) < 0) continue;
+        if (esperas[1].revents & POLLIN) {
+            char basura[64];
+            ssize_t leidos = read(aviso[0], basura, sizeof(basura));
+            (void)leidos;
+        }
+        if (!(esperas[0].revents & POLLIN)) continue;
+
+        bool cambio = false;
+        ssize_t largo = read(fd, eventos, sizeof(eventos));
+        for (char* p = eventos; largo > 0 && p < eventos + largo; ) {
+            const struct inotify_event* evento = (const struct inotify_event*)p;
+            if (evento->len > 0 && strcmp(evento->name, nombre) == 0) cambio = true;
+            p += sizeof(struct inotify_event) + evento->len;
+        }
+        if (cambio && ruta[0]) releer(ruta);
+    }
+
+    if (fd >= 0) close(fd);
+    objetos_soltar_cache_hilo();
+    return NULL;
+}
+
+bool recarga_activar(void) {
+    if (activa) return true;
+    if (pipe(aviso) != 0) return false;
+    if (pthread_create(&hilo, NULL, vigilar, NULL) != 0) {
+        close(aviso[0]);
+        close(aviso[1]);
+        return false;
+    }
+    activa = true;
+    if (rutaActual[0]) recarga_vigilar(rutaActual);
+    return true;
+}
+
+void recarga_vigilar(const char* ruta) {
+    if (ruta != rutaActual) snprintf(rutaActual, sizeof(rutaActual), "%s", ruta);
+    if (!activa) return;
+    while (atomic_flag_test_and_set_explicit(&cerrojoRuta, memory_order_acquire));
+    snprintf(rutaVigilada, sizeof(rutaVigilada), "%s", ruta);
+    atomic_fetch_add(&cambiosRuta, 1);
+    atomic_flag_clear_explicit(&cerrojoRuta, memory_order_release);
+    despertar();
+}
+
+static void detener_vigilante(void) {
+    if (!activa) return;
+    atomic_store(&detener, true);
+    despertar();
+    pthread_join(hilo, NULL);
+    close(aviso[0]);
+    close(aviso[1]);
+    activa = false;
+}
+
+#else
+
+bool recarga_activar(void) {
+    return false;       // Requiere inotify
+}
+
+void recarga_vigilar(const char* ruta) {
+    snprintf(rutaActual, sizeof(rutaActual), "%s", ruta);
+}
+
+static void detener_vigilante(void) {
+}
+
+#endif
+
+void recarga_detener(void) {
+    detener_vigilante();
+    VersionMapa* v = atomic_exchange(&publicada, NULL);
+    if (v) liberar_version(v);
+    while (retiradas) {
+        v = retiradas;
+        retiradas = v->siguiente;
+        liberar_version(v);
+    }
+}
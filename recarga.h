@@ -0,0 +1,49 @@
+#ifndef RECARGA_H
+#define RECARGA_H
+
+#include <stdbool.h>
+
+typedef struct Graph Graph;
+
+/*
+ * Recarga en caliente del mapa actual (--watch). Un hilo vigila el archivo con inotify
+ * y, cuando cambia, lo vuelve a leer en segundo plano y publica la versión nueva con un
+ * puntero atómico. El hilo principal la instala en 'graph' en un punto seguro (antes
+ * de cada opción del menú o comando del guion) con un solo intercambio atómico, así que
+ * nunca espera a que termine la lectura.
+ *
+ * Las partidas son los lectores: al comenzar anotan la época vigente (recarga_entrar) y
+ * al terminar la borran (recarga_salir), sin bloqueos. Un mapa reemplazado, descartado
+ * del catálogo o recargado se retira con recarga_retirar y se libera recién cuando ya
+ * no queda ninguna partida que haya comenzado antes de retirarlo (reclamación por épocas).
+ *
+ * Cada versión es dueña de sus datos: con textos diferidos, el archivo se copia al cargar
+ * (OpcionesCarga.copiarArchivo), porque la recarga ocurre justamente cuando se reescribe.
+ */
+
+#define MAXLECTORES 1024        // Partidas registradas al mismo tiempo
+
+// Comienza a vigilar el mapa actual (opción --watch). Retorna false si el sistema no
+// tiene inotify o no se pudo crear el hilo.
+bool recarga_activar(void);
+
+// Indica el archivo del mapa actual. Lo llama el catálogo después de cada carga.
+void recarga_vigilar(const char* ruta);
+
+// Instala en 'graph' la última versión publicada del mapa actual, si hay una.
+// Retorna true si lo reemplazó.
+bool recarga_aplicar(void);
+
+// Registra una partida que va a usar 'graph' (o una copia suya). Retorna su lector.
+int recarga_entrar(void);
+
+// Termina la partida registrada con recarga_entrar.
+void recarga_salir(int lector);
+
+// Se hace cargo del grafo (deja *g vacío) y lo libera cuando ninguna partida lo use.
+void recarga_retirar(Graph* g);
+
+// Detiene la vigilancia y libera los mapas retirados o publicados. Se llama al salir.
+void recarga_detener(void);
+
+#endif // RECARGA_H
@@ -0,0 +1,223 @@
+#include "textos.h"
+#include "grafo.h"
+#include "cadenas.h"
+#include "memoria.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+#define MINCACHETEXTOS 4
+
+/*
+ * Textos diferidos: en lugar de copiar el nombre o la descripción de cada escenario,
+ * el cargador guarda solo su posición en el archivo CSV. El texto se materializa
+ * cuando una pantalla lo necesita y queda en una pequeña caché LRU por hilo, de modo
+ * que los escenarios que se muestran seguido no se vuelven a copiar.
+ *
+ * En sistemas POSIX el archivo queda abierto y cada texto se lee con pread; en Windows
+ * se lee con fseek/fread. Con --watch la fuente copia el archivo completo al abrirlo,
+ * porque mientras haya partidas con la versión anterior del mapa el archivo se puede
+ * reescribir (ver fuente_abrir).
+ *
+ * La misma caché sirve a los textos comprimidos con diccionario (ver cadenas.h): se
+ * descomprimen al mostrarse. La clave de la caché es la posición del texto en el
+ * archivo, que es única para cada campo aunque el texto comprimido se comparta.
+ */
+
+struct FuenteTexto {
+    unsigned long generacion;   // Identifica a la fuente en la caché (no se reutiliza)
+    Diccionario*  diccionario;  // Diccionario de los textos comprimidos (NULL si no hay)
+    char*         copia;        // Contenido del archivo, si la fuente es dueña de sus bytes
+    size_t        tam;
+#ifndef _WIN32
+    int           fd;           // Archivo abierto (-1 si no hay)
+    struct stat   abierto;      // Inodo, tamaño y fecha del archivo al abrirlo
+#else
+    FILE*         archivo;
+#endif
+};
+
+typedef struct {
+    unsigned long generacion;   // 0 = casilla vacía
+    long          desplazamiento;
+    unsigned long ultimoUso;
+    char          texto[MAXDESC];
+} EntradaCache;
+
+static atomic_ulong siguienteGeneracion = 1;
+static atomic_int capacidadCache = 16;
+
+static _Thread_local EntradaCache cache[MAXCACHETEXTOS];
+static _Thread_local unsigned long reloj;
+
+FuenteTexto* fuente_crear(void) {
+    FuenteTexto* fuente = mem_reservar_ceros(MEM_GRAFO, 1, sizeof(FuenteTexto));
+    if (!fuente) return NULL;
+    fuente->generacion = atomic_fetch_add(&siguienteGeneracion, 1);
+#ifndef _WIN32
+    fuente->fd = -1;
+#endif
+    return fuente;
+}
+
+// Lee el archivo completo a un búfer propio. Retorna false si no se pudo.
+static bool copiar_archivo(FuenteTexto* fuente, const char* ruta) {
+    FILE* archivo = fopen(ruta, "rb");
+    if (!archivo) return false;
+    long tam = -1;
+    if (fseek(archivo, 0, SEEK_END) == 0) tam = ftell(archivo);
+    char* copia = tam > 0 && fseek(archivo, 0, SEEK_SET) == 0 ? mem_reservar(MEM_GRAFO, (size_t)tam) : NULL;
+    bool leido = copia && fread(copia, 1, (size_t)tam, archivo) == (size_t)tam;
+    fclose(archivo);
+    if (!leido) {
+        mem_liberar(copia);
+        return false;
+    }
+    fuente->copia = copia;
+    fuente->tam = (size_t)tam;
+    return true;
+}
+
+#ifndef _WIN32
+// Indica si el archivo abierto sigue siendo el que se leyó al cargar el mapa.
+static bool archivo_intacto(const FuenteTexto* fuente) {
+    struct stat ahora;
+    return fstat(fuente->fd, &ahora) == 0
+        && ahora.st_size == fuente->abierto.st_size
+        && ahora.st_mtim.tv_sec == fuente->abierto.st_mtim.tv_sec
+        && ahora.st_mtim.tv_nsec == fuente->abierto.st_mtim.tv_nsec;
+}
+#endif
+
+/**
+ * fuente_abrir
+ * -------------
+ * Asocia el archivo indicado a la fuente para leer desde él los textos diferidos.
+ * Retorna false si no se pudo abrir; en ese caso el cargador guarda los textos en memoria.
+ *
+ * Consideraciones:
+ *  - Con 'copiar', la fuente lee el archivo completo y ya no depende de él: es lo que
+ *    usa --watch, que vuelve a leer el mapa justamente cuando el archivo se reescribe
+ *    mientras hay partidas con la versión anterior.
+ *  - Sin 'copiar', el archivo queda abierto. Reemplazarlo (por ejemplo, renombrando
+ *    otro encima) es seguro: se sigue leyendo el archivo original. Si se reescribe en el
+ *    lugar, cada lectura lo detecta (cambian el tamaño o la fecha) y los textos quedan
+ *    vacíos en vez de mostrar bytes de la versión nueva.
+ */
+
+bool fuente_abrir(FuenteTexto* fuente, const char* ruta, bool copiar) {
+    if (copiar) return copiar_archivo(fuente, ruta);
+#ifndef _WIN32
+    int fd = open(ruta, O_RDONLY | O_CLOEXEC);
+    if (fd < 0 || fstat(fd, &fuente->abierto) != 0 || fuente->abierto.st_size == 0) {
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    fuente->fd = fd;
+    fuente->tam = (size_t)fuente->abierto.st_size;
+#else
+    fuente->archivo = fopen(ruta, "rb");
+    if (!fuente->archivo) return false;
+#endif
+    return true;
+}
+
+size_t fuente_memoria(const FuenteTexto* fuente) {
+    return fuente && fuente->copia ? fuente->tam : 0;
+}
+
+void fuente_asignar_diccionario(FuenteTexto* fuente, Diccionario* dic) {
+    diccionario_liberar(fuente->diccionario);
+    fuente->diccionario = dic;
+}
+
+void fuente_cerrar(FuenteTexto* fuente) {
+    if (!fuente) return;
+    mem_liberar(fuente->copia);
+#ifndef _WIN32
+    if (fuente->fd >= 0) close(fuente->fd);
+#else
+    if (fuente->archivo) fclose(fuente->archivo);
+#endif
+    diccionario_liberar(fuente->diccionario);
+    mem_liberar(fuente);
+}
+
+// Copia el texto desde la fuente al búfer de destino y lo termina en '\0'.
+// (Si el texto está comprimido, lo descomprime con el diccionario de la fuente).
+static void fuente_leer(const FuenteTexto* fuente, const Texto* texto, char* destino) {
+    if (texto->comprimido) {
+        diccionario_descomprimir(fuente->diccionario, texto->cadena, (size_t)texto->largo, destino, MAXDESC);
+        return;
+    }
+
+    size_t largo = (size_t)texto->largo;
+    if (fuente->copia) {
+        if ((size_t)texto->desplazamiento + largo > fuente->tam) largo = 0;
+        else memcpy(destino, fuente->copia + texto->desplazamiento, largo);
+        destino[largo] = '\0';
+        return;
+    }
+#ifndef _WIN32
+    // Se comprueba antes y después de leer: si el archivo cambió en el medio, no se usa
+    ssize_t leidos = -1;
+    if (fuente->fd >= 0 && (size_t)texto->desplazamiento + largo <= fuente->tam && archivo_intacto(fuente)) {
+        leidos = pread(fuente->fd, destino, largo, (off_t)texto->desplazamiento);
+    }
+    largo = leidos == (ssize_t)largo && archivo_intacto(fuente) ? largo : 0;
+#else
+    if (!fuente->archivo || fseek(fuente->archivo, texto->desplazamiento, SEEK_SET) != 0) largo = 0;
+    else largo = fread(destino, 1, largo, fuente->archivo);
+#endif
+    destino[largo] = '\0';
+}
+
+/**
+ * texto_obtener
+ * --------------
+ * Retorna el texto listo para mostrarse. Si está en memoria lo retorna directamente;
+ * si es diferido o comprimido lo busca en la caché LRU del hilo y, si no está, lo
+ * materializa desde la fuente reemplazando la entrada usada hace más tiempo.
+ *
+ * Consideraciones:
+ *  - El puntero de un texto diferido sigue siendo válido al menos hasta que el mismo hilo
+ *    materialice otros tres textos, por lo que puede usarse junto a otros en un mismo printf.
+ *  - No requiere bloqueos: cada hilo tiene su propia caché.
+ */
+
+const char* texto_obtener(const FuenteTexto* fuente, const Texto* texto) {
+    if (texto->cadena && !texto->comprimido) return texto->cadena;
+    if (!fuente) return "";
+
+    int capacidad = atomic_load_explicit(&capacidadCache, memory_order_relaxed);
+    EntradaCache* victima = &cache[0];
+    reloj++;
+    for (int i = 0; i < capacidad; i++) {
+        EntradaCache* e = &cache[i];
+        if (e->generacion == fuente->generacion && e->desplazamiento == texto->desplazamiento) {
+            e->ultimoUso = reloj;
+            return e->texto;
+        }
+        if (e->ultimoUso < victima->ultimoUso) victima = e;
+    }
+
+    fuente_leer(fuente, texto, victima->texto);
+    victima->generacion = fuente->generacion;
+    victima->desplazamiento = texto->desplazamiento;
+    victima->ultimoUso = reloj;
+    return victima->texto;
+}
+
+void textos_configurar_cache(int capacidad) {
+    if (capacidad < MINCACHETEXTOS) capacidad = MINCACHETEXTOS;
+    if (capacidad > MAXCACHETEXTOS) capacidad = MAXCACHETEXTOS;
+    atomic_store(&capacidadCache, capacidad);
+}
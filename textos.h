@@ -0,0 +1,42 @@
+#ifndef TEXTOS_H
+#define TEXTOS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define MAXCACHETEXTOS 64
+
+typedef struct FuenteTexto FuenteTexto;
+typedef struct Diccionario Diccionario;
+
+// Texto de un escenario: en memoria (tal cual o comprimido), o como posición dentro del archivo fuente.
+typedef struct {
+    const char* cadena;         // Texto en memoria (NULL si se lee bajo demanda desde la fuente)
+    long        desplazamiento; // Posición del texto dentro del archivo fuente
+    int         largo;          // Largo en bytes (sin el '\0'); si está comprimido, el largo comprimido
+    bool        comprimido;     // 'cadena' está comprimida con el diccionario de la fuente
+} Texto;
+
+// Crea una fuente de textos vacía (sin archivo ni diccionario).
+FuenteTexto* fuente_crear(void);
+
+// Abre el archivo para leer desde él los textos diferidos; con 'copiar' lo lee completo a
+// memoria y la fuente deja de depender del archivo. Retorna false si falla.
+bool fuente_abrir(FuenteTexto* fuente, const char* ruta, bool copiar);
+
+// Bytes que ocupa la copia del archivo (0 si la fuente lee del archivo o es NULL).
+size_t fuente_memoria(const FuenteTexto* fuente);
+
+// Asigna el diccionario con que se descomprimen los textos comprimidos (la fuente pasa a ser su dueña).
+void fuente_asignar_diccionario(FuenteTexto* fuente, Diccionario* dic);
+
+// Cierra la fuente. Los textos diferidos o comprimidos que dependían de ella dejan de ser válidos.
+void fuente_cerrar(FuenteTexto* fuente);
+
+// Retorna el texto, materializándolo desde la fuente si hace falta.
+const char* texto_obtener(const FuenteTexto* fuente, const Texto* texto);
+
+// Ajusta cuántos textos recientes guarda la caché LRU de cada hilo (entre 4 y MAXCACHETEXTOS).
+void textos_configurar_cache(int capacidad);
+
+#endif // TEXTOS_H
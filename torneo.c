@@ -0,0 +1,559 @@
+#include "torneo.h"
+#include "trabajo.h"
+#include "bot.h"
+#include "consejo.h"
+#include "game.h"
+#include "grafo.h"
+#include "extra.h"
+#include "list.h"
+#include "memoria.h"
+#include "metricas.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <limits.h>
+#include <math.h>
+#include <dirent.h>
+
+#define MAXESTRATEGIAS 16
+#define MAXRUTA 4096
+#define Z95 1.959963984540054     // Cuantil de la normal para un intervalo del 95 %
+
+typedef DecisionBot (*FuncionEstrategia)(const GameState* gs, int rivales, uint64_t* semilla);
+
+typedef struct {
+    const char*       nombre;
+    FuncionEstrategia decidir;
+} Estrategia;
+
+// Mapa del torneo. 'pendientes' cuenta las partidas que faltan: la última lo libera.
+typedef struct {
+    char*       ruta;
+    const char* nombre;         // Nombre del archivo, dentro de 'ruta'
+    Graph       grafo;
+    bool        cargado;
+    _Atomic int pendientes;
+} MapaTorneo;
+
+typedef struct {
+    int  puntaje[2];            // Puntaje de la estrategia a y de la b
+    bool jugada;                // false si no hubo memoria para la partida
+} ResultadoPartida;
+
+typedef struct {
+    MapaTorneo*        mapas;
+    int                numMapas;
+    const Estrategia*  estrategias[MAXESTRATEGIAS];
+    int                numEstrategias;
+    int                pares[MAXESTRATEGIAS * (MAXESTRATEGIAS - 1) / 2][2];
+    int                numPares;
+    int                partidas;
+    ResultadoPartida*  resultados;  // Uno por unidad
+    _Atomic int*       pendientesGrupo; // Partidas que faltan de cada mapa y par
+    _Atomic int        fallidas;    // Partidas que no se jugaron por falta de memoria
+    FILE*              salida;
+    atomic_flag        cerrojoSalida;
+} Torneo;
+
+/* ------------------------------------------------------------------ */
+/* Estrategias                                                         */
+/* ------------------------------------------------------------------ */
+
+// xorshift64*: cada partida tiene su propio estado, así que no hay nada compartido.
+static uint64_t azar(uint64_t* estado) {
+    uint64_t x = *estado;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *estado = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int peso_inventario(const GameState* gs) {
+    int peso = 0;
+    for (ListNode* ln = gs->inventory->head; ln; ln = ln->next) peso += ((Item*)ln->data)->weight;
+    return peso;
+}
+
+// Peor caso para llegar a un final con ese peso: el camino tiene como mucho 'distancia'
+// aristas y cada una cuesta peso / 10 más (ver heuristica en bot.c).
+static bool llega_al_final(int tiempo, int distancia, int peso) {
+    return distancia >= 0 && tiempo > distancia * (1 + peso / 10);
+}
+
+// Arista que deja más cerca de un final, contando el costo de recorrerla.
+static DecisionBot hacia_el_final(const GameState* gs) {
+    DecisionBot decision = { .tipo = BOT_NINGUNA };
+    int numAristas;
+    const Arista* aristas = aristas_de(gs->grafo, gs->currentNode, &numAristas);
+    int gastoPeso = (peso_inventario(gs) + 1 + 9) / 10;
+    int mejor = INT_MAX;
+    for (int k = 0; k < numAristas; k++) {
+        int distancia = gs->grafo->nodes[aristas[k].destino].state.distanciaFinal;
+        int total = distancia < 0 ? INT_MAX - 1 : aristas[k].costo + gastoPeso + distancia;
+        if (total < mejor) {
+            mejor = total;
+            decision = (DecisionBot){ .tipo = BOT_MOVER, .arista = &aristas[k] };
+        }
+    }
+    return decision;
+}
+
+static DecisionBot estrategia_bot(const GameState* gs, int rivales, uint64_t* semilla) {
+    (void)semilla;
+    return bot_decidir(gs, rivales);
+}
+
+static DecisionBot estrategia_greedy(const GameState* gs, int rivales, uint64_t* semilla) {
+    (void)rivales;
+    (void)semilla;
+    int peso = peso_inventario(gs);
+    int distancia = gs->currentNode->state.distanciaFinal;
+    Item* mejor = NULL;
+    List* items = gs->currentNode->state.availableItems;
+    for (ListNode* ln = items ? items->head : NULL; ln; ln = ln->next) {
+        Item* item = ln->data;
+        if (!item_disponible(item) || (mejor && item->value <= mejor->value)) continue;
+        if (llega_al_final(gs->tiempoRestante - 1, distancia, peso + item->weight)) mejor = item;
+    }
+    if (mejor) return (DecisionBot){ .tipo = BOT_RECOGER, .item = mejor };
+    return hacia_el_final(gs);
+}
+
+static DecisionBot estrategia_rush(const GameState* gs, int rivales, uint64_t* semilla) {
+    (void)rivales;
+    (void)semilla;
+    return hacia_el_final(gs);
+}
+
+static DecisionBot estrategia_suggest(const GameState* gs, int rivales, uint64_t* semilla) {
+    (void)rivales;
+    (void)semilla;
+    Consejo consejo;
+    DecisionBot decision = aconsejar_items(gs, &consejo) ? siguiente_consejo(&consejo) : (DecisionBot){ .tipo = BOT_NINGUNA };
+    return decision.tipo != BOT_NINGUNA ? decision : hacia_el_final(gs);
+}
+
+static DecisionBot estrategia_random(const GameState* gs, int rivales, uint64_t* semilla) {
+    (void)rivales;
+    int numAristas;
+    const Arista* aristas = aristas_de(gs->grafo, gs->currentNode, &numAristas);
+    int disponibles = 0;
+    List* items = gs->currentNode->state.availableItems;
+    for (ListNode* ln = items ? items->head : NULL; ln; ln = ln->next) {
+        if (item_disponible(ln->data)) disponibles++;
+    }
+    if (disponibles + numAristas == 0) return (DecisionBot){ .tipo = BOT_NINGUNA };
+
+    int eleccion = (int)(azar(semilla) % (uint64_t)(disponibles + numAristas));
+    if (eleccion >= disponibles) return (DecisionBot){ .tipo = BOT_MOVER, .arista = &aristas[eleccion - disponibles] };
+    for (ListNode* ln = items->head; ln; ln = ln->next) {
+        if (item_disponible(ln->data) && eleccion-- == 0) return (DecisionBot){ .tipo = BOT_RECOGER, .item = ln->data };
+    }
+    return (DecisionBot){ .tipo = BOT_NINGUNA };
+}
+
+static const Estrategia estrategias[] = {
+    { "bot",    estrategia_bot },
+    { "greedy", estrategia_greedy },
+    { "rush",   estrategia_rush },
+    { "suggest", estrategia_suggest },
+    { "random", estrategia_random },
+};
+
+#define NUMESTRATEGIAS ((int)(sizeof(estrategias) / sizeof(estrategias[0])))
+
+static const Estrategia* buscar_estrategia(const char* nombre) {
+    for (int i = 0; i < NUMESTRATEGIAS; i++) {
+        if (strcmp(estrategias[i].nombre, nombre) == 0) return &estrategias[i];
+    }
+    return NULL;
+}
+
+/* ------------------------------------------------------------------ */
+/* Partidas                                                            */
+/* ------------------------------------------------------------------ */
+
+// Acciones del jugador hasta que avanza o termina, como un turno del multijugador. Si la
+// estrategia no tiene qué hacer sin haber terminado, el jugador se rinde.
+static void jugar_turno(GameState* gs, const Estrategia* e, int rivales, uint64_t* semilla) {
+    while (!jugador_terminado(gs)) {
+        DecisionBot decision = e->decidir(gs, rivales, semilla);
+        if (decision.tipo == BOT_NINGUNA) {
+            gs->tiempoRestante = 0;
+            return;
+        }
+        bot_aplicar(gs, &decision, NULL);
+        if (decision.tipo == BOT_MOVER) return;
+    }
+}
+
+/*
+ * jugar_partida
+ * -------------
+ * Juega una partida de dos jugadores sobre una copia propia del mapa, con los mismos
+ * turnos que iniciar_partida_multijugador, y deja el puntaje final de cada uno. Retorna
+ * false si no hubo memoria para la partida.
+ */
+
+static bool jugar_partida(Graph* mapa, const Estrategia* jugadores[2], uint64_t semilla, int puntajes[2]) {
+    GameStateMultiplayer* partida = crear_partida_compartida(mapa, 2);
+    if (!partida) return false;
+
+    for (int turno = 0; ; turno = 1 - turno) {
+        GameState* gs = &partida->jugadores[turno];
+        GameState* rival = &partida->jugadores[1 - turno];
+        if (jugador_terminado(gs)) {
+            if (jugador_terminado(rival)) break;
+            continue;
+        }
+        jugar_turno(gs, jugadores[turno], jugador_terminado(rival) ? 0 : 1, &semilla);
+    }
+
+    for (int i = 0; i < 2; i++) puntajes[i] = calcular_puntaje(&partida->jugadores[i]);
+    liberar_partida_compartida(partida);
+    return true;
+}
+
+/* ------------------------------------------------------------------ */
+/* Resultados                                                          */
+/* ------------------------------------------------------------------ */
+
+typedef struct {
+    int    partidas;
+    int    victorias[2];
+    int    empates;
+    double suma[2];
+    double sumaCuadrados[2];
+} Resumen;
+
+// Las partidas que no se jugaron no cuentan: ni como empate ni en las medias.
+static void acumular(Resumen* r, const ResultadoPartida* p) {
+    if (!p->jugada) return;
+    r->partidas++;
+    if (p->puntaje[0] > p->puntaje[1])      r->victorias[0]++;
+    else if (p->puntaje[1] > p->puntaje[0]) r->victorias[1]++;
+    else                                    r->empates++;
+    for (int i = 0; i < 2; i++) {
+        r->suma[i] += p->puntaje[i];
+        r->sumaCuadrados[i] += (double)p->puntaje[i] * p->puntaje[i];
+    }
+}
+
+// Campo de texto del CSV, entre comillas si hace falta.
+static void escribir_campo(FILE* f, const char* texto) {
+    if (!strpbrk(texto, ",\"\n")) {
+        fputs(texto, f);
+        return;
+    }
+    fputc('"', f);
+    for (const char* c = texto; *c; c++) {
+        if (*c == '"') fputc('"', f);
+        fputc(*c, f);
+    }
+    fputc('"', f);
+}
+
+/*
+ * escribir_resumen
+ * ----------------
+ * Una fila del CSV. La tasa de victorias lleva el intervalo de Wilson, que sigue siendo
+ * válido con pocas partidas o tasas cercanas a 0 o 1; la media del puntaje, el intervalo
+ * normal con la varianza muestral. Si no se jugó ninguna partida, las estadísticas quedan
+ * vacías.
+ */
+
+static void escribir_resumen(FILE* f, const char* mapa, const char* a, const char* b, const Resumen* r) {
+    double n = r->partidas;
+    double tasa = r->victorias[0] / n;
+    double z2 = Z95 * Z95;
+    double centro = (tasa + z2 / (2 * n)) / (1 + z2 / n);
+    double margen = Z95 * sqrt(tasa * (1 - tasa) / n + z2 / (4 * n * n)) / (1 + z2 / n);
+
+    escribir_campo(f, mapa);
+    fputc(',', f);
+    escribir_campo(f, a);
+    fputc(',', f);
+    escribir_campo(f, b);
+    if (r->partidas == 0) {
+        fputs(",0,0,0,0,,,,,,,,,\n", f);
+        return;
+    }
+    fprintf(f, ",%d,%d,%d,%d,%.4f,%.4f,%.4f", r->partidas, r->victorias[0], r->victorias[1], r->empates,
+            tasa, centro - margen, centro + margen);
+    for (int i = 0; i < 2; i++) {
+        double media = r->suma[i] / n;
+        double varianza = n > 1 ? (r->sumaCuadrados[i] - n * media * media) / (n - 1) : 0;
+        if (varianza < 0) varianza = 0;     // Redondeo con puntajes iguales
+        fprintf(f, ",%.4f,%.4f,%.4f", media, varianza, Z95 * sqrt(varianza / n));
+    }
+    fputc('\n', f);
+}
+
+static void escribir_encabezado(FILE* f) {
+    fputs("mapa,estrategia_a,estrategia_b,partidas,victorias_a,victorias_b,empates,tasa_a,tasa_a_min,tasa_a_max,"
+          "media_a,varianza_a,ic_media_a,media_b,varianza_b,ic_media_b\n", f);
+}
+
+/* ------------------------------------------------------------------ */
+/* Unidades de trabajo                                                 */
+/* ------------------------------------------------------------------ */
+
+static void cargar_unidad(void* contexto, int unidad, int hilo) {
+    (void)hilo;
+    MapaTorneo* m = &((Torneo*)contexto)->mapas[unidad];
+    m->cargado = cargar_mapa_en(&m->grafo, m->ruta, &opcionesCarga);
+}
+
+// Semilla de la unidad (splitmix64): partidas vecinas con estados bien distintos.
+static uint64_t semilla_de(int unidad) {
+    uint64_t z = (uint64_t)unidad * 0x9E3779B97F4A7C15ULL + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*
+ * jugar_unidad
+ * ------------
+ * La unidad u es la partida u % partidas del par (u / partidas) % numPares en el mapa
+ * u / (partidas * numPares): las partidas de un mapa quedan contiguas y el pool las
+ * reparte por rangos, así que cada hilo trabaja casi siempre sobre el mismo mapa.
+ *
+ * Consideraciones:
+ *  - El hilo que termina la última partida de un mapa y un par escribe su fila; el que
+ *    termina la última del mapa lo libera.
+ *  - Los contadores usan acq_rel: quien llega a cero ve los resultados de los demás.
+ */
+
+static void jugar_unidad(void* contexto, int unidad, int hilo) {
+    (void)hilo;
+    Torneo* t = contexto;
+    int partida = unidad % t->partidas;
+    int grupo = unidad / t->partidas;
+    int par = grupo % t->numPares;
+    MapaTorneo* m = &t->mapas[grupo / t->numPares];
+
+    const Estrategia* a = t->estrategias[t->pares[par][0]];
+    const Estrategia* b = t->estrategias[t->pares[par][1]];
+    bool aPrimero = partida % 2 == 0;
+    const Estrategia* jugadores[2] = { aPrimero ? a : b, aPrimero ? b : a };
+    int puntajes[2] = { 0, 0 };
+    bool jugada = jugar_partida(&m->grafo, jugadores, semilla_de(unidad), puntajes);
+    if (!jugada) {
+        fprintf(stderr, "No hay memoria para una partida en \"%s\".\n", m->nombre);
+        atomic_fetch_add_explicit(&t->fallidas, 1, memory_order_relaxed);
+    }
+    t->resultados[unidad] = (ResultadoPartida){ { puntajes[aPrimero ? 0 : 1], puntajes[aPrimero ? 1 : 0] }, jugada };
+
+    if (atomic_fetch_sub_explicit(&t->pendientesGrupo[grupo], 1, memory_order_acq_rel) == 1) {
+        Resumen r = { 0 };
+        for (int i = 0; i < t->partidas; i++) acumular(&r, &t->resultados[grupo * t->partidas + i]);
+        while (atomic_flag_test_and_set_explicit(&t->cerrojoSalida, memory_order_acquire)) {}
+        escribir_resumen(t->salida, m->nombre, a->nombre, b->nombre, &r);
+        fflush(t->salida);
+        atomic_flag_clear_explicit(&t->cerrojoSalida, memory_order_release);
+    }
+    if (atomic_fetch_sub_explicit(&m->pendientes, 1, memory_order_acq_rel) == 1) {
+        liberarEscenarios(&m->grafo);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Preparación                                                         */
+/* ------------------------------------------------------------------ */
+
+static bool elegir_estrategias(Torneo* t, const char* lista) {
+    if (!lista) {
+        for (int i = 0; i < NUMESTRATEGIAS; i++) t->estrategias[t->numEstrategias++] = &estrategias[i];
+    } else {
+        char nombres[MAXRUTA];
+        snprintf(nombres, sizeof(nombres), "%s", lista);
+        for (char* nombre = strtok(nombres, ", "); nombre; nombre = strtok(NULL, ", ")) {
+            const Estrategia* e = buscar_estrategia(nombre);
+            if (!e) {
+                fprintf(stderr, "Estrategia desconocida: %s (use bot, greedy, rush, suggest o random)\n", nombre);
+                return false;
+            }
+            if (t->numEstrategias == MAXESTRATEGIAS) {
+                fprintf(stderr, "Demasiadas estrategias (máximo %d).\n", MAXESTRATEGIAS);
+                return false;
+            }
+            t->estrategias[t->numEstrategias++] = e;
+        }
+    }
+    if (t->numEstrategias < 2) {
+        fputs("El torneo necesita al menos dos estrategias.\n", stderr);
+        return false;
+    }
+    for (int i = 0; i < t->numEstrategias; i++) {
+        for (int j = i + 1; j < t->numEstrategias; j++) {
+            t->pares[t->numPares][0] = i;
+            t->pares[t->numPares][1] = j;
+            t->numPares++;
+        }
+    }
+    return true;
+}
+
+static int comparar_mapas(const void* a, const void* b) {
+    return strcmp(((const MapaTorneo*)a)->nombre, ((const MapaTorneo*)b)->nombre);
+}
+
+// Busca los .csv del directorio, ordenados por nombre para que el CSV sea reproducible.
+// Retorna false si no se pudo abrir o si faltó memoria para alguno: nunca una lista a medias.
+static bool listar_mapas(Torneo* t, const char* directorio) {
+    DIR* dir = opendir(directorio);
+    if (!dir) {
+        fprintf(stderr, "No se pudo abrir el directorio \"%s\".\n", directorio);
+        return false;
+    }
+    int capacidad = 0;
+    bool completa = true;
+    struct dirent* entrada;
+    while (completa && (entrada = readdir(dir)) != NULL) {
+        size_t largo = strlen(entrada->d_name);
+        if (largo < 5 || strcmp(entrada->d_name + largo - 4, ".csv") != 0) continue;
+        if (t->numMapas == capacidad) {
+            capacidad = capacidad ? capacidad * 2 : 64;
+            MapaTorneo* nuevos = mem_redimensionar(MEM_PARTIDAS, t->mapas, sizeof(MapaTorneo) * (size_t)capacidad);
+            completa = nuevos != NULL;
+            if (!completa) break;
+            t->mapas = nuevos;
+        }
+        char ruta[MAXRUTA];
+        snprintf(ruta, sizeof(ruta), "%s/%s", directorio, entrada->d_name);
+        MapaTorneo* m = &t->mapas[t->numMapas];
+        *m = (MapaTorneo){ .ruta = mem_duplicar(MEM_PARTIDAS, ruta) };
+        completa = m->ruta != NULL;
+        if (!completa) break;
+        m->nombre = m->ruta + strlen(directorio) + 1;
+        t->numMapas++;
+    }
+    closedir(dir);
+    if (!completa) {
+        fputs("No hay memoria para la lista de mapas del torneo.\n", stderr);
+        return false;
+    }
+    qsort(t->mapas, (size_t)t->numMapas, sizeof(MapaTorneo), comparar_mapas);
+    return true;
+}
+
+// Deja solo los mapas que se pudieron leer, cada uno con todas sus partidas pendientes.
+static void descartar_fallidos(Torneo* t) {
+    int validos = 0;
+    for (int i = 0; i < t->numMapas; i++) {
+        MapaTorneo* m = &t->mapas[i];
+        if (!m->cargado) {
+            fprintf(stderr, "Se omite \"%s\": no se pudo cargar.\n", m->ruta);
+            mem_liberar(m->ruta);
+            continue;
+        }
+        t->mapas[validos] = *m;
+        atomic_init(&t->mapas[validos].pendientes, t->numPares * t->partidas);
+        validos++;
+    }
+    t->numMapas = validos;
+}
+
+static void liberar_torneo(Torneo* t) {
+    for (int i = 0; i < t->numMapas; i++) {
+        liberarEscenarios(&t->mapas[i].grafo);  // Sin efecto si ya se liberó
+        mem_liberar(t->mapas[i].ruta);
+    }
+    mem_liberar(t->mapas);
+    mem_liberar(t->resultados);
+    mem_liberar((void*)t->pendientesGrupo);
+    if (t->salida && t->salida != stdout) fclose(t->salida);
+}
+
+/**
+ * jugar_torneo
+ * ------------
+ * Lee los mapas (en paralelo, con cargar_mapa_en), juega todas las partidas en el pool y
+ * al final escribe las filas de cada par en todos los mapas. Retorna el código de salida.
+ *
+ * Consideraciones:
+ *  - Los mapas se leen con las opciones de carga vigentes (--lazy-text, --reorder, ...).
+ *  - Todas las partidas de un mapa comparten su grafo, que nadie modifica: cada partida
+ *    juega sobre su propia copia (ver copiar_grafo).
+ *  - El bot decide con un presupuesto de tiempo real, así que sus resultados pueden
+ *    variar un poco según la carga de la máquina; las demás estrategias son reproducibles.
+ */
+
+static int jugar_torneo(Torneo* t, const OpcionesTorneo* opciones, int hilos) {
+    uint64_t inicio = metricas_reloj();
+    trabajo_ejecutar(t->numMapas, hilos, cargar_unidad, t);
+    descartar_fallidos(t);
+    if (t->numMapas == 0) {
+        fprintf(stderr, "No hay mapas para el torneo en \"%s\".\n", opciones->mapas);
+        return 1;
+    }
+
+    long long unidades = (long long)t->numMapas * t->numPares * t->partidas;
+    if (unidades > INT_MAX) {
+        fputs("Demasiadas partidas para un solo torneo.\n", stderr);
+        return 1;
+    }
+    int grupos = t->numMapas * t->numPares;
+    t->resultados = mem_reservar(MEM_PARTIDAS, sizeof(ResultadoPartida) * (size_t)unidades);
+    t->pendientesGrupo = mem_reservar(MEM_PARTIDAS, sizeof(_Atomic int) * (size_t)grupos);
+    if (!t->resultados || !t->pendientesGrupo) {
+        fputs("No hay memoria para el torneo.\n", stderr);
+        return 1;
+    }
+    for (int g = 0; g < grupos; g++) atomic_init(&t->pendientesGrupo[g], t->partidas);
+
+    t->salida = strcmp(opciones->salida, "-") == 0 ? stdout : fopen(opciones->salida, "w");
+    if (!t->salida) {
+        fprintf(stderr, "No se pudo crear \"%s\".\n", opciones->salida);
+        return 1;
+    }
+    fprintf(stderr, "Torneo: %d mapas leídos en %.2f s, %d pares, %lld partidas, %d hilos.\n", t->numMapas,
+            (metricas_reloj() - inicio) / 1e9, t->numPares, unidades, hilos);
+
+    escribir_encabezado(t->salida);
+    uint64_t inicioPartidas = metricas_reloj();
+    trabajo_ejecutar((int)unidades, hilos, jugar_unidad, t);
+    double segundos = (metricas_reloj() - inicioPartidas) / 1e9;
+
+    for (int par = 0; par < t->numPares; par++) {
+        Resumen r = { 0 };
+        for (int g = par; g < grupos; g += t->numPares) {
+            for (int i = 0; i < t->partidas; i++) acumular(&r, &t->resultados[g * t->partidas + i]);
+        }
+        escribir_resumen(t->salida, "*", t->estrategias[t->pares[par][0]]->nombre,
+                         t->estrategias[t->pares[par][1]]->nombre, &r);
+    }
+    fflush(t->salida);
+    long long jugadas = unidades - atomic_load(&t->fallidas);
+    fprintf(stderr, "Listo: %lld partidas en %.2f s (%.0f por segundo).\n", jugadas, segundos,
+            segundos > 0 ? jugadas / segundos : 0.0);
+    if (jugadas < unidades) {
+        fprintf(stderr, "No se jugaron %lld partidas por falta de memoria: no cuentan en los resultados.\n",
+                unidades - jugadas);
+    }
+    return ferror(t->salida) || jugadas < unidades ? 1 : 0;
+}
+
+int ejecutar_torneo(const OpcionesTorneo* opciones) {
+    if (!opciones->mapas) {
+        fputs("Falta el directorio de mapas (--maps).\n", stderr);
+        return 1;
+    }
+    if (opciones->partidas < 1) {
+        fputs("La cantidad de partidas (--games) debe ser positiva.\n", stderr);
+        return 1;
+    }
+
+    Torneo t = { .partidas = opciones->partidas, .cerrojoSalida = ATOMIC_FLAG_INIT };
+    int codigo = 1;
+    if (elegir_estrategias(&t, opciones->estrategias) && listar_mapas(&t, opciones->mapas)) {
+        codigo = jugar_torneo(&t, opciones, opciones->hilos > 0 ? opciones->hilos : trabajo_nucleos());
+    }
+    liberar_torneo(&t);
+    return codigo;
+}
@@ -0,0 +1,45 @@
+#ifndef TORNEO_H
+#define TORNEO_H
+
+/*
+ * Torneo de estrategias: juega partidas de dos jugadores, con las reglas del multijugador
+ * (un mundo compartido, turnos alternados, ítems reclamados de forma atómica), entre cada
+ * par de estrategias en cada mapa de un directorio, y escribe un CSV con el resultado de
+ * cada par. Sirve para medir el efecto de un cambio de balance en cientos de mapas.
+ *
+ * Estrategias:
+ *  - bot       La búsqueda de bot.h (respeta --bot-budget).
+ *  - greedy    Recoge el ítem de más valor que todavía le deja llegar a un final, y si no
+ *              hay, avanza hacia el final más cercano.
+ *  - rush      Avanza hacia el final más cercano sin recoger nada.
+ *  - suggest   Sigue el consejo de consejo.h en cada escenario (qué recoger y qué soltar)
+ *              y después avanza hacia el final más cercano.
+ *  - random    Recoge un ítem o avanza por una arista al azar.
+ *
+ * Cada unidad de trabajo es una partida (mapa × par × semilla) y se reparten en el pool
+ * con robo de trabajo de trabajo.h; los mapas también se leen en paralelo. La semilla
+ * decide quién juega primero (las pares empiezan con la primera estrategia del par) y el
+ * azar de random. Apenas termina la última partida de un mapa y un par, su fila se
+ * escribe en el CSV; al final se agregan las filas de cada par en todos los mapas ("*").
+ *
+ * Columnas: mapa, estrategia_a, estrategia_b, partidas, victorias_a, victorias_b, empates,
+ * tasa_a (victorias de a sobre partidas) con su intervalo de confianza del 95 % (Wilson),
+ * y media, varianza e intervalo del 95 % de la media del puntaje final (calcular_puntaje)
+ * de cada estrategia. Gana la partida el jugador con más puntaje. Las partidas que no se
+ * pudieron jugar por falta de memoria no cuentan en ninguna columna; en ese caso el
+ * torneo termina con código 1 y dice cuántas fueron.
+ */
+
+typedef struct {
+    const char* mapas;          // Directorio con los mapas (.csv)
+    const char* estrategias;    // Nombres separados por comas (NULL: todas)
+    int         partidas;       // Partidas por mapa y par de estrategias
+    int         hilos;          // Hilos de trabajo (0: uno por núcleo)
+    const char* salida;         // Archivo CSV ("-" para la salida estándar)
+} OpcionesTorneo;
+
+// Juega el torneo e informa el avance en la salida de error. Retorna el código de salida
+// del programa.
+int ejecutar_torneo(const OpcionesTorneo* opciones);
+
+#endif // TORNEO_H
@@ -0,0 +1,167 @@
+#include "trabajo.h"
+#include "objetos.h"
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Rango [inicio, fin) de un trabajador, empaquetado en 64 bits para cambiarlo de una vez.
+// En su propia línea de caché: los demás hilos solo la leen al buscar qué robar.
+typedef struct {
+    _Alignas(64) _Atomic uint64_t rango;
+} RangoTrabajo;
+
+typedef struct {
+    RangoTrabajo   rangos[MAXHILOSTRABAJO];
+    int            numHilos;
+    FuncionTrabajo funcion;
+    void*          contexto;
+} Pool;
+
+typedef struct {
+    Pool* pool;
+    int   hilo;
+} Trabajador;
+
+static uint64_t empaquetar(uint32_t inicio, uint32_t fin) {
+    return (uint64_t)inicio << 32 | fin;
+}
+
+static uint32_t inicio_de(uint64_t rango) { return (uint32_t)(rango >> 32); }
+static uint32_t fin_de(uint64_t rango)    { return (uint32_t)rango; }
+
+// Toma la primera unidad del rango propio. Retorna -1 si está vacío.
+static int tomar(RangoTrabajo* r) {
+    uint64_t rango = atomic_load_explicit(&r->rango, memory_order_relaxed);
+    while (inicio_de(rango) < fin_de(rango)) {
+        if (atomic_compare_exchange_weak_explicit(&r->rango, &rango, empaquetar(inicio_de(rango) + 1, fin_de(rango)),
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+            return (int)inicio_de(rango);
+        }
+    }
+    return -1;
+}
+
+/*
+ * robar
+ * -----
+ * Busca el rango con más unidades pendientes y le quita la mitad final (redondeando hacia
+ * arriba). Se queda con la primera de las robadas y deja el resto como su rango propio,
+ * que estaba vacío. Retorna -1 si no queda nada en ningún rango.
+ *
+ * Consideraciones:
+ *  - El dueño solo avanza el inicio y los ladrones solo retroceden el fin, siempre con
+ *    compare-and-swap sobre el rango completo, así que ninguna unidad se ejecuta dos veces.
+ *  - Las unidades robadas están fuera de todo rango hasta que se guardan; otro hilo que
+ *    busque en ese momento puede terminar antes de tiempo, pero el ladrón las ejecuta igual.
+ */
+
+static int robar(Pool* p, int yo) {
+    while (1) {
+        int victima = -1;
+        uint64_t rangoVictima = 0;
+        uint32_t mayor = 0;
+        for (int k = 1; k < p->numHilos; k++) {
+            int i = (yo + k) % p->numHilos;
+            uint64_t rango = atomic_load_explicit(&p->rangos[i].rango, memory_order_relaxed);
+            uint32_t pendientes = fin_de(rango) - inicio_de(rango);
+            if (inicio_de(rango) < fin_de(rango) && pendientes > mayor) {
+                victima = i;
+                rangoVictima = rango;
+                mayor = pendientes;
+            }
+        }
+        if (victima < 0) return -1;
+
+        uint32_t robadas = (mayor + 1) / 2;
+        uint32_t desde = fin_de(rangoVictima) - robadas;
+        if (atomic_compare_exchange_strong_explicit(&p->rangos[victima].rango, &rangoVictima,
+                                                    empaquetar(inicio_de(rangoVictima), desde),
+                                                    memory_order_relaxed, memory_order_relaxed)) {
+            atomic_store_explicit(&p->rangos[yo].rango, empaquetar(desde + 1, fin_de(rangoVictima)), memory_order_relaxed);
+            return (int)desde;
+        }
+    }
+}
+
+static void trabajar(Pool* p, int yo) {
+    int unidad;
+    while ((unidad = tomar(&p->rangos[yo])) >= 0 || (unidad = robar(p, yo)) >= 0) {
+        p->funcion(p->contexto, unidad, yo);
+    }
+}
+
+#ifndef _WIN32
+static void* hilo_trabajador(void* arg) {
+    Trabajador* t = arg;
+    trabajar(t->pool, t->hilo);
+    objetos_soltar_cache_hilo();
+    return NULL;
+}
+#endif
+
+int trabajo_nucleos(void) {
+#ifndef _WIN32
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nucleos > 0) return nucleos > MAXHILOSTRABAJO ? MAXHILOSTRABAJO : (int)nucleos;
+#endif
+    return 1;
+}
+
+/**
+ * trabajo_ejecutar
+ * ----------------
+ * Reparte las unidades en rangos contiguos del mismo tamaño (las unidades vecinas suelen
+ * compartir datos, como el mismo mapa), crea los hilos y trabaja también en el que llama.
+ *
+ * Consideraciones:
+ *  - Si no se puede crear algún hilo, su rango queda sin dueño y lo roban los demás.
+ *  - Es reentrante: no usa estado global, así que se puede llamar desde varios hilos a la vez.
+ *  - La creación y la espera de los hilos ordenan la memoria: lo que escribieron las
+ *    unidades es visible para el que llama al volver.
+ */
+
+void trabajo_ejecutar(int numUnidades, int numHilos, FuncionTrabajo funcion, void* contexto) {
+    if (numUnidades <= 0) return;
+    if (numHilos < 1) numHilos = 1;
+    if (numHilos > MAXHILOSTRABAJO) numHilos = MAXHILOSTRABAJO;
+    if (numHilos > numUnidades) numHilos = numUnidades;
+#ifdef _WIN32
+    numHilos = 1;
+#endif
+
+    // En la pila de quien llama (unos 16 KB): cada llamada tiene el suyo, así que dos
+    // hilos pueden repartir trabajo a la vez sin pisarse los rangos
+    Pool pool;
+    Pool* p = &pool;
+    p->numHilos = numHilos;
+    p->funcion = funcion;
+    p->contexto = contexto;
+    for (int i = 0; i < numHilos; i++) {
+        uint32_t inicio = (uint32_t)((int64_t)numUnidades * i / numHilos);
+        uint32_t fin = (uint32_t)((int64_t)numUnidades * (i + 1) / numHilos);
+        atomic_init(&p->rangos[i].rango, empaquetar(inicio, fin));
+    }
+
+#ifndef _WIN32
+    pthread_t hilos[MAXHILOSTRABAJO];
+    Trabajador trabajadores[MAXHILOSTRABAJO];
+    bool creado[MAXHILOSTRABAJO] = { false };
+    for (int i = 1; i < numHilos; i++) {
+        trabajadores[i] = (Trabajador){ p, i };
+        creado[i] = pthread_create(&hilos[i], NULL, hilo_trabajador, &trabajadores[i]) == 0;
+    }
+#endif
+
+    trabajar(p, 0);
+
+#ifndef _WIN32
+    for (int i = 1; i < numHilos; i++) {
+        if (creado[i]) pthread_join(hilos[i], NULL);
+    }
+#endif
+}
@@ -0,0 +1,32 @@
+#ifndef TRABAJO_H
+#define TRABAJO_H
+
+#include <stdbool.h>
+
+/*
+ * Pool de hilos con robo de trabajo para lotes de unidades independientes (ver torneo.h).
+ * Las unidades 0 .. N-1 se reparten en rangos contiguos, uno por hilo. Cada hilo toma las
+ * unidades de su rango desde el principio; cuando se le acaba, le roba la mitad final del
+ * rango más largo que quede. Tomar y robar son un compare-and-swap sobre el rango, sin
+ * cerrojos, así que todos los núcleos siguen ocupados aunque las unidades duren muy
+ * distinto (mapas de tamaños diferentes).
+ *
+ * El hilo que llama participa como un trabajador más. Al terminar, cada hilo devuelve su
+ * caché de objetos (ver objetos.h).
+ */
+
+#define MAXHILOSTRABAJO 256
+
+// Ejecuta una unidad. 'hilo' es el número del trabajador que la ejecuta (desde 0).
+typedef void (*FuncionTrabajo)(void* contexto, int unidad, int hilo);
+
+// Cantidad de núcleos disponibles (al menos 1).
+int trabajo_nucleos(void);
+
+// Ejecuta las unidades 0 .. numUnidades-1 con hasta 'numHilos' hilos y vuelve cuando
+// terminaron todas. Si no se pueden crear hilos, las ejecuta los que se hayan creado.
+// Es reentrante: varios hilos (y las propias unidades) pueden llamarla a la vez, y cada
+// llamada reparte sus unidades entre sus propios hilos.
+void trabajo_ejecutar(int numUnidades, int numHilos, FuncionTrabajo funcion, void* contexto);
+
+#endif // TRABAJO_H
@@ -0,0 +1,515 @@
+#include "validador.h"
+#include "extra.h"
+#include "grafo.h"
+#include "memoria.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+
+#define MAXDIAGMOSTRADOS 100
+
+// Par (ID, fila) usado para ordenar y buscar IDs sin depender de que sean consecutivos.
+typedef struct {
+    int id;
+    int fila;
+} ParId;
+
+static void agregar_diagnostico(ValidacionMapa* v, int linea, int columna, Severidad severidad,
+                                TipoDiagnostico tipo, const char* formato, ...) {
+    // Se cuenta antes de guardarlo: sin memoria para el mensaje, el error igual rechaza
+    // el mapa en modo estricto
+    if (severidad == DIAG_ERROR) v->errores++;
+    else v->advertencias++;
+
+    if (v->numDiagnosticos == v->capDiagnosticos) {
+        int nuevaCap = v->capDiagnosticos ? v->capDiagnosticos * 2 : 16;
+        Diagnostico* nuevos = mem_redimensionar(MEM_CARGADOR, v->diagnosticos, sizeof(Diagnostico) * nuevaCap);
+        if (!nuevos) return;
+        v->diagnosticos = nuevos;
+        v->capDiagnosticos = nuevaCap;
+    }
+
+    Diagnostico* d = &v->diagnosticos[v->numDiagnosticos++];
+    d->linea = linea;
+    d->columna = columna;
+    d->severidad = severidad;
+    d->tipo = tipo;
+
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(d->mensaje, MAXDIAGMSG, formato, args);
+    va_end(args);
+}
+
+static int comparar_pares(const void* a, const void* b) {
+    const ParId* x = a;
+    const ParId* y = b;
+    if (x->id != y->id) return x->id < y->id ? -1 : 1;
+    return x->fila - y->fila;
+}
+
+// Busca un ID entre los pares ordenados (sin duplicados). Retorna la fila o -1.
+static int buscar_id(const ParId* pares, int cantidad, int id) {
+    int lo = 0, hi = cantidad - 1;
+    while (lo <= hi) {
+        int medio = lo + (hi - lo) / 2;
+        if (pares[medio].id == id) return pares[medio].fila;
+        if (pares[medio].id < id) lo = medio + 1;
+        else hi = medio - 1;
+    }
+    return -1;
+}
+
+/*
+ * validar_items
+ * -------------
+ * Revisa el campo de ítems ("nombre,valor,peso;nombre,valor,peso;...") sin modificarlo
+ * y reporta cada ítem mal formado con su columna exacta.
+ */
+
+static void validar_items(ValidacionMapa* v, int linea, int columnaCampo, const char* campo) {
+    const char* cursor = campo;
+    ItemCsv item;
+    while (leer_item_csv(&cursor, &item)) {
+        int columna = columnaCampo + (int)(item.inicio - campo);
+        switch (item.estado) {
+            case ITEM_CSV_MALFORMADO:
+                agregar_diagnostico(v, linea, columna, DIAG_ERROR, DIAG_ITEM_MALFORMADO,
+                                    "el ítem \"%.*s\" no tiene la forma nombre,valor,peso", (int)item.largo, item.inicio);
+                break;
+            case ITEM_CSV_SIN_NOMBRE:
+                agregar_diagnostico(v, linea, columna, DIAG_ERROR, DIAG_ITEM_MALFORMADO, "ítem sin nombre");
+                break;
+            case ITEM_CSV_VALOR_INVALIDO:
+                agregar_diagnostico(v, linea, columnaCampo + (int)(item.textoValor - campo), DIAG_ERROR, DIAG_ITEM_MALFORMADO,
+                                    "valor inválido \"%.*s\" para el ítem \"%.*s\"", (int)item.largoValor, item.textoValor,
+                                    (int)item.largoNombre, item.nombre);
+                break;
+            case ITEM_CSV_PESO_INVALIDO:
+                agregar_diagnostico(v, linea, columnaCampo + (int)(item.textoPeso - campo), DIAG_ERROR, DIAG_ITEM_MALFORMADO,
+                                    "peso inválido \"%.*s\" para el ítem \"%.*s\"", (int)item.largoPeso, item.textoPeso,
+                                    (int)item.largoNombre, item.nombre);
+                break;
+            case ITEM_CSV_VALIDO:
+                if (item.largoNombre >= MAXITEMNAME) {
+                    agregar_diagnostico(v, linea, columna, DIAG_ADVERTENCIA, DIAG_CAMPO_DEMASIADO_LARGO,
+                                        "el nombre del ítem se recortará a %d caracteres", MAXITEMNAME - 1);
+                }
+                break;
+        }
+    }
+}
+
+static FilaMapa* nueva_fila(ValidacionMapa* v, int* capacidad) {
+    if (v->numFilas == *capacidad) {
+        int nuevaCap = *capacidad ? *capacidad * 2 : 128;
+        FilaMapa* nuevas = mem_redimensionar(MEM_CARGADOR, v->filas, sizeof(FilaMapa) * nuevaCap);
+        if (!nuevas) return NULL;
+        v->filas = nuevas;
+        *capacidad = nuevaCap;
+    }
+    FilaMapa* f = &v->filas[v->numFilas++];
+    f->id = 0;
+    f->nodo = -1;
+    f->esFinal = false;
+    f->primeraArista = v->numAristas;
+    f->numAristas = 0;
+    return f;
+}
+
+// Agrega una arista a la última fila. Su destino queda como ID hasta resolverlo en validar_grafo.
+static bool nueva_arista(ValidacionMapa* v, FilaMapa* f, int idDestino, int costo, int direccion, int columna) {
+    if (v->numAristas == v->capAristas) {
+        int nuevaCap = v->capAristas ? v->capAristas * 2 : 512;
+        AristaMapa* nuevas = mem_redimensionar(MEM_CARGADOR, v->aristas, sizeof(AristaMapa) * nuevaCap);
+        if (!nuevas) return false;
+        v->aristas = nuevas;
+        v->capAristas = nuevaCap;
+    }
+    AristaMapa* a = &v->aristas[v->numAristas++];
+    a->destino = idDestino;
+    a->costo = costo;
+    a->direccion = direccion;
+    a->columna = columna;
+    a->inicioEtiqueta = 0;
+    a->largoEtiqueta = 0;
+    f->numAristas++;
+    return true;
+}
+
+/*
+ * validar_aristas_extendidas
+ * --------------------------
+ * Revisa la columna opcional de aristas extendidas ("etiqueta,destino[,costo];...") y
+ * agrega cada arista bien formada a la fila. Los destinos se resuelven después, junto
+ * con los de las direcciones cardinales. Retorna false si no hay memoria.
+ */
+
+static bool validar_aristas_extendidas(ValidacionMapa* v, FilaMapa* f, int columnaCampo, const char* campo) {
+    const char* inicio = campo;
+    while (*inicio) {
+        const char* fin = strchr(inicio, ';');
+        size_t largo = fin ? (size_t)(fin - inicio) : strlen(inicio);
+        int columna = columnaCampo + (int)(inicio - campo);
+
+        if (largo > 0) {
+            char arista[MAXNAME + 64];
+            if (largo >= sizeof(arista)) {
+                agregar_diagnostico(v, f->linea, columna, DIAG_ERROR, DIAG_ARISTA_MALFORMADA,
+                                    "arista demasiado larga (%zu caracteres)", largo);
+            } else {
+                memcpy(arista, inicio, largo);
+                arista[largo] = '\0';
+
+                char* partes[3];
+                int numPartes = 0;
+                char* p = arista;
+                partes[numPartes++] = p;
+                while ((p = strchr(p, ',')) != NULL) {
+                    *p++ = '\0';
+                    if (numPartes == 3) { numPartes++; break; }
+                    partes[numPartes++] = p;
+                }
+
+                int destino, costo = 0;
+                size_t largoEtiqueta = strlen(partes[0]);
+                if (numPartes < 2 || numPartes > 3) {
+                    agregar_diagnostico(v, f->linea, columna, DIAG_ERROR, DIAG_ARISTA_MALFORMADA,
+                                        "la arista \"%.*s\" no tiene la forma etiqueta,destino[,costo]", (int)largo, inicio);
+                } else if (largoEtiqueta == 0 || largoEtiqueta >= MAXNAME) {
+                    agregar_diagnostico(v, f->linea, columna, DIAG_ERROR, DIAG_ARISTA_MALFORMADA,
+                                        largoEtiqueta == 0 ? "arista sin etiqueta" : "etiqueta de arista demasiado larga");
+                } else if (!texto_a_entero(partes[1], &destino) || destino < 1) {
+                    agregar_diagnostico(v, f->linea, columna + (int)(partes[1] - arista), DIAG_ERROR, DIAG_ARISTA_MALFORMADA,
+                                        "destino inválido \"%s\" para la arista \"%s\"", partes[1], partes[0]);
+                } else if (numPartes == 3 && (!texto_a_entero(partes[2], &costo) || costo < 0 || costo > MAXCOSTOARISTA)) {
+                    agregar_diagnostico(v, f->linea, columna + (int)(partes[2] - arista), DIAG_ERROR, DIAG_ARISTA_MALFORMADA,
+                                        "costo inválido \"%s\" para la arista \"%s\" (debe estar entre 0 y %d)",
+                                        partes[2], partes[0], MAXCOSTOARISTA);
+                } else {
+                    if (!nueva_arista(v, f, destino, costo, -1, columna)) return false;
+                    AristaMapa* a = &v->aristas[v->numAristas - 1];
+                    a->inicioEtiqueta = (int)(inicio - campo);
+                    a->largoEtiqueta = (int)largoEtiqueta;
+                }
+            }
+        }
+
+        if (!fin) break;
+        inicio = fin + 1;
+    }
+    return true;
+}
+
+/*
+ * validar_fila
+ * ------------
+ * Valida los campos de una fila. Si la fila puede cargarse la marca como aceptada
+ * (nodo = 0, el índice definitivo se asigna después) y le agrega sus aristas, con el
+ * ID de destino aún sin resolver. Retorna false si no hay memoria.
+ */
+
+static bool validar_fila(ValidacionMapa* v, FilaMapa* f, char** campos, const InfoLineaCsv* info) {
+    int linea = f->linea;
+
+    if (info->truncada) {
+        agregar_diagnostico(v, linea, 1, DIAG_ERROR, DIAG_LINEA_MALFORMADA, "línea demasiado larga");
+        return true;
+    }
+    if (info->comillaSinCerrar) {
+        agregar_diagnostico(v, linea, 1, DIAG_ERROR, DIAG_LINEA_MALFORMADA, "comillas sin cerrar");
+        return true;
+    }
+
+    #define COLUMNA(k) ((int)(campos[k] - campos[0]) + 1)
+
+    if (info->numCampos < NUMCAMPOSCSV) {
+        int ultimo = info->numCampos - 1;
+        agregar_diagnostico(v, linea, COLUMNA(ultimo) + (int)strlen(campos[ultimo]), DIAG_ERROR, DIAG_CAMPOS_FALTANTES,
+                            "la fila tiene %d campos; se esperaban %d", info->numCampos, NUMCAMPOSCSV);
+        return true;
+    }
+
+    int id;
+    if (!texto_a_entero(campos[0], &id) || id < 1) {
+        agregar_diagnostico(v, linea, COLUMNA(0), DIAG_ERROR, DIAG_ID_INVALIDO,
+                            "ID inválido \"%s\" (debe ser un entero mayor que 0)", campos[0]);
+        return true;
+    }
+    f->id = id;
+    f->nodo = 0;
+
+    if (strlen(campos[1]) >= MAXNAME) {
+        agregar_diagnostico(v, linea, COLUMNA(1), DIAG_ADVERTENCIA, DIAG_CAMPO_DEMASIADO_LARGO,
+                            "el nombre se recortará a %d caracteres", MAXNAME - 1);
+    }
+    if (strlen(campos[2]) >= MAXDESC) {
+        agregar_diagnostico(v, linea, COLUMNA(2), DIAG_ADVERTENCIA, DIAG_CAMPO_DEMASIADO_LARGO,
+                            "la descripción se recortará a %d caracteres", MAXDESC - 1);
+    }
+
+    validar_items(v, linea, COLUMNA(3), campos[3]);
+
+    for (int d = 0; d < MAXDIR; d++) {
+        int destino;
+        if (!texto_a_entero(campos[4 + d], &destino) || (destino < 1 && destino != -1)) {
+            agregar_diagnostico(v, linea, COLUMNA(4 + d), DIAG_ERROR, DIAG_ADYACENCIA_INVALIDA,
+                                "adyacencia %s inválida \"%s\" (debe ser un ID o -1)", nombresDirecciones[d], campos[4 + d]);
+            continue;
+        }
+        if (destino != -1 && !nueva_arista(v, f, destino, 0, d, COLUMNA(4 + d))) return false;
+    }
+    if (info->numCampos > CAMPOARISTAS &&
+        !validar_aristas_extendidas(v, f, COLUMNA(CAMPOARISTAS), campos[CAMPOARISTAS])) {
+        return false;
+    }
+
+    char final[8];
+    int k = 0;
+    for (const char* p = campos[8]; *p && k < 7; p++) final[k++] = (char)tolower((unsigned char)*p);
+    final[k] = '\0';
+    f->esFinal = (strcmp(final, "si") == 0 || strcmp(final, "sí") == 0);
+    if (!f->esFinal && strcmp(final, "no") != 0) {
+        agregar_diagnostico(v, linea, COLUMNA(8), DIAG_ADVERTENCIA, DIAG_FINAL_INVALIDO,
+                            "EsFinal \"%s\" no es Si ni No; se tomará como No", campos[8]);
+    }
+
+    #undef COLUMNA
+    return true;
+}
+
+/*
+ * validar_grafo
+ * -------------
+ * Verificaciones globales una vez leídas todas las filas: IDs duplicados, aristas
+ * colgantes o asimétricas, escenarios inalcanzables y existencia de un final alcanzable.
+ * También asigna a cada fila aceptada su índice definitivo de nodo.
+ */
+
+static bool validar_grafo(ValidacionMapa* v) {
+    ParId* pares = mem_reservar(MEM_CARGADOR, sizeof(ParId) * (v->numFilas + 1));
+    int* filaDeNodo = mem_reservar(MEM_CARGADOR, sizeof(int) * (v->numFilas + 1));
+    int* cola = mem_reservar(MEM_CARGADOR, sizeof(int) * (v->numFilas + 1));
+    bool* visitado = mem_reservar_ceros(MEM_CARGADOR, v->numFilas + 1, sizeof(bool));
+    if (!pares || !filaDeNodo || !cola || !visitado) {
+        mem_liberar(pares); mem_liberar(filaDeNodo); mem_liberar(cola); mem_liberar(visitado);
+        return false;
+    }
+
+    // IDs duplicados: se conserva la primera fila con cada ID
+    int numPares = 0;
+    for (int r = 0; r < v->numFilas; r++) {
+        if (v->filas[r].nodo < 0) continue;
+        pares[numPares].id = v->filas[r].id;
+        pares[numPares].fila = r;
+        numPares++;
+    }
+    qsort(pares, numPares, sizeof(ParId), comparar_pares);
+
+    int unicos = 0;
+    for (int i = 0; i < numPares; i++) {
+        if (unicos > 0 && pares[unicos - 1].id == pares[i].id) {
+            FilaMapa* f = &v->filas[pares[i].fila];
+            agregar_diagnostico(v, f->linea, 1, DIAG_ERROR, DIAG_ID_DUPLICADO,
+                                "ID %d duplicado (ya definido en la línea %d)", f->id, v->filas[pares[unicos - 1].fila].linea);
+            f->nodo = -1;
+            continue;
+        }
+        pares[unicos++] = pares[i];
+    }
+
+    // Índices de nodo en el orden del archivo
+    v->numNodos = 0;
+    for (int r = 0; r < v->numFilas; r++) {
+        if (v->filas[r].nodo < 0) continue;
+        filaDeNodo[v->numNodos] = r;
+        v->filas[r].nodo = v->numNodos++;
+    }
+    v->inicio = unicos > 0 ? v->filas[pares[0].fila].nodo : -1;
+
+    // Aristas colgantes (las de filas descartadas tampoco se cargan)
+    v->aristasValidas = 0;
+    for (int r = 0; r < v->numFilas; r++) {
+        FilaMapa* f = &v->filas[r];
+        for (int k = f->primeraArista; k < f->primeraArista + f->numAristas; k++) {
+            AristaMapa* a = &v->aristas[k];
+            int idDestino = a->destino;
+            a->destino = -1;
+            if (f->nodo < 0) continue;
+            int filaDestino = buscar_id(pares, unicos, idDestino);
+            if (filaDestino < 0) {
+                agregar_diagnostico(v, f->linea, a->columna, DIAG_ERROR, DIAG_ARISTA_COLGANTE, "%s apunta al ID %d, que no existe",
+                                    a->direccion >= 0 ? nombresDirecciones[a->direccion] : "La arista extendida", idDestino);
+            } else {
+                a->destino = v->filas[filaDestino].nodo;
+                v->aristasValidas++;
+            }
+        }
+    }
+
+    // Aristas asimétricas: la dirección opuesta de d es d ^ 1 (Arriba/Abajo, Izquierda/Derecha).
+    // Las aristas extendidas pueden ser de un solo sentido y no se revisan.
+    for (int r = 0; r < v->numFilas; r++) {
+        FilaMapa* f = &v->filas[r];
+        if (f->nodo < 0) continue;
+        for (int k = f->primeraArista; k < f->primeraArista + f->numAristas; k++) {
+            const AristaMapa* a = &v->aristas[k];
+            if (a->destino < 0 || a->direccion < 0) continue;
+            FilaMapa* destino = &v->filas[filaDeNodo[a->destino]];
+            bool vuelve = false;
+            for (int j = destino->primeraArista; j < destino->primeraArista + destino->numAristas; j++) {
+                if (v->aristas[j].direccion == (a->direccion ^ 1) && v->aristas[j].destino == f->nodo) vuelve = true;
+            }
+            if (!vuelve) {
+                agregar_diagnostico(v, f->linea, a->columna, DIAG_ADVERTENCIA, DIAG_ARISTA_ASIMETRICA,
+                                    "%s lleva al ID %d, pero su %s no vuelve al ID %d",
+                                    nombresDirecciones[a->direccion], destino->id, nombresDirecciones[a->direccion ^ 1], f->id);
+            }
+        }
+    }
+
+    // Alcanzabilidad desde el inicio (BFS)
+    if (v->numNodos == 0) {
+        agregar_diagnostico(v, 0, 0, DIAG_ERROR, DIAG_MAPA_VACIO, "el archivo no contiene escenarios válidos");
+    } else {
+        int frente = 0, fondo = 0;
+        bool finalAlcanzable = false;
+        cola[fondo++] = v->inicio;
+        visitado[v->inicio] = true;
+        while (frente < fondo) {
+            FilaMapa* f = &v->filas[filaDeNodo[cola[frente++]]];
+            if (f->esFinal) finalAlcanzable = true;
+            for (int k = f->primeraArista; k < f->primeraArista + f->numAristas; k++) {
+                int w = v->aristas[k].destino;
+                if (w >= 0 && !visitado[w]) {
+                    visitado[w] = true;
+                    cola[fondo++] = w;
+                }
+            }
+        }
+
+        for (int n = 0; n < v->numNodos; n++) {
+            if (visitado[n]) continue;
+            FilaMapa* f = &v->filas[filaDeNodo[n]];
+            agregar_diagnostico(v, f->linea, 1, DIAG_ADVERTENCIA, DIAG_NODO_INALCANZABLE,
+                                "el escenario %d no es alcanzable desde el inicio", f->id);
+        }
+        if (!finalAlcanzable) {
+            agregar_diagnostico(v, 0, 0, DIAG_ERROR, DIAG_SIN_FINAL_ALCANZABLE,
+                                "ningún escenario final es alcanzable desde el inicio");
+        }
+    }
+
+    mem_liberar(pares);
+    mem_liberar(filaDeNodo);
+    mem_liberar(cola);
+    mem_liberar(visitado);
+    return true;
+}
+
+/**
+ * validar_mapa
+ * -------------
+ * Recorre el archivo CSV de escenarios (desde su posición actual, incluyendo el
+ * encabezado) y reporta en una sola pasada todos los problemas encontrados, cada uno
+ * con su línea y columna.
+ *
+ * Verifica:
+ *  - Líneas mal formadas y filas con campos faltantes.
+ *  - IDs inválidos o duplicados.
+ *  - Ítems que no son triples nombre,valor,peso con números válidos.
+ *  - Adyacencias inválidas, colgantes (ID inexistente) o asimétricas.
+ *  - Aristas extendidas (columna opcional) mal formadas o colgantes.
+ *  - Escenarios inalcanzables desde el inicio y ausencia de un final alcanzable.
+ *
+ * Retorno:
+ *  - La validación con los diagnósticos y, para cada fila, si se carga, su índice de nodo
+ *    y sus aristas ya resueltas. El cargador solo usa filas y aristas válidas, por lo
+ *    que un mapa con errores nunca produce accesos fuera del arreglo de nodos.
+ *  - NULL si no hay memoria suficiente.
+ *
+ * Consideraciones:
+ *  - El nodo inicial es el escenario de menor ID.
+ *  - Los IDs no necesitan ser consecutivos ni estar ordenados.
+ */
+
+ValidacionMapa* validar_mapa(FILE* archivo) {
+    ValidacionMapa* v = mem_reservar_ceros(MEM_CARGADOR, 1, sizeof(ValidacionMapa));
+    if (!v) return NULL;
+    v->inicio = -1;
+
+    InfoLineaCsv info;
+    char** campos = leer_linea_csv(archivo, ',', &info);
+    if (campos == NULL) {
+        agregar_diagnostico(v, 0, 0, DIAG_ERROR, DIAG_MAPA_VACIO, "el archivo está vacío");
+        return v;
+    }
+    if (info.numCampos < NUMCAMPOSCSV) {
+        agregar_diagnostico(v, 1, 1, DIAG_ADVERTENCIA, DIAG_CAMPOS_FALTANTES,
+                            "el encabezado tiene %d columnas; se esperaban %d", info.numCampos, NUMCAMPOSCSV);
+    }
+
+    int capFilas = 0;
+    int linea = 1;
+    bool sinMemoria = false;
+
+    while ((campos = leer_linea_csv(archivo, ',', &info)) != NULL) {
+        linea++;
+        FilaMapa* f = nueva_fila(v, &capFilas);
+        if (!f) {
+            sinMemoria = true;
+            break;
+        }
+
+        f->linea = linea;
+        if (info.numCampos == 0 || (info.numCampos == 1 && campos[0][0] == '\0')) continue; // línea vacía
+        if (!validar_fila(v, f, campos, &info)) {
+            sinMemoria = true;
+            break;
+        }
+    }
+
+    if (sinMemoria || !validar_grafo(v)) {
+        liberar_validacion(v);
+        return NULL;
+    }
+    return v;
+}
+
+/**
+ * mostrar_diagnosticos
+ * ---------------------
+ * Imprime los diagnósticos en el formato "línea L, columna C: error|advertencia: mensaje".
+ * Para no inundar la consola con mapas muy dañados, muestra como máximo los primeros
+ * MAXDIAGMOSTRADOS y luego un resumen con el total de errores y advertencias.
+ */
+
+void mostrar_diagnosticos(const ValidacionMapa* v) {
+    if (!v || v->errores + v->advertencias == 0) return;
+
+    puts("\n------ Problemas encontrados en el mapa ------");
+    for (int i = 0; i < v->numDiagnosticos && i < MAXDIAGMOSTRADOS; i++) {
+        const Diagnostico* d = &v->diagnosticos[i];
+        const char* severidad = d->severidad == DIAG_ERROR ? "error" : "advertencia";
+        if (d->linea == 0) printf("mapa: %s: %s\n", severidad, d->mensaje);
+        else printf("línea %d, columna %d: %s: %s\n", d->linea, d->columna, severidad, d->mensaje);
+    }
+    if (v->numDiagnosticos > MAXDIAGMOSTRADOS) {
+        printf("... y %d problemas más.\n", v->numDiagnosticos - MAXDIAGMOSTRADOS);
+    }
+    if (v->errores + v->advertencias > v->numDiagnosticos) {
+        printf("... y %d problemas que no se pudieron detallar por falta de memoria.\n",
+               v->errores + v->advertencias - v->numDiagnosticos);
+    }
+    printf("Total: %d error(es), %d advertencia(s).\n", v->errores, v->advertencias);
+}
+
+void liberar_validacion(ValidacionMapa* v) {
+    if (!v) return;
+    mem_liberar(v->filas);
+    mem_liberar(v->aristas);
+    mem_liberar(v->diagnosticos);
+    mem_liberar(v);
+}
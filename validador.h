@@ -0,0 +1,87 @@
+#ifndef VALIDADOR_H
+#define VALIDADOR_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#define MAXDIAGMSG 160
+#define NUMCAMPOSCSV 9       // Campos obligatorios de cada fila
+#define CAMPOARISTAS 9       // Columna opcional con aristas extendidas ("etiqueta,destino[,costo];...")
+#define MAXCOSTOARISTA 1000
+
+typedef enum {
+    DIAG_ERROR,         // La fila, arista o ítem afectado no se carga
+    DIAG_ADVERTENCIA    // Se carga igual, pero probablemente es un error del mapa
+} Severidad;
+
+typedef enum {
+    DIAG_LINEA_MALFORMADA,      // Línea demasiado larga o con comillas sin cerrar
+    DIAG_CAMPOS_FALTANTES,      // La fila tiene menos campos de los esperados
+    DIAG_ID_INVALIDO,           // ID no numérico, fuera de rango o menor que 1
+    DIAG_ID_DUPLICADO,          // Otro escenario ya usa el mismo ID
+    DIAG_CAMPO_DEMASIADO_LARGO, // Nombre o descripción más largos de lo que se puede guardar
+    DIAG_ITEM_MALFORMADO,       // Ítem que no es "nombre,valor,peso" con números válidos
+    DIAG_ADYACENCIA_INVALIDA,   // Valor de adyacencia que no es un ID ni -1
+    DIAG_ARISTA_COLGANTE,       // Adyacencia hacia un ID que no existe en el mapa
+    DIAG_ARISTA_ASIMETRICA,     // A lleva a B en una dirección, pero B no vuelve a A por la opuesta
+    DIAG_ARISTA_MALFORMADA,     // Arista extendida que no es "etiqueta,destino[,costo]" válida
+    DIAG_FINAL_INVALIDO,        // Valor de EsFinal distinto de Si/No
+    DIAG_NODO_INALCANZABLE,     // No se puede llegar al escenario desde el inicio
+    DIAG_SIN_FINAL_ALCANZABLE,  // Ningún escenario final es alcanzable desde el inicio
+    DIAG_MAPA_VACIO             // El archivo no contiene escenarios válidos
+} TipoDiagnostico;
+
+typedef struct {
+    int             linea;      // Línea del archivo (1 = encabezado, 0 = problema global del mapa)
+    int             columna;    // Columna (en caracteres) donde comienza el campo afectado
+    Severidad       severidad;
+    TipoDiagnostico tipo;
+    char            mensaje[MAXDIAGMSG];
+} Diagnostico;
+
+// Arista validada de una fila, en el orden en que aparece (primero las cardinales).
+typedef struct {
+    int destino;            // Índice del nodo destino (-1 si la arista se descarta)
+    int costo;              // Costo base del movimiento (0 en las direcciones cardinales)
+    int direccion;          // Dirección cardinal (0-3) o -1 si es una arista extendida
+    int columna;            // Columna del archivo donde comienza la arista
+    int inicioEtiqueta;     // Aristas extendidas: posición de la etiqueta dentro del campo
+    int largoEtiqueta;
+} AristaMapa;
+
+// Resultado de validar una fila del CSV, usado luego por el cargador.
+typedef struct {
+    int linea;              // Línea del archivo donde está la fila
+    int id;                 // ID declarado en el CSV
+    int nodo;               // Índice asignado en graph.nodes (-1 si la fila se descarta)
+    int primeraArista;      // Sus aristas son aristas[primeraArista .. primeraArista + numAristas)
+    int numAristas;
+    bool esFinal;           // Si la fila marca un escenario final
+} FilaMapa;
+
+typedef struct {
+    FilaMapa*    filas;             // Una entrada por cada línea de datos leída, en orden
+    int          numFilas;
+    int          numNodos;          // Filas aceptadas (nodos que tendrá el grafo)
+    int          inicio;            // Índice del nodo inicial (-1 si no hay nodos)
+    AristaMapa*  aristas;           // Aristas de todas las filas, agrupadas por fila
+    int          numAristas;
+    int          capAristas;
+    int          aristasValidas;    // Aristas con destino resuelto (las que se cargarán)
+    Diagnostico* diagnosticos;
+    int          numDiagnosticos;
+    int          capDiagnosticos;
+    int          errores;
+    int          advertencias;
+} ValidacionMapa;
+
+// Valida el archivo completo en una sola pasada (más las verificaciones globales del grafo).
+ValidacionMapa* validar_mapa(FILE* archivo);
+
+// Muestra los diagnósticos encontrados, con línea y columna, y un resumen final.
+void mostrar_diagnosticos(const ValidacionMapa* v);
+
+// Libera la memoria de la validación.
+void liberar_validacion(ValidacionMapa* v);
+
+#endif // VALIDADOR_H